@@ -41,6 +41,9 @@ namespace itk
  * swapping. Byte swapping is often used when reading or writing binary
  * files. Files can either be Big Endian (BE) or Little Endian (LE).
  *
+ * Ranges are swapped in place, by loops the compiler can vectorize, and
+ * large ranges are split into chunks swapped in parallel.
+ *
  * \ingroup IOFilters
  * \ingroup OSSystemObjects
  * \ingroup ITKCommon
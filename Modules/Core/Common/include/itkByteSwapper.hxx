@@ -28,6 +28,7 @@
 #ifndef itkByteSwapper_hxx
 #define itkByteSwapper_hxx
 #include "itkByteSwapper.h"
+#include "itkByteSwapperCommon.h"
 #include <memory>
 #include <cstring>
 
@@ -286,14 +287,7 @@ template <typename T>
 void
 ByteSwapper<T>::Swap2Range(void * ptr, BufferSizeType num)
 {
-  auto * pos = static_cast<char *>(ptr);
-  for (BufferSizeType i = 0; i < num; i++)
-  {
-    const char one_byte = pos[0];
-    pos[0] = pos[1];
-    pos[1] = one_byte;
-    pos = pos + 2;
-  }
+  ByteSwapperCommon::SwapWordRange(ptr, num, 2);
 }
 
 // Swap bunch of bytes. Num is the number of four byte words to swap.
@@ -311,14 +305,8 @@ ByteSwapper<T>::SwapWrite2Range(void * ptr, BufferSizeType num, OStreamType * fp
   {
     memcpy(cpy, ptr, chunkSize * 2);
 
-    char * pos = cpy;
-    for (BufferSizeType i = 0; i < chunkSize; i++)
-    {
-      const char one_byte = pos[0];
-      pos[0] = pos[1];
-      pos[1] = one_byte;
-      pos = pos + 2;
-    }
+    ByteSwapper<T>::Swap2Range((void *)cpy, chunkSize);
+
     fp->write((char *)cpy, static_cast<std::streamsize>(2 * chunkSize));
     ptr = (char *)ptr + chunkSize * 2;
     num -= chunkSize;
@@ -354,19 +342,7 @@ template <typename T>
 void
 ByteSwapper<T>::Swap4Range(void * ptr, BufferSizeType num)
 {
-  auto * pos = static_cast<char *>(ptr);
-
-  for (BufferSizeType i = 0; i < num; i++)
-  {
-    char one_byte = pos[0];
-    pos[0] = pos[3];
-    pos[3] = one_byte;
-
-    one_byte = pos[1];
-    pos[1] = pos[2];
-    pos[2] = one_byte;
-    pos = pos + 4;
-  }
+  ByteSwapperCommon::SwapWordRange(ptr, num, 4);
 }
 
 // Swap bunch of bytes. Num is the number of four byte words to swap.
@@ -386,18 +362,8 @@ ByteSwapper<T>::SwapWrite4Range(void * ptr, BufferSizeType num, OStreamType * fp
   {
     memcpy(cpy, ptr, chunkSize * 4);
 
-    char * pos = cpy;
-    for (BufferSizeType i = 0; i < chunkSize; i++)
-    {
-      char one_byte = pos[0];
-      pos[0] = pos[3];
-      pos[3] = one_byte;
-
-      one_byte = pos[1];
-      pos[1] = pos[2];
-      pos[2] = one_byte;
-      pos = pos + 4;
-    }
+    ByteSwapper<T>::Swap4Range((void *)cpy, chunkSize);
+
     fp->write((char *)cpy, static_cast<std::streamsize>(4 * chunkSize));
     ptr = (char *)ptr + chunkSize * 4;
     num -= chunkSize;
@@ -441,27 +407,7 @@ template <typename T>
 void
 ByteSwapper<T>::Swap8Range(void * ptr, BufferSizeType num)
 {
-  auto * pos = static_cast<char *>(ptr);
-
-  for (BufferSizeType i = 0; i < num; i++)
-  {
-    char one_byte = pos[0];
-    pos[0] = pos[7];
-    pos[7] = one_byte;
-
-    one_byte = pos[1];
-    pos[1] = pos[6];
-    pos[6] = one_byte;
-
-    one_byte = pos[2];
-    pos[2] = pos[5];
-    pos[5] = one_byte;
-
-    one_byte = pos[3];
-    pos[3] = pos[4];
-    pos[4] = one_byte;
-    pos = pos + 8;
-  }
+  ByteSwapperCommon::SwapWordRange(ptr, num, 8);
 }
 
 // Swap bunch of bytes. Num is the number of four byte words to swap.
@@ -0,0 +1,48 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkByteSwapperCommon_h
+#define itkByteSwapperCommon_h
+
+#include "ITKCommonExport.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+
+/** \class ByteSwapperCommon
+ * \brief Byte swapping common between the ByteSwapper templates
+ *
+ * This class provides common non-templated code which can be compiled
+ * and used by all templated versions of ByteSwapper.
+ *
+ * \ingroup ITKCommon
+ */
+struct ITKCommon_EXPORT ByteSwapperCommon
+{
+  /**
+   * Reverse the bytes of num words of wordSize bytes, 2, 4 or 8, in place.
+   * The buffer need not be aligned. Ranges of less than a few hundred
+   * thousand words are swapped serially, larger ones in parallel.
+   */
+  static void
+  SwapWordRange(void * ptr, SizeValueType num, unsigned int wordSize);
+};
+
+} // end namespace itk
+
+#endif
@@ -30,7 +30,9 @@
 
 #include "itkImage.h"
 #include "itkProcessObject.h"
+#include "itkImportImageContainerCommon.h"
 #include <algorithm>
+#include <type_traits>
 
 namespace itk
 {
@@ -51,7 +53,22 @@ Image<TPixel, VImageDimension>::Allocate(bool initializePixels)
   this->ComputeOffsetTable();
   num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
 
-  m_Buffer->Reserve(num, initializePixels);
+  // A new buffer of pixels without a constructor is left untouched, so that
+  // the threads which later process its pieces can touch them first. A
+  // buffer which is grown keeps its pixels, and is allocated as usual.
+  const bool firstTouch = std::is_trivially_default_constructible<TPixel>::value &&
+                          ImportImageContainerCommon::GetGlobalDefaultNUMAFirstTouch() &&
+                          m_Buffer->GetImportPointer() == nullptr;
+  m_Buffer->Reserve(num, initializePixels && !firstTouch);
+  if (firstTouch && m_Buffer->GetImportPointer() != nullptr)
+  {
+    const RegionType & bufferedRegion = this->GetBufferedRegion();
+    ImportImageContainerCommon::FirstTouch(m_Buffer->GetImportPointer(),
+                                           VImageDimension,
+                                           &bufferedRegion.GetIndex()[0],
+                                           &bufferedRegion.GetSize()[0],
+                                           sizeof(TPixel));
+  }
 }
 
 
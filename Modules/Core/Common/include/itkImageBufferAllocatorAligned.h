@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocatorAligned_h
+#define itkImageBufferAllocatorAligned_h
+
+#include "itkImageBufferAllocatorBase.h"
+
+namespace itk
+{
+
+/** \class ImageBufferAllocatorAligned
+ * \brief Allocate image buffers aligned for SIMD instructions.
+ *
+ * The buffers start at a multiple of the Alignment, which is 64 bytes by
+ * default: the size of a cache line, and of an AVX-512 register.
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocatorAligned : public ImageBufferAllocatorBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocatorAligned);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocatorAligned;
+  using Superclass = ImageBufferAllocatorBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferAllocatorAligned, ImageBufferAllocatorBase);
+
+  /** Set/Get the alignment in bytes. It must be a power of two, and a
+   * multiple of sizeof(void *). */
+  itkSetMacro(Alignment, SizeValueType);
+  itkGetConstMacro(Alignment, SizeValueType);
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+protected:
+  ImageBufferAllocatorAligned();
+  ~ImageBufferAllocatorAligned() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Allocate memory starting at a multiple of the alignment. Throws a
+   * MemoryAllocationError on failure. */
+  static void *
+  AllocateAligned(SizeValueType numberOfBytes, SizeValueType alignment);
+
+  /** Release memory returned by AllocateAligned(). */
+  static void
+  FreeAligned(void * buffer);
+
+private:
+  SizeValueType m_Alignment{ 64 };
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocatorBase_h
+#define itkImageBufferAllocatorBase_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+
+/** \class ImageBufferAllocatorBase
+ * \brief Allocate and release the memory of image buffers.
+ *
+ * ImageBufferAllocatorBase is an abstract interface to the memory
+ * allocation of ImportImageContainer. By default, image buffers are
+ * allocated with array new. An allocator can be set on a single container
+ * with ImportImageContainer::SetAllocator(), or for all containers with
+ * ImportImageContainerCommon::SetGlobalDefaultAllocator().
+ *
+ * Allocate() returns uninitialized memory, and throws a
+ * MemoryAllocationError when the memory cannot be allocated. The container
+ * constructs the elements in that memory when needed.
+ *
+ * \sa ImageBufferAllocatorAligned
+ * \sa ImageBufferAllocatorHugePage
+ * \sa ImageBufferAllocatorRecycling
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocatorBase : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocatorBase);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocatorBase;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferAllocatorBase, Object);
+
+  /** Allocate an uninitialized buffer of the given number of bytes. */
+  virtual void *
+  Allocate(SizeValueType numberOfBytes) = 0;
+
+  /** Release a buffer returned by Allocate(). The number of bytes is the
+   * one which was passed to Allocate(). */
+  virtual void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) = 0;
+
+protected:
+  ImageBufferAllocatorBase();
+  ~ImageBufferAllocatorBase() override;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,76 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocatorHugePage_h
+#define itkImageBufferAllocatorHugePage_h
+
+#include "itkImageBufferAllocatorAligned.h"
+
+namespace itk
+{
+
+/** \class ImageBufferAllocatorHugePage
+ * \brief Allocate large image buffers on transparent huge pages.
+ *
+ * Buffers of at least HugePageSize bytes are aligned to, and padded to a
+ * multiple of the huge page size. On Linux, the kernel is then advised to
+ * back them with transparent huge pages, which saves most page faults and
+ * TLB misses for multi-gigabyte volumes. Smaller buffers, and buffers on
+ * other platforms, are allocated like by ImageBufferAllocatorAligned.
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocatorHugePage : public ImageBufferAllocatorAligned
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocatorHugePage);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocatorHugePage;
+  using Superclass = ImageBufferAllocatorAligned;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferAllocatorHugePage, ImageBufferAllocatorAligned);
+
+  /** Set/Get the size of a huge page in bytes, 2 MiB by default. It must be
+   * a power of two. */
+  itkSetMacro(HugePageSize, SizeValueType);
+  itkGetConstMacro(HugePageSize, SizeValueType);
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+protected:
+  ImageBufferAllocatorHugePage();
+  ~ImageBufferAllocatorHugePage() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  SizeValueType m_HugePageSize{ 2 * 1024 * 1024 };
+};
+} // end namespace itk
+
+#endif
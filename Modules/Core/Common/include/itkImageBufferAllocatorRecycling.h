@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocatorRecycling_h
+#define itkImageBufferAllocatorRecycling_h
+
+#include "itkImageBufferAllocatorBase.h"
+#include <map>
+#include <mutex>
+
+namespace itk
+{
+
+/** \class ImageBufferAllocatorRecycling
+ * \brief Reuse released image buffers of identical size.
+ *
+ * Released buffers are kept in a cache instead of being freed, and handed
+ * out again by the next allocation of exactly the same number of bytes.
+ * When a pipeline is re-executed on many images of the same size, almost
+ * all allocations and page faults are avoided this way.
+ *
+ * Buffers which are not found in the cache are allocated by the Allocator,
+ * an ImageBufferAllocatorAligned by default. At most MaximumCachedBytes
+ * bytes are kept in the cache; further released buffers are freed, so that
+ * a buffer larger than MaximumCachedBytes is never recycled. The default
+ * limit, 256 MiB, may be changed by giving a number of bytes in the
+ * ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_RECYCLING_MAXIMUM_CACHED_BYTES environment
+ * variable, e.g. when the allocator is picked through
+ * ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATOR to recycle multi-GB images.
+ * Recycled buffers are not cleared.
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataRepresentation
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocatorRecycling : public ImageBufferAllocatorBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocatorRecycling);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocatorRecycling;
+  using Superclass = ImageBufferAllocatorBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferAllocatorRecycling, ImageBufferAllocatorBase);
+
+  /** Set/Get the allocator of the buffers. Setting it releases the cache.
+   * The allocator cannot be changed while buffers it allocated are not
+   * deallocated, an exception is thrown then. */
+  virtual void
+  SetAllocator(ImageBufferAllocatorBase * allocator);
+  itkGetModifiableObjectMacro(Allocator, ImageBufferAllocatorBase);
+
+  /** Set/Get the maximum number of bytes kept in the cache, 256 MiB unless set
+   * by the environment. Raise it when the buffers of a whole pipeline, or
+   * larger buffers, should be recycled. */
+  virtual void
+  SetMaximumCachedBytes(SizeValueType maximumCachedBytes);
+  virtual SizeValueType
+  GetMaximumCachedBytes() const;
+
+  /** Set/Get whether an allocation which finds no buffer of its size in the
+   * cache frees the cached buffers first. The cache then never adds to the
+   * peak memory of a sequence of allocations and releases. Off by default. */
+  virtual void
+  SetReleaseCacheOnMiss(bool releaseCacheOnMiss);
+  virtual bool
+  GetReleaseCacheOnMiss() const;
+  itkBooleanMacro(ReleaseCacheOnMiss);
+
+  /** Get the number of bytes currently kept in the cache. */
+  SizeValueType
+  GetCachedBytes() const;
+
+  /** Get the number of buffers handed out by Allocate and not deallocated. */
+  SizeValueType
+  GetNumberOfAllocatedBuffers() const;
+
+  /** Free all the buffers kept in the cache. */
+  void
+  ReleaseCachedBuffers();
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+protected:
+  ImageBufferAllocatorRecycling();
+  ~ImageBufferAllocatorRecycling() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  ImageBufferAllocatorBase::Pointer    m_Allocator;
+  SizeValueType                        m_MaximumCachedBytes;
+  bool                                 m_ReleaseCacheOnMiss{ false };
+  SizeValueType                        m_CachedBytes{ 0 };
+  SizeValueType                        m_NumberOfAllocatedBuffers{ 0 };
+  std::multimap<SizeValueType, void *> m_CachedBuffers;
+  mutable std::mutex                   m_Mutex;
+};
+} // end namespace itk
+
+#endif
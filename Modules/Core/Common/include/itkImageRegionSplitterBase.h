@@ -115,6 +115,18 @@ public:
       region.GetImageDimension(), i, numberOfPieces, &region.GetModifiableIndex()[0], &region.GetModifiableSize()[0]);
   }
 
+  /** The number of pieces to request per work unit when splitting a
+   * region for multi-threading. The multi-threaders execute the pieces
+   * from a queue, so that the work units finishing early take the
+   * remaining pieces. By default there is one piece per work unit, while
+   * splitters into pieces of bounded size, like ImageRegionSplitterTile,
+   * request as many pieces as the region holds. */
+  virtual unsigned int
+  GetNumberOfPiecesPerWorkUnit() const
+  {
+    return 1;
+  }
+
 protected:
   ImageRegionSplitterBase();
 
@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegionSplitterTile_h
+#define itkImageRegionSplitterTile_h
+
+#include "itkImageRegionSplitterBase.h"
+
+namespace itk
+{
+/** \class ImageRegionSplitterTile
+ * \brief Divide a region into tiles of bounded size.
+ *
+ * ImageRegionSplitterTile divides an ImageRegion into rectangular tiles
+ * of at most TileNumberOfPixels pixels. The budget is divided evenly
+ * among the dimensions, giving cubic tiles, except along the dimensions
+ * where the region is smaller than its share: the tile then spans them
+ * whole, and the budget they leave goes to the other dimensions. The
+ * default of 32768 pixels, tiles of 32 x 32 x 32 pixels in 3D, keeps the
+ * tiles of an input and an output of a few bytes per pixel, with the
+ * neighbors of the tile along every dimension, in a level 2 cache, where
+ * slabs spanning the whole region along the fast dimensions exceed it.
+ *
+ * The tiles are numbered with the fastest dimension varying first, so
+ * that consecutive tiles are neighbors. When fewer pieces than tiles are
+ * requested, the tiles are merged along the dimensions with the most
+ * tiles into as many pieces as requested.
+ *
+ * The multi-threaders request one piece per tile, and their work units
+ * take the tiles from a queue, which balances the work when some tiles
+ * take longer than others, as in masked filters. The splitter can be set
+ * for a filter with ImageSource::SetImageRegionSplitter(), or for all
+ * filters with ImageSourceCommon::SetGlobalDefaultSplitter().
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+
+class ITKCommon_EXPORT ImageRegionSplitterTile : public ImageRegionSplitterBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegionSplitterTile);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegionSplitterTile;
+  using Superclass = ImageRegionSplitterBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageRegionSplitterTile, ImageRegionSplitterBase);
+
+  /** The maximum number of pixels of a tile. */
+  itkSetClampMacro(TileNumberOfPixels, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(TileNumberOfPixels, SizeValueType);
+
+  unsigned int
+  GetNumberOfPiecesPerWorkUnit() const override;
+
+protected:
+  ImageRegionSplitterTile();
+
+  unsigned int
+  GetNumberOfSplitsInternal(unsigned int         dim,
+                            const IndexValueType regionIndex[],
+                            const SizeValueType  regionSize[],
+                            unsigned int         requestedNumber) const override;
+
+  unsigned int
+  GetSplitInternal(unsigned int   dim,
+                   unsigned int   i,
+                   unsigned int   numberOfPieces,
+                   IndexValueType regionIndex[],
+                   SizeValueType  regionSize[]) const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The number of pieces along each dimension, and in total. */
+  unsigned int
+  ComputeSplits(unsigned int dim, unsigned int requestedNumber, const SizeValueType regionSize[], unsigned int splits[])
+    const;
+
+  SizeValueType m_TileNumberOfPixels{ 32768 };
+};
+} // end namespace itk
+
+#endif
@@ -226,6 +226,35 @@ public:
   ProcessObject::DataObjectPointer
   MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
 
+  /** Set the splitter dividing the output requested region for
+   * multi-threading, instead of the global default splitter, e.g. an
+   * ImageRegionSplitterTile. It is used by the classic multi-threading,
+   * and given to the multi-threader of this filter, through
+   * GetImageRegionSplitter(), for the duration of the dynamic
+   * multi-threading of GenerateData(). A nullptr restores the global
+   * default splitter. */
+  virtual void
+  SetImageRegionSplitter(const ImageRegionSplitterBase * splitter);
+
+  /** Set/Get the number of pieces per work unit the output requested region
+   * is split into with dynamic multi-threading. The work units take the
+   * pieces from a queue, so a number well above 1 (e.g. 16) balances the
+   * load of filters whose work varies across the region, e.g. restricted to
+   * a mask or to some labels: such filters opt in by setting it in their
+   * constructor. The default, 1, splits the region evenly between the work
+   * units. It has no effect with classic multi-threading.
+   * \sa MultiThreaderBase::SetNumberOfPiecesPerWorkUnit */
+  itkSetClampMacro(NumberOfPiecesPerWorkUnit, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfPiecesPerWorkUnit, unsigned int);
+
+  /** Set the default splitter of all filters.
+   * \sa ImageSourceCommon::SetGlobalDefaultSplitter */
+  static void
+  SetGlobalDefaultSplitter(const ImageRegionSplitterBase * splitter)
+  {
+    ImageSourceCommon::SetGlobalDefaultSplitter(splitter);
+  }
+
 protected:
   ImageSource();
   ~ImageSource() override = default;
@@ -308,6 +337,16 @@ protected:
   virtual void
   AllocateOutputs();
 
+  /** During an update planned by the pipeline memory planner, let the
+   * given output allocate its buffer with the allocator of the plan, which
+   * recycles the buffers released during the update. Outputs which are
+   * not of the output image type, or whose pixel container has an
+   * allocator of its own, are left alone. The pixel container gets its
+   * previous allocator back when the plan ends.
+   * \sa ProcessObject::SetPipelineMemoryPlanning() */
+  void
+  UsePipelineMemoryPlanAllocator(DataObject * output);
+
   /** If an imaging filter needs to perform processing after the buffer
    * has been allocated but before threads are spawned, the filter can
    * can provide an implementation for BeforeThreadedGenerateData(). The
@@ -355,7 +394,8 @@ protected:
    * deriving from this class to write a filter consideration to the
    * algorithm used to divide the image should be made. If a change is
    * desired this method should be overridden to return the
-   * appropriate object.
+   * appropriate object. By default, it returns the splitter set with
+   * SetImageRegionSplitter(), or the global default splitter.
    */
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
@@ -400,6 +440,39 @@ protected:
   itkBooleanMacro(DynamicMultiThreading);
 
   bool m_DynamicMultiThreading;
+
+private:
+  /** Set the allocator of the pixel container of the image, for the images
+   * which have one, until the pipeline memory plan ends. */
+  template <typename TImage>
+  auto
+  SetPixelContainerAllocator(TImage * image, ImageBufferAllocatorBase * allocator, bool)
+    -> decltype(image->GetPixelContainer()->SetAllocator(allocator))
+  {
+    const auto container = image->GetPixelContainer();
+    if (container->GetAllocator() == nullptr)
+    {
+      container->SetAllocator(allocator);
+      // The container had no allocator, and gets none back when the plan
+      // ends, unless the image was released and replaced it meanwhile
+      const ImageBufferAllocatorBase::Pointer planAllocator = allocator;
+      const typename TImage::Pointer          planImage = image;
+      this->AddPipelineMemoryPlanCleanup([planImage, planAllocator]() {
+        if (planImage->GetPixelContainer()->GetAllocator() == planAllocator)
+        {
+          planImage->GetPixelContainer()->SetAllocator(nullptr);
+        }
+      });
+    }
+  }
+  template <typename TImage>
+  void
+  SetPixelContainerAllocator(TImage *, ImageBufferAllocatorBase *, long)
+  {}
+
+  ImageRegionSplitterBase::ConstPointer m_ImageRegionSplitter;
+
+  unsigned int m_NumberOfPiecesPerWorkUnit{ 1 };
 };
 } // end namespace itk
 
@@ -142,9 +142,25 @@ template <typename TOutputImage>
 const ImageRegionSplitterBase *
 ImageSource<TOutputImage>::GetImageRegionSplitter() const
 {
+  if (m_ImageRegionSplitter)
+  {
+    return m_ImageRegionSplitter;
+  }
   return this->GetGlobalDefaultSplitter();
 }
 
+//----------------------------------------------------------------------------
+template <typename TOutputImage>
+void
+ImageSource<TOutputImage>::SetImageRegionSplitter(const ImageRegionSplitterBase * splitter)
+{
+  if (m_ImageRegionSplitter != splitter)
+  {
+    m_ImageRegionSplitter = splitter;
+    this->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 template <typename TOutputImage>
 unsigned int
@@ -181,12 +197,26 @@ ImageSource<TOutputImage>::AllocateOutputs()
 
     if (outputPtr)
     {
+      this->UsePipelineMemoryPlanAllocator(outputPtr);
       outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
       outputPtr->Allocate();
     }
   }
 }
 
+//----------------------------------------------------------------------------
+template <typename TOutputImage>
+void
+ImageSource<TOutputImage>::UsePipelineMemoryPlanAllocator(DataObject * output)
+{
+  ImageBufferAllocatorBase * const allocator = this->GetPipelineMemoryPlanAllocator();
+  auto * const                     image = dynamic_cast<TOutputImage *>(output);
+  if (allocator != nullptr && image != nullptr)
+  {
+    this->SetPixelContainerAllocator(image, allocator, true);
+  }
+}
+
 //----------------------------------------------------------------------------
 template <typename TOutputImage>
 void
@@ -226,14 +256,40 @@ ImageSource<TOutputImage>::GenerateData()
   }
   else
   {
-    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-    this->GetMultiThreader()->SetUpdateProgress(this->GetThreaderUpdateProgress());
-    this->GetMultiThreader()->template ParallelizeImageRegion<OutputImageDimension>(
-      this->GetOutput()->GetRequestedRegion(),
-      [this](const OutputImageRegionType & outputRegionForThread) {
-        this->DynamicThreadedGenerateData(outputRegionForThread);
-      },
-      this);
+    PipelineProfiler::Execution * const profiledExecution = this->GetProfiledExecution();
+    MultiThreaderBase * const           multiThreader = this->GetMultiThreader();
+    multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    multiThreader->SetUpdateProgress(this->GetThreaderUpdateProgress());
+
+    // The multi-threader may be shared with other filters, so the splitting
+    // of this filter is only set for this call. The global default splitter
+    // is left to the multi-threader, as TBBMultiThreader then splits itself.
+    const auto setSplitting =
+      [multiThreader](const ImageRegionSplitterBase * splitter, unsigned int numberOfPiecesPerWorkUnit) {
+        multiThreader->SetImageRegionSplitter(splitter != ImageSourceCommon::GetGlobalDefaultSplitter() ? splitter
+                                                                                                          : nullptr);
+        multiThreader->SetNumberOfPiecesPerWorkUnit(numberOfPiecesPerWorkUnit);
+      };
+    const ImageRegionSplitterBase::ConstPointer previousSplitter = multiThreader->GetImageRegionSplitter();
+    const unsigned int                          previousNumberOfPiecesPerWorkUnit =
+      multiThreader->GetNumberOfPiecesPerWorkUnit();
+    setSplitting(this->GetImageRegionSplitter(), m_NumberOfPiecesPerWorkUnit);
+    try
+    {
+      multiThreader->template ParallelizeImageRegion<OutputImageDimension>(
+        this->GetOutput()->GetRequestedRegion(),
+        [this, profiledExecution](const OutputImageRegionType & outputRegionForThread) {
+          const PipelineProfiler::PieceProbe pieceProbe(profiledExecution);
+          this->DynamicThreadedGenerateData(outputRegionForThread);
+        },
+        this);
+    }
+    catch (...)
+    {
+      setSplitting(previousSplitter, previousNumberOfPiecesPerWorkUnit);
+      throw;
+    }
+    setSplitting(previousSplitter, previousNumberOfPiecesPerWorkUnit);
   }
 
   // Call a method that can be overridden by a subclass to perform
@@ -289,6 +345,7 @@ ImageSource<TOutputImage>::ThreaderCallback(void * arg)
 
   if (threadId < total)
   {
+    const PipelineProfiler::PieceProbe pieceProbe(str->Filter->GetProfiledExecution());
     str->Filter->ThreadedGenerateData(splitRegion, threadId);
 #if defined(ITKV4_COMPATIBILITY)
     if (str->Filter->GetAbortGenerateData())
@@ -316,6 +373,8 @@ ImageSource<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "DynamicMultiThreading: " << (m_DynamicMultiThreading ? "On" : "Off") << std::endl;
+  itkPrintSelfObjectMacro(ImageRegionSplitter);
+  os << indent << "NumberOfPiecesPerWorkUnit: " << m_NumberOfPiecesPerWorkUnit << std::endl;
 }
 
 } // end namespace itk
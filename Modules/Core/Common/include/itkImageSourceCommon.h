@@ -43,6 +43,14 @@ struct ITKCommon_EXPORT ImageSourceCommon
    */
   static const ImageRegionSplitterBase *
   GetGlobalDefaultSplitter();
+
+  /**
+   * Set the splitter used by the filters and the multi-threaders which are
+   * not given a splitter, ImageRegionSplitterSlowDimension by default. A
+   * nullptr restores the default. It should be set before running filters.
+   */
+  static void
+  SetGlobalDefaultSplitter(const ImageRegionSplitterBase * splitter);
 };
 
 } // end namespace itk
@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocatorBase.h"
 #include <utility>
 
 namespace itk
@@ -151,6 +152,14 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get the allocator of the memory buffer, used from the next
+   * allocation on. When it is null, the default, the global default of
+   * ImportImageContainerCommon::GetGlobalDefaultAllocator() is used, and
+   * when that is null too, the buffer is allocated with array new.
+   * \sa ImageBufferAllocatorBase */
+  itkSetObjectMacro(Allocator, ImageBufferAllocatorBase);
+  itkGetModifiableObjectMacro(Allocator, ImageBufferAllocatorBase);
+
 protected:
   ImportImageContainer();
   ~ImportImageContainer() override;
@@ -164,7 +173,11 @@ protected:
   /**
    * Allocates elements of the array.  If UseDefaultConstructor is true, then
    * the default constructor is used to initialize each element.  POD date types
-   * initialize to zero.
+   * initialize to zero. The default implementation allocates with array new.
+   * It is called when no allocator is set, neither on this container nor as
+   * the global default: a set allocator allocates the elements instead. An
+   * override which does not use array new must free the elements in
+   * DeallocateManagedMemory.
    */
   virtual TElement *
   AllocateElements(ElementIdentifier size, bool UseDefaultConstructor = false) const;
@@ -203,6 +216,23 @@ private:
   TElementIdentifier m_Size;
   TElementIdentifier m_Capacity;
   bool               m_ContainerManageMemory;
+
+  ImageBufferAllocatorBase::Pointer m_Allocator;
+
+  /** The allocator which owns m_ImportPointer, null for array new. */
+  ImageBufferAllocatorBase::Pointer m_ImportPointerAllocator;
+
+  /** The allocator of this container, or else the global default one. */
+  ImageBufferAllocatorBase::Pointer
+  GetAllocatorOfNextAllocation() const;
+
+  /** Allocates the elements with the allocator of the next allocation, or
+   * with AllocateElements when there is none, and returns in allocator the
+   * allocator which owns them, null for AllocateElements. */
+  TElement *
+  AllocateManagedMemory(ElementIdentifier                   size,
+                        bool                                UseDefaultConstructor,
+                        ImageBufferAllocatorBase::Pointer & allocator) const;
 };
 } // end namespace itk
 
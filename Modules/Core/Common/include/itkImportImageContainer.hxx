@@ -29,7 +29,10 @@
 #define itkImportImageContainer_hxx
 
 #include "itkImportImageContainer.h"
+#include "itkImportImageContainerCommon.h"
 #include <algorithm> // For copy_n.
+#include <memory>    // For uninitialized_fill_n.
+#include <type_traits>
 
 namespace itk
 {
@@ -63,13 +66,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseDefaultConstructor);
+      ImageBufferAllocatorBase::Pointer allocator;
+      TElement *                        temp = this->AllocateManagedMemory(size, UseDefaultConstructor, allocator);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocator = allocator;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -83,7 +88,9 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
-    m_ImportPointer = this->AllocateElements(size, UseDefaultConstructor);
+    ImageBufferAllocatorBase::Pointer allocator;
+    m_ImportPointer = this->AllocateManagedMemory(size, UseDefaultConstructor, allocator);
+    m_ImportPointerAllocator = allocator;
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -103,13 +110,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
   {
     if (m_Size < m_Capacity)
     {
-      const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      const TElementIdentifier          size = m_Size;
+      ImageBufferAllocatorBase::Pointer allocator;
+      TElement *                        temp = this->AllocateManagedMemory(size, false, allocator);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocator = allocator;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -194,6 +203,48 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
   return data;
 }
 
+template <typename TElementIdentifier, typename TElement>
+ImageBufferAllocatorBase::Pointer
+ImportImageContainer<TElementIdentifier, TElement>::GetAllocatorOfNextAllocation() const
+{
+  if (m_Allocator.IsNotNull())
+  {
+    return m_Allocator;
+  }
+  return ImportImageContainerCommon::GetGlobalDefaultAllocator();
+}
+
+template <typename TElementIdentifier, typename TElement>
+TElement *
+ImportImageContainer<TElementIdentifier, TElement>::AllocateManagedMemory(
+  ElementIdentifier                   size,
+  bool                                UseDefaultConstructor,
+  ImageBufferAllocatorBase::Pointer & allocator) const
+{
+  ImportImageContainerCommon::CountAllocatedBytes(static_cast<SizeValueType>(size) * sizeof(TElement));
+
+  allocator = this->GetAllocatorOfNextAllocation();
+  if (allocator.IsNull())
+  {
+    return this->AllocateElements(size, UseDefaultConstructor);
+  }
+
+  // The allocator throws a MemoryAllocationError itself
+  auto * data = static_cast<TElement *>(allocator->Allocate(static_cast<SizeValueType>(size) * sizeof(TElement)));
+  if (UseDefaultConstructor)
+  {
+    std::uninitialized_fill_n(data, size, TElement());
+  }
+  else if (!std::is_trivially_default_constructible<TElement>::value)
+  {
+    for (ElementIdentifier i = 0; i < size; ++i)
+    {
+      new (data + i) TElement;
+    }
+  }
+  return data;
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
@@ -201,8 +252,27 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_ImportPointerAllocator.IsNotNull())
+    {
+      if (m_ImportPointer)
+      {
+        if (!std::is_trivially_destructible<TElement>::value)
+        {
+          for (ElementIdentifier i = 0; i < m_Capacity; ++i)
+          {
+            m_ImportPointer[i].~TElement();
+          }
+        }
+        m_ImportPointerAllocator->Deallocate(m_ImportPointer,
+                                             static_cast<SizeValueType>(m_Capacity) * sizeof(TElement));
+      }
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
+  m_ImportPointerAllocator = nullptr;
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
@@ -218,6 +288,7 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  itkPrintSelfObjectMacro(Allocator);
 }
 } // end namespace itk
 
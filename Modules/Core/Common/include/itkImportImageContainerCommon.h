@@ -0,0 +1,94 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImportImageContainerCommon_h
+#define itkImportImageContainerCommon_h
+
+#include "ITKCommonExport.h"
+#include "itkIntTypes.h"
+#include "itkImageBufferAllocatorBase.h"
+
+namespace itk
+{
+
+/** \class ImportImageContainerCommon
+ * \brief Code of ImportImageContainer common between templates
+ *
+ * This class provides common non-templated code which can be compiled
+ * and used by all templated versions of ImportImageContainer.
+ *
+ * \ingroup ITKCommon
+ */
+struct ITKCommon_EXPORT ImportImageContainerCommon
+{
+  /** Set/Get whether new image buffers are first touched by the threads of
+   * a multi-threader, right after Image::Allocate allocated them.
+   *
+   * On NUMA machines the operating system places a memory page on the node
+   * of the thread which touches it first. When this is enabled, the buffered
+   * region is zeroed by MultiThreaderBase::ParallelizeImageRegion, with the
+   * default splitter and number of work units, so the pieces are those that
+   * a filter with the default multi-threader later processes. The
+   * PoolMultiThreader processes a piece on the same thread in both calls,
+   * so the pages end up close to the threads which process them. Combine
+   * this with MultiThreaderBase::SetGlobalDefaultThreadAffinity.
+   *
+   * Only new buffers of pixel types which do not need a constructor are
+   * first touched; a grown buffer keeps the pixels copied into it.
+   * The default is picked up from the ITK_GLOBAL_DEFAULT_NUMA_FIRST_TOUCH
+   * environment variable, and is off otherwise. */
+  static void
+  SetGlobalDefaultNUMAFirstTouch(bool firstTouch);
+  static bool
+  GetGlobalDefaultNUMAFirstTouch();
+
+  /** Set/Get the allocator used by containers which do not have their own.
+   * A null allocator, the default, means array new.
+   *
+   * The default is picked up from the ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATOR
+   * environment variable, which may be Aligned, HugePage or Recycling.
+   * The allocator returned stays alive while the caller holds it, even if
+   * the global default is replaced meanwhile. */
+  static void
+  SetGlobalDefaultAllocator(ImageBufferAllocatorBase * allocator);
+  static ImageBufferAllocatorBase::Pointer
+  GetGlobalDefaultAllocator();
+
+  /** Count the bytes of an image buffer allocated by the current thread. */
+  static void
+  CountAllocatedBytes(SizeValueType numberOfBytes);
+
+  /** Get the number of bytes of the image buffers allocated by the current
+   * thread since it started.
+   * \sa PipelineProfiler */
+  static SizeValueType
+  GetNumberOfBytesAllocatedByThread();
+
+  /** Zero the buffer of an image region in parallel, piece by piece, as
+   * described in SetGlobalDefaultNUMAFirstTouch. The buffer holds the pixels
+   * of the region, the first dimension running fastest. */
+  static void
+  FirstTouch(void *               buffer,
+             unsigned int         dimension,
+             const IndexValueType index[],
+             const SizeValueType  size[],
+             SizeValueType        numberOfBytesPerPixel);
+};
+
+} // end namespace itk
+
+#endif
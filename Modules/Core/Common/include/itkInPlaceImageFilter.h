@@ -109,7 +109,12 @@ public:
    * in-place operation, i.e. calling SetInplace(true) or InplaceOn(),
    * will be effective only if CanRunInPlace also returns true.
    * By default CanRunInPlace checks whether the input and output
-   * image type match. */
+   * image type match.
+   *
+   * During an update planned by the pipeline memory planner, the filter
+   * does not run in place while other filters of the pipeline consume
+   * its input after it, even if InPlace is on.
+   * \sa ProcessObject::SetPipelineMemoryPlanning() */
   itkSetMacro(InPlace, bool);
   itkGetConstMacro(InPlace, bool);
   itkBooleanMacro(InPlace);
@@ -84,7 +84,11 @@ InPlaceImageFilter<TInputImage, TOutputImage>::InternalAllocateOutputs(const Tru
   {
     rMatch = false;
   }
-  if (inputPtr != nullptr && this->GetInPlace() && this->CanRunInPlace() && rMatch)
+  // The pipeline memory planner prevents running in place while other
+  // filters still consume the input
+  const bool inPlace =
+    this->GetInPlace() && (!this->IsPlannedInput(inputPtr) || this->IsPlannedInputReleasedAfterExecution(inputPtr));
+  if (inputPtr != nullptr && inPlace && this->CanRunInPlace() && rMatch)
   {
     // Graft this first input to the output.  Later, we'll need to
     // remove the input's hold on the bulk data.
@@ -113,6 +117,7 @@ InPlaceImageFilter<TInputImage, TOutputImage>::InternalAllocateOutputs(const Tru
 
       if (nthOutputPtr)
       {
+        this->UsePipelineMemoryPlanAllocator(nthOutputPtr);
         nthOutputPtr->SetBufferedRegion(nthOutputPtr->GetRequestedRegion());
         nthOutputPtr->Allocate();
       }
@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include <string>
+
+namespace itk
+{
+
+/** \class MemoryMappedFile
+ * \brief Map a byte range of a file into memory.
+ *
+ * The range is mapped copy-on-write: its pages are shared with the page
+ * cache of the operating system, and so with every other process mapping
+ * or reading the same file, until they are modified. Modifications are
+ * private to the mapping and never written back to the file.
+ *
+ * The range is unmapped by Unmap(), by mapping another range, or when
+ * the object is destroyed.
+ *
+ * \sa MemoryMappedImageContainer
+ * \ingroup ITKSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT MemoryMappedFile : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedFile;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MemoryMappedFile, Object);
+
+  /** Map numberOfBytes bytes of the file, starting at byte offset. The
+   * range must lie within the file. Throws an ExceptionObject when the
+   * file cannot be mapped. */
+  void
+  Map(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes);
+
+  /** Unmap the mapped range, if any. */
+  void
+  Unmap();
+
+  /** Get the address of the first mapped byte, or nullptr when nothing
+   * is mapped. */
+  void *
+  GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Get the number of mapped bytes. */
+  itkGetConstMacro(NumberOfBytes, SizeValueType);
+
+  /** Get the name of the mapped file. */
+  itkGetStringMacro(FileName);
+
+protected:
+  MemoryMappedFile();
+  ~MemoryMappedFile() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The mapping itself starts at a page boundary, m_Data is inside it. */
+  void *        m_MappedAddress{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+  void *        m_Data{ nullptr };
+  SizeValueType m_NumberOfBytes{ 0 };
+  std::string   m_FileName;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,97 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_h
+#define itkMemoryMappedImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+
+namespace itk
+{
+/** \class MemoryMappedImageContainer
+ *  \brief An ImportImageContainer whose elements are mapped from a file.
+ *
+ * MapFile() maps the elements stored contiguously in a file, in the memory
+ * layout of TElement, directly into the container, without reading or
+ * copying them. The elements are mapped copy-on-write by a MemoryMappedFile:
+ * processes mapping the same file share its pages until they modify them,
+ * and modifications are never written back to the file.
+ *
+ * Since this class is an ImportImageContainer, it can be used as the pixel
+ * container of an Image. When the container is grown by Reserve(), the
+ * elements are copied into a newly allocated buffer as usual.
+ *
+ * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
+ * mapped buffer.
+ *
+ * \tparam TElement The element type stored in the container.
+ *
+ * \sa ImageFileReader::SetUseMemoryMapping
+ * \ingroup ImageObjects
+ * \ingroup IOFilters
+ * \ingroup ITKCommon
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Save the template parameters. */
+  using ElementIdentifier = TElementIdentifier;
+  using Element = TElement;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Standard part of every itk Object. */
+  itkTypeMacro(MemoryMappedImageContainer, ImportImageContainer);
+
+  /** Map numberOfElements elements stored in the file fileName, starting at
+   * byte offset, into the container. The offset must be a multiple of the
+   * alignment of TElement. Throws an ExceptionObject when the elements
+   * cannot be mapped. */
+  void
+  MapFile(const std::string & fileName, SizeValueType offset, ElementIdentifier numberOfElements);
+
+  /** Get the mapping holding the elements, or nullptr when no file is mapped. */
+  itkGetModifiableObjectMacro(MappedFile, MemoryMappedFile);
+
+protected:
+  MemoryMappedImageContainer() = default;
+  ~MemoryMappedImageContainer() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  MemoryMappedFile::Pointer m_MappedFile;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkMemoryMappedImageContainer.hxx"
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_hxx
+#define itkMemoryMappedImageContainer_hxx
+
+#include "itkMemoryMappedImageContainer.h"
+
+namespace itk
+{
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::MapFile(const std::string & fileName,
+                                                                  SizeValueType       offset,
+                                                                  ElementIdentifier   numberOfElements)
+{
+  if (offset % alignof(TElement) != 0)
+  {
+    itkExceptionMacro(<< "Offset " << offset << " in " << fileName << " is not aligned to " << alignof(TElement)
+                      << " bytes");
+  }
+
+  const auto mappedFile = MemoryMappedFile::New();
+  mappedFile->Map(fileName, offset, static_cast<SizeValueType>(numberOfElements) * sizeof(TElement));
+
+  // The container does not own the mapped elements, the mapping does
+  this->SetImportPointer(static_cast<TElement *>(mappedFile->GetData()), numberOfElements, false);
+  m_MappedFile = mappedFile;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  itkPrintSelfObjectMacro(MappedFile);
+}
+
+} // end namespace itk
+
+#endif
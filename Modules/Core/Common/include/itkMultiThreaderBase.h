@@ -34,7 +34,9 @@
 #include "itkIntTypes.h"
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
+#include "itkImageRegionSplitterBase.h"
 #include "itkSingletonMacro.h"
+#include <atomic>
 #include <functional>
 #include <thread>
 #include "itkProgressReporter.h"
@@ -138,6 +140,29 @@ public:
   SetUpdateProgress(bool updates);
   itkGetConstMacro(UpdateProgress, bool);
 
+  /** Set the splitter dividing the regions of ParallelizeImageRegion() into
+   * pieces. A nullptr, the default, selects the global default splitter of
+   * ImageSourceCommon, except for TBBMultiThreader, which then splits the
+   * regions with TBB. */
+  itkSetConstObjectMacro(ImageRegionSplitter, ImageRegionSplitterBase);
+
+  /** Get the splitter dividing the regions of ParallelizeImageRegion(): the
+   * one set, or the global default splitter. */
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const;
+
+  /** Set/Get the number of pieces per work unit ParallelizeImageRegion()
+   * splits a region into, at least. As the work units take the pieces from
+   * a queue, the work units done early process the pieces left by the others:
+   * a number well above 1 (e.g. 16) balances work varying across the region,
+   * e.g. restricted to a mask, at the cost of more calls of the functor.
+   * The default, 1, splits the region evenly between the work units. A
+   * splitter may ask for more pieces. TBBMultiThreader balances the load
+   * itself when no splitter is set.
+   * \sa ImageRegionSplitterBase::GetNumberOfPiecesPerWorkUnit() */
+  itkSetClampMacro(NumberOfPiecesPerWorkUnit, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfPiecesPerWorkUnit, unsigned int);
+
   /** Set/Get the maximum number of threads to use when multithreading.  It
    * will be clamped to the range [ 1, ITK_MAX_THREADS ] because several arrays
    * are already statically allocated using the ITK_MAX_THREADS number.
@@ -209,6 +234,29 @@ public:
   static ThreaderEnum
   GetGlobalDefaultThreader();
 
+  /** Set/Get whether the worker threads of the Pool and TBB multi-threaders
+   * are pinned to logical processors, one worker per processor.
+   *
+   * Pinning keeps a worker on the NUMA node where the pages it first touched
+   * were placed, see ImportImageContainerCommon::SetGlobalDefaultNUMAFirstTouch.
+   * The setting is read once, when the ThreadPool and the first
+   * TBBMultiThreader are created, so it must be set before the first filter
+   * executes; changing it later has no effect. The default is picked up from
+   * the ITK_GLOBAL_DEFAULT_THREAD_AFFINITY environment variable, and is off
+   * otherwise. */
+  static void
+  SetGlobalDefaultThreadAffinity(bool threadAffinity);
+  static bool
+  GetGlobalDefaultThreadAffinity();
+
+  /** Pin the calling thread to the given one of the logical processors which
+   * the process may run on, modulo their number. On Linux, the allowed
+   * processors are those of the cpuset of the first calling thread, grouped
+   * by NUMA node, so that consecutive indices share a node. Returns false if
+   * the platform does not support it. */
+  static bool
+  SetCurrentThreadAffinity(ThreadIdType processor);
+
   /** Set/Get the value which is used to initialize the NumberOfThreads in the
    * constructor.  It will be clamped to the range [1, m_GlobalMaximumNumberOfThreads ].
    * Therefore the caller of this method should check that the requested number
@@ -418,12 +466,36 @@ ITK_GCC_PRAGMA_DIAG_POP()
                          ThreadingFunctorType funcP,
                          ProcessObject *      filter);
 
+  /** Whether the calling thread is currently executing a work unit.
+   *
+   * Parallel calls made from within a work unit, e.g. by an interpolator,
+   * a metric or a sub-filter called from DynamicThreadedGenerateData, are
+   * nested. PoolMultiThreader runs nested work as jobs of the same thread
+   * pool, and a thread waiting for its jobs helps executing queued jobs
+   * instead of blocking. PlatformMultiThreader executes nested work on the
+   * calling thread, because spawning more threads would oversubscribe the
+   * machine. TBBMultiThreader relies on TBB, which supports nesting natively.
+   * All of them mark the work units they execute, so the answer does not
+   * depend on the threader. */
+  static bool
+  IsInsideWorkUnit();
+
 protected:
   MultiThreaderBase();
   ~MultiThreaderBase() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Marks the calling thread as executing a work unit during its lifetime.
+   * Multi-threaders create one of these around each work unit they execute. */
+  class ITKCommon_EXPORT WorkUnitScope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(WorkUnitScope);
+    WorkUnitScope();
+    ~WorkUnitScope();
+  };
+
   struct ArrayCallback
   {
     ArrayThreadingFunctorType functor;
@@ -437,20 +509,34 @@ protected:
 
   struct RegionAndCallback
   {
-    ThreadingFunctorType   functor;
-    unsigned int           dimension;
-    const IndexValueType * index;
-    const SizeValueType *  size;
-    SizeValueType          pixelCount;
-    ProcessObject *        filter;
+    ThreadingFunctorType            functor;
+    unsigned int                    dimension;
+    const IndexValueType *          index;
+    const SizeValueType *           size;
+    SizeValueType                   pixelCount;
+    ProcessObject *                 filter;
+    const ImageRegionSplitterBase * splitter;
+    ThreadIdType                    numberOfPieces;
+    std::atomic<ThreadIdType>       nextPiece;
   };
 
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   ParallelizeImageRegionHelper(void * arg);
 
+  /** The number of pieces ParallelizeImageRegion() splits a region into,
+   * which the work units execute from a queue. */
+  ThreadIdType
+  ComputeNumberOfPieces(const ImageRegionSplitterBase * splitter, const ImageIORegion & region) const;
+
+  /** The splitter set, nullptr for the global default splitter. */
+  ImageRegionSplitterBase::ConstPointer m_ImageRegionSplitter;
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits;
 
+  /** The minimum number of pieces per work unit of ParallelizeImageRegion(). */
+  unsigned int m_NumberOfPiecesPerWorkUnit{ 1 };
+
   /** The number of threads to use.
    *  The m_MaximumNumberOfThreads must always be less than or equal to
    *  the m_GlobalMaximumNumberOfThreads before it is used during the execution
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineProfiler_h
+#define itkPipelineProfiler_h
+
+#include "ITKCommonExport.h"
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+class ProcessObject;
+
+/** \class PipelineProfiler
+ * \brief Records the executions of the filters of the pipelines
+ *
+ * When profiling is enabled, every execution of the GenerateData() method
+ * of a filter by ProcessObject::UpdateOutputData() is recorded:
+ * - its wall time and the CPU time of the process meanwhile;
+ * - the bytes allocated for image buffers by the updating thread, and the
+ *   increase of the peak resident set size of the process;
+ * - the pieces of the output region the work units were given, and the
+ *   time each thread spent in them, which shows the load imbalance.
+ *
+ * The time of the inputs is not included, as they are updated before, but
+ * the time of the mini-pipelines of a filter is. The pieces are only known
+ * for the filters deriving from ImageSource.
+ *
+ * The records are exported as Chrome trace events, to be viewed with
+ * chrome://tracing or Perfetto, or as a summary per filter class.
+ *
+ * Profiling is disabled by default. The default is picked up from the
+ * ITK_GLOBAL_DEFAULT_PIPELINE_PROFILING environment variable. When the
+ * ITK_GLOBAL_DEFAULT_PIPELINE_PROFILING_TRACE_FILE environment variable
+ * names a file, profiling is enabled and the Chrome trace is written to the
+ * file at exit. When disabled, a filter execution only checks a flag.
+ *
+ * At most GetMaximumNumberOfRecords() records are kept, 100000 by default,
+ * so that profiling a long running application does not grow its memory
+ * without bound: the oldest records are dropped to make room for the new
+ * ones, and counted by GetNumberOfDroppedRecords().
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineProfiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /** The pieces executed by a thread during a filter execution. The times
+   * are in seconds, since the start of the profiling. */
+  struct WorkUnitRecord
+  {
+    unsigned int  Thread;
+    SizeValueType NumberOfPieces;
+    double        Start;
+    double        End;
+    double        BusyTime;
+  };
+
+  /** An execution of a filter. The times are in seconds, the start being
+   * counted since the start of the profiling. */
+  struct Record
+  {
+    std::string                 ClassName;
+    std::string                 ObjectName;
+    unsigned int                Thread;
+    double                      Start;
+    double                      WallTime;
+    double                      CPUTime;
+    SizeValueType               AllocatedBytes;
+    SizeValueType               PeakResidentSetSizeIncrease;
+    ThreadIdType                NumberOfWorkUnits;
+    SizeValueType               NumberOfPieces;
+    std::vector<WorkUnitRecord> WorkUnits;
+
+    /** The busiest thread time divided by the mean thread time, 1 when the
+     * load is balanced, 0 without pieces. */
+    double
+    GetImbalance() const;
+  };
+
+  /** Records the execution of a filter, from its construction to Finish().
+   * ProcessObject creates it around GenerateData(). */
+  class ITKCommon_EXPORT Execution
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(Execution);
+
+    explicit Execution(const ProcessObject * filter);
+
+    /** Record the execution of a piece by the current thread. Thread safe. */
+    void
+    AddPiece(Clock::time_point start, Clock::time_point end);
+
+    /** Add the record of the execution to the profiler. */
+    void
+    Finish();
+
+  private:
+    Record            m_Record;
+    Clock::time_point m_Start;
+    double            m_StartCPUTime;
+    SizeValueType     m_StartAllocatedBytes;
+    SizeValueType     m_StartPeakResidentSetSize;
+    std::mutex        m_Mutex;
+  };
+
+  /** Records the execution of a piece from its construction to its
+   * destruction, when given an execution. */
+  class PieceProbe
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(PieceProbe);
+
+    explicit PieceProbe(Execution * execution)
+      : m_Execution(execution)
+    {
+      if (execution)
+      {
+        m_Start = Clock::now();
+      }
+    }
+
+    ~PieceProbe()
+    {
+      if (m_Execution)
+      {
+        m_Execution->AddPiece(m_Start, Clock::now());
+      }
+    }
+
+  private:
+    Execution *       m_Execution;
+    Clock::time_point m_Start;
+  };
+
+  PipelineProfiler() = delete;
+
+  /** Set/Get whether the filter executions are recorded. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** Get a copy of the records, in the order the executions finished. */
+  static std::vector<Record>
+  GetRecords();
+
+  /** Remove the records, and reset the number of dropped records. */
+  static void
+  Clear();
+
+  /** Set/Get the maximum number of records kept. When there are more, the
+   * oldest ones are dropped. */
+  static void
+  SetMaximumNumberOfRecords(SizeValueType maximumNumberOfRecords);
+  static SizeValueType
+  GetMaximumNumberOfRecords();
+
+  /** Get the number of records dropped since the last Clear(), to keep at
+   * most GetMaximumNumberOfRecords() of them. */
+  static SizeValueType
+  GetNumberOfDroppedRecords();
+
+  /** Write the records as Chrome trace events, in JSON. */
+  static void
+  WriteChromeTrace(std::ostream & os);
+
+  /** Write the totals per filter class, the most time consuming first. */
+  static void
+  WriteSummary(std::ostream & os);
+};
+} // end namespace itk
+
+#endif
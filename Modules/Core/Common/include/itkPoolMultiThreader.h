@@ -82,7 +82,15 @@ public:
                    ArrayThreadingFunctorType aFunc,
                    ProcessObject *           filter) override;
 
-  /** Break up region into smaller chunks, and call the function with chunks as parameters. */
+  /** Break up region into smaller chunks, and call the function with chunks as parameters.
+   *
+   * Each participating thread first processes its own block of consecutive
+   * pieces: the calling thread the first block, and the pool worker w the
+   * block w + 1, out of one block per pool thread plus one. The threads which
+   * run out of pieces then take the remaining pieces of the others. Repeated
+   * calls over the same region therefore mostly process a piece on the same
+   * thread, which keeps its pages on the NUMA node of that thread.
+   * \sa ImportImageContainerCommon::SetGlobalDefaultNUMAFirstTouch */
   void
   ParallelizeImageRegion(unsigned int         dimension,
                          const IndexValueType index[],
@@ -32,16 +32,20 @@
 #include "itkObjectFactory.h"
 #include "itkNumericTraits.h"
 #include "itkThreadSupport.h"
+#include "itkPipelineProfiler.h"
 #include <vector>
 #include <map>
 #include <set>
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <thread>
 
 namespace itk
 {
 
 class MultiThreaderBase;
+class ImageBufferAllocatorBase;
 
 /** \class ProcessObject
  * \brief The base class for all process objects (source,
@@ -489,6 +493,36 @@ public:
   itkGetConstReferenceMacro(ReleaseDataBeforeUpdateFlag, bool);
   itkBooleanMacro(ReleaseDataBeforeUpdateFlag);
 
+  /** Turn on/off the pipeline memory planner for the updates which start
+   * at this ProcessObject. Before executing, the planner counts the
+   * filters of the pipeline upstream of this one which consume each
+   * intermediate output. An intermediate output is released as soon as
+   * the last of them has executed, and an InPlaceImageFilter with InPlace
+   * on only runs in place when it is the last consumer of its input. The
+   * outputs allocated by ImageSource::AllocateOutputs() use an allocator
+   * owned by the update, which hands the image buffers released during
+   * the update to the next allocations of the same size. The peak memory
+   * of a chain of filters is then about two or three images, instead of
+   * one per filter.
+   *
+   * As with the ReleaseDataFlag, a released output is regenerated when it
+   * is updated again. Data objects without a source, such as the images
+   * given by the application, are never released. Default value is off.
+   *
+   * \sa SetGlobalPipelineMemoryPlanning() */
+  itkSetMacro(PipelineMemoryPlanning, bool);
+  itkGetConstMacro(PipelineMemoryPlanning, bool);
+  itkBooleanMacro(PipelineMemoryPlanning);
+
+  /** Turn on/off the pipeline memory planner for the updates of all the
+   * ProcessObjects. The default is picked up from the
+   * ITK_GLOBAL_DEFAULT_PIPELINE_MEMORY_PLANNING environment variable, and
+   * is off otherwise. */
+  static void
+  SetGlobalPipelineMemoryPlanning(bool planning);
+  static bool
+  GetGlobalPipelineMemoryPlanning();
+
   /** Get/Set the number of work units to create when executing. */
   itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
   itkGetConstReferenceMacro(NumberOfWorkUnits, ThreadIdType);
@@ -850,6 +884,16 @@ protected:
   GenerateData()
   {}
 
+  /** The record of the current execution of GenerateData(), to which the
+   * pieces executed by the work units are added, nullptr when profiling is
+   * disabled.
+   * \sa PipelineProfiler */
+  PipelineProfiler::Execution *
+  GetProfiledExecution() const
+  {
+    return m_ProfiledExecution;
+  }
+
   /** Called to allocate the input array.  Copies old inputs. */
   /** Propagate a call to ResetPipeline() up the pipeline. Called only from
    * DataObject. */
@@ -887,6 +931,31 @@ protected:
   virtual void
   RestoreInputReleaseDataFlags();
 
+  /** Whether the given input is an intermediate output of the pipeline,
+   * released by the pipeline memory planner of the current update. */
+  bool
+  IsPlannedInput(const DataObject * input) const;
+
+  /** Whether the pipeline memory planner releases the given input once this
+   * filter has executed, no other filter of the update having to consume
+   * it: the filter may then overwrite it. */
+  bool
+  IsPlannedInputReleasedAfterExecution(const DataObject * input) const;
+
+  /** The allocator of the image buffers of the outputs during an update
+   * planned by the pipeline memory planner, or nullptr otherwise. It
+   * hands the buffers released during the update to the next allocations
+   * of the same size. */
+  ImageBufferAllocatorBase *
+  GetPipelineMemoryPlanAllocator() const;
+
+  /** During an update planned by the pipeline memory planner, register a
+   * function which undoes a change made for the plan, such as setting its
+   * allocator on an output. The functions are called when the plan ends,
+   * and are ignored outside of a planned update. */
+  void
+  AddPipelineMemoryPlanCleanup(std::function<void()> cleanup);
+
   /**
    * When true, the MultiThreader will report course grain progress. If set to false, a progress must be explicitly
    * updated in derived filters.
@@ -940,6 +1009,22 @@ private:
   DataObjectPointerArraySizeType
   MakeIndexFromName(const DataObjectIdentifierType &) const;
 
+  /** The consumers of the intermediate outputs of a planned update. */
+  struct PipelineMemoryPlan;
+  using PipelineMemoryPlanPointer = std::shared_ptr<PipelineMemoryPlan>;
+
+  /** Build the memory plan of the pipeline upstream of this filter. */
+  PipelineMemoryPlanPointer
+  PlanPipelineMemory();
+
+  /** Remove the plan from the filters of the pipeline. */
+  static void
+  EndPipelineMemoryPlan(PipelineMemoryPlan & plan);
+
+  /** Release the inputs for which this filter was the last consumer. */
+  void
+  ReleasePlannedInputs();
+
   /** STL map to store the named inputs and outputs */
   using DataObjectPointerMap = std::map<DataObjectIdentifierType, DataObjectPointer>;
 
@@ -980,6 +1065,11 @@ private:
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag;
 
+  bool                      m_PipelineMemoryPlanning{ false };
+  PipelineMemoryPlanPointer m_PipelineMemoryPlan;
+
+  PipelineProfiler::Execution * m_ProfiledExecution{ nullptr };
+
   /** Friends of ProcessObject */
   friend class DataObject;
 
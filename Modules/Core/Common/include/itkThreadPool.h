@@ -21,10 +21,12 @@
 #include "itkConfigure.h"
 #include "itkIntTypes.h"
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <future>
 #include <condition_variable>
+#include <memory>
 #include <thread>
 
 #include "itkObject.h"
@@ -43,6 +45,13 @@ namespace itk
  * Initially the thread pool is started with GlobalDefaultNumberOfThreads.
  * The jobs are submitted via AddWork method.
  *
+ * Each worker thread owns a separate work queue. Jobs submitted from outside
+ * the pool are distributed round-robin over the worker queues, while jobs
+ * submitted from within a worker go to that worker's own queue. A worker
+ * takes jobs from the back of its own queue, and when it runs out of work it
+ * steals jobs from the front of the other workers' queues. This way the
+ * workers do not contend for a single lock when many small jobs are queued.
+ *
  * This implementation heavily borrows from:
  * https://github.com/progschj/ThreadPool
  *
@@ -93,14 +102,39 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
       std::bind(std::forward<Function>(function), std::forward<Arguments>(arguments)...));
 
     std::future<return_type> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock(this->GetMutex());
-      m_WorkQueue.emplace_back([task]() { (*task)(); });
-    }
-    m_Condition.notify_one();
+    this->SubmitWork([task]() { (*task)(); }, nullptr);
+    return res;
+  }
+
+  /** Add this job to the thread pool queue, tagged with a scope.
+   *
+   * The scope identifies a group of jobs, e.g. the work units of one parallel
+   * call, so that the thread waiting for them can execute the ones which are
+   * still queued, see ExecutePendingJob. The scope must not be nullptr. */
+  template <class Function, class... Arguments>
+  auto
+  AddScopedWork(const void * scope, Function && function, Arguments &&... arguments)
+    -> std::future<typename std::result_of<Function(Arguments...)>::type>
+  {
+    using return_type = typename std::result_of<Function(Arguments...)>::type;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+      std::bind(std::forward<Function>(function), std::forward<Arguments>(arguments)...));
+
+    std::future<return_type> res = task->get_future();
+    this->SubmitWork([task]() { (*task)(); }, scope);
     return res;
   }
 
+  /** Execute one queued job of the given scope on the calling thread, if there
+   * is any. Returns false if no such job was waiting. A thread which waits for
+   * the jobs of its scope calls this to help, instead of blocking a pool thread.
+   * Jobs of other scopes are never executed here, so that a waiting thread does
+   * not run unrelated work on its stack. The caller must still not hold a lock
+   * which the jobs of its own scope acquire, as that deadlocks in any case. */
+  bool
+  ExecutePendingJob(const void * scope);
+
   /** Can call this method if we want to add extra threads to the pool. */
   void
   AddThreads(ThreadIdType count);
@@ -111,6 +145,11 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
     return static_cast<ThreadIdType>(m_Threads.size());
   }
 
+  /** Returns 0 for a thread outside the pool, such as the thread starting a
+   * parallel call, and the worker index plus one for a worker of the pool. */
+  ThreadIdType
+  GetIndexOfCurrentThread() const;
+
   /** The approximate number of idle threads. */
   int
   GetNumberOfCurrentlyIdleThreads() const;
@@ -130,6 +169,11 @@ protected:
   std::mutex &
   GetMutex();
 
+  /** Push a job onto one of the worker queues and wake up an idle worker.
+   * Only the mutex of the chosen worker queue is locked. The scope may be nullptr. */
+  void
+  SubmitWork(std::function<void()> && work, const void * scope);
+
   ThreadPool();
   ~ThreadPool() override;
 
@@ -137,10 +181,47 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(ThreadPoolGlobals, PimplGlobals);
 
-  /** This is a list of jobs submitted to the thread pool.
-   * This is the only place where the jobs are submitted.
-   * Filled by AddWork, emptied by ThreadExecute. */
-  std::deque<std::function<void()>> m_WorkQueue;
+  /** A list of jobs owned by one worker thread, with its own lock.
+   * Filled by SubmitWork, emptied by its owner and by stealing workers. */
+  struct WorkerQueue
+  {
+    struct Job
+    {
+      std::function<void()> m_Function;
+      const void *          m_Scope;
+    };
+
+    std::mutex      m_Mutex;
+    std::deque<Job> m_Jobs;
+  };
+
+  /** Take a job from the worker's own queue, or steal one from another queue.
+   * Returns false if all the queues are empty. */
+  bool
+  TryGetWork(ThreadIdType workerIndex, std::function<void()> & work);
+
+  /** Take a job of the given scope from any queue, searching the worker's own
+   * queue first. Returns false if no job of this scope is queued. */
+  bool
+  TryGetScopedWork(ThreadIdType workerIndex, const void * scope, std::function<void()> & work);
+
+  /** One queue per worker thread. The queues are allocated for ITK_MAX_THREADS
+   * workers up front, so that adding threads never relocates a queue which is
+   * in use. Workers beyond ITK_MAX_THREADS share queues. */
+  std::unique_ptr<WorkerQueue[]> m_WorkQueues;
+
+  /** The number of queues in use, min(ITK_MAX_THREADS, number of threads). */
+  std::atomic<ThreadIdType> m_NumberOfWorkQueues{ 0 };
+
+  /** Round-robin counter to pick a queue for jobs submitted from outside the pool. */
+  std::atomic<ThreadIdType> m_NextWorkQueue{ 0 };
+
+  /** The number of jobs which are queued, but not yet taken by a worker. */
+  std::atomic<SizeValueType> m_NumberOfPendingJobs{ 0 };
+
+  /** The number of workers waiting on m_Condition. Used by SubmitWork
+   * to avoid locking the global mutex when nobody needs to be woken up. */
+  std::atomic<ThreadIdType> m_NumberOfSleepingThreads{ 0 };
 
   /** When a thread is idle, it is waiting on m_Condition.
    * AddWork signals it to resume a (random) thread. */
@@ -153,12 +234,17 @@ private:
   /* Has destruction started? */
   bool m_Stopping{ false };
 
+  /** Whether the workers are pinned to processors. Read before the workers
+   * start, as a worker starting late, e.g. while the process exits, must
+   * not initialize the globals of MultiThreaderBase. */
+  bool m_ThreadAffinity{ false };
+
   /** To lock on the internal variables */
   static ThreadPoolGlobals * m_PimplGlobals;
 
   /** The continuously running thread function */
   static void
-  ThreadExecute();
+  ThreadExecute(ThreadIdType workerIndex);
 };
 
 } // namespace itk
@@ -29,6 +29,8 @@
 #define itkVectorImage_hxx
 #include "itkVectorImage.h"
 #include "itkProcessObject.h"
+#include "itkImportImageContainerCommon.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -56,7 +58,20 @@ VectorImage<TPixel, VImageDimension>::Allocate(const bool UseDefaultConstructor)
   this->ComputeOffsetTable();
   num = this->GetOffsetTable()[VImageDimension];
 
-  m_Buffer->Reserve(num * m_VectorLength, UseDefaultConstructor);
+  // See Image::Allocate
+  const bool firstTouch = std::is_trivially_default_constructible<TPixel>::value &&
+                          ImportImageContainerCommon::GetGlobalDefaultNUMAFirstTouch() &&
+                          m_Buffer->GetImportPointer() == nullptr;
+  m_Buffer->Reserve(num * m_VectorLength, UseDefaultConstructor && !firstTouch);
+  if (firstTouch && m_Buffer->GetImportPointer() != nullptr)
+  {
+    const RegionType & bufferedRegion = this->GetBufferedRegion();
+    ImportImageContainerCommon::FirstTouch(m_Buffer->GetImportPointer(),
+                                           VImageDimension,
+                                           &bufferedRegion.GetIndex()[0],
+                                           &bufferedRegion.GetSize()[0],
+                                           sizeof(TPixel) * m_VectorLength);
+  }
 }
 
 template <typename TPixel, unsigned int VImageDimension>
@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkByteSwapperCommon.h"
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace itk
+{
+
+namespace
+{
+// Ranges of fewer words are swapped serially, without a multi-threader
+constexpr SizeValueType wordsPerChunk = 262144;
+
+// The shifts are recognized by the compilers as byte swaps, which the
+// loop below vectorizes
+inline uint16_t
+ReverseBytes(uint16_t word)
+{
+  return static_cast<uint16_t>((word >> 8) | (word << 8));
+}
+
+inline uint32_t
+ReverseBytes(uint32_t word)
+{
+  return ((word & 0x000000ffu) << 24) | ((word & 0x0000ff00u) << 8) | ((word & 0x00ff0000u) >> 8) |
+         ((word & 0xff000000u) >> 24);
+}
+
+inline uint64_t
+ReverseBytes(uint64_t word)
+{
+  return (static_cast<uint64_t>(ReverseBytes(static_cast<uint32_t>(word))) << 32) |
+         ReverseBytes(static_cast<uint32_t>(word >> 32));
+}
+
+// The words are copied in and out, as the buffer may not be aligned
+template <typename TWord>
+void
+SwapWords(char * bytes, SizeValueType num)
+{
+  for (SizeValueType i = 0; i < num; ++i)
+  {
+    TWord word;
+    std::memcpy(&word, bytes + i * sizeof(TWord), sizeof(TWord));
+    word = ReverseBytes(word);
+    std::memcpy(bytes + i * sizeof(TWord), &word, sizeof(TWord));
+  }
+}
+
+template <typename TWord>
+void
+SwapWordsByChunks(char * bytes, SizeValueType num)
+{
+  if (num < 2 * wordsPerChunk)
+  {
+    SwapWords<TWord>(bytes, num);
+    return;
+  }
+
+  const SizeValueType numberOfChunks = (num + wordsPerChunk - 1) / wordsPerChunk;
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [bytes, num](SizeValueType chunk) {
+      const SizeValueType first = chunk * wordsPerChunk;
+      SwapWords<TWord>(bytes + first * sizeof(TWord), std::min(num - first, wordsPerChunk));
+    },
+    nullptr);
+}
+} // namespace
+
+void
+ByteSwapperCommon::SwapWordRange(void * ptr, SizeValueType num, unsigned int wordSize)
+{
+  auto * const bytes = static_cast<char *>(ptr);
+  switch (wordSize)
+  {
+    case 2:
+      SwapWordsByChunks<uint16_t>(bytes, num);
+      break;
+    case 4:
+      SwapWordsByChunks<uint32_t>(bytes, num);
+      break;
+    case 8:
+      SwapWordsByChunks<uint64_t>(bytes, num);
+      break;
+    default:
+      itkGenericExceptionMacro(<< "Cannot swap words of " << wordSize << " bytes");
+  }
+}
+
+} // end namespace itk
@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferAllocatorAligned.h"
+#include <algorithm>
+#include <cstdlib>
+#if defined(_WIN32)
+#  include <malloc.h>
+#endif
+
+namespace itk
+{
+
+ImageBufferAllocatorAligned::ImageBufferAllocatorAligned() = default;
+
+ImageBufferAllocatorAligned::~ImageBufferAllocatorAligned() = default;
+
+void *
+ImageBufferAllocatorAligned::Allocate(SizeValueType numberOfBytes)
+{
+  if (m_Alignment < sizeof(void *) || (m_Alignment & (m_Alignment - 1)) != 0)
+  {
+    itkExceptionMacro(<< "Alignment " << m_Alignment << " is not a power of two multiple of " << sizeof(void *));
+  }
+  return AllocateAligned(numberOfBytes, m_Alignment);
+}
+
+void
+ImageBufferAllocatorAligned::Deallocate(void * buffer, SizeValueType itkNotUsed(numberOfBytes))
+{
+  FreeAligned(buffer);
+}
+
+void *
+ImageBufferAllocatorAligned::AllocateAligned(SizeValueType numberOfBytes, SizeValueType alignment)
+{
+  // Allocating zero bytes may return nullptr, which would look like a failure.
+  numberOfBytes = std::max<SizeValueType>(numberOfBytes, 1);
+  void * buffer = nullptr;
+#if defined(_WIN32)
+  buffer = _aligned_malloc(numberOfBytes, alignment);
+#else
+  if (posix_memalign(&buffer, alignment, numberOfBytes) != 0)
+  {
+    buffer = nullptr;
+  }
+#endif
+  if (!buffer)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+  return buffer;
+}
+
+void
+ImageBufferAllocatorAligned::FreeAligned(void * buffer)
+{
+#if defined(_WIN32)
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+}
+
+void
+ImageBufferAllocatorAligned::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Alignment: " << m_Alignment << std::endl;
+}
+
+} // end namespace itk
@@ -0,0 +1,60 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferAllocatorHugePage.h"
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+ImageBufferAllocatorHugePage::ImageBufferAllocatorHugePage() = default;
+
+ImageBufferAllocatorHugePage::~ImageBufferAllocatorHugePage() = default;
+
+void *
+ImageBufferAllocatorHugePage::Allocate(SizeValueType numberOfBytes)
+{
+  if (m_HugePageSize == 0 || (m_HugePageSize & (m_HugePageSize - 1)) != 0)
+  {
+    itkExceptionMacro(<< "HugePageSize " << m_HugePageSize << " is not a power of two");
+  }
+  if (numberOfBytes < m_HugePageSize)
+  {
+    return Superclass::Allocate(numberOfBytes);
+  }
+
+  // Whole huge pages only, so that the kernel can use them for the entire buffer
+  const SizeValueType paddedNumberOfBytes = (numberOfBytes + m_HugePageSize - 1) & ~(m_HugePageSize - 1);
+  void *              buffer = AllocateAligned(paddedNumberOfBytes, m_HugePageSize);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Only a hint: it fails harmlessly when transparent huge pages are disabled
+  madvise(buffer, paddedNumberOfBytes, MADV_HUGEPAGE);
+#endif
+  return buffer;
+}
+
+void
+ImageBufferAllocatorHugePage::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "HugePageSize: " << m_HugePageSize << std::endl;
+}
+
+} // end namespace itk
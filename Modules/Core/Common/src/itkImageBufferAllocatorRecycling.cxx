@@ -0,0 +1,236 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferAllocatorRecycling.h"
+#include "itkImageBufferAllocatorAligned.h"
+#include "itksys/SystemTools.hxx"
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+SizeValueType
+GetDefaultMaximumCachedBytes()
+{
+  static const SizeValueType defaultMaximumCachedBytes = []() {
+    SizeValueType maximumCachedBytes = SizeValueType{ 256 } * 1024 * 1024;
+    std::string   envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_RECYCLING_MAXIMUM_CACHED_BYTES", envVar))
+    {
+      std::istringstream envStream(envVar);
+      SizeValueType      envBytes;
+      if (envStream >> envBytes)
+      {
+        maximumCachedBytes = envBytes;
+      }
+    }
+    return maximumCachedBytes;
+  }();
+  return defaultMaximumCachedBytes;
+}
+} // namespace
+
+ImageBufferAllocatorRecycling::ImageBufferAllocatorRecycling()
+  : m_Allocator(ImageBufferAllocatorAligned::New().GetPointer())
+  , m_MaximumCachedBytes(GetDefaultMaximumCachedBytes())
+{}
+
+ImageBufferAllocatorRecycling::~ImageBufferAllocatorRecycling()
+{
+  this->ReleaseCachedBuffers();
+}
+
+void
+ImageBufferAllocatorRecycling::SetAllocator(ImageBufferAllocatorBase * allocator)
+{
+  // The cached buffers belong to the previous allocator
+  ImageBufferAllocatorBase::Pointer    previousAllocator;
+  std::multimap<SizeValueType, void *> cachedBuffers;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Allocator == allocator)
+    {
+      return;
+    }
+    if (m_NumberOfAllocatedBuffers > 0)
+    {
+      itkExceptionMacro(<< "Cannot change the allocator while " << m_NumberOfAllocatedBuffers
+                        << " buffers allocated by it are not deallocated");
+    }
+    previousAllocator = m_Allocator;
+    m_Allocator = allocator;
+    cachedBuffers.swap(m_CachedBuffers);
+    m_CachedBytes = 0;
+  }
+  for (const auto & cachedBuffer : cachedBuffers)
+  {
+    previousAllocator->Deallocate(cachedBuffer.second, cachedBuffer.first);
+  }
+  this->Modified();
+}
+
+void
+ImageBufferAllocatorRecycling::SetMaximumCachedBytes(SizeValueType maximumCachedBytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_MaximumCachedBytes == maximumCachedBytes)
+    {
+      return;
+    }
+    m_MaximumCachedBytes = maximumCachedBytes;
+  }
+  this->Modified();
+}
+
+SizeValueType
+ImageBufferAllocatorRecycling::GetMaximumCachedBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumCachedBytes;
+}
+
+void
+ImageBufferAllocatorRecycling::SetReleaseCacheOnMiss(bool releaseCacheOnMiss)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_ReleaseCacheOnMiss == releaseCacheOnMiss)
+    {
+      return;
+    }
+    m_ReleaseCacheOnMiss = releaseCacheOnMiss;
+  }
+  this->Modified();
+}
+
+bool
+ImageBufferAllocatorRecycling::GetReleaseCacheOnMiss() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_ReleaseCacheOnMiss;
+}
+
+SizeValueType
+ImageBufferAllocatorRecycling::GetCachedBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_CachedBytes;
+}
+
+SizeValueType
+ImageBufferAllocatorRecycling::GetNumberOfAllocatedBuffers() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfAllocatedBuffers;
+}
+
+void
+ImageBufferAllocatorRecycling::ReleaseCachedBuffers()
+{
+  ImageBufferAllocatorBase::Pointer    allocator;
+  std::multimap<SizeValueType, void *> cachedBuffers;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    allocator = m_Allocator;
+    cachedBuffers.swap(m_CachedBuffers);
+    m_CachedBytes = 0;
+  }
+  for (const auto & cachedBuffer : cachedBuffers)
+  {
+    allocator->Deallocate(cachedBuffer.second, cachedBuffer.first);
+  }
+}
+
+void *
+ImageBufferAllocatorRecycling::Allocate(SizeValueType numberOfBytes)
+{
+  ImageBufferAllocatorBase::Pointer allocator;
+  bool                              releaseCache;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Allocator.IsNull())
+    {
+      itkExceptionMacro(<< "Allocator is not set");
+    }
+    // Counted before the allocation, so that the allocator cannot be
+    // changed until the buffer is deallocated
+    ++m_NumberOfAllocatedBuffers;
+    const auto found = m_CachedBuffers.find(numberOfBytes);
+    if (found != m_CachedBuffers.end())
+    {
+      void * buffer = found->second;
+      m_CachedBuffers.erase(found);
+      m_CachedBytes -= numberOfBytes;
+      return buffer;
+    }
+    allocator = m_Allocator;
+    releaseCache = m_ReleaseCacheOnMiss;
+  }
+  if (releaseCache)
+  {
+    this->ReleaseCachedBuffers();
+  }
+  try
+  {
+    return allocator->Allocate(numberOfBytes);
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    --m_NumberOfAllocatedBuffers;
+    throw;
+  }
+}
+
+void
+ImageBufferAllocatorRecycling::Deallocate(void * buffer, SizeValueType numberOfBytes)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  ImageBufferAllocatorBase::Pointer allocator;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    --m_NumberOfAllocatedBuffers;
+    if (m_CachedBytes + numberOfBytes <= m_MaximumCachedBytes)
+    {
+      m_CachedBuffers.emplace(numberOfBytes, buffer);
+      m_CachedBytes += numberOfBytes;
+      return;
+    }
+    allocator = m_Allocator;
+  }
+  allocator->Deallocate(buffer, numberOfBytes);
+}
+
+void
+ImageBufferAllocatorRecycling::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  itkPrintSelfObjectMacro(Allocator);
+  os << indent << "MaximumCachedBytes: " << this->GetMaximumCachedBytes() << std::endl;
+  os << indent << "ReleaseCacheOnMiss: " << (this->GetReleaseCacheOnMiss() ? "On" : "Off") << std::endl;
+  os << indent << "CachedBytes: " << this->GetCachedBytes() << std::endl;
+  os << indent << "NumberOfAllocatedBuffers: " << this->GetNumberOfAllocatedBuffers() << std::endl;
+}
+
+} // end namespace itk
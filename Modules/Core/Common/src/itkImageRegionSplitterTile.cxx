@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageRegionSplitterTile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace itk
+{
+
+ImageRegionSplitterTile::ImageRegionSplitterTile() = default;
+
+unsigned int
+ImageRegionSplitterTile::GetNumberOfPiecesPerWorkUnit() const
+{
+  // As many pieces as there are tiles
+  return NumericTraits<unsigned int>::max();
+}
+
+unsigned int
+ImageRegionSplitterTile::GetNumberOfSplitsInternal(unsigned int         dim,
+                                                   const IndexValueType itkNotUsed(regionIndex)[],
+                                                   const SizeValueType  regionSize[],
+                                                   unsigned int         requestedNumber) const
+{
+  std::vector<unsigned int> splits(dim);
+  return this->ComputeSplits(dim, requestedNumber, regionSize, splits.data());
+}
+
+unsigned int
+ImageRegionSplitterTile::GetSplitInternal(unsigned int   dim,
+                                          unsigned int   i,
+                                          unsigned int   numberOfPieces,
+                                          IndexValueType regionIndex[],
+                                          SizeValueType  regionSize[]) const
+{
+  std::vector<unsigned int> splits(dim);
+  numberOfPieces = this->ComputeSplits(dim, numberOfPieces, regionSize, splits.data());
+
+  // The pieces along each dimension differ by at most one pixel
+  unsigned int offset = i;
+  for (unsigned int d = 0; d < dim; ++d)
+  {
+    const uint64_t piece = offset % splits[d];
+    offset /= splits[d];
+
+    const uint64_t size = regionSize[d];
+    const uint64_t begin = piece * size / splits[d];
+    const uint64_t end = (piece + 1) * size / splits[d];
+    regionIndex[d] += static_cast<IndexValueType>(begin);
+    regionSize[d] = static_cast<SizeValueType>(end - begin);
+  }
+
+  return numberOfPieces;
+}
+
+unsigned int
+ImageRegionSplitterTile::ComputeSplits(unsigned int        dim,
+                                       unsigned int        requestedNumber,
+                                       const SizeValueType regionSize[],
+                                       unsigned int        splits[]) const
+{
+  // The size of the tiles, balanced among the dimensions: the dimensions
+  // are visited from the smallest size up, each taking an even share of
+  // the budget left, so that the budget which a dimension smaller than its
+  // share leaves goes to the larger ones. Among dimensions of equal size,
+  // the fastest one is visited last, and gets what the rounding leaves.
+  std::vector<unsigned int> order(dim);
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [regionSize](unsigned int a, unsigned int b) {
+    return regionSize[a] != regionSize[b] ? regionSize[a] < regionSize[b] : a > b;
+  });
+  double budget = static_cast<double>(m_TileNumberOfPixels);
+  for (unsigned int k = 0; k < dim; ++k)
+  {
+    const unsigned int d = order[k];
+    const double       size = static_cast<double>(regionSize[d]);
+    const double       edge = std::floor(std::pow(budget, 1.0 / (dim - k)) + 1e-9);
+    const double       tileSize = std::max(1.0, std::min(edge, size));
+    splits[d] = regionSize[d] == 0
+                  ? 1u
+                  : static_cast<unsigned int>(
+                      std::min(std::ceil(size / tileSize), static_cast<double>(NumericTraits<unsigned int>::max())));
+    // The tiles along the dimension are at most this large once the pieces
+    // are evened out
+    budget = std::max(1.0, std::floor(budget / std::max(1.0, std::ceil(size / splits[d]))));
+  }
+
+  // Merge the tiles along the dimension with the most pieces, until there
+  // are not more pieces than requested
+  requestedNumber = std::max(requestedNumber, 1u);
+  while (true)
+  {
+    uint64_t     numberOfPieces = 1;
+    unsigned int maxSplitDim = 0;
+    for (unsigned int d = 0; d < dim; ++d)
+    {
+      numberOfPieces = std::min<uint64_t>(numberOfPieces * splits[d], uint64_t{ 1 } << 32);
+      if (splits[d] >= splits[maxSplitDim])
+      {
+        maxSplitDim = d;
+      }
+    }
+    if (numberOfPieces <= requestedNumber)
+    {
+      return static_cast<unsigned int>(numberOfPieces);
+    }
+    // At most halve the pieces along a dimension at once, to merge along
+    // all of them when there are many more pieces than requested
+    const double ratio = static_cast<double>(requestedNumber) / static_cast<double>(numberOfPieces);
+    const auto   reduced = static_cast<unsigned int>(std::ceil(splits[maxSplitDim] * ratio));
+    splits[maxSplitDim] = std::min(splits[maxSplitDim] - 1, std::max((splits[maxSplitDim] + 1) / 2, reduced));
+  }
+}
+
+void
+ImageRegionSplitterTile::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "TileNumberOfPixels: " << m_TileNumberOfPixels << std::endl;
+}
+
+} // end namespace itk
@@ -25,8 +25,8 @@ namespace itk
 
 namespace
 {
-std::mutex                       globalDefaultSplitterLock;
-ImageRegionSplitterBase::Pointer globalDefaultSplitter;
+std::mutex                            globalDefaultSplitterLock;
+ImageRegionSplitterBase::ConstPointer globalDefaultSplitter;
 } // namespace
 
 const ImageRegionSplitterBase *
@@ -45,5 +45,12 @@ ImageSourceCommon::GetGlobalDefaultSplitter()
   return globalDefaultSplitter;
 }
 
+void
+ImageSourceCommon::SetGlobalDefaultSplitter(const ImageRegionSplitterBase * splitter)
+{
+  std::lock_guard<std::mutex> lock(globalDefaultSplitterLock);
+  globalDefaultSplitter = splitter;
+}
+
 
 } // namespace itk
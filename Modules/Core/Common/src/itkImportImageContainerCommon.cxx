@@ -0,0 +1,208 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImportImageContainerCommon.h"
+#include "itkImageBufferAllocatorHugePage.h"
+#include "itkImageBufferAllocatorRecycling.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+
+namespace
+{
+std::mutex globalDefaultNUMAFirstTouchLock;
+bool       globalDefaultNUMAFirstTouchIsInitialized = false;
+bool       globalDefaultNUMAFirstTouch = false;
+
+std::mutex                        globalDefaultAllocatorLock;
+bool                              globalDefaultAllocatorIsInitialized = false;
+ImageBufferAllocatorBase::Pointer globalDefaultAllocator;
+
+// Below this size, the placement of the pages hardly matters.
+constexpr SizeValueType minimumNumberOfBytesToFirstTouch = 4 * 1024 * 1024;
+
+thread_local SizeValueType numberOfBytesAllocatedByThread = 0;
+
+// The default threader, shared by the first touches of a thread until the
+// global default threader or number of threads changes.
+MultiThreaderBase *
+GetFirstTouchThreader()
+{
+  thread_local MultiThreaderBase::Pointer      threader;
+  thread_local MultiThreaderBase::ThreaderEnum threaderType = MultiThreaderBase::ThreaderEnum::Unknown;
+  thread_local ThreadIdType                    numberOfThreads = 0;
+
+  const MultiThreaderBase::ThreaderEnum globalThreaderType = MultiThreaderBase::GetGlobalDefaultThreader();
+  const ThreadIdType                    globalNumberOfThreads = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  if (threader.IsNull() || threaderType != globalThreaderType || numberOfThreads != globalNumberOfThreads)
+  {
+    threader = MultiThreaderBase::New();
+    threaderType = globalThreaderType;
+    numberOfThreads = globalNumberOfThreads;
+  }
+  return threader;
+}
+} // namespace
+
+void
+ImportImageContainerCommon::SetGlobalDefaultNUMAFirstTouch(bool firstTouch)
+{
+  std::lock_guard<std::mutex> lock(globalDefaultNUMAFirstTouchLock);
+  globalDefaultNUMAFirstTouch = firstTouch;
+  globalDefaultNUMAFirstTouchIsInitialized = true;
+}
+
+bool
+ImportImageContainerCommon::GetGlobalDefaultNUMAFirstTouch()
+{
+  std::lock_guard<std::mutex> lock(globalDefaultNUMAFirstTouchLock);
+  if (!globalDefaultNUMAFirstTouchIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_NUMA_FIRST_TOUCH", envVar))
+    {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      globalDefaultNUMAFirstTouch = (envVar == "ON" || envVar == "TRUE" || envVar == "YES" || envVar == "1");
+    }
+    globalDefaultNUMAFirstTouchIsInitialized = true;
+  }
+  return globalDefaultNUMAFirstTouch;
+}
+
+void
+ImportImageContainerCommon::SetGlobalDefaultAllocator(ImageBufferAllocatorBase * allocator)
+{
+  std::lock_guard<std::mutex> lock(globalDefaultAllocatorLock);
+  globalDefaultAllocator = allocator;
+  globalDefaultAllocatorIsInitialized = true;
+}
+
+ImageBufferAllocatorBase::Pointer
+ImportImageContainerCommon::GetGlobalDefaultAllocator()
+{
+  std::lock_guard<std::mutex> lock(globalDefaultAllocatorLock);
+  if (!globalDefaultAllocatorIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATOR", envVar))
+    {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      if (envVar == "ALIGNED")
+      {
+        globalDefaultAllocator = ImageBufferAllocatorAligned::New().GetPointer();
+      }
+      else if (envVar == "HUGEPAGE")
+      {
+        globalDefaultAllocator = ImageBufferAllocatorHugePage::New().GetPointer();
+      }
+      else if (envVar == "RECYCLING")
+      {
+        globalDefaultAllocator = ImageBufferAllocatorRecycling::New().GetPointer();
+      }
+    }
+    globalDefaultAllocatorIsInitialized = true;
+  }
+  return globalDefaultAllocator;
+}
+
+void
+ImportImageContainerCommon::CountAllocatedBytes(SizeValueType numberOfBytes)
+{
+  numberOfBytesAllocatedByThread += numberOfBytes;
+}
+
+SizeValueType
+ImportImageContainerCommon::GetNumberOfBytesAllocatedByThread()
+{
+  return numberOfBytesAllocatedByThread;
+}
+
+void
+ImportImageContainerCommon::FirstTouch(void *               buffer,
+                                       unsigned int         dimension,
+                                       const IndexValueType index[],
+                                       const SizeValueType  size[],
+                                       SizeValueType        numberOfBytesPerPixel)
+{
+  auto * const               bytes = static_cast<char *>(buffer);
+  std::vector<SizeValueType> offsetTable(dimension + 1, 1);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    offsetTable[d + 1] = offsetTable[d] * size[d];
+  }
+  const SizeValueType numberOfBytes = offsetTable[dimension] * numberOfBytesPerPixel;
+  if (numberOfBytes < minimumNumberOfBytesToFirstTouch)
+  {
+    std::memset(bytes, 0, numberOfBytes);
+    return;
+  }
+  MultiThreaderBase * const threader = GetFirstTouchThreader();
+  if (threader->GetNumberOfWorkUnits() <= 1)
+  {
+    std::memset(bytes, 0, numberOfBytes);
+    return;
+  }
+
+  threader->ParallelizeImageRegion(
+    dimension,
+    index,
+    size,
+    [bytes, dimension, index, size, numberOfBytesPerPixel, &offsetTable](const IndexValueType pieceIndex[],
+                                                                         const SizeValueType  pieceSize[]) {
+      // A piece need not be contiguous, so zero it line by line. The leading
+      // dimensions which the piece spans entirely form a single line.
+      unsigned int  lineDimension = 1;
+      SizeValueType lineLength = pieceSize[0];
+      while (lineDimension < dimension && pieceSize[lineDimension - 1] == size[lineDimension - 1])
+      {
+        lineLength *= pieceSize[lineDimension];
+        ++lineDimension;
+      }
+      SizeValueType numberOfLines = 1;
+      SizeValueType pieceOffset = 0;
+      for (unsigned int d = 0; d < dimension; ++d)
+      {
+        pieceOffset += static_cast<SizeValueType>(pieceIndex[d] - index[d]) * offsetTable[d];
+        numberOfLines *= (d < lineDimension) ? 1 : pieceSize[d];
+      }
+
+      std::vector<SizeValueType> position(dimension, 0);
+      for (SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        SizeValueType offset = pieceOffset;
+        for (unsigned int d = lineDimension; d < dimension; ++d)
+        {
+          offset += position[d] * offsetTable[d];
+        }
+        std::memset(bytes + offset * numberOfBytesPerPixel, 0, lineLength * numberOfBytesPerPixel);
+        for (unsigned int d = lineDimension; d < dimension && ++position[d] == pieceSize[d]; ++d)
+        {
+          position[d] = 0;
+        }
+      }
+    },
+    nullptr);
+}
+
+} // namespace itk
@@ -43,6 +43,9 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <vector>
 
 #if defined(ITK_USE_TBB)
 #  include "itkTBBMultiThreader.h"
@@ -53,6 +56,67 @@
 namespace itk
 {
 
+namespace
+{
+// How many work units the calling thread is executing, one inside the other.
+thread_local unsigned int workUnitNestingLevel = 0;
+
+#if defined(__linux__) && defined(ITK_USE_PTHREADS)
+// The processors which the calling thread may run on, the processors of one
+// NUMA node after the other, so that consecutive workers share a node.
+std::vector<int>
+GetAllowedProcessors()
+{
+  std::vector<int> processors;
+  cpu_set_t        allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0)
+  {
+    return processors;
+  }
+
+  std::vector<bool> listed(CPU_SETSIZE, false);
+  for (unsigned int node = 0;; ++node)
+  {
+    std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!cpuList)
+    {
+      break;
+    }
+    // Comma separated ranges, e.g. 0-3,8-11
+    std::string range;
+    while (std::getline(cpuList, range, ','))
+    {
+      int first = -1;
+      int last = -1;
+      if (std::sscanf(range.c_str(), "%d-%d", &first, &last) == 1)
+      {
+        last = first;
+      }
+      for (int cpu = std::max(first, 0); cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+      {
+        if (CPU_ISSET(cpu, &allowed) && !listed[cpu])
+        {
+          processors.push_back(cpu);
+          listed[cpu] = true;
+        }
+      }
+    }
+  }
+
+  // Without NUMA information, in the order of the processor numbers
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &allowed) && !listed[cpu])
+    {
+      processors.push_back(cpu);
+    }
+  }
+  return processors;
+}
+#endif
+} // namespace
+
 struct MultiThreaderBaseGlobals
 {
   // Initialize static members.
@@ -89,6 +153,11 @@ struct MultiThreaderBaseGlobals
   //  m_GlobalMaximumNumberOfThreads and larger or equal to 1 once it has been
   //  initialized in the constructor of the first MultiThreaderBase instantiation.
   ThreadIdType m_GlobalDefaultNumberOfThreads{ 0 };
+
+  // Whether pool and TBB workers are pinned to processors. Defaults to the
+  // environmental variable ITK_GLOBAL_DEFAULT_THREAD_AFFINITY.
+  bool GlobalDefaultThreadAffinityIsInitialized{ false };
+  bool m_GlobalDefaultThreadAffinity{ false };
 };
 
 itkGetGlobalSimpleMacro(MultiThreaderBase, MultiThreaderBaseGlobals, PimplGlobals);
@@ -179,6 +248,82 @@ You should now use ITK_GLOBAL_DEFAULT_THREADER\
   return m_PimplGlobals->m_GlobalDefaultThreader;
 }
 
+void
+MultiThreaderBase::SetGlobalDefaultThreadAffinity(bool threadAffinity)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  m_PimplGlobals->m_GlobalDefaultThreadAffinity = threadAffinity;
+  m_PimplGlobals->GlobalDefaultThreadAffinityIsInitialized = true;
+}
+
+bool
+MultiThreaderBase::GetGlobalDefaultThreadAffinity()
+{
+  // This method must be concurrent thread safe
+  itkInitGlobalsMacro(PimplGlobals);
+
+  if (!m_PimplGlobals->GlobalDefaultThreadAffinityIsInitialized)
+  {
+    std::lock_guard<std::mutex> lock(m_PimplGlobals->globalDefaultInitializerLock);
+
+    if (!m_PimplGlobals->GlobalDefaultThreadAffinityIsInitialized)
+    {
+      std::string envVar;
+      if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_THREAD_AFFINITY", envVar))
+      {
+        envVar = itksys::SystemTools::UpperCase(envVar);
+        m_PimplGlobals->m_GlobalDefaultThreadAffinity =
+          (envVar == "ON" || envVar == "TRUE" || envVar == "YES" || envVar == "1");
+      }
+      m_PimplGlobals->GlobalDefaultThreadAffinityIsInitialized = true;
+    }
+  }
+  return m_PimplGlobals->m_GlobalDefaultThreadAffinity;
+}
+
+bool
+MultiThreaderBase::SetCurrentThreadAffinity(ThreadIdType processor)
+{
+#if defined(__linux__) && defined(ITK_USE_PTHREADS)
+  // Taken once, before any worker is pinned, as workers inherit the affinity
+  // of the thread which starts them.
+  static const std::vector<int> allowedProcessors = GetAllowedProcessors();
+  if (allowedProcessors.empty())
+  {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(allowedProcessors[processor % allowedProcessors.size()], &cpuSet);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#elif defined(ITK_USE_WIN32_THREADS)
+  DWORD_PTR processMask = 0;
+  DWORD_PTR systemMask = 0;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) || processMask == 0)
+  {
+    return false;
+  }
+  // The allowed processors are the bits of the process mask
+  unsigned int numberOfAllowedProcessors = 0;
+  for (DWORD_PTR bits = processMask; bits != 0; bits &= bits - 1)
+  {
+    ++numberOfAllowedProcessors;
+  }
+  processor %= numberOfAllowedProcessors;
+  DWORD_PTR mask = processMask;
+  for (ThreadIdType i = 0; i < processor; ++i)
+  {
+    mask &= mask - 1; // clear the lowest allowed processor
+  }
+  mask &= ~(mask - 1); // keep the lowest remaining one
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+  (void)processor;
+  return false;
+#endif
+}
+
 MultiThreaderBase::ThreaderEnum
 MultiThreaderBase ::ThreaderTypeFromString(std::string threaderString)
 {
@@ -276,6 +421,25 @@ MultiThreaderBase::SetUpdateProgress(bool updates)
   this->m_UpdateProgress = updates;
 }
 
+const ImageRegionSplitterBase *
+MultiThreaderBase::GetImageRegionSplitter() const
+{
+  if (m_ImageRegionSplitter)
+  {
+    return m_ImageRegionSplitter;
+  }
+  return ImageSourceCommon::GetGlobalDefaultSplitter();
+}
+
+ThreadIdType
+MultiThreaderBase::ComputeNumberOfPieces(const ImageRegionSplitterBase * splitter, const ImageIORegion & region) const
+{
+  const uint64_t requestedNumber =
+    uint64_t{ m_NumberOfWorkUnits } * std::max(m_NumberOfPiecesPerWorkUnit, splitter->GetNumberOfPiecesPerWorkUnit());
+  return splitter->GetNumberOfSplits(
+    region, static_cast<unsigned int>(std::min<uint64_t>(requestedNumber, NumericTraits<unsigned int>::max())));
+}
+
 ThreadIdType
 MultiThreaderBase::GetGlobalDefaultNumberOfThreads()
 {
@@ -431,6 +595,22 @@ MultiThreaderBase::MultiThreaderBase()
 
 MultiThreaderBase::~MultiThreaderBase() = default;
 
+bool
+MultiThreaderBase ::IsInsideWorkUnit()
+{
+  return workUnitNestingLevel > 0;
+}
+
+MultiThreaderBase::WorkUnitScope::WorkUnitScope()
+{
+  ++workUnitNestingLevel;
+}
+
+MultiThreaderBase::WorkUnitScope::~WorkUnitScope()
+{
+  --workUnitNestingLevel;
+}
+
 ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
 MultiThreaderBase ::SingleMethodProxy(void * arg)
 {
@@ -440,6 +620,7 @@ MultiThreaderBase ::SingleMethodProxy(void * arg)
   // execute the user specified threader callback, catching any exceptions
   try
   {
+    WorkUnitScope workUnitScope;
     (*threadInfoStruct->ThreadFunction)(arg);
     threadInfoStruct->ThreadExitCode = WorkUnitInfo::ThreadExitCodeEnum::SUCCESS;
   }
@@ -479,7 +660,15 @@ MultiThreaderBase ::ParallelizeArray(SizeValueType             firstIndex,
   // Upon destruction, progress will be set to 1.0
   ProgressReporter progress(filter, 0, 1);
 
-  if (firstIndex + 1 < lastIndexPlus1)
+  if (firstIndex + 1 < lastIndexPlus1 && MultiThreaderBase::IsInsideWorkUnit())
+  {
+    // Nested call: the calling work unit already occupies a thread.
+    for (SizeValueType i = firstIndex; i < lastIndexPlus1; ++i)
+    {
+      aFunc(i);
+    }
+  }
+  else if (firstIndex + 1 < lastIndexPlus1)
   {
     struct ArrayCallback acParams
     {
@@ -542,14 +731,26 @@ MultiThreaderBase ::ParallelizeImageRegion(unsigned int
   }
   ProgressReporter progress(filter, 0, 1);
 
+  if (MultiThreaderBase::IsInsideWorkUnit())
+  {
+    // Nested call: the calling work unit already occupies a thread.
+    funcP(index, size);
+    return;
+  }
+
   SizeValueType pixelCount = 1;
+  ImageIORegion region(dimension);
   for (unsigned d = 0; d < dimension; d++)
   {
     pixelCount *= size[d];
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
   }
-  struct RegionAndCallback rnc
+  // The work units take the pieces from a queue
+  const ImageRegionSplitterBase * splitter = this->GetImageRegionSplitter();
+  struct RegionAndCallback        rnc
   {
-    funcP, dimension, index, size, 0, filter
+    funcP, dimension, index, size, 0, filter, splitter, this->ComputeNumberOfPieces(splitter, region), { 0 }
   };
   this->SetSingleMethod(&MultiThreaderBase::ParallelizeImageRegionHelper, &rnc);
   this->SingleMethodExecute();
@@ -559,24 +760,20 @@ ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
 MultiThreaderBase ::ParallelizeImageRegionHelper(void * arg)
 {
   using ThreadInfo = MultiThreaderBase::WorkUnitInfo;
-  auto *       threadInfo = static_cast<ThreadInfo *>(arg);
-  ThreadIdType threadId = threadInfo->WorkUnitID;
-  ThreadIdType threadCount = threadInfo->NumberOfWorkUnits;
-  auto *       rnc = static_cast<struct RegionAndCallback *>(threadInfo->UserData);
-
-  const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
-  ImageIORegion                   region(rnc->dimension);
-  for (unsigned d = 0; d < rnc->dimension; d++)
-  {
-    region.SetIndex(d, rnc->index[d]);
-    region.SetSize(d, rnc->size[d]);
-  }
-  ThreadIdType total = splitter->GetSplit(threadId, threadCount, region);
+  auto * threadInfo = static_cast<ThreadInfo *>(arg);
+  auto * rnc = static_cast<struct RegionAndCallback *>(threadInfo->UserData);
 
   TotalProgressReporter reporter(rnc->filter, rnc->pixelCount);
 
-  if (threadId < total)
+  for (ThreadIdType i = rnc->nextPiece++; i < rnc->numberOfPieces; i = rnc->nextPiece++)
   {
+    ImageIORegion region(rnc->dimension);
+    for (unsigned d = 0; d < rnc->dimension; d++)
+    {
+      region.SetIndex(d, rnc->index[d]);
+      region.SetSize(d, rnc->size[d]);
+    }
+    rnc->splitter->GetSplit(i, rnc->numberOfPieces, region);
     rnc->functor(&region.GetIndex()[0], &region.GetSize()[0]);
 
     reporter.Completed(region.GetNumberOfPixels());
@@ -592,12 +789,14 @@ MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Number of Work Units: " << m_NumberOfWorkUnits << "\n";
+  os << indent << "Number of Pieces per Work Unit: " << m_NumberOfPiecesPerWorkUnit << "\n";
   os << indent << "Number of Threads: " << m_MaximumNumberOfThreads << "\n";
   os << indent << "Global Maximum Number Of Threads: " << m_PimplGlobals->m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: " << m_PimplGlobals->m_GlobalDefaultNumberOfThreads << std::endl;
   os << indent << "Global Default Threader Type: " << m_PimplGlobals->m_GlobalDefaultThreader << std::endl;
   os << indent << "SingleMethod: " << m_SingleMethod << std::endl;
   os << indent << "SingleData: " << m_SingleData << std::endl;
+  itkPrintSelfObjectMacro(ImageRegionSplitter);
 }
 
 MultiThreaderBaseGlobals * MultiThreaderBase::m_PimplGlobals;
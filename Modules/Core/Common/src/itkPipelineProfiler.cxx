@@ -0,0 +1,415 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineProfiler.h"
+#include "itkImportImageContainerCommon.h"
+#include "itkProcessObject.h"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#if defined(WIN32) || defined(_WIN32)
+#  include <windows.h>
+#  if defined(SUPPORT_PSAPI)
+#    include <psapi.h>
+#  endif
+#else
+#  include <sys/resource.h> // getrusage()
+#endif
+
+namespace itk
+{
+
+namespace
+{
+using Clock = PipelineProfiler::Clock;
+
+// -1 until picked up from the environment
+std::atomic<int> globalProfilingEnabled{ -1 };
+
+std::mutex                           globalProfilingLock;
+std::deque<PipelineProfiler::Record> globalRecords;
+SizeValueType                        globalMaximumNumberOfRecords = 100000;
+SizeValueType                        globalNumberOfDroppedRecords = 0;
+const Clock::time_point              profilingStart = Clock::now();
+std::atomic<unsigned int>            numberOfProfiledThreads{ 0 };
+
+// Drops the oldest records beyond the maximum number of records, with the
+// lock held
+void
+DropOldestRecords()
+{
+  while (globalRecords.size() > globalMaximumNumberOfRecords)
+  {
+    globalRecords.pop_front();
+    ++globalNumberOfDroppedRecords;
+  }
+}
+
+// Writes the Chrome trace at exit, when the environment names a file
+struct TraceFileWriter
+{
+  std::string FileName;
+
+  ~TraceFileWriter()
+  {
+    if (!FileName.empty())
+    {
+      std::ofstream file(FileName.c_str());
+      PipelineProfiler::WriteChromeTrace(file);
+    }
+  }
+};
+TraceFileWriter traceFileWriter;
+
+// The threads are numbered in the order they record something
+unsigned int
+GetThreadIndex()
+{
+  thread_local const unsigned int threadIndex = numberOfProfiledThreads++;
+  return threadIndex;
+}
+
+double
+SecondsSinceStart(Clock::time_point time)
+{
+  return std::chrono::duration<double>(time - profilingStart).count();
+}
+
+// The CPU time of the process in seconds, and its peak resident set size
+void
+GetProcessResources(double & cpuTime, SizeValueType & peakResidentSetSize)
+{
+  cpuTime = 0.0;
+  peakResidentSetSize = 0;
+#if defined(WIN32) || defined(_WIN32)
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+  {
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    // In units of 100 nanoseconds
+    cpuTime = static_cast<double>(kernel.QuadPart + user.QuadPart) * 1e-7;
+  }
+#  if defined(SUPPORT_PSAPI)
+  PROCESS_MEMORY_COUNTERS memoryCounters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+  {
+    peakResidentSetSize = static_cast<SizeValueType>(memoryCounters.PeakWorkingSetSize);
+  }
+#  endif
+#else
+  rusage resourceInfo;
+  if (getrusage(RUSAGE_SELF, &resourceInfo) == 0)
+  {
+    cpuTime = static_cast<double>(resourceInfo.ru_utime.tv_sec + resourceInfo.ru_stime.tv_sec) +
+              static_cast<double>(resourceInfo.ru_utime.tv_usec + resourceInfo.ru_stime.tv_usec) * 1e-6;
+#  if defined(__APPLE__)
+    // In bytes
+    peakResidentSetSize = static_cast<SizeValueType>(resourceInfo.ru_maxrss);
+#  else
+    // In kilobytes
+    peakResidentSetSize = static_cast<SizeValueType>(resourceInfo.ru_maxrss) * 1024;
+#  endif
+  }
+#endif
+}
+
+std::string
+EscapeJSON(const std::string & text)
+{
+  std::ostringstream escaped;
+  for (const char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escaped << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    }
+    else
+    {
+      escaped << c;
+    }
+  }
+  return escaped.str();
+}
+} // namespace
+
+double
+PipelineProfiler::Record::GetImbalance() const
+{
+  double totalTime = 0.0;
+  double maximumTime = 0.0;
+  for (const auto & workUnit : WorkUnits)
+  {
+    totalTime += workUnit.BusyTime;
+    maximumTime = std::max(maximumTime, workUnit.BusyTime);
+  }
+  if (WorkUnits.empty())
+  {
+    return 0.0;
+  }
+  return totalTime > 0.0 ? maximumTime * static_cast<double>(WorkUnits.size()) / totalTime : 1.0;
+}
+
+PipelineProfiler::Execution::Execution(const ProcessObject * filter)
+  : m_Record()
+{
+  m_Record.ClassName = filter->GetNameOfClass();
+  m_Record.ObjectName = filter->GetObjectName();
+  m_Record.Thread = GetThreadIndex();
+  m_Record.NumberOfWorkUnits = filter->GetNumberOfWorkUnits();
+  GetProcessResources(m_StartCPUTime, m_StartPeakResidentSetSize);
+  m_StartAllocatedBytes = ImportImageContainerCommon::GetNumberOfBytesAllocatedByThread();
+  m_Start = Clock::now();
+  m_Record.Start = SecondsSinceStart(m_Start);
+}
+
+void
+PipelineProfiler::Execution::AddPiece(Clock::time_point start, Clock::time_point end)
+{
+  const unsigned int thread = GetThreadIndex();
+  const double       startTime = SecondsSinceStart(start);
+  const double       endTime = SecondsSinceStart(end);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  ++m_Record.NumberOfPieces;
+  for (auto & workUnit : m_Record.WorkUnits)
+  {
+    if (workUnit.Thread == thread)
+    {
+      ++workUnit.NumberOfPieces;
+      workUnit.Start = std::min(workUnit.Start, startTime);
+      workUnit.End = std::max(workUnit.End, endTime);
+      workUnit.BusyTime += endTime - startTime;
+      return;
+    }
+  }
+  m_Record.WorkUnits.push_back({ thread, 1, startTime, endTime, endTime - startTime });
+}
+
+void
+PipelineProfiler::Execution::Finish()
+{
+  const Clock::time_point end = Clock::now();
+  double                  cpuTime;
+  SizeValueType           peakResidentSetSize;
+  GetProcessResources(cpuTime, peakResidentSetSize);
+
+  m_Record.WallTime = std::chrono::duration<double>(end - m_Start).count();
+  m_Record.CPUTime = cpuTime - m_StartCPUTime;
+  m_Record.AllocatedBytes = ImportImageContainerCommon::GetNumberOfBytesAllocatedByThread() - m_StartAllocatedBytes;
+  m_Record.PeakResidentSetSizeIncrease =
+    peakResidentSetSize > m_StartPeakResidentSetSize ? peakResidentSetSize - m_StartPeakResidentSetSize : 0;
+  std::sort(m_Record.WorkUnits.begin(),
+            m_Record.WorkUnits.end(),
+            [](const WorkUnitRecord & a, const WorkUnitRecord & b) { return a.Thread < b.Thread; });
+
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  globalRecords.push_back(std::move(m_Record));
+  DropOldestRecords();
+}
+
+void
+PipelineProfiler::SetEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  globalProfilingEnabled = enabled ? 1 : 0;
+}
+
+bool
+PipelineProfiler::GetEnabled()
+{
+  // Only an atomic load once initialized, as every filter execution checks it
+  const int enabled = globalProfilingEnabled;
+  if (enabled >= 0)
+  {
+    return enabled != 0;
+  }
+
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  if (globalProfilingEnabled < 0)
+  {
+    bool        enabledByEnvironment = false;
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_PIPELINE_PROFILING", envVar))
+    {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      enabledByEnvironment = (envVar == "ON" || envVar == "TRUE" || envVar == "YES" || envVar == "1");
+    }
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_PIPELINE_PROFILING_TRACE_FILE", envVar) && !envVar.empty())
+    {
+      traceFileWriter.FileName = envVar;
+      enabledByEnvironment = true;
+    }
+    globalProfilingEnabled = enabledByEnvironment ? 1 : 0;
+  }
+  return globalProfilingEnabled != 0;
+}
+
+std::vector<PipelineProfiler::Record>
+PipelineProfiler::GetRecords()
+{
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  return std::vector<Record>(globalRecords.begin(), globalRecords.end());
+}
+
+void
+PipelineProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  globalRecords.clear();
+  globalNumberOfDroppedRecords = 0;
+}
+
+void
+PipelineProfiler::SetMaximumNumberOfRecords(SizeValueType maximumNumberOfRecords)
+{
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  globalMaximumNumberOfRecords = maximumNumberOfRecords;
+  DropOldestRecords();
+}
+
+SizeValueType
+PipelineProfiler::GetMaximumNumberOfRecords()
+{
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  return globalMaximumNumberOfRecords;
+}
+
+SizeValueType
+PipelineProfiler::GetNumberOfDroppedRecords()
+{
+  std::lock_guard<std::mutex> lock(globalProfilingLock);
+  return globalNumberOfDroppedRecords;
+}
+
+void
+PipelineProfiler::WriteChromeTrace(std::ostream & os)
+{
+  const std::vector<Record> records = GetRecords();
+
+  // In microseconds, as the trace viewers expect
+  std::ostringstream trace;
+  trace << std::fixed << std::setprecision(3);
+  trace << "{\"traceEvents\":[";
+  bool firstEvent = true;
+  for (const auto & record : records)
+  {
+    const std::string name = EscapeJSON(record.ClassName);
+    trace << (firstEvent ? "\n" : ",\n");
+    firstEvent = false;
+    trace << "{\"name\":\"" << name << "\",\"cat\":\"filter\",\"ph\":\"X\",\"pid\":0,\"tid\":" << record.Thread
+          << ",\"ts\":" << record.Start * 1e6 << ",\"dur\":" << record.WallTime * 1e6 << ",\"args\":{\"object\":\""
+          << EscapeJSON(record.ObjectName) << "\",\"cpu_time_ms\":" << record.CPUTime * 1e3
+          << ",\"allocated_bytes\":" << record.AllocatedBytes
+          << ",\"peak_rss_increase_bytes\":" << record.PeakResidentSetSizeIncrease
+          << ",\"work_units\":" << record.NumberOfWorkUnits << ",\"pieces\":" << record.NumberOfPieces
+          << ",\"threads\":" << record.WorkUnits.size() << ",\"imbalance\":" << record.GetImbalance() << "}}";
+    for (const auto & workUnit : record.WorkUnits)
+    {
+      trace << ",\n{\"name\":\"" << name << " pieces\",\"cat\":\"work unit\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+            << workUnit.Thread << ",\"ts\":" << workUnit.Start * 1e6 << ",\"dur\":"
+            << (workUnit.End - workUnit.Start) * 1e6 << ",\"args\":{\"pieces\":" << workUnit.NumberOfPieces
+            << ",\"busy_time_ms\":" << workUnit.BusyTime * 1e3 << "}}";
+    }
+  }
+  trace << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_records\":" << GetNumberOfDroppedRecords() << "}}"
+        << std::endl;
+  os << trace.str();
+}
+
+void
+PipelineProfiler::WriteSummary(std::ostream & os)
+{
+  struct Totals
+  {
+    SizeValueType NumberOfExecutions;
+    double        WallTime;
+    double        CPUTime;
+    SizeValueType AllocatedBytes;
+    SizeValueType PeakResidentSetSizeIncrease;
+    SizeValueType NumberOfPieces;
+    SizeValueType MaximumNumberOfThreads;
+    double        MaximumImbalance;
+  };
+  std::map<std::string, Totals> totalsPerClass;
+  for (const auto & record : GetRecords())
+  {
+    Totals & totals = totalsPerClass[record.ClassName];
+    ++totals.NumberOfExecutions;
+    totals.WallTime += record.WallTime;
+    totals.CPUTime += record.CPUTime;
+    totals.AllocatedBytes += record.AllocatedBytes;
+    totals.PeakResidentSetSizeIncrease += record.PeakResidentSetSizeIncrease;
+    totals.NumberOfPieces += record.NumberOfPieces;
+    totals.MaximumNumberOfThreads = std::max<SizeValueType>(totals.MaximumNumberOfThreads, record.WorkUnits.size());
+    totals.MaximumImbalance = std::max(totals.MaximumImbalance, record.GetImbalance());
+  }
+
+  using ClassTotals = std::pair<std::string, Totals>;
+  std::vector<ClassTotals> sortedTotals(totalsPerClass.begin(), totalsPerClass.end());
+  std::stable_sort(sortedTotals.begin(), sortedTotals.end(), [](const ClassTotals & a, const ClassTotals & b) {
+    return a.second.WallTime > b.second.WallTime;
+  });
+
+  int nameWidth = 6;
+  for (const auto & classTotals : sortedTotals)
+  {
+    nameWidth = std::max(nameWidth, static_cast<int>(classTotals.first.size()));
+  }
+  nameWidth += 2;
+  constexpr int width = 14;
+  constexpr double megabyte = 1024.0 * 1024.0;
+
+  std::ostringstream summary;
+  summary << std::left << std::setw(nameWidth) << "Filter" << std::right << std::setw(width) << "Executions"
+          << std::setw(width) << "Wall (s)" << std::setw(width) << "CPU (s)" << std::setw(width) << "Alloc (MB)"
+          << std::setw(width) << "Peak RSS (MB)" << std::setw(width) << "Pieces" << std::setw(width) << "Threads"
+          << std::setw(width) << "Imbalance" << std::endl;
+  summary << std::fixed;
+  for (const auto & classTotals : sortedTotals)
+  {
+    const Totals & totals = classTotals.second;
+    summary << std::left << std::setw(nameWidth) << classTotals.first << std::right << std::setw(width)
+            << totals.NumberOfExecutions << std::setprecision(3) << std::setw(width) << totals.WallTime
+            << std::setw(width) << totals.CPUTime << std::setprecision(1) << std::setw(width)
+            << totals.AllocatedBytes / megabyte << std::setw(width) << totals.PeakResidentSetSizeIncrease / megabyte
+            << std::setw(width) << totals.NumberOfPieces << std::setw(width) << totals.MaximumNumberOfThreads
+            << std::setprecision(2) << std::setw(width) << totals.MaximumImbalance << std::endl;
+  }
+  const SizeValueType numberOfDroppedRecords = GetNumberOfDroppedRecords();
+  if (numberOfDroppedRecords > 0)
+  {
+    summary << numberOfDroppedRecords << " older executions were dropped, beyond the maximum of "
+            << GetMaximumNumberOfRecords() << " records" << std::endl;
+  }
+  os << summary.str();
+}
+} // end namespace itk
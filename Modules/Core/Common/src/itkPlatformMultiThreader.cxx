@@ -119,6 +119,22 @@ PlatformMultiThreader::SingleMethodExecute()
   // obey the global maximum number of threads limit
   m_NumberOfWorkUnits = std::min(MultiThreaderBase::GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
 
+  if (MultiThreaderBase::IsInsideWorkUnit())
+  {
+    // Nested call: spawning threads from within a work unit would
+    // oversubscribe the machine, so all the work units run on this thread.
+    for (thread_loop = 0; thread_loop < m_NumberOfWorkUnits; ++thread_loop)
+    {
+      WorkUnitInfo workUnitInfo;
+      workUnitInfo.WorkUnitID = thread_loop;
+      workUnitInfo.NumberOfWorkUnits = m_NumberOfWorkUnits;
+      workUnitInfo.UserData = m_SingleData;
+      workUnitInfo.ThreadFunction = m_SingleMethod;
+      m_SingleMethod(&workUnitInfo);
+    }
+    return;
+  }
+
   // Init process_id table because a valid process_id (i.e., non-zero), is
   // checked in the WaitForSingleMethodThread loops
   for (thread_loop = 1; thread_loop < m_NumberOfWorkUnits; ++thread_loop)
@@ -168,6 +184,7 @@ PlatformMultiThreader::SingleMethodExecute()
   {
     m_ThreadInfoArray[0].UserData = m_SingleData;
     m_ThreadInfoArray[0].NumberOfWorkUnits = m_NumberOfWorkUnits;
+    WorkUnitScope workUnitScope;
     m_SingleMethod((void *)(&m_ThreadInfoArray[0]));
   }
   catch (ProcessAborted &)
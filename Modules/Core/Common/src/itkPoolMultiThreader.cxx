@@ -33,6 +33,7 @@
 #include <exception>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace itk
 {
@@ -74,6 +75,30 @@ public:
 private:
   std::exception_ptr m_FirstCaughtException;
 };
+
+// Waits until the job behind the future has finished. Rather than blocking,
+// the waiting thread executes the queued jobs of the same scope, i.e. the other
+// work units of its own parallel call. This way nested parallel calls made from
+// pool threads cannot occupy all the threads of the pool with waiting, which
+// would deadlock. Unrelated jobs are left to the pool, as they might acquire a
+// lock which the caller holds. The caller must not hold a lock which its own
+// work units acquire.
+template <typename TFuture>
+void
+WaitAndHelp(ThreadPool * threadPool, const void * scope, TFuture & future, ProcessObject * filter)
+{
+  while (future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+  {
+    if (!threadPool->ExecutePendingJob(scope))
+    {
+      future.wait_for(threadCompletionPollingInterval);
+    }
+    if (filter)
+    {
+      filter->IncrementProgress(0);
+    }
+  }
+}
 } // namespace
 
 
@@ -134,20 +159,29 @@ PoolMultiThreader::SingleMethodExecute()
   {
     m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
     m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = m_NumberOfWorkUnits;
-    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddWork(m_SingleMethod, &m_ThreadInfoArray[threadLoop]);
+    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddScopedWork(m_ThreadInfoArray, [this, threadLoop] {
+      WorkUnitScope workUnitScope;
+      return m_SingleMethod(&m_ThreadInfoArray[threadLoop]);
+    });
   }
 
   // Now, the parent thread calls this->SingleMethod() itself
   m_ThreadInfoArray[0].UserData = m_SingleData;
   m_ThreadInfoArray[0].NumberOfWorkUnits = m_NumberOfWorkUnits;
   ExceptionHandler exceptionHandler;
-  exceptionHandler.TryAndCatch([this] { m_SingleMethod(&m_ThreadInfoArray[0]); });
+  exceptionHandler.TryAndCatch([this] {
+    WorkUnitScope workUnitScope;
+    m_SingleMethod(&m_ThreadInfoArray[0]);
+  });
 
   // The parent thread has finished SingleMethod()
   // so now it waits for each of the other work units to finish
   for (threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop)
   {
-    exceptionHandler.TryAndCatch([this, threadLoop] { m_ThreadInfoArray[threadLoop].Future.get(); });
+    exceptionHandler.TryAndCatch([this, threadLoop] {
+      WaitAndHelp(m_ThreadPool.GetPointer(), m_ThreadInfoArray, m_ThreadInfoArray[threadLoop].Future, nullptr);
+      m_ThreadInfoArray[threadLoop].Future.get();
+    });
   }
 
   exceptionHandler.RethrowFirstCaughtException();
@@ -173,6 +207,7 @@ PoolMultiThreader ::ParallelizeArray(SizeValueType             firstIndex,
     }
 
     auto lambda = [aFunc](SizeValueType start, SizeValueType end) {
+      WorkUnitScope workUnitScope;
       for (SizeValueType ii = start; ii < end; ii++)
       {
         aFunc(ii);
@@ -181,10 +216,13 @@ PoolMultiThreader ::ParallelizeArray(SizeValueType             firstIndex,
       return ITK_THREAD_RETURN_DEFAULT_VALUE;
     };
 
-    SizeValueType workUnit = 1;
+    // Local futures, so that concurrent nested calls can share this threader,
+    // and their address identifies the jobs of this call in the pool
+    std::vector<std::future<ITK_THREAD_RETURN_TYPE>> futures(m_NumberOfWorkUnits);
+    SizeValueType                                    workUnit = 1;
     for (SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize)
     {
-      m_ThreadInfoArray[workUnit++].Future = m_ThreadPool->AddWork(lambda, i, std::min(i + chunkSize, lastIndexPlus1));
+      futures[workUnit++] = m_ThreadPool->AddScopedWork(&futures, lambda, i, std::min(i + chunkSize, lastIndexPlus1));
     }
     itkAssertOrThrowMacro(workUnit <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
 
@@ -200,16 +238,8 @@ PoolMultiThreader ::ParallelizeArray(SizeValueType             firstIndex,
     // now wait for the other computations to finish
     for (SizeValueType i = 1; i < workUnit; i++)
     {
-      exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-        std::future_status status;
-        do
-        {
-          status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-          if (filter)
-          {
-            filter->IncrementProgress(0);
-          }
-        } while (status != std::future_status::ready);
+      exceptionHandler.TryAndCatch([this, i, &futures, &reporter, &filter] {
+        WaitAndHelp(m_ThreadPool.GetPointer(), &futures, futures[i], filter);
         reporter.CompletedPixel();
       });
     }
@@ -238,6 +268,7 @@ PoolMultiThreader ::ParallelizeImageRegion(unsigned int         dimension,
   if (m_NumberOfWorkUnits == 1) // no multi-threading wanted
   {
     ProgressReporter reporter(filter, 0, 1);
+    WorkUnitScope    workUnitScope;
     funcP(index, size); // process whole region
     reporter.CompletedPixel();
   }
@@ -251,57 +282,79 @@ PoolMultiThreader ::ParallelizeImageRegion(unsigned int         dimension,
     }
     if (region.GetNumberOfPixels() <= 1)
     {
+      WorkUnitScope workUnitScope;
       funcP(index, size); // process whole region
     }
     else
     {
-      const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
-      ThreadIdType                    splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
-      ProgressReporter                reporter(filter, 0, splitCount);
-      itkAssertOrThrowMacro(splitCount <= m_NumberOfWorkUnits, "Split count is greater than number of work units!");
-      ImageIORegion iRegion;
-      ThreadIdType  total;
-      for (ThreadIdType i = 1; i < splitCount; i++)
-      {
-        iRegion = region;
-        total = splitter->GetSplit(i, splitCount, iRegion);
-        if (i < total)
-        {
-          m_ThreadInfoArray[i].Future = m_ThreadPool->AddWork([funcP, iRegion]() {
+      // Each thread first claims its own block of pieces, so that a piece is
+      // processed by the same thread in every call. The work units then take
+      // the unclaimed pieces from a queue, so that the work units finishing
+      // early process the remaining pieces
+      const ImageRegionSplitterBase * splitter = this->GetImageRegionSplitter();
+      const ThreadIdType              numberOfPieces = this->ComputeNumberOfPieces(splitter, region);
+      const ThreadIdType              numberOfWorkUnits = std::min(numberOfPieces, m_NumberOfWorkUnits);
+      const SizeValueType             numberOfBlocks = m_ThreadPool->GetMaximumNumberOfThreads() + 1;
+      ProgressReporter                reporter(filter, 0, numberOfWorkUnits);
+      std::vector<std::atomic<bool>>  claimed(numberOfPieces);
+      std::atomic<ThreadIdType>       nextPiece(0);
+      auto processPieces = [this, &funcP, splitter, &region, numberOfPieces, numberOfBlocks, &claimed, &nextPiece]() {
+        WorkUnitScope       workUnitScope;
+        const SizeValueType block = m_ThreadPool->GetIndexOfCurrentThread() % numberOfBlocks;
+        const auto          blockBegin = static_cast<ThreadIdType>(block * numberOfPieces / numberOfBlocks);
+        const auto          blockEnd = static_cast<ThreadIdType>((block + 1) * numberOfPieces / numberOfBlocks);
+        auto                processPiece = [&](ThreadIdType i) {
+          if (claimed[i].exchange(true))
+          {
+            return;
+          }
+          ImageIORegion iRegion = region;
+          splitter->GetSplit(i, numberOfPieces, iRegion);
+          try
+          {
             funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
-            // make this lambda have the same signature as m_SingleMethod
-            return ITK_THREAD_RETURN_DEFAULT_VALUE;
-          });
+          }
+          catch (...)
+          {
+            // Leave the remaining pieces, the exception being rethrown anyway
+            nextPiece = numberOfPieces;
+            throw;
+          }
+        };
+        for (ThreadIdType i = blockBegin; i < blockEnd && nextPiece < numberOfPieces; ++i)
+        {
+          processPiece(i);
         }
-        else
+        for (ThreadIdType i = nextPiece++; i < numberOfPieces; i = nextPiece++)
         {
-          itkExceptionMacro("Could not get work unit "
-                            << i << " even though we checked possible number of splits beforehand!");
+          processPiece(i);
         }
+      };
+
+      // Local futures, so that concurrent nested calls can share this threader,
+      // and their address identifies the jobs of this call in the pool
+      std::vector<std::future<ITK_THREAD_RETURN_TYPE>> futures(numberOfWorkUnits);
+      for (ThreadIdType i = 1; i < numberOfWorkUnits; i++)
+      {
+        futures[i] = m_ThreadPool->AddScopedWork(&futures, [&processPieces]() {
+          processPieces();
+          // make this lambda have the same signature as m_SingleMethod
+          return ITK_THREAD_RETURN_DEFAULT_VALUE;
+        });
       }
-      iRegion = region;
-      total = splitter->GetSplit(0, splitCount, iRegion);
 
       // execute this thread's share
       ExceptionHandler exceptionHandler;
-      exceptionHandler.TryAndCatch([funcP, iRegion, &reporter] {
-        funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
+      exceptionHandler.TryAndCatch([&processPieces, &reporter] {
+        processPieces();
         reporter.CompletedPixel();
       });
 
       // now wait for the other computations to finish
-      for (ThreadIdType i = 1; i < splitCount; i++)
+      for (ThreadIdType i = 1; i < numberOfWorkUnits; i++)
       {
-        exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-          std::future_status status;
-          do
-          {
-            status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-            if (filter)
-            {
-              filter->IncrementProgress(0);
-            }
-          } while (status != std::future_status::ready);
+        exceptionHandler.TryAndCatch([this, i, &futures, &reporter, &filter] {
+          WaitAndHelp(m_ThreadPool.GetPointer(), &futures, futures[i], filter);
           reporter.CompletedPixel();
         });
       }
@@ -31,7 +31,10 @@
 #include <cstdio>
 #include <sstream>
 #include <algorithm>
+#include "itkImageBufferAllocatorRecycling.h"
+#include "itkImportImageContainerCommon.h"
 #include "itkMultiThreaderBase.h"
+#include "itksys/SystemTools.hxx"
 
 namespace itk
 {
@@ -45,8 +48,30 @@ constexpr char   globalIndexNames[ITK_GLOBAL_INDEX_NAMES_NUMBER][ITK_GLOBAL_INDE
   "_0", "_1", "_2", "_3", "_4", "_5", "_6", "_7", "_8", "_9"
 };
 
+std::mutex globalPipelineMemoryPlanningLock;
+bool       globalPipelineMemoryPlanningIsInitialized = false;
+bool       globalPipelineMemoryPlanning = false;
+
 } // namespace
 
+struct ProcessObject::PipelineMemoryPlan
+{
+  /** The filters of the update. */
+  std::vector<ProcessObject *> m_Filters;
+
+  /** The number of filters of the update which consume each intermediate
+   * output, and the number of those which have not executed yet. */
+  std::map<const DataObject *, unsigned int> m_NumberOfConsumers;
+  std::map<const DataObject *, unsigned int> m_NumberOfPendingConsumers;
+
+  /** The allocator of the outputs, which recycles the buffers released
+   * during the update. */
+  ImageBufferAllocatorRecycling::Pointer m_Allocator;
+
+  /** The functions which undo the changes made for the plan. */
+  std::vector<std::function<void()>> m_Cleanups;
+};
+
 
 ProcessObject ::ProcessObject()
   : m_Inputs()
@@ -1157,15 +1182,16 @@ ProcessObject::IncrementProgress(float increment)
   // Clamp the value to be between 0 and 1.
   uint32_t integerIncrement = progressFloatToFixed(increment);
 
+  // Saturate instead of overflowing, when the rounded increments sum up to
+  // more than 1
   uint32_t oldProgress = m_Progress;
-
-  uint32_t updatedProgress = m_Progress.fetch_add(integerIncrement);
-
-  // check if progress overflowed
-  if (oldProgress > updatedProgress)
+  uint32_t updatedProgress;
+  do
   {
-    m_Progress = std::numeric_limits<uint32_t>::max();
-  }
+    updatedProgress = integerIncrement > std::numeric_limits<uint32_t>::max() - oldProgress
+                        ? std::numeric_limits<uint32_t>::max()
+                        : oldProgress + integerIncrement;
+  } while (!m_Progress.compare_exchange_weak(oldProgress, updatedProgress));
 
   if (std::this_thread::get_id() == this->m_UpdateThreadID)
   {
@@ -1271,6 +1297,7 @@ ProcessObject ::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Number Of Work Units: " << m_NumberOfWorkUnits << std::endl;
   os << indent << "ReleaseDataFlag: " << (this->GetReleaseDataFlag() ? "On" : "Off") << std::endl;
   os << indent << "ReleaseDataBeforeUpdateFlag: " << (m_ReleaseDataBeforeUpdateFlag ? "On" : "Off") << std::endl;
+  os << indent << "PipelineMemoryPlanning: " << (m_PipelineMemoryPlanning ? "On" : "Off") << std::endl;
   os << indent << "AbortGenerateData: " << (m_AbortGenerateData ? "On" : "Off") << std::endl;
   os << indent << "Progress: " << progressFixedToFloat(m_Progress) << std::endl;
   os << indent << "Multithreader: " << std::endl;
@@ -1637,7 +1664,7 @@ ProcessObject ::ReleaseInputs()
 
 
 void
-ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
+ProcessObject ::UpdateOutputData(DataObject * output)
 {
   /**
    * prevent chasing our tail
@@ -1647,6 +1674,26 @@ ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
     return;
   }
 
+  /**
+   * Plan the memory of the pipeline, unless this filter is already part of
+   * the plan of a downstream filter
+   */
+  if (m_PipelineMemoryPlan == nullptr && (m_PipelineMemoryPlanning || Self::GetGlobalPipelineMemoryPlanning()))
+  {
+    const PipelineMemoryPlanPointer plan = this->PlanPipelineMemory();
+    try
+    {
+      this->ProcessObject::UpdateOutputData(output);
+    }
+    catch (...)
+    {
+      Self::EndPipelineMemoryPlan(*plan);
+      throw;
+    }
+    Self::EndPipelineMemoryPlan(*plan);
+    return;
+  }
+
 
   /**
    * Prepare all the outputs. This may deallocate previous bulk data.
@@ -1703,12 +1750,23 @@ ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
   m_AbortGenerateData = false;
   m_Progress = 0u;
 
+  /**
+   * Record the execution when profiling
+   */
+  std::unique_ptr<PipelineProfiler::Execution> profiledExecution;
+  if (PipelineProfiler::GetEnabled())
+  {
+    profiledExecution.reset(new PipelineProfiler::Execution(this));
+    m_ProfiledExecution = profiledExecution.get();
+  }
+
   try
   {
     this->GenerateData();
   }
   catch (ProcessAborted &)
   {
+    m_ProfiledExecution = nullptr;
     this->InvokeEvent(AbortEvent());
     this->ResetPipeline();
     this->RestoreInputReleaseDataFlags();
@@ -1716,11 +1774,18 @@ ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
   }
   catch (...)
   {
+    m_ProfiledExecution = nullptr;
     this->ResetPipeline();
     this->RestoreInputReleaseDataFlags();
     throw;
   }
 
+  if (profiledExecution)
+  {
+    m_ProfiledExecution = nullptr;
+    profiledExecution->Finish();
+  }
+
   /**
    * If we ended due to aborting, push the progress up to 1.0 (since
    * it probably didn't end there)
@@ -1739,11 +1804,11 @@ ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
   /**
    * Now we have to mark the data as up to date.
    */
-  for (auto & output : m_Outputs)
+  for (auto & namedOutput : m_Outputs)
   {
-    if (output.second)
+    if (namedOutput.second)
     {
-      output.second->DataHasBeenGenerated();
+      namedOutput.second->DataHasBeenGenerated();
     }
   }
 
@@ -1757,11 +1822,195 @@ ProcessObject ::UpdateOutputData(DataObject * itkNotUsed(output))
    */
   this->ReleaseInputs();
 
+  /**
+   * Release the inputs that no other filter of a planned update consumes
+   */
+  if (m_PipelineMemoryPlan != nullptr)
+  {
+    this->ReleasePlannedInputs();
+  }
+
   // Mark that we are no longer updating the data in this filter
   m_Updating = false;
 }
 
 
+void
+ProcessObject::SetGlobalPipelineMemoryPlanning(bool planning)
+{
+  std::lock_guard<std::mutex> lock(globalPipelineMemoryPlanningLock);
+  globalPipelineMemoryPlanning = planning;
+  globalPipelineMemoryPlanningIsInitialized = true;
+}
+
+
+bool
+ProcessObject::GetGlobalPipelineMemoryPlanning()
+{
+  std::lock_guard<std::mutex> lock(globalPipelineMemoryPlanningLock);
+  if (!globalPipelineMemoryPlanningIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_PIPELINE_MEMORY_PLANNING", envVar))
+    {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      globalPipelineMemoryPlanning = (envVar == "ON" || envVar == "TRUE" || envVar == "YES" || envVar == "1");
+    }
+    globalPipelineMemoryPlanningIsInitialized = true;
+  }
+  return globalPipelineMemoryPlanning;
+}
+
+
+ProcessObject::PipelineMemoryPlanPointer
+ProcessObject::PlanPipelineMemory()
+{
+  const auto plan = std::make_shared<PipelineMemoryPlan>();
+  m_PipelineMemoryPlan = plan;
+  plan->m_Filters.push_back(this);
+
+  // Walk up the pipeline, counting the consumers of each output
+  std::vector<ProcessObject *> filtersToVisit(1, this);
+  while (!filtersToVisit.empty())
+  {
+    ProcessObject * const filter = filtersToVisit.back();
+    filtersToVisit.pop_back();
+
+    std::set<DataObject *> inputs;
+    for (const auto & input : filter->m_Inputs)
+    {
+      if (input.second)
+      {
+        inputs.insert(input.second.GetPointer());
+      }
+    }
+    for (DataObject * input : inputs)
+    {
+      // Data without a source could not be regenerated. A filter which is
+      // executing, or belongs to another plan, is not part of this update.
+      ProcessObject * const source = input->GetSource();
+      if (source == nullptr || source->m_Updating ||
+          (source->m_PipelineMemoryPlan != nullptr && source->m_PipelineMemoryPlan != plan))
+      {
+        continue;
+      }
+      ++plan->m_NumberOfConsumers[input];
+      if (source->m_PipelineMemoryPlan == nullptr)
+      {
+        source->m_PipelineMemoryPlan = plan;
+        plan->m_Filters.push_back(source);
+        filtersToVisit.push_back(source);
+      }
+    }
+  }
+  plan->m_NumberOfPendingConsumers = plan->m_NumberOfConsumers;
+
+  // The buffers released during the update are handed to the following
+  // allocations, and never kept longer than the previous buffers were, so
+  // that buffers of any size may be kept
+  plan->m_Allocator = ImageBufferAllocatorRecycling::New();
+  plan->m_Allocator->SetMaximumCachedBytes(NumericTraits<SizeValueType>::max());
+  const ImageBufferAllocatorBase::Pointer allocator = ImportImageContainerCommon::GetGlobalDefaultAllocator();
+  if (allocator.IsNotNull())
+  {
+    plan->m_Allocator->SetAllocator(allocator);
+  }
+  plan->m_Allocator->ReleaseCacheOnMissOn();
+  return plan;
+}
+
+
+void
+ProcessObject::EndPipelineMemoryPlan(PipelineMemoryPlan & plan)
+{
+  for (ProcessObject * filter : plan.m_Filters)
+  {
+    filter->m_PipelineMemoryPlan = nullptr;
+  }
+  plan.m_Filters.clear();
+
+  for (const auto & cleanup : plan.m_Cleanups)
+  {
+    cleanup();
+  }
+  plan.m_Cleanups.clear();
+
+  // The buffers of the outputs are freed when they are released later
+  plan.m_Allocator->SetMaximumCachedBytes(0);
+  plan.m_Allocator->ReleaseCachedBuffers();
+}
+
+
+void
+ProcessObject::ReleasePlannedInputs()
+{
+  PipelineMemoryPlan & plan = *m_PipelineMemoryPlan;
+
+  // The outputs which were just generated wait for all their consumers again
+  for (const auto & output : m_Outputs)
+  {
+    const auto consumers = plan.m_NumberOfConsumers.find(output.second.GetPointer());
+    if (consumers != plan.m_NumberOfConsumers.end())
+    {
+      plan.m_NumberOfPendingConsumers[consumers->first] = consumers->second;
+    }
+  }
+
+  std::set<DataObject *> inputs;
+  for (const auto & input : m_Inputs)
+  {
+    if (input.second)
+    {
+      inputs.insert(input.second.GetPointer());
+    }
+  }
+  for (DataObject * input : inputs)
+  {
+    const auto pending = plan.m_NumberOfPendingConsumers.find(input);
+    if (pending != plan.m_NumberOfPendingConsumers.end() && pending->second > 0 && --pending->second == 0)
+    {
+      input->ReleaseData();
+    }
+  }
+}
+
+
+bool
+ProcessObject::IsPlannedInput(const DataObject * input) const
+{
+  return m_PipelineMemoryPlan != nullptr && m_PipelineMemoryPlan->m_NumberOfConsumers.count(input) > 0;
+}
+
+
+bool
+ProcessObject::IsPlannedInputReleasedAfterExecution(const DataObject * input) const
+{
+  if (m_PipelineMemoryPlan == nullptr)
+  {
+    return false;
+  }
+  const auto pending = m_PipelineMemoryPlan->m_NumberOfPendingConsumers.find(input);
+  return pending != m_PipelineMemoryPlan->m_NumberOfPendingConsumers.end() && pending->second == 1;
+}
+
+
+ImageBufferAllocatorBase *
+ProcessObject::GetPipelineMemoryPlanAllocator() const
+{
+  return m_PipelineMemoryPlan != nullptr ? m_PipelineMemoryPlan->m_Allocator.GetPointer() : nullptr;
+}
+
+
+void
+ProcessObject::AddPipelineMemoryPlanCleanup(std::function<void()> cleanup)
+{
+  if (m_PipelineMemoryPlan != nullptr)
+  {
+    m_PipelineMemoryPlan->m_Cleanups.push_back(std::move(cleanup));
+  }
+}
+
+
 void
 ProcessObject ::CacheInputReleaseDataFlags()
 {
@@ -24,6 +24,8 @@
 #include <atomic>
 #include <thread>
 #include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_scheduler_observer.h"
 
 #include "tbb/global_control.h"
 // From tbb/examples/common/utility/get_default_num_threads.h
@@ -44,8 +46,35 @@ get_default_num_threads()
 namespace itk
 {
 
+namespace
+{
+// Pins the TBB worker threads to processors as they join the scheduler.
+// The application thread is left alone.
+class ThreadAffinityObserver : public tbb::task_scheduler_observer
+{
+public:
+  ThreadAffinityObserver() { this->observe(true); }
+  ~ThreadAffinityObserver() override { this->observe(false); }
+
+  void
+  on_scheduler_entry(bool isWorker) override
+  {
+    const int slot = tbb::this_task_arena::current_thread_index();
+    if (isWorker && slot > 0)
+    {
+      MultiThreaderBase::SetCurrentThreadAffinity(static_cast<ThreadIdType>(slot));
+    }
+  }
+};
+} // namespace
+
 TBBMultiThreader::TBBMultiThreader()
 {
+  if (MultiThreaderBase::GetGlobalDefaultThreadAffinity())
+  {
+    static ThreadAffinityObserver threadAffinityObserver;
+  }
+
   ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
 #if defined(ITKV4_COMPATIBILITY)
   m_NumberOfWorkUnits = defaultThreads;
@@ -100,6 +129,7 @@ TBBMultiThreader::SingleMethodExecute()
       ti.WorkUnitID = r.begin();
       ti.UserData = m_SingleData;
       ti.NumberOfWorkUnits = m_NumberOfWorkUnits;
+      WorkUnitScope workUnitScope;
       m_SingleMethod(&ti); // TBB takes care of properly propagating exceptions
     },
     tbb::simple_partitioner());
@@ -146,6 +176,7 @@ TBBMultiThreader ::ParallelizeArray(SizeValueType             firstIndex,
         TotalProgressReporter progress(filter, count, 100);
         progress.CheckAbortGenerateData();
 
+        WorkUnitScope workUnitScope;
         aFunc(r.begin()); // invoke the function
 
         progress.CompletedPixel();
@@ -254,6 +285,7 @@ TBBMultiThreader ::ParallelizeImageRegion(unsigned int         dimension,
 
   if (m_NumberOfWorkUnits == 1)
   {
+    WorkUnitScope workUnitScope;
     funcP(index, size);
   }
   else
@@ -264,17 +296,36 @@ TBBMultiThreader ::ParallelizeImageRegion(unsigned int         dimension,
       region.SetIndex(d, index[d]);
       region.SetSize(d, size[d]);
     }
-    TBBImageRegionSplitter regionSplitter = region;
-
     const SizeValueType totalCount = region.GetNumberOfPixels();
     tbb::global_control l_ParallelizeImageRegion_tbb_global_context(
       tbb::global_control::max_allowed_parallelism,
       std::min<int>(tbb_utility::get_default_num_threads(), m_MaximumNumberOfThreads));
 
+    if (m_ImageRegionSplitter)
+    {
+      // The pieces of the splitter set, balanced by TBB work stealing
+      const ImageRegionSplitterBase * splitter = m_ImageRegionSplitter;
+      const ThreadIdType              numberOfPieces = this->ComputeNumberOfPieces(splitter, region);
+      tbb::parallel_for(ThreadIdType{ 0 }, numberOfPieces, [&](ThreadIdType i) {
+        TotalProgressReporter progress(filter, totalCount, 100);
+        progress.CheckAbortGenerateData();
+
+        ImageIORegion regionToProcess = region;
+        splitter->GetSplit(i, numberOfPieces, regionToProcess);
+        WorkUnitScope workUnitScope;
+        funcP(&regionToProcess.GetIndex()[0], &regionToProcess.GetSize()[0]);
+
+        progress.Completed(regionToProcess.GetNumberOfPixels());
+      });
+      return;
+    }
+
+    TBBImageRegionSplitter regionSplitter = region;
     tbb::parallel_for(regionSplitter, [&](TBBImageRegionSplitter regionToProcess) {
       TotalProgressReporter progress(filter, totalCount, 100);
       progress.CheckAbortGenerateData();
 
+      WorkUnitScope workUnitScope;
       funcP(&regionToProcess.GetIndex()[0], &regionToProcess.GetSize()[0]);
 
       progress.Completed(regionToProcess.GetNumberOfPixels());
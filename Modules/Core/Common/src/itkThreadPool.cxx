@@ -30,6 +30,13 @@
 namespace itk
 {
 
+namespace
+{
+// The pool worker running on the current thread, if any.
+thread_local const ThreadPool * currentThreadPool = nullptr;
+thread_local ThreadIdType       currentWorkerIndex = 0;
+} // namespace
+
 struct ThreadPoolGlobals
 {
   ThreadPoolGlobals() = default;
@@ -97,14 +104,17 @@ ThreadPool ::SetDoNotWaitForThreads(bool doNotWaitForThreads)
 }
 
 ThreadPool ::ThreadPool()
+  : m_WorkQueues(new WorkerQueue[ITK_MAX_THREADS])
 {
   m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
   m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
   ThreadIdType threadCount = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  m_ThreadAffinity = MultiThreaderBase::GetGlobalDefaultThreadAffinity();
+  m_NumberOfWorkQueues = std::min<ThreadIdType>(ITK_MAX_THREADS, threadCount);
   m_Threads.reserve(threadCount);
-  for (unsigned int i = 0; i < threadCount; ++i)
+  for (ThreadIdType i = 0; i < threadCount; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, i);
   }
 }
 
@@ -112,10 +122,12 @@ void
 ThreadPool ::AddThreads(ThreadIdType count)
 {
   std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
+  const auto firstIndex = static_cast<ThreadIdType>(m_Threads.size());
+  m_NumberOfWorkQueues = std::min<ThreadIdType>(ITK_MAX_THREADS, firstIndex + count);
   m_Threads.reserve(m_Threads.size() + count);
-  for (unsigned int i = 0; i < count; ++i)
+  for (ThreadIdType i = 0; i < count; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, firstIndex + i);
   }
 }
 
@@ -125,11 +137,132 @@ ThreadPool ::GetMutex()
   return m_PimplGlobals->m_Mutex;
 }
 
+ThreadIdType
+ThreadPool ::GetIndexOfCurrentThread() const
+{
+  return currentThreadPool == this ? currentWorkerIndex + 1 : 0;
+}
+
 int
 ThreadPool ::GetNumberOfCurrentlyIdleThreads() const
 {
   std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
-  return int(m_Threads.size()) - int(m_WorkQueue.size()); // lousy approximation
+  return int(m_Threads.size()) - int(m_NumberOfPendingJobs); // lousy approximation
+}
+
+void
+ThreadPool ::SubmitWork(std::function<void()> && work, const void * scope)
+{
+  // Workers push onto their own queue, everybody else spreads the jobs.
+  ThreadIdType queueIndex;
+  if (currentThreadPool == this)
+  {
+    queueIndex = currentWorkerIndex % ITK_MAX_THREADS;
+  }
+  else
+  {
+    queueIndex = m_NextWorkQueue++ % m_NumberOfWorkQueues;
+  }
+
+  WorkerQueue & queue = m_WorkQueues[queueIndex];
+  {
+    // Counted before it can be taken, so that the count never wraps around
+    std::unique_lock<std::mutex> queueHolder(queue.m_Mutex);
+    ++m_NumberOfPendingJobs;
+    queue.m_Jobs.push_back(WorkerQueue::Job{ std::move(work), scope });
+  }
+
+  // A worker increments m_NumberOfSleepingThreads while holding the global
+  // mutex, before it checks m_NumberOfPendingJobs and goes to sleep. Taking the
+  // mutex here guarantees that such a worker is already waiting on m_Condition.
+  if (m_NumberOfSleepingThreads > 0)
+  {
+    {
+      std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+bool
+ThreadPool ::ExecutePendingJob(const void * scope)
+{
+  std::function<void()> job;
+  if (!this->TryGetScopedWork(currentThreadPool == this ? currentWorkerIndex : 0, scope, job))
+  {
+    return false;
+  }
+  job();
+  return true;
+}
+
+bool
+ThreadPool ::TryGetWork(ThreadIdType workerIndex, std::function<void()> & work)
+{
+  if (m_NumberOfPendingJobs == 0)
+  {
+    return false;
+  }
+
+  // Newest job from our own queue first, as its data is most likely cached.
+  const ThreadIdType ownIndex = workerIndex % ITK_MAX_THREADS;
+  {
+    WorkerQueue &                queue = m_WorkQueues[ownIndex];
+    std::unique_lock<std::mutex> queueHolder(queue.m_Mutex);
+    if (!queue.m_Jobs.empty())
+    {
+      work = std::move(queue.m_Jobs.back().m_Function);
+      queue.m_Jobs.pop_back();
+      --m_NumberOfPendingJobs;
+      return true;
+    }
+  }
+
+  // Then steal the oldest job from somebody else.
+  const ThreadIdType queueCount = m_NumberOfWorkQueues;
+  for (ThreadIdType i = 1; i < queueCount; ++i)
+  {
+    WorkerQueue &                queue = m_WorkQueues[(ownIndex + i) % queueCount];
+    std::unique_lock<std::mutex> queueHolder(queue.m_Mutex);
+    if (!queue.m_Jobs.empty())
+    {
+      work = std::move(queue.m_Jobs.front().m_Function);
+      queue.m_Jobs.pop_front();
+      --m_NumberOfPendingJobs;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+ThreadPool ::TryGetScopedWork(ThreadIdType workerIndex, const void * scope, std::function<void()> & work)
+{
+  if (m_NumberOfPendingJobs == 0)
+  {
+    return false;
+  }
+
+  // Jobs submitted by a worker are in its own queue, the others are spread
+  // over all the queues. Other workers may have stolen some of them already.
+  const ThreadIdType ownIndex = workerIndex % ITK_MAX_THREADS;
+  const ThreadIdType queueCount = std::max<ThreadIdType>(m_NumberOfWorkQueues, ownIndex + 1);
+  for (ThreadIdType i = 0; i < queueCount; ++i)
+  {
+    WorkerQueue &                queue = m_WorkQueues[(ownIndex + i) % queueCount];
+    std::unique_lock<std::mutex> queueHolder(queue.m_Mutex);
+    for (auto it = queue.m_Jobs.begin(); it != queue.m_Jobs.end(); ++it)
+    {
+      if (it->m_Scope == scope)
+      {
+        work = std::move(it->m_Function);
+        queue.m_Jobs.erase(it);
+        --m_NumberOfPendingJobs;
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 ThreadPool ::~ThreadPool()
@@ -156,25 +289,33 @@ ThreadPool ::~ThreadPool()
 
 
 void
-ThreadPool ::ThreadExecute()
+ThreadPool ::ThreadExecute(ThreadIdType workerIndex)
 {
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  currentThreadPool = threadPool;
+  currentWorkerIndex = workerIndex;
+  if (threadPool->m_ThreadAffinity)
+  {
+    MultiThreaderBase::SetCurrentThreadAffinity(workerIndex);
+  }
 
   while (true)
   {
     std::function<void()> task;
 
+    if (!threadPool->TryGetWork(workerIndex, task))
     {
       std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
-      threadPool->m_Condition.wait(mutexHolder,
-                                   [threadPool] { return threadPool->m_Stopping || !threadPool->m_WorkQueue.empty(); });
-      if (threadPool->m_Stopping && threadPool->m_WorkQueue.empty())
+      ++threadPool->m_NumberOfSleepingThreads;
+      threadPool->m_Condition.wait(
+        mutexHolder, [threadPool] { return threadPool->m_Stopping || threadPool->m_NumberOfPendingJobs > 0; });
+      --threadPool->m_NumberOfSleepingThreads;
+      if (threadPool->m_Stopping && threadPool->m_NumberOfPendingJobs == 0)
       {
         return;
       }
-      task = std::move(threadPool->m_WorkQueue.front());
-      threadPool->m_WorkQueue.pop_front();
+      continue; // another worker might have taken the job already
     }
 
     task(); // execute the task
@@ -19,6 +19,59 @@
 #include <iostream>
 #include "itkByteSwapper.h"
 #include "itkMath.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Swaps a range spanning several of the chunks swapped in parallel, to the
+// other byte order and back
+template <typename T>
+bool
+SwapRangeTest()
+{
+  std::vector<T> values(1000003);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<T>(i * 2654435761u);
+  }
+  std::vector<T> swapped = values;
+  if (itk::ByteSwapper<T>::SystemIsBigEndian())
+  {
+    itk::ByteSwapper<T>::SwapRangeFromSystemToLittleEndian(swapped.data(), swapped.size());
+  }
+  else
+  {
+    itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(swapped.data(), swapped.size());
+  }
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    T      expected = values[i];
+    auto * bytes = reinterpret_cast<unsigned char *>(&expected);
+    std::reverse(bytes, bytes + sizeof(T));
+    if (swapped[i] != expected)
+    {
+      std::cout << "Swapped range of " << sizeof(T) << " byte words differs at " << i << std::endl;
+      return false;
+    }
+  }
+  if (itk::ByteSwapper<T>::SystemIsBigEndian())
+  {
+    itk::ByteSwapper<T>::SwapRangeFromSystemToLittleEndian(swapped.data(), swapped.size());
+  }
+  else
+  {
+    itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(swapped.data(), swapped.size());
+  }
+  if (swapped != values)
+  {
+    std::cout << "Range of " << sizeof(T) << " byte words swapped twice differs" << std::endl;
+    return false;
+  }
+  std::cout << "Passed range of " << sizeof(T) << " byte words" << std::endl;
+  return true;
+}
+} // namespace
 
 int
 itkByteSwapTest(int, char *[])
@@ -194,6 +247,11 @@ itkByteSwapTest(int, char *[])
     (&err)->Print(std::cerr);
     return EXIT_FAILURE;
   }
+  if (!SwapRangeTest<unsigned short>() || !SwapRangeTest<unsigned int>() || !SwapRangeTest<unsigned long long>())
+  {
+    return EXIT_FAILURE;
+  }
+
   // we failed to throw an exception for the double swap (once it's implemented, this should return 0
   return EXIT_SUCCESS;
 }
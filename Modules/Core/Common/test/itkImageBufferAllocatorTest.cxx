@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImportImageContainer.h"
+#include "itkImageBufferAllocatorAligned.h"
+#include "itkImageBufferAllocatorHugePage.h"
+#include "itkImageBufferAllocatorRecycling.h"
+#include "itkImage.h"
+#include "itkTestingMacros.h"
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+// Counts the calls of AllocateElements, which allocates with array new
+// itself, or through the superclass
+class CountingImportImageContainer : public itk::ImportImageContainer<itk::SizeValueType, float>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingImportImageContainer);
+
+  using Self = CountingImportImageContainer;
+  using Superclass = itk::ImportImageContainer<itk::SizeValueType, float>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  mutable unsigned int m_NumberOfAllocations{ 0 };
+  bool                 m_UseSuperclass{ false };
+
+protected:
+  CountingImportImageContainer() = default;
+
+  float *
+  AllocateElements(ElementIdentifier size, bool UseDefaultConstructor) const override
+  {
+    ++m_NumberOfAllocations;
+    if (m_UseSuperclass)
+    {
+      return Superclass::AllocateElements(size, UseDefaultConstructor);
+    }
+    return new float[size]();
+  }
+};
+} // namespace
+
+int
+itkImageBufferAllocatorTest(int argc, char * argv[])
+{
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, float>;
+
+  // Aligned allocation
+  auto aligned = itk::ImageBufferAllocatorAligned::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(aligned, ImageBufferAllocatorAligned, ImageBufferAllocatorBase);
+  aligned->SetAlignment(128);
+  ITK_TEST_SET_GET_VALUE(128, aligned->GetAlignment());
+
+  auto container = ContainerType::New();
+  container->SetAllocator(aligned);
+  ITK_TEST_SET_GET_VALUE(aligned.GetPointer(), container->GetAllocator());
+  container->Reserve(1001, true);
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast<std::uintptr_t>(container->GetBufferPointer()) % 128, 0);
+  for (itk::SizeValueType i = 0; i < 1001; ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL((*container)[i], 0.0f);
+  }
+  container->Squeeze();
+  container->Initialize();
+
+  aligned->SetAlignment(3);
+  ITK_TRY_EXPECT_EXCEPTION(aligned->Allocate(16));
+
+  // Huge page allocation
+  auto hugePage = itk::ImageBufferAllocatorHugePage::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(hugePage, ImageBufferAllocatorHugePage, ImageBufferAllocatorAligned);
+  const itk::SizeValueType hugePageSize = hugePage->GetHugePageSize();
+  container->SetAllocator(hugePage);
+  container->Reserve(hugePageSize, true);
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast<std::uintptr_t>(container->GetBufferPointer()) % hugePageSize, 0);
+  container->Initialize();
+
+  // Recycling allocation: a buffer released by one container is handed to the next
+  auto recycling = itk::ImageBufferAllocatorRecycling::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(recycling, ImageBufferAllocatorRecycling, ImageBufferAllocatorBase);
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 0);
+  // The default limit, which may be set by the environment
+  const itk::SizeValueType defaultMaximumCachedBytes =
+    argc > 1 ? std::stoull(argv[1]) : itk::SizeValueType{ 256 } * 1024 * 1024;
+  ITK_TEST_EXPECT_EQUAL(recycling->GetMaximumCachedBytes(), defaultMaximumCachedBytes);
+
+  container->SetAllocator(recycling);
+  container->Reserve(5000, false);
+  const float * const firstBuffer = container->GetBufferPointer();
+  container->Initialize();
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 5000 * sizeof(float));
+
+  auto other = ContainerType::New();
+  other->SetAllocator(recycling);
+  other->Reserve(5000, false);
+  ITK_TEST_EXPECT_EQUAL(other->GetBufferPointer(), firstBuffer);
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 0);
+  other->Initialize();
+
+  recycling->SetMaximumCachedBytes(100);
+  recycling->ReleaseCachedBuffers();
+  other->Reserve(5000, false);
+  other->Initialize();
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 0);
+
+  // An allocation of another size empties the cache
+  recycling->SetMaximumCachedBytes(100000);
+  ITK_TEST_SET_GET_BOOLEAN(recycling, ReleaseCacheOnMiss, true);
+  other->Reserve(5000, false);
+  other->Initialize();
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 5000 * sizeof(float));
+  other->Reserve(7000, false);
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 0);
+
+  // The allocator of a buffer still in use cannot be changed
+  ITK_TEST_EXPECT_EQUAL(recycling->GetNumberOfAllocatedBuffers(), 1);
+  ITK_TRY_EXPECT_EXCEPTION(recycling->SetAllocator(hugePage));
+  other->Initialize();
+  ITK_TEST_EXPECT_EQUAL(recycling->GetNumberOfAllocatedBuffers(), 0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(recycling->SetAllocator(hugePage));
+  ITK_TEST_EXPECT_EQUAL(recycling->GetCachedBytes(), 0);
+  ITK_TEST_SET_GET_VALUE(hugePage.GetPointer(), recycling->GetAllocator());
+  other->Reserve(7000, false);
+  other->Initialize();
+
+  // Global default allocator, used by images
+  itk::ImportImageContainerCommon::SetGlobalDefaultAllocator(aligned);
+  ITK_TEST_SET_GET_VALUE(aligned.GetPointer(),
+                         itk::ImportImageContainerCommon::GetGlobalDefaultAllocator().GetPointer());
+  aligned->SetAlignment(64);
+  using ImageType = itk::Image<short, 3>;
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize({ { 17, 19, 23 } });
+  image->SetRegions(region);
+  image->Allocate(true);
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast<std::uintptr_t>(image->GetBufferPointer()) % 64, 0);
+  ITK_TEST_EXPECT_EQUAL(image->GetPixel({ { 16, 18, 22 } }), 0);
+
+  // A set allocator allocates the elements instead of AllocateElements
+  auto counting = CountingImportImageContainer::New();
+  counting->Reserve(1000, false);
+  ITK_TEST_EXPECT_EQUAL(counting->m_NumberOfAllocations, 0);
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast<std::uintptr_t>(counting->GetBufferPointer()) % 64, 0);
+  counting->Initialize();
+
+  itk::ImportImageContainerCommon::SetGlobalDefaultAllocator(nullptr);
+
+  // Without allocator, an override of AllocateElements is called, and the
+  // superclass implementation allocates with array new
+  counting->Reserve(1000, false);
+  ITK_TEST_EXPECT_EQUAL(counting->m_NumberOfAllocations, 1);
+  counting->Initialize();
+  counting->m_UseSuperclass = true;
+  counting->Reserve(1000, true);
+  ITK_TEST_EXPECT_EQUAL(counting->m_NumberOfAllocations, 2);
+  ITK_TEST_EXPECT_EQUAL((*counting)[999], 0.0f);
+  counting->Initialize();
+  image = nullptr;
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkImageBufferAllocatorBase.h"
+#include "itkImportImageContainerCommon.h"
+#include "itkPoolMultiThreader.h"
+#include "itkTestingMacros.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Fills the buffers it allocates with garbage, to see what was zeroed.
+class GarbageAllocator : public itk::ImageBufferAllocatorBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(GarbageAllocator);
+
+  using Self = GarbageAllocator;
+  using Superclass = itk::ImageBufferAllocatorBase;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(GarbageAllocator, ImageBufferAllocatorBase);
+
+  void *
+  Allocate(itk::SizeValueType numberOfBytes) override
+  {
+    void * buffer = ::operator new(numberOfBytes);
+    std::memset(buffer, 0xAB, numberOfBytes);
+    return buffer;
+  }
+
+  void
+  Deallocate(void * buffer, itk::SizeValueType) override
+  {
+    ::operator delete(buffer);
+  }
+
+protected:
+  GarbageAllocator() = default;
+  ~GarbageAllocator() override = default;
+};
+} // namespace
+
+// Checks that the PoolMultiThreader processes each piece of a region once
+// when the pieces are distributed by blocks, and that the first touch of a
+// new image buffer zeroes the buffered region, but not a grown one.
+int
+itkImageFirstTouchTest(int, char *[])
+{
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(3);
+  itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+
+  // Two pieces per thread, pool threads and calling thread. Which thread
+  // processes a piece depends on the scheduling, so only the pieces
+  // processed are checked.
+  const itk::ThreadIdType numberOfBlocks = pool->GetMaximumNumberOfThreads() + 1;
+  const itk::ThreadIdType numberOfPieces = std::min<itk::ThreadIdType>(2 * numberOfBlocks, itk::ITK_MAX_THREADS);
+
+  itk::MultiThreaderBase::Pointer threader = itk::PoolMultiThreader::New().GetPointer();
+  threader->SetNumberOfWorkUnits(numberOfPieces);
+
+  using RegionType = itk::ImageRegion<2>;
+  RegionType::SizeType size = { { 16, numberOfPieces } };
+  const RegionType     region(size);
+  for (unsigned int repetition = 0; repetition < 2; ++repetition)
+  {
+    std::vector<std::atomic<unsigned int>> timesRowProcessed(numberOfPieces);
+    for (auto & times : timesRowProcessed)
+    {
+      times = 0;
+    }
+    threader->ParallelizeImageRegion<2>(
+      region,
+      [&timesRowProcessed](const RegionType & piece) {
+        for (itk::IndexValueType row = piece.GetIndex(1); row < piece.GetUpperIndex()[1] + 1; ++row)
+        {
+          ++timesRowProcessed[row];
+        }
+      },
+      nullptr);
+    for (itk::ThreadIdType i = 0; i < numberOfPieces; ++i)
+    {
+      ITK_TEST_EXPECT_EQUAL(timesRowProcessed[i].load(), 1u);
+    }
+  }
+
+  // A first touched image is zeroed, even when its pixels need not be initialized.
+  itk::ImportImageContainerCommon::SetGlobalDefaultNUMAFirstTouch(true);
+  ITK_TEST_EXPECT_TRUE(itk::ImportImageContainerCommon::GetGlobalDefaultNUMAFirstTouch());
+
+  using ImageType = itk::Image<float, 3>;
+  ImageType::Pointer         image = ImageType::New();
+  const ImageType::IndexType imageIndex = { { 3, -2, 5 } };
+  const ImageType::SizeType  imageSize = { { 200, 100, 60 } };
+  image->SetRegions(ImageType::RegionType(imageIndex, imageSize));
+  image->GetPixelContainer()->SetAllocator(GarbageAllocator::New());
+  image->Allocate(false);
+
+  const float *            buffer = image->GetBufferPointer();
+  const itk::SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  itk::SizeValueType       numberOfNonZeroPixels = 0;
+  for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    numberOfNonZeroPixels += (buffer[i] != 0.0f);
+  }
+  ITK_TEST_EXPECT_EQUAL(numberOfNonZeroPixels, 0);
+
+  // A grown buffer keeps the pixels copied from the previous one.
+  float * const pixels = image->GetBufferPointer();
+  for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    pixels[i] = static_cast<float>(i % 97 + 1);
+  }
+  const ImageType::SizeType largerImageSize = { { 200, 100, 80 } };
+  image->SetRegions(ImageType::RegionType(imageIndex, largerImageSize));
+  image->Allocate(false);
+  ITK_TEST_EXPECT_TRUE(image->GetBufferPointer() != pixels);
+
+  const float *      grownBuffer = image->GetBufferPointer();
+  itk::SizeValueType numberOfChangedPixels = 0;
+  for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    numberOfChangedPixels += (grownBuffer[i] != static_cast<float>(i % 97 + 1));
+  }
+  ITK_TEST_EXPECT_EQUAL(numberOfChangedPixels, 0);
+
+  itk::ImportImageContainerCommon::SetGlobalDefaultNUMAFirstTouch(false);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
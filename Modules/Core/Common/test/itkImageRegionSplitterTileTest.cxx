@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionSplitterTile.h"
+#include "itkRegionRecordingImageSource.h"
+#include "itkTestingMacros.h"
+
+int
+itkImageRegionSplitterTileTest(int, char *[])
+{
+  auto splitter = itk::ImageRegionSplitterTile::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(splitter, ImageRegionSplitterTile, ImageRegionSplitterBase);
+
+  ITK_TEST_SET_GET_VALUE(32768, splitter->GetTileNumberOfPixels());
+  ITK_TEST_EXPECT_TRUE(splitter->GetNumberOfPiecesPerWorkUnit() > 1);
+
+  // Tiles of 64 pixels of a 100 x 10 region: the 10 rows are split in two,
+  // leaving 12 pixels to the columns, hence 9 x 2 tiles of 11 or 12 x 5 pixels
+  splitter->SetTileNumberOfPixels(64);
+  ITK_TEST_SET_GET_VALUE(64, splitter->GetTileNumberOfPixels());
+
+  itk::ImageRegion<2> region;
+  region.SetSize(0, 100);
+  region.SetSize(1, 10);
+  region.SetIndex(0, 1);
+  region.SetIndex(1, 10);
+
+  const itk::ImageRegion<2> lpRegion = region;
+
+  ITK_TEST_EXPECT_EQUAL(splitter->GetNumberOfSplits(lpRegion, 1), 1);
+  ITK_TEST_EXPECT_EQUAL(splitter->GetNumberOfSplits(lpRegion, 5), 4);
+  ITK_TEST_EXPECT_EQUAL(splitter->GetNumberOfSplits(lpRegion, 18), 18);
+  ITK_TEST_EXPECT_EQUAL(splitter->GetNumberOfSplits(lpRegion, 1000), 18);
+
+  // The tiles are numbered with the fastest dimension varying first
+  region = lpRegion;
+  splitter->GetSplit(0, 18, region);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(0), 1);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(1), 10);
+  ITK_TEST_EXPECT_EQUAL(region.GetSize(0), 11);
+  ITK_TEST_EXPECT_EQUAL(region.GetSize(1), 5);
+
+  region = lpRegion;
+  splitter->GetSplit(1, 18, region);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(0), 12);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(1), 10);
+
+  region = lpRegion;
+  splitter->GetSplit(17, 18, region);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(0), 89);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(1), 15);
+  ITK_TEST_EXPECT_EQUAL(region.GetSize(0), 12);
+  ITK_TEST_EXPECT_EQUAL(region.GetSize(1), 5);
+
+  // Merged along the dimensions with the most pieces when fewer are requested
+  region = lpRegion;
+  splitter->GetSplit(3, 4, region);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(0), 51);
+  ITK_TEST_EXPECT_EQUAL(region.GetIndex(1), 15);
+  ITK_TEST_EXPECT_EQUAL(region.GetSize(0), 50);
+  ITK_TEST_EXPECT_EQUAL(region.GetSize(1), 5);
+
+  // The default budget gives cubes of 32 x 32 x 32 pixels
+  splitter->SetTileNumberOfPixels(32768);
+  itk::ImageRegion<3> cubicRegion;
+  cubicRegion.SetSize({ { 256, 256, 256 } });
+  ITK_TEST_EXPECT_EQUAL(splitter->GetNumberOfSplits(cubicRegion, 1000), 512);
+  splitter->GetSplit(0, 512, cubicRegion);
+  ITK_TEST_EXPECT_EQUAL(cubicRegion.GetSize(), itk::Size<3>({ { 32, 32, 32 } }));
+
+  // A thin dimension is spanned whole, and its budget goes to the others
+  itk::ImageRegion<3> thinRegion;
+  thinRegion.SetSize({ { 1000, 1000, 2 } });
+  ITK_TEST_EXPECT_EQUAL(splitter->GetNumberOfSplits(thinRegion, 1000), 64);
+  splitter->GetSplit(0, 64, thinRegion);
+  ITK_TEST_EXPECT_EQUAL(thinRegion.GetSize(), itk::Size<3>({ { 125, 125, 2 } }));
+
+  // Tiles of 4096 pixels of a 64^3 image: 16 x 16 x 16 pixels
+  splitter->SetTileNumberOfPixels(4096);
+  auto source = itk::Testing::RegionRecordingImageSource::New();
+  source->SetNumberOfWorkUnits(4);
+  source->SetImageRegionSplitter(splitter);
+  // The multi-threader, which may be shared, only gets the splitter during the update
+  ITK_TEST_EXPECT_TRUE(source->GetMultiThreader()->GetImageRegionSplitter() != splitter.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+  ITK_TEST_EXPECT_TRUE(source->GetMultiThreader()->GetImageRegionSplitter() != splitter.GetPointer());
+  const itk::ImageRegion<3> outputRegion = source->GetOutput()->GetRequestedRegion();
+  ITK_TEST_EXPECT_EQUAL(source->m_Regions.size(), 64);
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, outputRegion, 4096));
+
+  // The splitter of a subclass overriding GetImageRegionSplitter()
+  source->SetImageRegionSplitter(nullptr);
+  source->m_OverridingSplitter = splitter;
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+  ITK_TEST_EXPECT_EQUAL(source->m_Regions.size(), 64);
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, outputRegion, 4096));
+  source->m_OverridingSplitter = nullptr;
+  source->SetImageRegionSplitter(splitter);
+
+  // The classic multi-threading has at most one region per work unit
+  source->SetDynamicMultiThreading(false);
+  source->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+  ITK_TEST_EXPECT_TRUE(source->m_Regions.size() <= source->GetNumberOfWorkUnits());
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, outputRegion));
+
+  // The global default splitter
+  source->SetImageRegionSplitter(nullptr);
+  source->SetDynamicMultiThreading(true);
+  itk::ImageSourceCommon::SetGlobalDefaultSplitter(splitter);
+  ITK_TEST_EXPECT_TRUE(itk::ImageSourceCommon::GetGlobalDefaultSplitter() == splitter.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+  ITK_TEST_EXPECT_TRUE(source->GetMultiThreader()->GetImageRegionSplitter() ==
+                       itk::ImageSourceCommon::GetGlobalDefaultSplitter());
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, outputRegion, 4096));
+  if (source->GetMultiThreader()->GetNameOfClass() != std::string("TBBMultiThreader"))
+  {
+    ITK_TEST_EXPECT_EQUAL(source->m_Regions.size(), 64);
+  }
+
+  itk::ImageSourceCommon::SetGlobalDefaultSplitter(nullptr);
+  ITK_TEST_EXPECT_EQUAL(std::string(itk::ImageSourceCommon::GetGlobalDefaultSplitter()->GetNameOfClass()),
+                        "ImageRegionSplitterSlowDimension");
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
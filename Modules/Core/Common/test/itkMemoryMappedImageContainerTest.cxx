@@ -0,0 +1,94 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMemoryMappedImageContainer.h"
+#include "itkImage.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+#include <vector>
+
+int
+itkMemoryMappedImageContainerTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+
+  // A file with a 12 byte header followed by the elements
+  constexpr itk::SizeValueType headerSize = 12;
+  constexpr itk::SizeValueType numberOfElements = 10000;
+  std::vector<float>           elements(numberOfElements);
+  for (itk::SizeValueType i = 0; i < numberOfElements; ++i)
+  {
+    elements[i] = static_cast<float>(i) * 0.5f;
+  }
+  {
+    std::ofstream file(fileName.c_str(), std::ios::binary);
+    const char    header[headerSize] = "ITKMAPTEST0";
+    file.write(header, headerSize);
+    file.write(reinterpret_cast<const char *>(elements.data()), numberOfElements * sizeof(float));
+  }
+
+  using ContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, float>;
+  auto container = ContainerType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(container, MemoryMappedImageContainer, ImportImageContainer);
+  ITK_TEST_EXPECT_TRUE(container->GetMappedFile() == nullptr);
+
+  container->MapFile(fileName, headerSize, numberOfElements);
+  ITK_TEST_EXPECT_EQUAL(container->Size(), numberOfElements);
+  ITK_TEST_EXPECT_EQUAL(container->GetMappedFile()->GetNumberOfBytes(), numberOfElements * sizeof(float));
+  for (itk::SizeValueType i = 0; i < numberOfElements; ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL((*container)[i], elements[i]);
+  }
+
+  // Modifications are private to the mapping
+  (*container)[0] = -1.0f;
+  ITK_TEST_EXPECT_EQUAL((*container)[0], -1.0f);
+  {
+    auto other = ContainerType::New();
+    other->MapFile(fileName, headerSize, numberOfElements);
+    ITK_TEST_EXPECT_EQUAL((*other)[0], elements[0]);
+  }
+
+  // The mapping is used as the buffer of an image
+  using ImageType = itk::Image<float, 2>;
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize({ { 100, 100 } });
+  image->SetRegions(region);
+  image->SetPixelContainer(container);
+  ITK_TEST_EXPECT_EQUAL(image->GetPixel({ { 5, 3 } }), elements[305]);
+
+  // Growing the container copies the elements out of the mapping
+  container->Reserve(2 * numberOfElements);
+  ITK_TEST_EXPECT_EQUAL((*container)[numberOfElements - 1], elements[numberOfElements - 1]);
+
+  // Misaligned offset and ranges beyond the end of the file
+  ITK_TRY_EXPECT_EXCEPTION(container->MapFile(fileName, headerSize + 1, numberOfElements - 1));
+  ITK_TRY_EXPECT_EXCEPTION(container->MapFile(fileName, headerSize, numberOfElements + 1));
+  ITK_TRY_EXPECT_EXCEPTION(container->MapFile(fileName + ".missing", 0, 1));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -134,6 +134,11 @@ itkMultiThreaderBaseTest(int argc, char * argv[])
   result &= SetAndVerify(itk::MultiThreaderBase::GetGlobalMaximumNumberOfThreads() + 1);
 
 
+  itk::MultiThreaderBase::SetGlobalDefaultThreadAffinity(true);
+  ITK_TEST_EXPECT_TRUE(itk::MultiThreaderBase::GetGlobalDefaultThreadAffinity());
+  itk::MultiThreaderBase::SetGlobalDefaultThreadAffinity(false);
+  ITK_TEST_EXPECT_TRUE(!itk::MultiThreaderBase::GetGlobalDefaultThreadAffinity());
+
   // Test streaming enumeration for MultiThreaderBaseEnums::Threader elements
   const std::set<itk::MultiThreaderBaseEnums::Threader> allThreader{
     itk::MultiThreaderBaseEnums::Threader::Platform,
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiThreaderBase.h"
+#include "itkPoolMultiThreader.h"
+#include "itkRegionRecordingImageSource.h"
+#include "itkTestingMacros.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using RegionType = itk::Testing::RegionRecordingImageSource::RegionType;
+
+int
+itkMultiThreaderLoadBalancingTest(int, char *[])
+{
+  RegionType::SizeType size;
+  size.Fill(64);
+  const RegionType wholeRegion(size);
+
+  const itk::MultiThreaderBase::ThreaderEnum threaderTypes[] = { itk::MultiThreaderBase::ThreaderEnum::Platform,
+                                                                 itk::MultiThreaderBase::ThreaderEnum::Pool };
+  const itk::MultiThreaderBase::ThreaderEnum defaultThreaderType = itk::MultiThreaderBase::GetGlobalDefaultThreader();
+  for (const auto threaderType : threaderTypes)
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultThreader(threaderType);
+    itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+    std::cout << "Threader: " << threader->GetNameOfClass() << std::endl;
+
+    ITK_TEST_SET_GET_VALUE(1, threader->GetNumberOfPiecesPerWorkUnit());
+    threader->SetNumberOfPiecesPerWorkUnit(0);
+    ITK_TEST_SET_GET_VALUE(1, threader->GetNumberOfPiecesPerWorkUnit());
+
+    std::vector<RegionType> regions;
+    std::mutex              mutex;
+    auto                    recordRegion = [&regions, &mutex](const RegionType & region) {
+      std::lock_guard<std::mutex> lock(mutex);
+      regions.push_back(region);
+    };
+
+    // By default, one piece per work unit
+    threader->SetNumberOfWorkUnits(4);
+    threader->ParallelizeImageRegion<3>(wholeRegion, recordRegion, nullptr);
+    ITK_TEST_EXPECT_EQUAL(regions.size(), 4u);
+    ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(regions, wholeRegion));
+
+    // Many more pieces than work units, up to the slices of the region
+    regions.clear();
+    threader->SetNumberOfPiecesPerWorkUnit(8);
+    ITK_TEST_SET_GET_VALUE(8, threader->GetNumberOfPiecesPerWorkUnit());
+    threader->ParallelizeImageRegion<3>(wholeRegion, recordRegion, nullptr);
+    ITK_TEST_EXPECT_EQUAL(regions.size(), 32u);
+    ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(regions, wholeRegion));
+
+    regions.clear();
+    threader->SetNumberOfPiecesPerWorkUnit(100);
+    threader->ParallelizeImageRegion<3>(wholeRegion, recordRegion, nullptr);
+    ITK_TEST_EXPECT_EQUAL(regions.size(), 64u);
+    ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(regions, wholeRegion));
+  }
+  itk::MultiThreaderBase::SetGlobalDefaultThreader(defaultThreaderType);
+
+  // A filter opting in, with the pool multi-threader
+  auto source = itk::Testing::RegionRecordingImageSource::New();
+  source->SetMultiThreader(itk::PoolMultiThreader::New());
+  ITK_TEST_SET_GET_VALUE(1, source->GetNumberOfPiecesPerWorkUnit());
+  source->SetNumberOfPiecesPerWorkUnit(16);
+  ITK_TEST_SET_GET_VALUE(16, source->GetNumberOfPiecesPerWorkUnit());
+  source->SetNumberOfWorkUnits(2);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+  ITK_TEST_EXPECT_EQUAL(source->m_Regions.size(), 32u);
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, wholeRegion));
+  // The multi-threader, which may be shared, is left as it was
+  ITK_TEST_SET_GET_VALUE(1, source->GetMultiThreader()->GetNumberOfPiecesPerWorkUnit());
+
+  // Classic multi-threading gets one region per work unit
+  source->SetDynamicMultiThreading(false);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->UpdateLargestPossibleRegion());
+  ITK_TEST_EXPECT_TRUE(source->m_Regions.size() <= 2);
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, wholeRegion));
+
+  // The pieces are claimed from a queue rather than split statically
+  // between the work units: while the first piece started is held, the other
+  // work unit processes all the other pieces. Split statically, half of
+  // them would wait for the held piece, until the timeout.
+  source->SetDynamicMultiThreading(true);
+  source->GetMultiThreader()->SetMaximumNumberOfThreads(2);
+  std::mutex              workMutex;
+  std::condition_variable workCondition;
+  bool                    pieceHeld = false;
+  unsigned int            numberOfOtherPieces = 0;
+  bool                    otherPiecesDoneWhileHeld = false;
+  source->m_Work = [&](const RegionType &) {
+    std::unique_lock<std::mutex> lock(workMutex);
+    if (!pieceHeld)
+    {
+      pieceHeld = true;
+      otherPiecesDoneWhileHeld = workCondition.wait_for(
+        lock, std::chrono::seconds(30), [&numberOfOtherPieces]() { return numberOfOtherPieces == 31; });
+    }
+    else
+    {
+      ++numberOfOtherPieces;
+      workCondition.notify_all();
+    }
+  };
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->UpdateLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(source->m_Regions.size(), 32u);
+  ITK_TEST_EXPECT_TRUE(itk::Testing::CheckRegions(source->m_Regions, wholeRegion));
+  ITK_TEST_EXPECT_TRUE(otherPiecesDoneWhileHeld);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiThreaderBase.h"
+#include "itkImageRegion.h"
+#include "itkTestingMacros.h"
+#include <atomic>
+
+// Calls ParallelizeArray from within ParallelizeImageRegion work units,
+// the way a filter calls a multi-threaded interpolator or sub-filter.
+// With the thread pool this used to deadlock once all the pool threads
+// were waiting for their inner work.
+int
+itkMultiThreaderNestedParallelismTest(int, char *[])
+{
+  itk::MultiThreaderBase::Pointer outerThreader = itk::MultiThreaderBase::New();
+  itk::MultiThreaderBase::Pointer innerThreader = itk::MultiThreaderBase::New();
+  std::cout << "Threader: " << outerThreader->GetNameOfClass() << std::endl;
+  std::cout << "Work units: " << outerThreader->GetNumberOfWorkUnits() << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(!itk::MultiThreaderBase::IsInsideWorkUnit());
+
+  using RegionType = itk::ImageRegion<2>;
+  RegionType::SizeType size = { { 37, 41 } };
+  const RegionType     region(size);
+  constexpr unsigned   innerSize = 100;
+
+  std::atomic<itk::SizeValueType> outerCount{ 0 };
+  std::atomic<itk::SizeValueType> pieceCount{ 0 };
+  std::atomic<itk::SizeValueType> innerCount{ 0 };
+  std::atomic<itk::SizeValueType> outsideWorkUnitCount{ 0 };
+  outerThreader->ParallelizeImageRegion<2>(
+    region,
+    [&](const RegionType & piece) {
+      if (!itk::MultiThreaderBase::IsInsideWorkUnit())
+      {
+        ++outsideWorkUnitCount;
+      }
+      outerCount += piece.GetNumberOfPixels();
+      ++pieceCount;
+      // Both a separate threader and the calling threader itself
+      innerThreader->ParallelizeArray(
+        0, innerSize, [&innerCount](itk::SizeValueType) { ++innerCount; }, nullptr);
+      outerThreader->ParallelizeArray(
+        0, innerSize, [&innerCount](itk::SizeValueType) { ++innerCount; }, nullptr);
+    },
+    nullptr);
+
+  ITK_TEST_EXPECT_TRUE(!itk::MultiThreaderBase::IsInsideWorkUnit());
+  ITK_TEST_EXPECT_EQUAL(outsideWorkUnitCount, 0);
+  ITK_TEST_EXPECT_EQUAL(outerCount, region.GetNumberOfPixels());
+  ITK_TEST_EXPECT_EQUAL(innerCount, 2 * innerSize * pieceCount);
+
+  // The elements of an array are processed in work units too, whatever the threader
+  outerThreader->ParallelizeArray(
+    0,
+    innerSize,
+    [&outsideWorkUnitCount](itk::SizeValueType) {
+      if (!itk::MultiThreaderBase::IsInsideWorkUnit())
+      {
+        ++outsideWorkUnitCount;
+      }
+    },
+    nullptr);
+  ITK_TEST_EXPECT_TRUE(!itk::MultiThreaderBase::IsInsideWorkUnit());
+  ITK_TEST_EXPECT_EQUAL(outsideWorkUnitCount, 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
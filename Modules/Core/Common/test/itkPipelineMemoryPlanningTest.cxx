@@ -0,0 +1,263 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAddImageFilter.h"
+#include "itkImageBufferAllocatorRecycling.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImportImageContainerCommon.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <new>
+#include <vector>
+
+// Checks that the pipeline memory planner releases the intermediate
+// images after their last consumer, and reuses their buffers
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+using ShiftType = itk::ShiftScaleImageFilter<ImageType, ImageType>;
+using AddType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+
+// Keeps track of the bytes allocated for the image buffers
+class CountingAllocator : public itk::ImageBufferAllocatorBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingAllocator);
+
+  using Self = CountingAllocator;
+  using Superclass = itk::ImageBufferAllocatorBase;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(CountingAllocator, ImageBufferAllocatorBase);
+
+  void *
+  Allocate(itk::SizeValueType numberOfBytes) override
+  {
+    m_AllocatedBytes += numberOfBytes;
+    m_PeakAllocatedBytes = std::max(m_PeakAllocatedBytes, m_AllocatedBytes);
+    return ::operator new(numberOfBytes);
+  }
+
+  void
+  Deallocate(void * buffer, itk::SizeValueType numberOfBytes) override
+  {
+    m_AllocatedBytes -= numberOfBytes;
+    ::operator delete(buffer);
+  }
+
+  void
+  ResetPeak()
+  {
+    m_PeakAllocatedBytes = m_AllocatedBytes;
+  }
+
+  itk::SizeValueType m_AllocatedBytes{ 0 };
+  itk::SizeValueType m_PeakAllocatedBytes{ 0 };
+
+protected:
+  CountingAllocator() = default;
+  ~CountingAllocator() override = default;
+};
+
+bool
+CheckPixels(const ImageType * image, float expected)
+{
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << it.GetIndex() << ": expected " << expected << ", but got " << it.Get()
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// A chain of filters adding one to the input
+template <typename TFilter>
+std::vector<typename TFilter::Pointer>
+MakeChain(const ImageType * input, unsigned int numberOfFilters);
+
+template <>
+std::vector<ShiftType::Pointer>
+MakeChain<ShiftType>(const ImageType * input, unsigned int numberOfFilters)
+{
+  std::vector<ShiftType::Pointer> filters;
+  for (unsigned int i = 0; i < numberOfFilters; ++i)
+  {
+    auto filter = ShiftType::New();
+    filter->SetInput(i == 0 ? input : filters.back()->GetOutput());
+    filter->SetShift(1.0);
+    filters.push_back(filter);
+  }
+  return filters;
+}
+
+template <>
+std::vector<AddType::Pointer>
+MakeChain<AddType>(const ImageType * input, unsigned int numberOfFilters)
+{
+  std::vector<AddType::Pointer> filters;
+  for (unsigned int i = 0; i < numberOfFilters; ++i)
+  {
+    auto filter = AddType::New();
+    filter->SetInput1(i == 0 ? input : filters.back()->GetOutput());
+    filter->SetConstant2(1.0f);
+    filters.push_back(filter);
+  }
+  return filters;
+}
+
+} // namespace
+
+int
+itkPipelineMemoryPlanningTest(int, char *[])
+{
+  constexpr unsigned int numberOfFilters = 10;
+
+  auto allocator = CountingAllocator::New();
+  itk::ImportImageContainerCommon::SetGlobalDefaultAllocator(allocator);
+
+  auto input = ImageType::New();
+  input->SetRegions(ImageType::SizeType{ { 64, 64, 64 } });
+  input->Allocate();
+  input->FillBuffer(0.0f);
+  const itk::SizeValueType imageBytes = input->GetPixelContainer()->Size() * sizeof(float);
+
+  ITK_TEST_EXPECT_TRUE(!itk::ProcessObject::GetGlobalPipelineMemoryPlanning());
+
+  // Without planning, every intermediate image is kept
+  {
+    std::vector<ShiftType::Pointer> filters = MakeChain<ShiftType>(input, numberOfFilters);
+    ITK_TEST_EXPECT_TRUE(!filters.back()->GetPipelineMemoryPlanning());
+    allocator->ResetPeak();
+    ITK_TRY_EXPECT_NO_EXCEPTION(filters.back()->Update());
+    ITK_TEST_EXPECT_TRUE(allocator->m_PeakAllocatedBytes >= (numberOfFilters + 1) * imageBytes);
+    ITK_TEST_EXPECT_TRUE(filters[4]->GetOutput()->GetBufferPointer() != nullptr);
+    ITK_TEST_EXPECT_TRUE(CheckPixels(filters.back()->GetOutput(), numberOfFilters));
+  }
+
+  // With planning, the intermediate images are released, and their buffers reused
+  {
+    std::vector<ShiftType::Pointer> filters = MakeChain<ShiftType>(input, numberOfFilters);
+    ITK_TEST_SET_GET_BOOLEAN(filters.back(), PipelineMemoryPlanning, true);
+    itk::ImageBufferAllocatorRecycling::Pointer planAllocator;
+    ImageType * const                           output = filters.back()->GetOutput();
+    filters.back()->AddObserver(itk::EndEvent(), [&planAllocator, output](const itk::EventObject &) {
+      planAllocator = dynamic_cast<itk::ImageBufferAllocatorRecycling *>(output->GetPixelContainer()->GetAllocator());
+    });
+    allocator->ResetPeak();
+    ITK_TRY_EXPECT_NO_EXCEPTION(filters.back()->Update());
+    std::cout << "Peak memory of " << numberOfFilters << " filters: "
+              << double(allocator->m_PeakAllocatedBytes) / imageBytes - 1 << " images" << std::endl;
+    ITK_TEST_EXPECT_TRUE(allocator->m_PeakAllocatedBytes <= 4 * imageBytes);
+    ITK_TEST_EXPECT_TRUE(filters[4]->GetOutput()->GetBufferPointer() == nullptr);
+    ITK_TEST_EXPECT_TRUE(CheckPixels(filters.back()->GetOutput(), numberOfFilters));
+    ITK_TEST_EXPECT_EQUAL(itk::ImportImageContainerCommon::GetGlobalDefaultAllocator().GetPointer(),
+                          allocator.GetPointer());
+
+    // The outputs were allocated by the allocator of the update, which
+    // allocates with the global default one, and is no longer set on them
+    // once the update ends
+    ITK_TEST_EXPECT_TRUE(planAllocator.IsNotNull());
+    ITK_TEST_EXPECT_EQUAL(planAllocator->GetAllocator(), allocator.GetPointer());
+    ITK_TEST_EXPECT_EQUAL(planAllocator->GetCachedBytes(), 0);
+    ITK_TEST_EXPECT_EQUAL(planAllocator->GetNumberOfAllocatedBuffers(), 1);
+    ITK_TEST_EXPECT_TRUE(output->GetPixelContainer()->GetAllocator() == nullptr);
+
+    // A re-allocation of the same container after the update uses the
+    // global default allocator
+    output->GetPixelContainer()->Initialize();
+    ITK_TEST_EXPECT_EQUAL(planAllocator->GetNumberOfAllocatedBuffers(), 0);
+    const itk::SizeValueType allocatedBytes = allocator->m_AllocatedBytes;
+    output->Allocate();
+    ITK_TEST_EXPECT_EQUAL(planAllocator->GetNumberOfAllocatedBuffers(), 0);
+    ITK_TEST_EXPECT_EQUAL(allocator->m_AllocatedBytes, allocatedBytes + imageBytes);
+    output->ReleaseData();
+
+    // The released images are generated again when needed
+    ITK_TRY_EXPECT_NO_EXCEPTION(filters[4]->Update());
+    ITK_TEST_EXPECT_TRUE(CheckPixels(filters[4]->GetOutput(), 5));
+  }
+
+  // The filters which may run in place do so when they are the last consumer
+  // of their input, and the planner never turns InPlace on
+  for (const bool inPlace : { false, true })
+  {
+    std::vector<AddType::Pointer> filters = MakeChain<AddType>(input, numberOfFilters);
+    ITK_TEST_EXPECT_TRUE(!filters[1]->GetInPlace());
+    for (unsigned int i = 1; i < numberOfFilters; ++i)
+    {
+      filters[i]->SetInPlace(inPlace);
+    }
+    itk::ProcessObject::SetGlobalPipelineMemoryPlanning(true);
+    allocator->ResetPeak();
+    ITK_TRY_EXPECT_NO_EXCEPTION(filters.back()->Update());
+    itk::ProcessObject::SetGlobalPipelineMemoryPlanning(false);
+    if (inPlace)
+    {
+      ITK_TEST_EXPECT_TRUE(allocator->m_PeakAllocatedBytes <= 2 * imageBytes);
+    }
+    else
+    {
+      ITK_TEST_EXPECT_TRUE(allocator->m_PeakAllocatedBytes >= 3 * imageBytes);
+    }
+    ITK_TEST_EXPECT_TRUE(CheckPixels(filters.back()->GetOutput(), numberOfFilters));
+    // The input given by the application is never released nor overwritten
+    ITK_TEST_EXPECT_TRUE(CheckPixels(input, 0));
+  }
+
+  // An intermediate image consumed by two filters is not overwritten by the first one
+  for (const bool planning : { false, true })
+  {
+    auto shift = ShiftType::New();
+    shift->SetInput(input);
+    shift->SetShift(1.0);
+    unsigned int numberOfExecutions = 0;
+    shift->AddObserver(itk::StartEvent(), [&numberOfExecutions](const itk::EventObject &) { ++numberOfExecutions; });
+
+    auto add1 = AddType::New();
+    add1->SetInput1(shift->GetOutput());
+    add1->SetConstant2(1.0f);
+    add1->InPlaceOn();
+    auto add2 = AddType::New();
+    add2->SetInput1(shift->GetOutput());
+    add2->SetConstant2(2.0f);
+    add2->InPlaceOn();
+    auto sum = AddType::New();
+    sum->SetInput1(add1->GetOutput());
+    sum->SetInput2(add2->GetOutput());
+    sum->SetPipelineMemoryPlanning(planning);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(sum->Update());
+    ITK_TEST_EXPECT_TRUE(CheckPixels(sum->GetOutput(), 5));
+    std::cout << "Executions of the shared filter " << (planning ? "with" : "without")
+              << " planning: " << numberOfExecutions << std::endl;
+    ITK_TEST_EXPECT_EQUAL(numberOfExecutions, planning ? 1u : 2u);
+  }
+
+  itk::ImportImageContainerCommon::SetGlobalDefaultAllocator(nullptr);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
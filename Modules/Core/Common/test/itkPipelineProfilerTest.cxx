@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAddImageFilter.h"
+#include "itkPipelineProfiler.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkTestingMacros.h"
+#include <sstream>
+
+// Checks the records of the filter executions, and their export
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+using ShiftType = itk::ShiftScaleImageFilter<ImageType, ImageType>;
+using AddType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+
+// The pieces of the work units add up
+bool
+CheckPieces(const itk::PipelineProfiler::Record & record, itk::SizeValueType numberOfPieces)
+{
+  itk::SizeValueType sum = 0;
+  for (const auto & workUnit : record.WorkUnits)
+  {
+    sum += workUnit.NumberOfPieces;
+    if (workUnit.BusyTime < 0.0 || workUnit.End < workUnit.Start)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong times of the work unit of thread " << workUnit.Thread << std::endl;
+      return false;
+    }
+  }
+  if (record.NumberOfPieces != numberOfPieces || sum != numberOfPieces)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << record.ClassName << " recorded " << record.NumberOfPieces << " pieces, " << sum
+              << " in its work units, expected " << numberOfPieces << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkPipelineProfilerTest(int, char *[])
+{
+  ImageType::SizeType size;
+  size.Fill(32);
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  image->FillBuffer(1.0f);
+  constexpr itk::SizeValueType numberOfBytes = 32 * 32 * 32 * sizeof(float);
+
+  auto shift = ShiftType::New();
+  shift->SetInput(image);
+  shift->SetShift(1.0);
+  shift->SetNumberOfWorkUnits(4);
+  auto add = AddType::New();
+  add->SetInput1(image);
+  add->SetInput2(shift->GetOutput());
+  add->SetObjectName("the \"sum\"");
+  add->InPlaceOff();
+  add->SetNumberOfWorkUnits(4);
+  add->SetNumberOfPiecesPerWorkUnit(4);
+
+  // Nothing recorded when disabled
+  itk::PipelineProfiler::SetEnabled(false);
+  ITK_TEST_EXPECT_TRUE(!itk::PipelineProfiler::GetEnabled());
+  auto unprofiledShift = ShiftType::New();
+  unprofiledShift->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(unprofiledShift->Update());
+  ITK_TEST_EXPECT_TRUE(itk::PipelineProfiler::GetRecords().empty());
+
+  itk::PipelineProfiler::SetEnabled(true);
+  ITK_TEST_EXPECT_TRUE(itk::PipelineProfiler::GetEnabled());
+  ITK_TRY_EXPECT_NO_EXCEPTION(add->Update());
+
+  // The input is executed first, and finishes first
+  const std::vector<itk::PipelineProfiler::Record> records = itk::PipelineProfiler::GetRecords();
+  ITK_TEST_EXPECT_EQUAL(records.size(), 2u);
+  const itk::PipelineProfiler::Record & shiftRecord = records[0];
+  const itk::PipelineProfiler::Record & addRecord = records[1];
+  ITK_TEST_EXPECT_EQUAL(shiftRecord.ClassName, std::string("ShiftScaleImageFilter"));
+  ITK_TEST_EXPECT_EQUAL(addRecord.ClassName, std::string("AddImageFilter"));
+  ITK_TEST_EXPECT_EQUAL(addRecord.ObjectName, std::string("the \"sum\""));
+  ITK_TEST_EXPECT_TRUE(shiftRecord.Start + shiftRecord.WallTime <= addRecord.Start);
+  for (const auto & record : records)
+  {
+    ITK_TEST_EXPECT_TRUE(record.WallTime >= 0.0);
+    ITK_TEST_EXPECT_TRUE(record.CPUTime >= 0.0);
+    ITK_TEST_EXPECT_EQUAL(record.AllocatedBytes, numberOfBytes);
+    ITK_TEST_EXPECT_EQUAL(record.NumberOfWorkUnits, 4u);
+    ITK_TEST_EXPECT_TRUE(!record.WorkUnits.empty() && record.WorkUnits.size() <= 4);
+    ITK_TEST_EXPECT_TRUE(record.GetImbalance() >= 1.0);
+  }
+
+  // Classic multi-threading gives a piece per work unit, dynamic
+  // multi-threading the pieces asked for, unless TBB splits the region
+  ITK_TEST_EXPECT_TRUE(CheckPieces(shiftRecord, 4));
+  if (std::string(add->GetMultiThreader()->GetNameOfClass()) != "TBBMultiThreader")
+  {
+    ITK_TEST_EXPECT_TRUE(CheckPieces(addRecord, 16));
+  }
+
+  std::ostringstream trace;
+  itk::PipelineProfiler::WriteChromeTrace(trace);
+  std::cout << trace.str();
+  ITK_TEST_EXPECT_TRUE(trace.str().find("{\"traceEvents\":[") == 0);
+  ITK_TEST_EXPECT_TRUE(trace.str().find("\"name\":\"ShiftScaleImageFilter\",\"cat\":\"filter\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(trace.str().find("\"name\":\"AddImageFilter pieces\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(trace.str().find("\"object\":\"the \\\"sum\\\"\"") != std::string::npos);
+
+  std::ostringstream summary;
+  itk::PipelineProfiler::WriteSummary(summary);
+  std::cout << summary.str();
+  ITK_TEST_EXPECT_TRUE(summary.str().find("Filter") == 0);
+  ITK_TEST_EXPECT_TRUE(summary.str().find("\nShiftScaleImageFilter ") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(summary.str().find("\nAddImageFilter ") != std::string::npos);
+
+  itk::PipelineProfiler::Clear();
+  ITK_TEST_EXPECT_TRUE(itk::PipelineProfiler::GetRecords().empty());
+
+  // Beyond the maximum number of records, the oldest ones are dropped
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetMaximumNumberOfRecords(), 100000u);
+  itk::PipelineProfiler::SetMaximumNumberOfRecords(3);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    shift->SetShift(static_cast<double>(i + 2));
+    ITK_TRY_EXPECT_NO_EXCEPTION(shift->Update());
+  }
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetRecords().size(), 3u);
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetNumberOfDroppedRecords(), 2u);
+  ITK_TRY_EXPECT_NO_EXCEPTION(add->Update());
+  const std::vector<itk::PipelineProfiler::Record> keptRecords = itk::PipelineProfiler::GetRecords();
+  ITK_TEST_EXPECT_EQUAL(keptRecords.size(), 3u);
+  ITK_TEST_EXPECT_EQUAL(keptRecords.back().ClassName, std::string("AddImageFilter"));
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetNumberOfDroppedRecords(), 3u);
+
+  // Lowering the maximum drops the records beyond it at once
+  itk::PipelineProfiler::SetMaximumNumberOfRecords(1);
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetRecords().size(), 1u);
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetNumberOfDroppedRecords(), 5u);
+
+  std::ostringstream cappedTrace;
+  itk::PipelineProfiler::WriteChromeTrace(cappedTrace);
+  ITK_TEST_EXPECT_TRUE(cappedTrace.str().find("\"dropped_records\":5") != std::string::npos);
+  std::ostringstream cappedSummary;
+  itk::PipelineProfiler::WriteSummary(cappedSummary);
+  std::cout << cappedSummary.str();
+  ITK_TEST_EXPECT_TRUE(cappedSummary.str().find("5 older executions were dropped") != std::string::npos);
+
+  itk::PipelineProfiler::Clear();
+  ITK_TEST_EXPECT_TRUE(itk::PipelineProfiler::GetRecords().empty());
+  ITK_TEST_EXPECT_EQUAL(itk::PipelineProfiler::GetNumberOfDroppedRecords(), 0u);
+  itk::PipelineProfiler::SetMaximumNumberOfRecords(100000);
+  itk::PipelineProfiler::SetEnabled(false);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRegionRecordingImageSource_h
+#define itkRegionRecordingImageSource_h
+
+#include "itkImageSource.h"
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+namespace Testing
+{
+
+/** Records the regions its 64^3 output image is generated in. The work done
+ * for each region may be given, e.g. to hold some of them, and so may the
+ * splitter returned by an override of GetImageRegionSplitter(). */
+class RegionRecordingImageSource : public ImageSource<Image<unsigned char, 3>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RegionRecordingImageSource);
+
+  using Self = RegionRecordingImageSource;
+  using Superclass = ImageSource<Image<unsigned char, 3>>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ImageType = Image<unsigned char, 3>;
+  using RegionType = ImageType::RegionType;
+
+  itkNewMacro(Self);
+  itkTypeMacro(RegionRecordingImageSource, ImageSource);
+
+  using Superclass::SetDynamicMultiThreading;
+
+  std::function<void(const RegionType &)> m_Work;
+  std::vector<RegionType>                 m_Regions;
+  ImageRegionSplitterBase::ConstPointer   m_OverridingSplitter;
+
+protected:
+  RegionRecordingImageSource() = default;
+
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const override
+  {
+    if (m_OverridingSplitter)
+    {
+      return m_OverridingSplitter;
+    }
+    return Superclass::GetImageRegionSplitter();
+  }
+
+  void
+  GenerateOutputInformation() override
+  {
+    ImageType::SizeType size;
+    size.Fill(64);
+    this->GetOutput()->SetLargestPossibleRegion(RegionType(size));
+  }
+
+  void
+  BeforeThreadedGenerateData() override
+  {
+    m_Regions.clear();
+  }
+
+  void
+  ThreadedGenerateData(const RegionType & region, ThreadIdType) override
+  {
+    this->DynamicThreadedGenerateData(region);
+  }
+
+  void
+  DynamicThreadedGenerateData(const RegionType & region) override
+  {
+    if (m_Work)
+    {
+      m_Work(region);
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Regions.push_back(region);
+  }
+
+private:
+  std::mutex m_Mutex;
+};
+
+/** Whether the regions partition the whole region, each having at most
+ * maximumNumberOfPixels pixels. */
+inline bool
+CheckRegions(const std::vector<RegionRecordingImageSource::RegionType> & regions,
+             const RegionRecordingImageSource::RegionType &              wholeRegion,
+             SizeValueType maximumNumberOfPixels = std::numeric_limits<SizeValueType>::max())
+{
+  SizeValueType numberOfPixels = 0;
+  for (const auto & region : regions)
+  {
+    if (!wholeRegion.IsInside(region) || region.GetNumberOfPixels() > maximumNumberOfPixels)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong region " << region << " of " << wholeRegion << std::endl;
+      return false;
+    }
+    numberOfPixels += region.GetNumberOfPixels();
+  }
+  for (auto first = regions.cbegin(); first != regions.cend(); ++first)
+  {
+    for (auto second = first + 1; second != regions.cend(); ++second)
+    {
+      auto overlap = *second;
+      if (overlap.Crop(*first))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The regions " << *first << " and " << *second << " overlap" << std::endl;
+        return false;
+      }
+    }
+  }
+  if (numberOfPixels != wholeRegion.GetNumberOfPixels())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The regions have " << numberOfPixels << " pixels instead of " << wholeRegion.GetNumberOfPixels()
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace Testing
+} // namespace itk
+
+#endif // itkRegionRecordingImageSource_h
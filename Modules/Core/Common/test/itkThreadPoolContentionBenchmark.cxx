@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPoolMultiThreader.h"
+#include "itkImageRegion.h"
+#include "itkTimeProbe.h"
+#include <atomic>
+#include <iomanip>
+
+// Measures how the thread pool scales when it is fed many small jobs,
+// which is what a filter with many small ParallelizeImageRegion chunks does.
+// Built with ITK_BUILD_BENCHMARKS, and run with ctest -L BENCHMARK; the
+// results are checked by itkThreadPoolContentionTest.
+//
+// Usage: itkThreadPoolContentionBenchmark [maximumNumberOfThreads]
+int
+main(int argc, char * argv[])
+{
+  unsigned int maximumNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  if (argc > 1)
+  {
+    maximumNumberOfThreads = static_cast<unsigned int>(std::stoi(argv[1]));
+  }
+  maximumNumberOfThreads =
+    std::max(1u, std::min(maximumNumberOfThreads, itk::MultiThreaderBase::GetGlobalMaximumNumberOfThreads()));
+  constexpr unsigned int numberOfRepetitions = 200;
+  constexpr unsigned int numberOfJobs = 10000;
+  const unsigned int     numberOfWorkUnits = std::min<unsigned int>(itk::ITK_MAX_THREADS, 16 * maximumNumberOfThreads);
+
+  // Start with a single pool thread, and grow the pool as we go.
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+  itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+
+  using RegionType = itk::ImageRegion<3>;
+  RegionType::SizeType size = { { 64, 64, 64 } };
+  const RegionType     region(size);
+
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "region [s]" << std::setw(16) << "jobs [s]" << std::endl;
+  for (unsigned int threads = 1; threads <= maximumNumberOfThreads;
+       threads = (threads < maximumNumberOfThreads) ? std::min(2 * threads, maximumNumberOfThreads) : threads + 1)
+  {
+    itk::MultiThreaderBase::Pointer threader = itk::PoolMultiThreader::New().GetPointer();
+    threader->SetMaximumNumberOfThreads(threads); // grows the pool
+    threader->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+    // Many small chunks of an image region, as dispatched by filters.
+    std::atomic<itk::SizeValueType> pixelCount{ 0 };
+    itk::TimeProbe                  regionProbe;
+    regionProbe.Start();
+    for (unsigned int r = 0; r < numberOfRepetitions; ++r)
+    {
+      threader->ParallelizeImageRegion<3>(
+        region, [&pixelCount](const RegionType & piece) { pixelCount += piece.GetNumberOfPixels(); }, nullptr);
+    }
+    regionProbe.Stop();
+
+    // A burst of tiny jobs submitted directly to the pool.
+    std::vector<std::future<int>> futures;
+    futures.reserve(numberOfJobs);
+    itk::TimeProbe jobProbe;
+    jobProbe.Start();
+    for (unsigned int j = 0; j < numberOfJobs; ++j)
+    {
+      futures.push_back(pool->AddWork([](unsigned int value) { return static_cast<int>(value % 7); }, j));
+    }
+    for (auto & future : futures)
+    {
+      future.get();
+    }
+    jobProbe.Stop();
+
+    std::cout << std::setw(8) << pool->GetMaximumNumberOfThreads() << std::setw(16) << regionProbe.GetTotal()
+              << std::setw(16) << jobProbe.GetTotal() << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPoolMultiThreader.h"
+#include "itkImageRegion.h"
+#include "itkTestingMacros.h"
+#include <atomic>
+#include <thread>
+
+// Feeds the thread pool many small jobs, as a filter with many small
+// ParallelizeImageRegion chunks does, while the pool grows, and checks the
+// results for every number of threads. Then checks that a thread waiting for
+// the jobs of its scope does not execute unrelated jobs. The timings are measured by
+// itkThreadPoolContentionBenchmark.
+int
+itkThreadPoolContentionTest(int argc, char * argv[])
+{
+  unsigned int maximumNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  if (argc > 1)
+  {
+    maximumNumberOfThreads = static_cast<unsigned int>(std::stoi(argv[1]));
+  }
+  maximumNumberOfThreads =
+    std::max(1u, std::min(maximumNumberOfThreads, itk::MultiThreaderBase::GetGlobalMaximumNumberOfThreads()));
+  constexpr unsigned int numberOfRepetitions = 20;
+  const unsigned int     numberOfWorkUnits = std::min<unsigned int>(itk::ITK_MAX_THREADS, 16 * maximumNumberOfThreads);
+
+  // Start with a single pool thread, and grow the pool as we go.
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+  itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+
+  using RegionType = itk::ImageRegion<3>;
+  RegionType::SizeType size = { { 64, 64, 64 } };
+  const RegionType     region(size);
+
+  for (unsigned int threads = 1; threads <= maximumNumberOfThreads;
+       threads = (threads < maximumNumberOfThreads) ? std::min(2 * threads, maximumNumberOfThreads) : threads + 1)
+  {
+    // Through the base class, whose templated ParallelizeImageRegion is hidden by the override
+    itk::MultiThreaderBase::Pointer threader = itk::PoolMultiThreader::New().GetPointer();
+    threader->SetMaximumNumberOfThreads(threads); // grows the pool
+    threader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TEST_EXPECT_EQUAL(threader->GetNumberOfWorkUnits(), numberOfWorkUnits);
+    std::cout << "Threads: " << pool->GetMaximumNumberOfThreads() << std::endl;
+
+    // Many small chunks of an image region, as dispatched by filters.
+    std::atomic<itk::SizeValueType> pixelCount{ 0 };
+    for (unsigned int r = 0; r < numberOfRepetitions; ++r)
+    {
+      threader->ParallelizeImageRegion<3>(
+        region, [&pixelCount](const RegionType & piece) { pixelCount += piece.GetNumberOfPixels(); }, nullptr);
+    }
+    ITK_TEST_EXPECT_EQUAL(pixelCount.load(), numberOfRepetitions * region.GetNumberOfPixels());
+
+    // A burst of tiny jobs submitted directly to the pool.
+    constexpr unsigned int        numberOfJobs = 10000;
+    std::vector<std::future<int>> futures;
+    futures.reserve(numberOfJobs);
+    for (unsigned int j = 0; j < numberOfJobs; ++j)
+    {
+      futures.push_back(pool->AddWork([](unsigned int value) { return static_cast<int>(value % 7); }, j));
+    }
+    int sum = 0;
+    int expectedSum = 0;
+    for (unsigned int j = 0; j < numberOfJobs; ++j)
+    {
+      sum += futures[j].get();
+      expectedSum += static_cast<int>(j % 7);
+    }
+    ITK_TEST_EXPECT_EQUAL(sum, expectedSum);
+  }
+
+  // A thread waiting for the jobs of its scope only executes those, and
+  // leaves unrelated jobs to the pool. Keep all the pool threads busy, so
+  // that the queued jobs stay in the queue.
+  const unsigned int             numberOfThreads = pool->GetMaximumNumberOfThreads();
+  std::promise<void>             release;
+  std::shared_future<void>       released = release.get_future().share();
+  std::atomic<unsigned int>      numberOfBlockedThreads{ 0 };
+  std::vector<std::future<void>> blockers;
+  for (unsigned int t = 0; t < numberOfThreads; ++t)
+  {
+    blockers.push_back(pool->AddWork([&numberOfBlockedThreads, released] {
+      ++numberOfBlockedThreads;
+      released.wait();
+    }));
+  }
+  while (numberOfBlockedThreads < numberOfThreads)
+  {
+    std::this_thread::yield();
+  }
+
+  std::atomic<bool> unrelatedJobExecuted{ false };
+  std::future<void> unrelatedJob = pool->AddWork([&unrelatedJobExecuted] { unrelatedJobExecuted = true; });
+  const int         scope = 0;
+  ITK_TEST_EXPECT_TRUE(!pool->ExecutePendingJob(&scope));
+  ITK_TEST_EXPECT_TRUE(!unrelatedJobExecuted);
+
+  std::future<int> scopedJob = pool->AddScopedWork(&scope, [] { return 7; });
+  ITK_TEST_EXPECT_TRUE(pool->ExecutePendingJob(&scope));
+  ITK_TEST_EXPECT_EQUAL(scopedJob.get(), 7);
+  ITK_TEST_EXPECT_TRUE(!unrelatedJobExecuted);
+
+  release.set_value();
+  for (auto & blocker : blockers)
+  {
+    blocker.get();
+  }
+  unrelatedJob.get();
+  ITK_TEST_EXPECT_TRUE(unrelatedJobExecuted);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -148,7 +148,10 @@ public:
 protected:
   MaskNeighborhoodOperatorImageFilter()
     : m_DefaultValue(NumericTraits<OutputPixelType>::ZeroValue())
-  {}
+  {
+    // The work is restricted to the mask, so balance it over many pieces
+    this->SetNumberOfPiecesPerWorkUnit(16);
+  }
   ~MaskNeighborhoodOperatorImageFilter() override = default;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
@@ -0,0 +1,451 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPixelExpression_h
+#define itkPixelExpression_h
+
+#include "itkUnaryGeneratorImageFilter.h"
+#include "itkBinaryGeneratorImageFilter.h"
+#include "itkTernaryFunctorImageFilter.h"
+#include <tuple>
+#include <type_traits>
+
+namespace itk
+{
+namespace Functor
+{
+
+/** \class PixelExpressionBase
+ * \brief Base class of the pixel expressions.
+ *
+ * A pixel expression composes point-wise functors at compile time. It is
+ * called with the pixels of the input images, and evaluates the whole
+ * expression on them, so that a chain of point-wise operations, such as
+ * subtract, multiply, clamp and cast, runs in a single pass over the
+ * images and allocates a single output image:
+ *
+ * \code
+ * using namespace itk::Functor;
+ * itk::Functor::Clamp<float, float> clamp;
+ * clamp.SetBounds(0.0f, 255.0f);
+ * const auto expression = StaticCast<unsigned char>(Apply(clamp, (InputPixel<0>() - InputPixel<1>()) * 2.0f));
+ * auto filter = itk::MakePixelExpressionImageFilter<OutputImageType>(expression, image1, image2);
+ * \endcode
+ *
+ * The arithmetic operators +, -, * and / combine expressions and
+ * constants. Apply() calls any functor, such as the ones of the ITK
+ * functor filters, on up to three expressions.
+ *
+ * The intermediate values have the type given by the C++ arithmetic and
+ * by the functors, instead of being converted to the pixel type of an
+ * intermediate image.
+ *
+ * \sa MakePixelExpressionImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+class PixelExpressionBase
+{};
+
+/** Whether T is a pixel expression. */
+template <typename T>
+using IsPixelExpression = std::is_base_of<PixelExpressionBase, T>;
+
+/** \class InputPixel
+ * \brief The pixel of the VIndex-th input image.
+ * \ingroup ITKImageFilterBase
+ */
+template <unsigned int VIndex>
+class InputPixel : public PixelExpressionBase
+{
+public:
+  template <typename... TPixels>
+  typename std::tuple_element<VIndex, std::tuple<TPixels...>>::type
+  operator()(const TPixels &... pixels) const
+  {
+    return std::get<VIndex>(std::tie(pixels...));
+  }
+
+  bool
+  operator==(const InputPixel &) const
+  {
+    return true;
+  }
+
+  bool
+  operator!=(const InputPixel &) const
+  {
+    return false;
+  }
+};
+
+/** \class ConstantPixel
+ * \brief A constant value.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename T>
+class ConstantPixel : public PixelExpressionBase
+{
+public:
+  ConstantPixel() = default;
+  explicit ConstantPixel(const T & value)
+    : m_Value(value)
+  {}
+
+  template <typename... TPixels>
+  const T &
+  operator()(const TPixels &...) const
+  {
+    return m_Value;
+  }
+
+  bool
+  operator==(const ConstantPixel & other) const
+  {
+    return m_Value == other.m_Value;
+  }
+
+  bool
+  operator!=(const ConstantPixel & other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  T m_Value{};
+};
+
+/** The expression of an operand: an expression itself, or a constant. */
+template <typename T, bool VIsPixelExpression = IsPixelExpression<T>::value>
+struct PixelExpressionOf
+{
+  using Type = T;
+
+  static const Type &
+  Make(const T & operand)
+  {
+    return operand;
+  }
+};
+
+template <typename T>
+struct PixelExpressionOf<T, false>
+{
+  using Type = ConstantPixel<T>;
+
+  static Type
+  Make(const T & operand)
+  {
+    return Type(operand);
+  }
+};
+
+/** \class UnaryPixelExpression
+ * \brief A functor applied to the value of an expression.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFunctor, typename TArgument>
+class UnaryPixelExpression : public PixelExpressionBase
+{
+public:
+  UnaryPixelExpression() = default;
+  UnaryPixelExpression(const TFunctor & functor, const TArgument & argument)
+    : m_Functor(functor)
+    , m_Argument(argument)
+  {}
+
+  template <typename... TPixels>
+  auto
+  operator()(const TPixels &... pixels) const -> decltype(std::declval<const TFunctor &>()(
+    std::declval<const TArgument &>()(pixels...)))
+  {
+    return m_Functor(m_Argument(pixels...));
+  }
+
+  bool
+  operator==(const UnaryPixelExpression & other) const
+  {
+    return m_Functor == other.m_Functor && m_Argument == other.m_Argument;
+  }
+
+  bool
+  operator!=(const UnaryPixelExpression & other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  TFunctor  m_Functor{};
+  TArgument m_Argument{};
+};
+
+/** \class BinaryPixelExpression
+ * \brief A functor applied to the values of two expressions.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFunctor, typename TArgument1, typename TArgument2>
+class BinaryPixelExpression : public PixelExpressionBase
+{
+public:
+  BinaryPixelExpression() = default;
+  BinaryPixelExpression(const TFunctor & functor, const TArgument1 & argument1, const TArgument2 & argument2)
+    : m_Functor(functor)
+    , m_Argument1(argument1)
+    , m_Argument2(argument2)
+  {}
+
+  template <typename... TPixels>
+  auto
+  operator()(const TPixels &... pixels) const -> decltype(std::declval<const TFunctor &>()(
+    std::declval<const TArgument1 &>()(pixels...),
+    std::declval<const TArgument2 &>()(pixels...)))
+  {
+    return m_Functor(m_Argument1(pixels...), m_Argument2(pixels...));
+  }
+
+  bool
+  operator==(const BinaryPixelExpression & other) const
+  {
+    return m_Functor == other.m_Functor && m_Argument1 == other.m_Argument1 && m_Argument2 == other.m_Argument2;
+  }
+
+  bool
+  operator!=(const BinaryPixelExpression & other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  TFunctor   m_Functor{};
+  TArgument1 m_Argument1{};
+  TArgument2 m_Argument2{};
+};
+
+/** \class TernaryPixelExpression
+ * \brief A functor applied to the values of three expressions.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFunctor, typename TArgument1, typename TArgument2, typename TArgument3>
+class TernaryPixelExpression : public PixelExpressionBase
+{
+public:
+  TernaryPixelExpression() = default;
+  TernaryPixelExpression(const TFunctor &   functor,
+                         const TArgument1 & argument1,
+                         const TArgument2 & argument2,
+                         const TArgument3 & argument3)
+    : m_Functor(functor)
+    , m_Argument1(argument1)
+    , m_Argument2(argument2)
+    , m_Argument3(argument3)
+  {}
+
+  template <typename... TPixels>
+  auto
+  operator()(const TPixels &... pixels) const -> decltype(std::declval<const TFunctor &>()(
+    std::declval<const TArgument1 &>()(pixels...),
+    std::declval<const TArgument2 &>()(pixels...),
+    std::declval<const TArgument3 &>()(pixels...)))
+  {
+    return m_Functor(m_Argument1(pixels...), m_Argument2(pixels...), m_Argument3(pixels...));
+  }
+
+  bool
+  operator==(const TernaryPixelExpression & other) const
+  {
+    return m_Functor == other.m_Functor && m_Argument1 == other.m_Argument1 && m_Argument2 == other.m_Argument2 &&
+           m_Argument3 == other.m_Argument3;
+  }
+
+  bool
+  operator!=(const TernaryPixelExpression & other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  TFunctor   m_Functor{};
+  TArgument1 m_Argument1{};
+  TArgument2 m_Argument2{};
+  TArgument3 m_Argument3{};
+};
+
+/** Apply a functor to the values of expressions or constants. */
+template <typename TFunctor, typename TArgument>
+UnaryPixelExpression<TFunctor, typename PixelExpressionOf<TArgument>::Type>
+Apply(const TFunctor & functor, const TArgument & argument)
+{
+  return { functor, PixelExpressionOf<TArgument>::Make(argument) };
+}
+
+template <typename TFunctor, typename TArgument1, typename TArgument2>
+BinaryPixelExpression<TFunctor,
+                      typename PixelExpressionOf<TArgument1>::Type,
+                      typename PixelExpressionOf<TArgument2>::Type>
+Apply(const TFunctor & functor, const TArgument1 & argument1, const TArgument2 & argument2)
+{
+  return { functor, PixelExpressionOf<TArgument1>::Make(argument1), PixelExpressionOf<TArgument2>::Make(argument2) };
+}
+
+template <typename TFunctor, typename TArgument1, typename TArgument2, typename TArgument3>
+TernaryPixelExpression<TFunctor,
+                       typename PixelExpressionOf<TArgument1>::Type,
+                       typename PixelExpressionOf<TArgument2>::Type,
+                       typename PixelExpressionOf<TArgument3>::Type>
+Apply(const TFunctor &   functor,
+      const TArgument1 & argument1,
+      const TArgument2 & argument2,
+      const TArgument3 & argument3)
+{
+  return { functor,
+           PixelExpressionOf<TArgument1>::Make(argument1),
+           PixelExpressionOf<TArgument2>::Make(argument2),
+           PixelExpressionOf<TArgument3>::Make(argument3) };
+}
+
+/** \class StaticCastPixel
+ * \brief Convert a value with static_cast.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TOutput>
+class StaticCastPixel
+{
+public:
+  template <typename TInput>
+  TOutput
+  operator()(const TInput & value) const
+  {
+    return static_cast<TOutput>(value);
+  }
+
+  bool
+  operator==(const StaticCastPixel &) const
+  {
+    return true;
+  }
+
+  bool
+  operator!=(const StaticCastPixel &) const
+  {
+    return false;
+  }
+};
+
+/** Convert the value of an expression with static_cast. */
+template <typename TOutput, typename TArgument>
+UnaryPixelExpression<StaticCastPixel<TOutput>, typename PixelExpressionOf<TArgument>::Type>
+StaticCast(const TArgument & argument)
+{
+  return Apply(StaticCastPixel<TOutput>(), argument);
+}
+
+/** The functors of the arithmetic operators of the expressions. */
+#define itkPixelExpressionOperatorMacro(name, op)                                                                      \
+  class name                                                                                                           \
+  {                                                                                                                    \
+  public:                                                                                                              \
+    template <typename TInput1, typename TInput2>                                                                      \
+    auto                                                                                                               \
+    operator()(const TInput1 & value1, const TInput2 & value2) const -> decltype(value1 op value2)                     \
+    {                                                                                                                  \
+      return value1 op value2;                                                                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+    bool                                                                                                               \
+    operator==(const name &) const                                                                                     \
+    {                                                                                                                  \
+      return true;                                                                                                     \
+    }                                                                                                                  \
+                                                                                                                       \
+    bool                                                                                                               \
+    operator!=(const name &) const                                                                                     \
+    {                                                                                                                  \
+      return false;                                                                                                    \
+    }                                                                                                                  \
+  };                                                                                                                   \
+                                                                                                                       \
+  template <typename TArgument1, typename TArgument2>                                                                  \
+  typename std::enable_if<IsPixelExpression<TArgument1>::value || IsPixelExpression<TArgument2>::value,                \
+                          BinaryPixelExpression<name,                                                                  \
+                                                typename PixelExpressionOf<TArgument1>::Type,                          \
+                                                typename PixelExpressionOf<TArgument2>::Type>>::type                   \
+  operator op(const TArgument1 & argument1, const TArgument2 & argument2)                                              \
+  {                                                                                                                    \
+    return Apply(name(), argument1, argument2);                                                                        \
+  }
+
+itkPixelExpressionOperatorMacro(PlusPixel, +)
+itkPixelExpressionOperatorMacro(MinusPixel, -)
+itkPixelExpressionOperatorMacro(MultipliesPixel, *)
+itkPixelExpressionOperatorMacro(DividesPixel, /)
+
+#undef itkPixelExpressionOperatorMacro
+
+} // end namespace Functor
+
+/** Make the filter which evaluates a pixel expression on the pixels of
+ * one, two or three input images, in a single multi-threaded pass.
+ *
+ * The filter is a UnaryGeneratorImageFilter or BinaryGeneratorImageFilter
+ * for one or two inputs, and a TernaryFunctorImageFilter for three inputs,
+ * in which case the functors of the expression must be equality
+ * comparable, as the ITK functors are.
+ *
+ * \sa Functor::PixelExpressionBase
+ * \ingroup ITKImageFilterBase */
+template <typename TOutputImage, typename TExpression, typename TInputImage1>
+typename UnaryGeneratorImageFilter<TInputImage1, TOutputImage>::Pointer
+MakePixelExpressionImageFilter(const TExpression & expression, const TInputImage1 * input1)
+{
+  auto filter = UnaryGeneratorImageFilter<TInputImage1, TOutputImage>::New();
+  filter->SetInput(input1);
+  filter->SetFunctor(expression);
+  return filter;
+}
+
+template <typename TOutputImage, typename TExpression, typename TInputImage1, typename TInputImage2>
+typename BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::Pointer
+MakePixelExpressionImageFilter(const TExpression & expression, const TInputImage1 * input1, const TInputImage2 * input2)
+{
+  auto filter = BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::New();
+  filter->SetInput1(input1);
+  filter->SetInput2(input2);
+  filter->SetFunctor(expression);
+  return filter;
+}
+
+template <typename TOutputImage,
+          typename TExpression,
+          typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3>
+typename TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TExpression>::Pointer
+MakePixelExpressionImageFilter(const TExpression &  expression,
+                               const TInputImage1 * input1,
+                               const TInputImage2 * input2,
+                               const TInputImage3 * input3)
+{
+  auto filter = TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TExpression>::New();
+  filter->SetInput1(input1);
+  filter->SetInput2(input2);
+  filter->SetInput3(input3);
+  filter->SetFunctor(expression);
+  return filter;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPixelExpression.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkSubtractImageFilter.h"
+#include "itkTimeProbe.h"
+
+// Measures the speedup of a point-wise filter chain fused in one pixel
+// expression over the chain of filters. It is built with
+// ITK_BUILD_BENCHMARKS and run by ctest -L BENCHMARK, while
+// itkPixelExpressionImageFilterTest checks that both give the same image.
+//
+// Usage: itkPixelExpressionImageFilterBenchmark [size]
+int
+main(int argc, char * argv[])
+{
+  unsigned int size = 256;
+  if (argc > 1)
+  {
+    size = static_cast<unsigned int>(std::stoi(argv[1]));
+  }
+
+  using namespace itk::Functor;
+  using FloatImageType = itk::Image<float, 3>;
+  using CharImageType = itk::Image<unsigned char, 3>;
+
+  FloatImageType::SizeType imageSize;
+  imageSize.Fill(size);
+  auto image1 = FloatImageType::New();
+  image1->SetRegions(imageSize);
+  image1->Allocate();
+  image1->FillBuffer(150.0f);
+  auto image2 = FloatImageType::New();
+  image2->SetRegions(imageSize);
+  image2->Allocate();
+  image2->FillBuffer(75.0f);
+
+  // Subtract, multiply, clamp and cast, as a chain of filters
+  auto subtract = itk::SubtractImageFilter<FloatImageType>::New();
+  subtract->SetInput1(image1);
+  subtract->SetInput2(image2);
+  auto multiply = itk::MultiplyImageFilter<FloatImageType>::New();
+  multiply->SetInput(subtract->GetOutput());
+  multiply->SetConstant(2.0f);
+  auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(multiply->GetOutput());
+  clamp->SetBounds(0.0f, 255.0f);
+  auto cast = itk::CastImageFilter<FloatImageType, CharImageType>::New();
+  cast->SetInput(clamp->GetOutput());
+
+  // and fused in one expression
+  Clamp<float, float> clampFunctor;
+  clampFunctor.SetBounds(0.0f, 255.0f);
+  const auto expression = StaticCast<unsigned char>(Apply(clampFunctor, (InputPixel<0>() - InputPixel<1>()) * 2.0f));
+  auto       fused =
+    itk::MakePixelExpressionImageFilter<CharImageType>(expression, image1.GetPointer(), image2.GetPointer());
+
+  itk::TimeProbe chainProbe;
+  itk::TimeProbe fusedProbe;
+  try
+  {
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      subtract->Modified();
+      chainProbe.Start();
+      cast->Update();
+      chainProbe.Stop();
+
+      fused->Modified();
+      fusedProbe.Start();
+      fused->Update();
+      fusedProbe.Stop();
+    }
+  }
+  catch (const itk::ExceptionObject & err)
+  {
+    std::cerr << err << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Subtract, multiply, clamp and cast of " << size << "^3 pixels: chain " << chainProbe.GetMean()
+            << "s, fused " << fusedProbe.GetMean() << "s, speedup " << chainProbe.GetMean() / fusedProbe.GetMean()
+            << std::endl;
+  return EXIT_SUCCESS;
+}
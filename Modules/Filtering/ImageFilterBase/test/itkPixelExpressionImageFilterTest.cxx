@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPixelExpression.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkSubtractImageFilter.h"
+#include "itkTernaryAddImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+using FloatImageType = itk::Image<float, 3>;
+using CharImageType = itk::Image<unsigned char, 3>;
+
+FloatImageType::Pointer
+MakeRandomImage(unsigned int size, float minimum, float maximum)
+{
+  auto                      image = FloatImageType::New();
+  FloatImageType::SizeType  imageSize;
+  imageSize.Fill(size);
+  image->SetRegions(imageSize);
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(42 + static_cast<int>(minimum));
+  for (itk::ImageRegionIterator<FloatImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(generator->GetUniformVariate(minimum, maximum)));
+  }
+  return image;
+}
+
+template <typename TImage1, typename TImage2>
+bool
+ImagesAreEqual(const TImage1 * image1, const TImage2 * image2)
+{
+  if (image1->GetBufferedRegion() != image2->GetBufferedRegion())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Different regions: " << image1->GetBufferedRegion() << " and " << image2->GetBufferedRegion()
+              << std::endl;
+    return false;
+  }
+  itk::ImageRegionConstIterator<TImage1> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage2> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Different pixels at " << it1.GetIndex() << ": " << +it1.Get() << " and " << +it2.Get()
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkPixelExpressionImageFilterTest(int, char *[])
+{
+  using namespace itk::Functor;
+
+  const FloatImageType::Pointer image1 = MakeRandomImage(128, 0.0f, 200.0f);
+  const FloatImageType::Pointer image2 = MakeRandomImage(128, 50.0f, 100.0f);
+  const FloatImageType::Pointer image3 = MakeRandomImage(128, -10.0f, 10.0f);
+
+  // The chain of point-wise filters: subtract, multiply, clamp and cast
+  auto subtract = itk::SubtractImageFilter<FloatImageType>::New();
+  subtract->SetInput1(image1);
+  subtract->SetInput2(image2);
+  auto multiply = itk::MultiplyImageFilter<FloatImageType>::New();
+  multiply->SetInput(subtract->GetOutput());
+  multiply->SetConstant(2.0f);
+  auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(multiply->GetOutput());
+  clamp->SetBounds(0.0f, 255.0f);
+  auto cast = itk::CastImageFilter<FloatImageType, CharImageType>::New();
+  cast->SetInput(clamp->GetOutput());
+
+  // The same chain, fused in one expression
+  Clamp<float, float> clampFunctor;
+  clampFunctor.SetBounds(0.0f, 255.0f);
+  const auto expression = StaticCast<unsigned char>(Apply(clampFunctor, (InputPixel<0>() - InputPixel<1>()) * 2.0f));
+  auto       fused =
+    itk::MakePixelExpressionImageFilter<CharImageType>(expression, image1.GetPointer(), image2.GetPointer());
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fused, BinaryGeneratorImageFilter, InPlaceImageFilter);
+
+  // The timings of both are reported by itkPixelExpressionImageFilterBenchmark
+  ITK_TRY_EXPECT_NO_EXCEPTION(cast->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(fused->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual(cast->GetOutput(), fused->GetOutput()));
+
+  // A functor of the ITK filters applied to the input pixels
+  auto sub = itk::SubtractImageFilter<FloatImageType>::New();
+  sub->SetInput1(image1);
+  sub->SetInput2(image2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(sub->Update());
+  auto applied = itk::MakePixelExpressionImageFilter<FloatImageType>(
+    Apply(Sub2<float, float, float>(), InputPixel<0>(), InputPixel<1>()), image1.GetPointer(), image2.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(applied->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual(sub->GetOutput(), applied->GetOutput()));
+
+  // One input, with constants on both sides of the operators
+  auto scaled = itk::MakePixelExpressionImageFilter<FloatImageType>(1.0f + InputPixel<0>() / 4.0f, image1.GetPointer());
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(scaled, UnaryGeneratorImageFilter, InPlaceImageFilter);
+  ITK_TRY_EXPECT_NO_EXCEPTION(scaled->Update());
+  itk::ImageRegionConstIterator<FloatImageType> inputIt(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FloatImageType> scaledIt(scaled->GetOutput(), image1->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++scaledIt)
+  {
+    if (scaledIt.Get() != 1.0f + inputIt.Get() / 4.0f)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong scaled pixel at " << inputIt.GetIndex() << ": " << scaledIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Three inputs, compared with the ternary add filter
+  auto ternaryAdd = itk::TernaryAddImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType>::New();
+  ternaryAdd->SetInput1(image1);
+  ternaryAdd->SetInput2(image2);
+  ternaryAdd->SetInput3(image3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(ternaryAdd->Update());
+  auto ternary = itk::MakePixelExpressionImageFilter<FloatImageType>(
+    InputPixel<0>() + InputPixel<1>() + InputPixel<2>(), image1.GetPointer(), image2.GetPointer(), image3.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(ternary->Update());
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual(ternaryAdd->GetOutput(), ternary->GetOutput()));
+
+  // Setting an equal expression does not modify the filter
+  const itk::ModifiedTimeType mtime = ternary->GetMTime();
+  ternary->SetFunctor(InputPixel<0>() + InputPixel<1>() + InputPixel<2>());
+  ITK_TEST_EXPECT_EQUAL(ternary->GetMTime(), mtime);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
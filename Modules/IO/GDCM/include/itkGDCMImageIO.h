@@ -137,6 +137,14 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Clone() returns a GDCMImageIO with the same reading settings, so that
+   * the files of a series are decoded concurrently by ImageSeriesReader. */
+  bool
+  CanCloneForReading() const override
+  {
+    return true;
+  }
+
   /** Set/Get the original component type of the image. This differs from
    * ComponentType which may change as a function of rescale slope and
    * intercept. */
@@ -359,6 +367,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
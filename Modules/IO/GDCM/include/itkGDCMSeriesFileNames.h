@@ -24,12 +24,6 @@
 #include <vector>
 #include "ITKIOGDCMExport.h"
 
-// forward declaration, to remove compile dependency on GDCM library
-namespace gdcm
-{
-class SerieHelper;
-}
-
 namespace itk
 {
 /**
@@ -51,6 +45,11 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ * The files of the directory are scanned concurrently, reading only their
+ * header up to the Pixel Data element, which is not loaded. As when reading
+ * them with gdcm::ImageReader, only the files describing a valid image are
+ * kept.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -202,8 +201,10 @@ private:
   FileNamesContainerType m_InputFileNames;
   FileNamesContainerType m_OutputFileNames;
 
-  /** Internal structure to order serie from one directory */
-  std::unique_ptr<gdcm::SerieHelper> m_SerieHelper;
+  /** Internal structure to order serie from one directory, defined in the
+   * implementation to remove the compile dependency on GDCM library */
+  class ParallelSerieHelper;
+  std::unique_ptr<ParallelSerieHelper> m_SerieHelper;
 
   /** Internal structure to keep the list of series UIDs */
   SeriesUIDContainerType m_SeriesUIDs;
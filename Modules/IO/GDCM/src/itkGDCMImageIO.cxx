@@ -121,6 +121,24 @@ GDCMImageIO::~GDCMImageIO()
   delete this->m_DICOMHeader;
 }
 
+LightObject::Pointer
+GDCMImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+  Self::Pointer        imageIO = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (imageIO.IsNull())
+  {
+    itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+
+  // Only the settings used for reading
+  imageIO->SetLoadPrivateTags(this->GetLoadPrivateTags());
+  imageIO->SetReadYBRtoRGB(this->GetReadYBRtoRGB());
+  imageIO->SetUseStreamedReading(this->GetUseStreamedReading());
+
+  return loPtr;
+}
+
 /**
  * Helper function to test for some dicom like formatting.
  * @param file A stream to test if the file is dicom like
@@ -20,15 +20,99 @@
 
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
+#include "itkMultiThreaderBase.h"
 #include "itkProgressReporter.h"
+#include "gdcmDirectory.h"
+#include "gdcmImageReader.h"
+#include "gdcmMediaStorage.h"
 #include "gdcmSerieHelper.h"
 
 namespace itk
 {
 
+namespace
+{
+class HeaderReader : public gdcm::ImageReader
+{
+public:
+  /** Read the data elements up to the Pixel Data element, without loading
+   * it. Returns false when the file is not DICOM, has no Pixel Data, or does
+   * not describe an image that gdcm::ImageReader::Read() would accept. */
+  bool
+  ReadUpToPixelData()
+  {
+    const gdcm::Tag           pixelData(0x7fe0, 0x0010);
+    const std::set<gdcm::Tag> skipTags{ pixelData };
+    if (!this->ReadUpToTag(pixelData, skipTags) || this->GetStreamPtr()->eof())
+    {
+      return false;
+    }
+
+    // Check the image description as gdcm::ImageRegionReader does, with the
+    // checks of gdcm::ImageReader that need no pixel data
+    const gdcm::File &           file = this->GetFile();
+    const gdcm::TransferSyntax & transferSyntax = file.GetHeader().GetDataSetTransferSyntax();
+    gdcm::MediaStorage           mediaStorage;
+    mediaStorage.SetFromFile(file);
+    if (!gdcm::MediaStorage::IsImage(mediaStorage))
+    {
+      return false;
+    }
+    PixelData->SetTransferSyntax(transferSyntax);
+    if (!this->ReadImageInternal(mediaStorage, false))
+    {
+      return false;
+    }
+
+    // Only the pixel data of an encapsulated image may give its missing size
+    const unsigned int * dimensions = PixelData->GetDimensions();
+    return (dimensions[0] != 0 && dimensions[1] != 0) || transferSyntax.IsEncapsulated();
+  }
+};
+} // namespace
+
+/** gdcm::SerieHelper reading the headers of the files of a directory
+ * concurrently. The files are then added in the order of the directory,
+ * so that the series found and the order of their files do not depend on
+ * the order in which the headers were read. */
+class GDCMSeriesFileNames::ParallelSerieHelper : public gdcm::SerieHelper
+{
+public:
+  void
+  SetDirectory(std::string const & dir, bool recursive)
+  {
+    gdcm::Directory directory;
+    directory.Load(dir, recursive);
+    const gdcm::Directory::FilenamesType & filenames = directory.GetFilenames();
+
+    // Only DICOM files containing a valid image (Pixel Data element) are added
+    std::vector<gdcm::SmartPointer<gdcm::FileWithName>> files(filenames.size());
+    MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      filenames.size(),
+      [&](SizeValueType i) {
+        HeaderReader reader;
+        reader.SetFileName(filenames[i].c_str());
+        if (reader.ReadUpToPixelData())
+        {
+          files[i] = new gdcm::FileWithName(reader.GetFile());
+          files[i]->filename = filenames[i];
+        }
+      },
+      nullptr);
+
+    for (const auto & file : files)
+    {
+      if (file)
+      {
+        this->AddFile(*file);
+      }
+    }
+  }
+};
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
-  : m_SerieHelper{ new gdcm::SerieHelper() }
+  : m_SerieHelper{ new ParallelSerieHelper() }
 {}
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames() = default;
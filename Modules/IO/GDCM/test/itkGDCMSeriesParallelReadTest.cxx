@@ -0,0 +1,208 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageSeriesReader.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+#include "gdcmAttribute.h"
+#include "gdcmImageReader.h"
+#include "gdcmReader.h"
+#include "gdcmWriter.h"
+
+#include <fstream>
+#include <functional>
+
+// Scan a directory with a series written in reverse name order, a file
+// which is not DICOM, a DICOM file which is not an image, and DICOM files of
+// the series whose image description is invalid, then read the series
+// concurrently and sequentially with the same GDCMImageIO.
+
+namespace
+{
+
+using PixelType = short;
+using SliceType = itk::Image<PixelType, 2>;
+using VolumeType = itk::Image<PixelType, 3>;
+using ReaderType = itk::ImageSeriesReader<VolumeType>;
+
+constexpr unsigned int NumberOfSlices = 10;
+
+PixelType
+PixelValue(const VolumeType::IndexType & index)
+{
+  return static_cast<PixelType>(index[2] * 1000 + index[1] * 64 + index[0]);
+}
+
+std::string
+GetTagValue(const itk::MetaDataDictionary & dictionary, const std::string & tag)
+{
+  std::string value;
+  itk::ExposeMetaData<std::string>(dictionary, tag, value);
+  return value;
+}
+
+// Writes a copy of a DICOM file, with its data set changed
+bool
+WriteChangedFile(const std::string &                       inputFileName,
+                 const std::string &                       outputFileName,
+                 const std::function<void(gdcm::File &)> & change)
+{
+  gdcm::Reader reader;
+  reader.SetFileName(inputFileName.c_str());
+  if (!reader.Read())
+  {
+    return false;
+  }
+  change(reader.GetFile());
+  gdcm::Writer writer;
+  writer.SetFile(reader.GetFile());
+  writer.SetFileName(outputFileName.c_str());
+  return writer.Write();
+}
+
+ReaderType::Pointer
+ReadSeries(const std::vector<std::string> & fileNames, itk::GDCMImageIO * imageIO, unsigned int numberOfWorkUnits)
+{
+  auto reader = ReaderType::New();
+  reader->SetImageIO(imageIO);
+  reader->SetFileNames(fileNames);
+  reader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  reader->Update();
+  return reader;
+}
+
+} // namespace
+
+int
+itkGDCMSeriesParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/itkGDCMSeriesParallelReadTest";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+
+  // The series, slice z being in the file named 9 - z, with one writer so
+  // that all the files share the same Series Instance UID
+  auto slice = SliceType::New();
+  slice->SetRegions(SliceType::SizeType{ { 64, 48 } });
+  slice->Allocate();
+  auto writer = itk::ImageFileWriter<SliceType>::New();
+  writer->SetInput(slice);
+  writer->SetImageIO(itk::GDCMImageIO::New());
+  for (unsigned int z = 0; z < NumberOfSlices; ++z)
+  {
+    for (itk::ImageRegionIteratorWithIndex<SliceType> it(slice, slice->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(PixelValue({ { it.GetIndex()[0], it.GetIndex()[1], z } }));
+    }
+    slice->Modified();
+    itk::MetaDataDictionary & dictionary = slice->GetMetaDataDictionary();
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|0016", "1.2.840.10008.5.1.4.1.1.2"); // CT Image Storage
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "CT");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0032", "0\\0\\" + std::to_string(2.5 * z));
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0013", std::to_string(z + 1));
+    writer->SetFileName(directory + "/slice" + std::to_string(NumberOfSlices - 1 - z) + ".dcm");
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+  std::ofstream(directory + "/notes.txt") << "Not a DICOM file" << std::endl;
+
+  // A text report, without Pixel Data
+  const std::string sliceFileName = directory + "/slice0.dcm";
+  ITK_TEST_EXPECT_TRUE(WriteChangedFile(sliceFileName, directory + "/report.dcm", [](gdcm::File & file) {
+    const char * basicTextSR = "1.2.840.10008.5.1.4.1.1.88.11";
+    file.GetHeader().Replace(gdcm::Attribute<0x0002, 0x0002>{ basicTextSR }.GetAsDataElement());
+    file.GetDataSet().Replace(gdcm::Attribute<0x0008, 0x0016>{ basicTextSR }.GetAsDataElement());
+    file.GetDataSet().Remove(gdcm::Tag(0x7fe0, 0x0010));
+  }));
+  // Images of the series that gdcm::ImageReader cannot read
+  ITK_TEST_EXPECT_TRUE(WriteChangedFile(sliceFileName, directory + "/noRows.dcm", [](gdcm::File & file) {
+    file.GetDataSet().Remove(gdcm::Tag(0x0028, 0x0010));
+  }));
+  ITK_TEST_EXPECT_TRUE(WriteChangedFile(sliceFileName, directory + "/samplesPerPixel.dcm", [](gdcm::File & file) {
+    file.GetDataSet().Replace(gdcm::Attribute<0x0028, 0x0002>{ 5 }.GetAsDataElement());
+    file.GetDataSet().Remove(gdcm::Tag(0x0028, 0x0004));
+  }));
+  for (const char * fileName : { "/noRows.dcm", "/samplesPerPixel.dcm" })
+  {
+    gdcm::ImageReader imageReader;
+    imageReader.SetFileName((directory + fileName).c_str());
+    ITK_TEST_EXPECT_TRUE(!imageReader.Read());
+  }
+
+  auto seriesFileNames = itk::GDCMSeriesFileNames::New();
+  seriesFileNames->SetInputDirectory(directory);
+  ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetSeriesUIDs().size(), 1u);
+  const std::vector<std::string> fileNames = seriesFileNames->GetInputFileNames();
+  ITK_TEST_EXPECT_EQUAL(fileNames.size(), NumberOfSlices);
+  for (unsigned int z = 0; z < fileNames.size(); ++z)
+  {
+    ITK_TEST_EXPECT_EQUAL(itksys::SystemTools::GetFilenameName(fileNames[z]),
+                          "slice" + std::to_string(NumberOfSlices - 1 - z) + ".dcm");
+  }
+
+  auto                imageIO = itk::GDCMImageIO::New();
+  ReaderType::Pointer parallelReader;
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelReader = ReadSeries(fileNames, imageIO, 4));
+  // The ImageIO set is left with the information of the last file
+  const std::string lastPosition = GetTagValue(imageIO->GetMetaDataDictionary(), "0020|0032");
+
+  ReaderType::Pointer sequentialReader;
+  ITK_TRY_EXPECT_NO_EXCEPTION(sequentialReader = ReadSeries(fileNames, imageIO, 1));
+  ITK_TEST_EXPECT_EQUAL(lastPosition, GetTagValue(imageIO->GetMetaDataDictionary(), "0020|0032"));
+
+  const VolumeType * image = parallelReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(image->GetLargestPossibleRegion().GetSize(2), NumberOfSlices);
+  ITK_TEST_EXPECT_TRUE(itk::Math::AlmostEquals(image->GetSpacing()[2], 2.5));
+  for (itk::ImageRegionConstIterator<VolumeType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != PixelValue(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << it.GetIndex() << ": expected " << PixelValue(it.GetIndex()) << ", but got "
+                << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const ReaderType::DictionaryArrayType & parallelDictionaries = *parallelReader->GetMetaDataDictionaryArray();
+  const ReaderType::DictionaryArrayType & sequentialDictionaries = *sequentialReader->GetMetaDataDictionaryArray();
+  ITK_TEST_EXPECT_EQUAL(parallelDictionaries.size(), NumberOfSlices);
+  ITK_TEST_EXPECT_EQUAL(sequentialDictionaries.size(), NumberOfSlices);
+  for (unsigned int z = 0; z < NumberOfSlices; ++z)
+  {
+    for (const std::string tag : { "0020|0032", "0020|0013", "0020|000e", "0008|0018" })
+    {
+      ITK_TEST_EXPECT_EQUAL(GetTagValue(*parallelDictionaries[z], tag), GetTagValue(*sequentialDictionaries[z], tag));
+    }
+    ITK_TEST_EXPECT_EQUAL(std::stoi(GetTagValue(*parallelDictionaries[z], "0020|0013")), static_cast<int>(z + 1));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
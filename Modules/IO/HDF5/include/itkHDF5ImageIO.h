@@ -79,6 +79,12 @@ namespace itk
  *                             in the MetaDataDictionary
  * re-arrangement.
  *
+ * The voxel data is chunked and compressed. By default a chunk is a slice
+ * of the image, along its slowest moving dimension. Another chunk shape,
+ * such as cubes, can be set with SetChunkSize(). Regions are streamed by
+ * hyperslabs, enlarged when reading, and split when writing, along the
+ * boundaries of the chunks, so that each chunk is compressed once and is
+ * decompressed by one read.
  *
  */
 
@@ -137,6 +143,40 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Enlarges the requested region to the boundaries of the chunks of the
+   * dataset, when streaming. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
+  /** The pieces written are made of whole chunks, split along the slowest
+   * moving dimension that spans several chunks. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the size of the chunks of the written dataset, in pixels,
+   * fastest moving dimension first. The chunks span one pixel along the
+   * dimensions missing, and at most the image along each dimension.
+   * Pixel components are always in the same chunk. By default, empty, a
+   * chunk is a slice along the slowest moving dimension. */
+  void
+  SetChunkSize(const ImageIORegion::SizeType & chunkSize)
+  {
+    if (this->m_ChunkSize != chunkSize)
+    {
+      this->m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  itkGetConstReferenceMacro(ChunkSize, ImageIORegion::SizeType);
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -203,6 +243,11 @@ private:
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
 
+  // Size of the chunks of the dataset to write, fastest moving dimension
+  // first, without the pixel components
+  ImageIORegion::SizeType
+  GetChunkSizeForWriting() const;
+
   void
   CloseH5File();
   void
@@ -211,6 +256,10 @@ private:
   H5::H5File *  m_H5File{ nullptr };
   H5::DataSet * m_VoxelDataSet{ nullptr };
   bool          m_ImageInformationWritten{ false };
+
+  ImageIORegion::SizeType m_ChunkSize;
+  // Size of the chunks of the dataset read, fastest moving dimension first
+  ImageIORegion::SizeType m_DataSetChunkSize;
 };
 } // end namespace itk
 
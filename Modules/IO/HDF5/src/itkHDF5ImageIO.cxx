@@ -55,6 +55,12 @@ HDF5ImageIO ::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << this->m_H5File << std::endl;
+  os << indent << "ChunkSize:";
+  for (auto size : this->m_ChunkSize)
+  {
+    os << " " << size;
+  }
+  os << std::endl;
 }
 
 //
@@ -733,6 +739,46 @@ HDF5ImageIO ::ReadImageInformation()
       }
     }
     //
+    // the chunks of the dataset, along which boundaries regions are streamed
+    {
+      this->m_DataSetChunkSize.assign(numDims, 1);
+      H5::DSetCreatPropList plist = imageSet.getCreatePlist();
+      if (plist.getLayout() == H5D_CHUNKED)
+      {
+        const int                        nDims = imageSpace.getSimpleExtentNdims();
+        const std::unique_ptr<hsize_t[]> chunkDims(new hsize_t[nDims]);
+        plist.getChunk(nDims, chunkDims.get());
+        for (int i = 0; i < numDims; i++)
+        {
+          this->m_DataSetChunkSize[i] = chunkDims[numDims - 1 - i];
+        }
+
+        // cache a layer of chunks along the slowest moving dimension, so
+        // that the pieces of a region streamed in it do not decompress
+        // the chunks again
+        SizeValueType layerSize = this->GetComponentSize() * this->GetNumberOfComponents();
+        SizeValueType chunksInLayer = 1;
+        for (int i = 0; i < numDims; i++)
+        {
+          const SizeValueType chunkSize = this->m_DataSetChunkSize[i];
+          const SizeValueType numberOfChunks =
+            i + 1 < numDims ? (this->GetDimensions(i) + chunkSize - 1) / chunkSize : 1;
+          chunksInLayer *= numberOfChunks;
+          layerSize *= numberOfChunks * chunkSize;
+        }
+        constexpr SizeValueType defaultCacheSize = 1024 * 1024;
+        constexpr SizeValueType maximumCacheSize = 256 * 1024 * 1024;
+        if (layerSize > defaultCacheSize)
+        {
+          H5::DSetAccPropList dapl;
+          dapl.setChunkCache(static_cast<size_t>(std::max<SizeValueType>(100 * chunksInLayer + 1, 521)),
+                             static_cast<size_t>(std::min(layerSize, maximumCacheSize)),
+                             H5D_CHUNK_CACHE_W0_DEFAULT);
+          *(this->m_VoxelDataSet) = this->m_H5File->openDataSet(VoxelDataName, dapl);
+        }
+      }
+    }
+    //
     // read out metadata
     MetaDataDictionary & metaDict = this->GetMetaDataDictionary();
     // Necessary to clear dict if ImageIO object is re-used
@@ -1072,14 +1118,18 @@ HDF5ImageIO ::WriteImageInformation()
     H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
+    // by default, set the chunk size to be the N-1 dimension
     // region
     H5::DSetCreatPropList plist;
 
     // we have implicit compression enabled here?
     plist.setDeflate(this->GetCompressionLevel());
 
-    dims[0] = 1;
+    const ImageIORegion::SizeType chunkSize = this->GetChunkSizeForWriting();
+    for (int i(0), j(static_cast<int>(chunkSize.size()) - 1); j >= 0; i++, j--)
+    {
+      dims[i] = chunkSize[j];
+    }
     plist.setChunk(numDims, dims.get());
     dims.reset();
 
@@ -1257,6 +1307,18 @@ HDF5ImageIO ::WriteImageInformation()
 void
 HDF5ImageIO ::Write(const void * buffer)
 {
+  // A write starts with the piece at the start of the image, for which the
+  // file of a previous write is not reused
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  bool                  startsWrite = true;
+  for (unsigned int i = 0; i < ioRegion.GetImageDimension(); ++i)
+  {
+    startsWrite = startsWrite && ioRegion.GetIndex(i) == 0;
+  }
+  if (startsWrite)
+  {
+    this->m_ImageInformationWritten = false;
+  }
   this->WriteImageInformation();
   try
   {
@@ -1303,6 +1365,58 @@ HDF5ImageIO ::Write(const void * buffer)
   }
 }
 
+ImageIORegion::SizeType
+HDF5ImageIO ::GetChunkSizeForWriting() const
+{
+  const unsigned int      numDims = this->GetNumberOfDimensions();
+  ImageIORegion::SizeType chunkSize(numDims);
+  for (unsigned int i = 0; i < numDims; i++)
+  {
+    if (this->m_ChunkSize.empty())
+    {
+      chunkSize[i] = i + 1 < numDims ? this->GetDimensions(i) : 1;
+    }
+    else
+    {
+      chunkSize[i] = i < this->m_ChunkSize.size() ? this->m_ChunkSize[i] : 1;
+      chunkSize[i] = std::max<SizeValueType>(std::min<SizeValueType>(chunkSize[i], this->GetDimensions(i)), 1);
+    }
+  }
+  return chunkSize;
+}
+
+ImageIORegion
+HDF5ImageIO ::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  return this->EnlargeRegionToChunks(Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested),
+                                     this->m_DataSetChunkSize);
+}
+
+unsigned int
+HDF5ImageIO ::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                                const ImageIORegion & pasteRegion,
+                                                const ImageIORegion & largestPossibleRegion)
+{
+  const unsigned int numberOfSplits =
+    Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  if (numberOfSplits <= 1)
+  {
+    return numberOfSplits;
+  }
+  return this->GetActualNumberOfSplitsForWritingChunks(
+    numberOfRequestedSplits, pasteRegion, this->GetChunkSizeForWriting());
+}
+
+ImageIORegion
+HDF5ImageIO ::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                       unsigned int          numberOfActualSplits,
+                                       const ImageIORegion & pasteRegion,
+                                       const ImageIORegion & itkNotUsed(largestPossibleRegion))
+{
+  return this->GetSplitRegionForWritingChunks(
+    ithPiece, numberOfActualSplits, pasteRegion, this->GetChunkSizeForWriting());
+}
+
 //
 // GetHeaderSize -- return 0
 ImageIOBase::SizeType
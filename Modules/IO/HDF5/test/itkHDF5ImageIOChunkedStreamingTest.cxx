@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHDF5ImageIO.h"
+#include "itkHDF5ImageIOFactory.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image<PixelType, 3>;
+using MonitorFilterType = itk::PipelineMonitorImageFilter<ImageType>;
+
+PixelType
+PixelValue(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[2] * 1000 + index[1] * 40 + index[0]);
+}
+
+bool
+CheckPixels(const ImageType * image)
+{
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != PixelValue(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << it.GetIndex() << ": expected " << PixelValue(it.GetIndex()) << ", but got "
+                << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The region read for the requested one, with the chunks of the file
+bool
+CheckStreamableRegion(const std::string &        fileName,
+                      const ImageType::IndexType & requestedIndex,
+                      const ImageType::SizeType &  requestedSize,
+                      const ImageType::IndexType & expectedIndex,
+                      const ImageType::SizeType &  expectedSize)
+{
+  auto imageIO = itk::HDF5ImageIO::New();
+  imageIO->SetFileName(fileName);
+  imageIO->SetUseStreamedReading(true);
+  imageIO->ReadImageInformation();
+
+  itk::ImageIORegion requested(3);
+  itk::ImageIORegion expected(3);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    requested.SetIndex(i, requestedIndex[i]);
+    requested.SetSize(i, requestedSize[i]);
+    expected.SetIndex(i, expectedIndex[i]);
+    expected.SetSize(i, expectedSize[i]);
+  }
+  const itk::ImageIORegion streamable = imageIO->GenerateStreamableReadRegionFromRequestedRegion(requested);
+  if (streamable != expected)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Region read for " << requested << " in " << fileName << " is " << streamable << ", expected "
+              << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkHDF5ImageIOChunkedStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkHDF5ImageIOChunkedStreamingTest.hdf5";
+  const std::string chunkedFileName = std::string(argv[1]) + "/itkHDF5ImageIOChunkedStreamingTestCubes.hdf5";
+  const std::string slabsFileName = std::string(argv[1]) + "/itkHDF5ImageIOChunkedStreamingTestSlabs.hdf5";
+
+  itk::ObjectFactoryBase::RegisterFactory(itk::HDF5ImageIOFactory::New());
+
+  auto imageIO = itk::HDF5ImageIO::New();
+  ITK_TEST_EXPECT_TRUE(imageIO->GetChunkSize().empty());
+  itk::ImageIORegion::SizeType chunkSize{ 16, 16, 16 };
+  imageIO->SetChunkSize(chunkSize);
+  ITK_TEST_EXPECT_TRUE(imageIO->GetChunkSize() == chunkSize);
+
+  ImageType::SizeType size = { { 40, 30, 20 } };
+  auto                image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PixelValue(it.GetIndex()));
+  }
+
+  // Written whole, with the default chunks of one slice
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(itk::HDF5ImageIO::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  ITK_TEST_EXPECT_TRUE(
+    CheckStreamableRegion(fileName, { { 5, 5, 5 } }, { { 3, 3, 3 } }, { { 0, 0, 5 } }, { { 40, 30, 3 } }));
+
+  // Streamed into cubic chunks, which are written by whole layers
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetUseStreaming(true);
+  auto writerMonitor = MonitorFilterType::New();
+  writerMonitor->SetInput(reader->GetOutput());
+
+  auto chunkedWriter = itk::ImageFileWriter<ImageType>::New();
+  chunkedWriter->SetInput(writerMonitor->GetOutput());
+  chunkedWriter->SetFileName(chunkedFileName);
+  chunkedWriter->SetImageIO(imageIO);
+  chunkedWriter->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedWriter->Update());
+
+  const MonitorFilterType::RegionVectorType writtenRegions = writerMonitor->GetUpdatedBufferedRegions();
+  ITK_TEST_EXPECT_EQUAL(writtenRegions.size(), 2u);
+  ITK_TEST_EXPECT_EQUAL(writtenRegions[0], ImageType::RegionType({ { 0, 0, 0 } }, { { 40, 30, 16 } }));
+  ITK_TEST_EXPECT_EQUAL(writtenRegions[1], ImageType::RegionType({ { 0, 0, 16 } }, { { 40, 30, 4 } }));
+
+  ITK_TEST_EXPECT_TRUE(
+    CheckStreamableRegion(chunkedFileName, { { 5, 5, 5 } }, { { 3, 3, 3 } }, { { 0, 0, 0 } }, { { 16, 16, 16 } }));
+  ITK_TEST_EXPECT_TRUE(CheckStreamableRegion(
+    chunkedFileName, { { 20, 20, 17 } }, { { 10, 5, 2 } }, { { 16, 16, 16 } }, { { 16, 14, 4 } }));
+
+  // Read in pieces enlarged to the chunks, the five pieces requested being
+  // in the two layers of chunks read
+  auto chunkedReader = itk::ImageFileReader<ImageType>::New();
+  chunkedReader->SetFileName(chunkedFileName);
+  chunkedReader->SetUseStreaming(true);
+  auto readerMonitor = MonitorFilterType::New();
+  readerMonitor->SetInput(chunkedReader->GetOutput());
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(readerMonitor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  ITK_TEST_EXPECT_TRUE(readerMonitor->VerifyAllInputCanStream(2));
+  for (const auto & region : readerMonitor->GetUpdatedBufferedRegions())
+  {
+    ITK_TEST_EXPECT_EQUAL(region.GetIndex(2) % 16, 0);
+    ITK_TEST_EXPECT_TRUE(region.GetSize(2) == 16 || region.GetIndex(2) + region.GetSize(2) == 20);
+  }
+  ITK_TEST_EXPECT_TRUE(CheckPixels(streamer->GetOutput()));
+
+  // The chunks span one pixel along the dimensions missing
+  imageIO->SetChunkSize({ 16, 8 });
+  chunkedWriter->SetFileName(slabsFileName);
+  chunkedWriter->SetNumberOfStreamDivisions(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedWriter->Update());
+  ITK_TEST_EXPECT_TRUE(
+    CheckStreamableRegion(slabsFileName, { { 5, 5, 5 } }, { { 3, 3, 3 } }, { { 0, 0, 5 } }, { { 16, 8, 3 } }));
+
+  auto slabsReader = itk::ImageFileReader<ImageType>::New();
+  slabsReader->SetFileName(slabsFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(slabsReader->Update());
+  ITK_TEST_EXPECT_TRUE(CheckPixels(slabsReader->GetOutput()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockCompressor_h
+#define itkBlockCompressor_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+#include "itkThreadSupport.h"
+#include <functional>
+#include <vector>
+
+namespace itk
+{
+/** \class BlockCompressor
+ * \brief Compress a buffer as independent blocks, in parallel.
+ *
+ * BlockCompressor is the abstract base of the codecs that ImageIO classes
+ * use to compress pixel data. The data is split into blocks of BlockSize
+ * bytes, which are compressed independently of each other by the work
+ * units of a MultiThreaderBase, and then concatenated, between the header
+ * and the trailer of the codec, into a single compressed stream. Subclasses
+ * write blocks that chain into a stream that any decoder of the format can
+ * read, so the files stay readable by other software.
+ *
+ * Compressing blocks independently costs a little compression ratio, but
+ * the time of writing large compressed images no longer grows with the
+ * speed of a single core. Since each block starts at a known position in
+ * the compressed stream, a reader that knows these positions decompresses
+ * the blocks in parallel with Decompress(), and can decompress only the
+ * blocks that hold the bytes it needs.
+ *
+ * \sa DeflateBlockCompressor
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT BlockCompressor : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BlockCompressor);
+
+  /** Standard class type aliases. */
+  using Self = BlockCompressor;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BlockCompressor, Object);
+
+  /** Type for representing sizes and positions in bytes. */
+  using SizeType = ::itk::intmax_t;
+
+  /** Set/Get the number of uncompressed bytes per block, 1 MiB by default.
+   * Blocks are at most 1 GiB. */
+  itkSetClampMacro(BlockSize, SizeType, 1, SizeType{ 1 } << 30);
+  itkGetConstMacro(BlockSize, SizeType);
+
+  /** Set/Get the compression level, whose meaning and range depend on the
+   * codec. */
+  itkSetMacro(CompressionLevel, int);
+  itkGetConstMacro(CompressionLevel, int);
+
+  /** Set/Get the number of work units that compress or decompress the
+   * blocks; the global default number of threads by default. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
+  /** Compress numberOfBytes bytes of data into a complete stream of the
+   * format of the codec, which replaces the content of compressed. When
+   * blockOffsets is not null, it receives the position in compressed at
+   * which each block starts. Throws an ExceptionObject when compression
+   * fails. */
+  void
+  Compress(const void *            data,
+           SizeType                numberOfBytes,
+           std::vector<char> &     compressed,
+           std::vector<SizeType> * blockOffsets = nullptr) const;
+
+  /** Decompress consecutive blocks written by Compress() with the same
+   * BlockSize. compressed holds compressedSize bytes of compressed data, in
+   * which the blocks start at the given offsets; the last block ends at
+   * compressedSize at the latest. The blocks decompress to numberOfBytes
+   * bytes: BlockSize bytes per block, except for the last block, which may
+   * be shorter. Throws an ExceptionObject when the data is corrupted. */
+  void
+  Decompress(const void *                  compressed,
+             SizeType                      compressedSize,
+             const std::vector<SizeType> & blockOffsets,
+             void *                        data,
+             SizeType                      numberOfBytes) const;
+
+protected:
+  BlockCompressor();
+  ~BlockCompressor() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** A compressed block, with the size and check value (such as a CRC) of
+   * its uncompressed data. */
+  struct CompressedBlock
+  {
+    std::vector<char> m_Data;
+    SizeType          m_UncompressedSize{ 0 };
+    uint32_t          m_Check{ 0 };
+  };
+
+  /** Compress one block; isLastBlock tells whether the block ends the
+   * stream. Called concurrently for different blocks. */
+  virtual void
+  CompressBlock(const char * data, SizeType numberOfBytes, bool isLastBlock, CompressedBlock & block) const = 0;
+
+  /** Decompress one block of compressedSize bytes into numberOfBytes
+   * bytes. Called concurrently for different blocks. */
+  virtual void
+  DecompressBlock(const char * compressed, SizeType compressedSize, char * data, SizeType numberOfBytes) const = 0;
+
+  /** Append the header of the stream. */
+  virtual void
+  AppendHeader(std::vector<char> & compressed) const;
+
+  /** Append the trailer of the stream, which follows the given blocks. */
+  virtual void
+  AppendTrailer(const std::vector<CompressedBlock> & blocks, std::vector<char> & compressed) const;
+
+private:
+  /** Call function for each block index, on the work units when there are
+   * several blocks. */
+  void
+  ForEachBlock(SizeValueType numberOfBlocks, const std::function<void(SizeValueType)> & function) const;
+
+  SizeType     m_BlockSize;
+  int          m_CompressionLevel{ 0 };
+  ThreadIdType m_NumberOfWorkUnits;
+};
+} // end namespace itk
+
+#endif // itkBlockCompressor_h
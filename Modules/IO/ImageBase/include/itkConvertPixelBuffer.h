@@ -36,6 +36,9 @@ namespace itk
  * OutputConvertTraits() is the traits class.  The default one used is
  * DefaultConvertPixelTraits.
  *
+ * Large buffers are converted in parallel, by chunks of pixels, using
+ * the global default number of threads of MultiThreaderBase.
+ *
  * \ingroup ITKIOImageBase
  *
  * \sphinx
@@ -173,6 +176,30 @@ protected:
   template <typename UComponentType>
   static typename EnableIfC<NumericTraits<UComponentType>::IsInteger, UComponentType>::Type
   DefaultAlphaValue();
+
+private:
+  using ConvertFunctionType = void (*)(InputPixelType *, OutputPixelType *, size_t);
+  using ConvertMultiComponentFunctionType = void (*)(InputPixelType *, int, OutputPixelType *, size_t);
+
+  /** Number of pixels converted by each work unit. */
+  static constexpr size_t PixelsPerChunk = 65536;
+
+  /** Split the buffer into chunks of PixelsPerChunk pixels, converted in
+   * parallel by convert. A buffer of a single chunk is converted by the
+   * calling thread. */
+  static void
+  ConvertInParallel(ConvertFunctionType convert,
+                    InputPixelType *    inputData,
+                    int                 inputNumberOfComponents,
+                    OutputPixelType *   outputData,
+                    size_t              size);
+
+  static void
+  ConvertInParallel(ConvertMultiComponentFunctionType convert,
+                    InputPixelType *                  inputData,
+                    int                               inputNumberOfComponents,
+                    OutputPixelType *                 outputData,
+                    size_t                            size);
 };
 } // namespace itk
 
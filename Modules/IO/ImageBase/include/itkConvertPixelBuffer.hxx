@@ -21,6 +21,8 @@
 
 #include "itkRGBPixel.h"
 #include "itkDefaultConvertPixelTraits.h"
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
 #include <cstddef>
 
 
@@ -58,16 +60,16 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
       switch (inputNumberOfComponents)
       {
         case 1:
-          ConvertGrayToGray(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertGrayToGray, inputData, 1, outputData, size);
           break;
         case 3:
-          ConvertRGBToGray(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertRGBToGray, inputData, 3, outputData, size);
           break;
         case 4:
-          ConvertRGBAToGray(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertRGBAToGray, inputData, 4, outputData, size);
           break;
         default:
-          ConvertMultiComponentToGray(inputData, inputNumberOfComponents, outputData, size);
+          ConvertInParallel(&Self::ConvertMultiComponentToGray, inputData, inputNumberOfComponents, outputData, size);
           break;
       }
       break;
@@ -78,13 +80,14 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
       switch (inputNumberOfComponents)
       {
         case 1:
-          ConvertGrayToComplex(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertGrayToComplex, inputData, 1, outputData, size);
           break;
         case 2:
-          ConvertComplexToComplex(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertComplexToComplex, inputData, 2, outputData, size);
           break;
         default:
-          ConvertMultiComponentToComplex(inputData, inputNumberOfComponents, outputData, size);
+          ConvertInParallel(
+            &Self::ConvertMultiComponentToComplex, inputData, inputNumberOfComponents, outputData, size);
           break;
       }
       break;
@@ -96,16 +99,16 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
       switch (inputNumberOfComponents)
       {
         case 1:
-          ConvertGrayToRGB(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertGrayToRGB, inputData, 1, outputData, size);
           break;
         case 3:
-          ConvertRGBToRGB(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertRGBToRGB, inputData, 3, outputData, size);
           break;
         case 4:
-          ConvertRGBAToRGB(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertRGBAToRGB, inputData, 4, outputData, size);
           break;
         default:
-          ConvertMultiComponentToRGB(inputData, inputNumberOfComponents, outputData, size);
+          ConvertInParallel(&Self::ConvertMultiComponentToRGB, inputData, inputNumberOfComponents, outputData, size);
       }
       break;
     }
@@ -115,16 +118,16 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
       switch (inputNumberOfComponents)
       {
         case 1:
-          ConvertGrayToRGBA(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertGrayToRGBA, inputData, 1, outputData, size);
           break;
         case 3:
-          ConvertRGBToRGBA(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertRGBToRGBA, inputData, 3, outputData, size);
           break;
         case 4:
-          ConvertRGBAToRGBA(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertRGBAToRGBA, inputData, 4, outputData, size);
           break;
         default:
-          ConvertMultiComponentToRGBA(inputData, inputNumberOfComponents, outputData, size);
+          ConvertInParallel(&Self::ConvertMultiComponentToRGBA, inputData, inputNumberOfComponents, outputData, size);
       }
       break;
     }
@@ -134,10 +137,10 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
       switch (inputNumberOfComponents)
       {
         case 6:
-          ConvertTensor6ToTensor6(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertTensor6ToTensor6, inputData, 6, outputData, size);
           break;
         case 9:
-          ConvertTensor9ToTensor6(inputData, outputData, size);
+          ConvertInParallel(&Self::ConvertTensor9ToTensor6, inputData, 9, outputData, size);
           break;
         default:
           itkGenericExceptionMacro("No conversion available from " << inputNumberOfComponents
@@ -463,6 +466,7 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
       OutputConvertTraits::SetNthComponent(1, *outputData, val);
       OutputConvertTraits::SetNthComponent(2, *outputData, val);
       OutputConvertTraits::SetNthComponent(3, *outputData, alpha);
+      outputData++;
     }
   }
   else
@@ -589,14 +593,65 @@ ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::Conver
   OutputPixelType * outputData,
   size_t            size)
 {
-  size_t length = size * (size_t)inputNumberOfComponents;
+  // The components are converted one by one, as gray pixels
+  ConvertInParallel(&Self::ConvertGrayToGray, inputData, 1, outputData, size * (size_t)inputNumberOfComponents);
+}
 
-  for (size_t i = 0; i < length; i++)
+template <typename InputPixelType, typename OutputPixelType, typename OutputConvertTraits>
+void
+ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::ConvertInParallel(
+  ConvertFunctionType convert,
+  InputPixelType *    inputData,
+  int                 inputNumberOfComponents,
+  OutputPixelType *   outputData,
+  size_t              size)
+{
+  const size_t numberOfChunks = (size + PixelsPerChunk - 1) / PixelsPerChunk;
+  if (numberOfChunks <= 1)
   {
-    OutputConvertTraits::SetNthComponent(0, *outputData, static_cast<OutputComponentType>(*inputData));
-    ++outputData;
-    ++inputData;
+    convert(inputData, outputData, size);
+    return;
+  }
+
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [convert, inputData, inputNumberOfComponents, outputData, size](SizeValueType chunk) {
+      const size_t first = chunk * PixelsPerChunk;
+      convert(inputData + first * (size_t)inputNumberOfComponents,
+              outputData + first,
+              std::min(size - first, static_cast<size_t>(PixelsPerChunk)));
+    },
+    nullptr);
+}
+
+template <typename InputPixelType, typename OutputPixelType, typename OutputConvertTraits>
+void
+ConvertPixelBuffer<InputPixelType, OutputPixelType, OutputConvertTraits>::ConvertInParallel(
+  ConvertMultiComponentFunctionType convert,
+  InputPixelType *                  inputData,
+  int                               inputNumberOfComponents,
+  OutputPixelType *                 outputData,
+  size_t                            size)
+{
+  const size_t numberOfChunks = (size + PixelsPerChunk - 1) / PixelsPerChunk;
+  if (numberOfChunks <= 1)
+  {
+    convert(inputData, inputNumberOfComponents, outputData, size);
+    return;
   }
+
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [convert, inputData, inputNumberOfComponents, outputData, size](SizeValueType chunk) {
+      const size_t first = chunk * PixelsPerChunk;
+      convert(inputData + first * (size_t)inputNumberOfComponents,
+              inputNumberOfComponents,
+              outputData + first,
+              std::min(size - first, static_cast<size_t>(PixelsPerChunk)));
+    },
+    nullptr);
 }
 } // end namespace itk
 
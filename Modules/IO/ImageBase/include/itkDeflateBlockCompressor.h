@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkDeflateBlockCompressor_h
+#define itkDeflateBlockCompressor_h
+
+#include "itkBlockCompressor.h"
+
+namespace itk
+{
+/**\class DeflateBlockCompressorEnums
+ * \brief Contains all enum classes used by DeflateBlockCompressor class.
+ * \ingroup ITKIOImageBase
+ */
+class DeflateBlockCompressorEnums
+{
+public:
+  /**\class Format
+   * \ingroup ITKIOImageBase
+   * The framing of the deflate stream. */
+  enum class Format : uint8_t
+  {
+    Zlib, // RFC 1950, with an Adler-32 checksum
+    Gzip  // RFC 1952, with a CRC-32 and the uncompressed size
+  };
+
+  /**\class Strategy
+   * \ingroup ITKIOImageBase
+   * The deflate strategy. RunLength only matches repeats of the previous
+   * byte, which is several times faster than the default strategy and
+   * compresses label images nearly as well. HuffmanOnly does no matching
+   * at all. */
+  enum class Strategy : uint8_t
+  {
+    Default,
+    RunLength,
+    HuffmanOnly
+  };
+};
+// Define how to print enumeration
+extern ITKIOImageBase_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const DeflateBlockCompressorEnums::Format value);
+extern ITKIOImageBase_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const DeflateBlockCompressorEnums::Strategy value);
+
+/** \class DeflateBlockCompressor
+ * \brief Compress a buffer into a zlib or gzip stream, in parallel.
+ *
+ * Every block is compressed as a raw deflate stream of its own. All blocks
+ * but the last one end with an empty stored block instead of a final
+ * block, so that their concatenation is one valid deflate stream, as done
+ * by pigz. The checksums of the blocks are combined into the checksum of
+ * the whole data for the trailer. The result is thus a regular zlib or
+ * gzip stream that any inflate implementation decompresses, and each block
+ * can also be decompressed on its own, as raw deflate data, starting at its
+ * offset.
+ *
+ * The compression level is the zlib one, from 1 (fastest) to 9 (best); the
+ * default is 6.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT DeflateBlockCompressor : public BlockCompressor
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DeflateBlockCompressor);
+
+  /** Standard class type aliases. */
+  using Self = DeflateBlockCompressor;
+  using Superclass = BlockCompressor;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DeflateBlockCompressor, BlockCompressor);
+
+  using FormatEnum = DeflateBlockCompressorEnums::Format;
+  using StrategyEnum = DeflateBlockCompressorEnums::Strategy;
+
+  /** Set/Get the framing of the stream, zlib by default. */
+  itkSetEnumMacro(Format, FormatEnum);
+  itkGetEnumMacro(Format, FormatEnum);
+
+  /** Set/Get the deflate strategy, Default by default. */
+  itkSetEnumMacro(Strategy, StrategyEnum);
+  itkGetEnumMacro(Strategy, StrategyEnum);
+
+protected:
+  DeflateBlockCompressor();
+  ~DeflateBlockCompressor() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  CompressBlock(const char * data, SizeType numberOfBytes, bool isLastBlock, CompressedBlock & block) const override;
+
+  void
+  DecompressBlock(const char * compressed, SizeType compressedSize, char * data, SizeType numberOfBytes) const override;
+
+  void
+  AppendHeader(std::vector<char> & compressed) const override;
+
+  void
+  AppendTrailer(const std::vector<CompressedBlock> & blocks, std::vector<char> & compressed) const override;
+
+private:
+  FormatEnum   m_Format{ FormatEnum::Zlib };
+  StrategyEnum m_Strategy{ StrategyEnum::Default };
+};
+} // end namespace itk
+
+#endif // itkDeflateBlockCompressor_h
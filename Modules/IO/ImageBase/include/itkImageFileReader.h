@@ -27,6 +27,12 @@
 #include "itkImageRegion.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace itk
 {
@@ -55,6 +61,11 @@ namespace itk
  * raw binary format) have no accepted suffix, so you will have to
  * manually create the ImageIO instance of the write type.
  *
+ * When streaming, the reader can prefetch: after reading a region, it
+ * reads the regions expected to be requested next on a background thread
+ * while the pipeline processes the region read, so that reading and
+ * processing overlap. See SetNumberOfPrefetchedRegions().
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -118,9 +129,33 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the pixel data may be memory mapped instead of read.
+   * When the ImageIO reports that the file stores the whole image
+   * uncompressed in the layout and byte order of the output pixel type,
+   * the output is given a MemoryMappedImageContainer over the file
+   * instead of a copy of it. Processes mapping the same file share its
+   * pages in the page cache. Off by default. */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstReferenceMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
+  /** Set/Get the number of regions read ahead when streaming, 0, the
+   * default, disabling prefetching. After reading a region, the reader
+   * starts reading, one after the other on a background thread, the regions
+   * that follow it along the slowest moving dimension it does not span, as
+   * the pieces of StreamingImageFilter and ImageFileWriter do. A region
+   * prefetched is given to the pipeline when it is requested, and discarded
+   * otherwise. Prefetching requires an ImageIO that can stream, and at most
+   * this number of regions are held in memory in addition to the output.
+   * The regions are read by a clone of the ImageIO when it can be cloned for
+   * reading; otherwise by the ImageIO itself, which the reader then only
+   * uses once the regions being prefetched are read. */
+  itkSetMacro(NumberOfPrefetchedRegions, unsigned int);
+  itkGetConstMacro(NumberOfPrefetchedRegions, unsigned int);
+
 protected:
   ImageFileReader();
-  ~ImageFileReader() override = default;
+  ~ImageFileReader() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
@@ -153,6 +188,19 @@ protected:
   void
   GenerateData() override;
 
+  /** Give the output a pixel container mapped from the file, when the
+   * ImageIO allows it. Returns false when the pixels must be read. */
+  bool
+  MemoryMapOutput();
+
+  /** Whether the components read by the ImageIO have the representation of
+   * the output components, so that they can be read into the output buffer.
+   * This is the case for the same component type, and for integer types of
+   * the same size and signedness, as long and long long on most 64 bits
+   * systems. */
+  bool
+  IsOutputComponentType() const;
+
   ImageIOBase::Pointer m_ImageIO;
 
   bool m_UserSpecifiedImageIO; // keep track whether the
@@ -160,12 +208,77 @@ protected:
 
   bool m_UseStreaming;
 
+  bool m_UseMemoryMapping;
+
 private:
+  /** The pixel data of a region read in the background. */
+  struct PrefetchedData
+  {
+    ImageIORegion           m_IORegion;
+    std::unique_ptr<char[]> m_Buffer;
+  };
+
+  /** A region expected to be requested, being read in the background. */
+  struct PrefetchedRegion
+  {
+    ImageRegionType             m_RequestedRegion;
+    std::future<PrefetchedData> m_Data;
+  };
+
+  /** Start reading the regions expected to be requested after the last
+   * one. */
+  void
+  PrefetchRegions();
+
+  /** Abandon the reads not started, wait for the one in progress, and
+   * discard the regions prefetched. */
+  void
+  CancelPrefetching();
+
+  /** Wait until the prefetch thread reads no region, and has no read left
+   * to start. The ImageIO it shares may then be used. */
+  void
+  WaitForPrefetchThread();
+
+  /** Read the regions to prefetch, one after the other, until stopped. */
+  void
+  RunPrefetchThread();
+
+  /** The region expected to be requested after region, the next piece
+   * along the slowest dimension it does not span. Returns false when no
+   * region is expected. */
+  bool
+  GetNextRequestedRegion(const ImageRegionType & region, ImageRegionType & next) const;
+
   std::string m_ExceptionMessage;
 
   // The region that the ImageIO class will return when we ask to
   // produce the requested region.
   ImageIORegion m_ActualIORegion;
+
+  unsigned int m_NumberOfPrefetchedRegions{ 0 };
+
+  // The regions prefetched, in the order they are expected to be requested,
+  // and the data of the region requested, when it was prefetched
+  std::deque<PrefetchedRegion> m_PrefetchedRegions;
+  std::unique_ptr<char[]>      m_PrefetchedBuffer;
+  ImageRegionType              m_LastRequestedRegion;
+
+  // The ImageIO that reads the regions prefetched: a clone of m_ImageIO, or
+  // m_ImageIO itself when it cannot be cloned for reading
+  ImageIOBase::Pointer m_PrefetchImageIO;
+
+  // The thread that reads the regions prefetched, the reads it has not
+  // started yet, and whether it is reading one. The futures of the regions
+  // prefetched cannot tell the latter, as they are discarded with the
+  // regions which are not requested.
+  std::thread                                      m_PrefetchThread;
+  std::mutex                                       m_PrefetchMutex;
+  std::condition_variable                          m_PrefetchCondition;
+  std::condition_variable                          m_PrefetchIdleCondition;
+  std::deque<std::packaged_task<PrefetchedData()>> m_PrefetchTasks;
+  bool                                             m_PrefetchReading{ false };
+  bool                                             m_StopPrefetchThread{ false };
 };
 } // namespace itk
 
@@ -25,6 +25,7 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImageContainer.h"
 
 #include "itksys/SystemTools.hxx"
 #include <memory> // For unique_ptr
@@ -39,6 +40,22 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::ImageFileReader()
   this->SetFileName("");
   m_UserSpecifiedImageIO = false;
   m_UseStreaming = true;
+  m_UseMemoryMapping = false;
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+ImageFileReader<TOutputImage, ConvertPixelTraits>::~ImageFileReader()
+{
+  this->CancelPrefetching();
+  if (m_PrefetchThread.joinable())
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+      m_StopPrefetchThread = true;
+    }
+    m_PrefetchCondition.notify_one();
+    m_PrefetchThread.join();
+  }
 }
 
 template <typename TOutputImage, typename ConvertPixelTraits>
@@ -51,6 +68,8 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   os << indent << "UserSpecifiedImageIO flag: " << m_UserSpecifiedImageIO << "\n";
   os << indent << "m_UseStreaming: " << m_UseStreaming << "\n";
+  os << indent << "m_UseMemoryMapping: " << m_UseMemoryMapping << "\n";
+  os << indent << "m_NumberOfPrefetchedRegions: " << m_NumberOfPrefetchedRegions << "\n";
 }
 
 template <typename TOutputImage, typename ConvertPixelTraits>
@@ -74,6 +93,10 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
 
   itkDebugMacro(<< "Reading file for GenerateOutputInformation()" << this->GetFileName());
 
+  // The regions prefetched may be of another file, or use another ImageIO
+  this->CancelPrefetching();
+  m_PrefetchImageIO = nullptr;
+
   // Check to see if we can read the file given the name or prefix
   //
   if (this->GetFileName().empty())
@@ -306,12 +329,46 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::EnlargeOutputRequestedRegion(
 
   ImageIOAdaptor::Convert(imageRequestedRegion, ioRequestedRegion, largestRegion.GetIndex());
 
-  // Tell the IO if we should use streaming while reading
-  m_ImageIO->SetUseStreamedReading(m_UseStreaming);
+  // Take the region from the ones prefetched, discarding the regions
+  // expected before it. The ImageIO may only be used once the prefetch
+  // thread reads no region with it: discarding the futures of the regions
+  // does not wait for their reads.
+  m_LastRequestedRegion = imageRequestedRegion;
+  m_PrefetchedBuffer.reset();
+  while (!m_PrefetchedRegions.empty() && m_PrefetchedRegions.front().m_RequestedRegion != imageRequestedRegion)
+  {
+    m_PrefetchedRegions.pop_front();
+  }
+  if (!m_PrefetchedRegions.empty())
+  {
+    try
+    {
+      PrefetchedData data = m_PrefetchedRegions.front().m_Data.get();
+      m_ActualIORegion = data.m_IORegion;
+      m_PrefetchedBuffer = std::move(data.m_Buffer);
+    }
+    catch (const ExceptionObject & err)
+    {
+      // The region is read again, to report the error
+      itkDebugMacro(<< "Prefetching " << imageRequestedRegion << " failed: " << err.GetDescription());
+    }
+    m_PrefetchedRegions.pop_front();
+  }
+  if (m_PrefetchImageIO == m_ImageIO)
+  {
+    this->WaitForPrefetchThread();
+  }
+  if (!m_PrefetchedBuffer)
+  {
+    this->CancelPrefetching();
+
+    // Tell the IO if we should use streaming while reading
+    m_ImageIO->SetUseStreamedReading(m_UseStreaming);
 
-  // Delegate to the ImageIO the computation of how the
-  // requested region must be enlarged.
-  m_ActualIORegion = m_ImageIO->GenerateStreamableReadRegionFromRequestedRegion(ioRequestedRegion);
+    // Delegate to the ImageIO the computation of how the
+    // requested region must be enlarged.
+    m_ActualIORegion = m_ImageIO->GenerateStreamableReadRegionFromRequestedRegion(ioRequestedRegion);
+  }
 
   // the m_ActualIORegion may be more dimensions then the output
   // Image, in which case we still need to read this larger region to
@@ -356,6 +413,15 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   typename TOutputImage::Pointer output = this->GetOutput();
 
+  // The pixels of the region, when they were prefetched
+  std::unique_ptr<char[]> prefetchedBuffer = std::move(m_PrefetchedBuffer);
+
+  if (!prefetchedBuffer && m_UseMemoryMapping && this->MemoryMapOutput())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
   itkDebugMacro(<< "ImageFileReader::GenerateData() \n"
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << "\n");
@@ -379,11 +445,14 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     m_ExceptionMessage = err.GetDescription();
   }
 
-  // Tell the ImageIO to read the file
-  m_ImageIO->SetFileName(this->GetFileName().c_str());
+  if (!prefetchedBuffer)
+  {
+    // Tell the ImageIO to read the file
+    m_ImageIO->SetFileName(this->GetFileName().c_str());
 
-  itkDebugMacro(<< "Setting imageIO IORegion to: " << m_ActualIORegion);
-  m_ImageIO->SetIORegion(m_ActualIORegion);
+    itkDebugMacro(<< "Setting imageIO IORegion to: " << m_ActualIORegion);
+    m_ImageIO->SetIORegion(m_ActualIORegion);
+  }
 
   // the size of the buffer is computed based on the actual number of
   // pixels to be read and the actual size of the pixels to be read
@@ -391,38 +460,48 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   size_t sizeOfActualIORegion =
     m_ActualIORegion.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents());
 
-  IOComponentEnum ioType = ImageIOBase ::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
-  if (m_ImageIO->GetComponentType() != ioType ||
+  if (!this->IsOutputComponentType() ||
       (m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents()))
   {
     // the pixel types don't match so a type conversion needs to be
     // performed
     itkDebugMacro(<< "Buffer conversion required from: "
                   << m_ImageIO->GetComponentTypeAsString(m_ImageIO->GetComponentType())
-                  << " to: " << m_ImageIO->GetComponentTypeAsString(ioType) << " ConvertPixelTraits::NumComponents "
-                  << ConvertPixelTraits::GetNumberOfComponents() << " m_ImageIO->NumComponents "
-                  << m_ImageIO->GetNumberOfComponents());
-
-    const std::unique_ptr<char[]> loadBuffer(new char[sizeOfActualIORegion]);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+                  << " to: "
+                  << m_ImageIO->GetComponentTypeAsString(
+                       ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType)
+                  << " ConvertPixelTraits::NumComponents " << ConvertPixelTraits::GetNumberOfComponents()
+                  << " m_ImageIO->NumComponents " << m_ImageIO->GetNumberOfComponents());
+
+    std::unique_ptr<char[]> loadBuffer = std::move(prefetchedBuffer);
+    if (!loadBuffer)
+    {
+      loadBuffer.reset(new char[sizeOfActualIORegion]);
+      m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    }
 
     // See note below as to why the buffered region is needed and
     // not actualIOregion
     this->DoConvertBuffer(static_cast<void *>(loadBuffer.get()), output->GetBufferedRegion().GetNumberOfPixels());
   }
-  else if (m_ActualIORegion.GetNumberOfPixels() != output->GetBufferedRegion().GetNumberOfPixels())
+  else if (prefetchedBuffer || m_ActualIORegion.GetNumberOfPixels() != output->GetBufferedRegion().GetNumberOfPixels())
   {
     // NOTE:
     // for the number of pixels read and the number of pixels
     // requested to not match, the dimensions of the two regions may
-    // be different, therefore we buffer and copy the pixels
+    // be different, therefore we buffer and copy the pixels. The
+    // pixels prefetched are copied as well.
 
-    itkDebugMacro(<< "Buffer required because file dimension is greater then image dimension");
+    itkDebugMacro(<< "Buffer required because file dimension is greater then image dimension, or prefetched");
 
     OutputImagePixelType * outputBuffer = output->GetPixelContainer()->GetBufferPointer();
 
-    const std::unique_ptr<char[]> loadBuffer(new char[sizeOfActualIORegion]);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    std::unique_ptr<char[]> loadBuffer = std::move(prefetchedBuffer);
+    if (!loadBuffer)
+    {
+      loadBuffer.reset(new char[sizeOfActualIORegion]);
+      m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    }
 
     // we use std::copy_n here as it should be optimized to memcpy for
     // plain old data, but still is oop
@@ -438,9 +517,238 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     m_ImageIO->Read(outputBuffer);
   }
 
+  this->PrefetchRegions();
+
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::PrefetchRegions()
+{
+  if (m_NumberOfPrefetchedRegions == 0 || !m_UseStreaming || !m_ImageIO->CanStreamRead())
+  {
+    return;
+  }
+
+  if (m_PrefetchImageIO.IsNull())
+  {
+    m_PrefetchImageIO = m_ImageIO;
+    if (m_ImageIO->CanCloneForReading())
+    {
+      ImageIOBase::Pointer clone = m_ImageIO->Clone();
+      try
+      {
+        clone->SetFileName(this->GetFileName());
+        clone->SetUseStreamedReading(true);
+        clone->ReadImageInformation();
+        m_PrefetchImageIO = clone;
+      }
+      catch (const ExceptionObject & err)
+      {
+        itkDebugMacro(<< "Prefetching with a clone of the ImageIO failed: " << err.GetDescription());
+      }
+    }
+  }
+  if (!m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread = std::thread([this]() { this->RunPrefetchThread(); });
+  }
+
+  const ImageRegionType largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+  using ImageIOAdaptor = ImageIORegionAdaptor<TOutputImage::ImageDimension>;
+
+  ImageRegionType region =
+    m_PrefetchedRegions.empty() ? m_LastRequestedRegion : m_PrefetchedRegions.back().m_RequestedRegion;
+  ImageRegionType nextRegion;
+  while (m_PrefetchedRegions.size() < m_NumberOfPrefetchedRegions && this->GetNextRequestedRegion(region, nextRegion))
+  {
+    region = nextRegion;
+    ImageIORegion ioRequestedRegion(TOutputImage::ImageDimension);
+    ImageIOAdaptor::Convert(region, ioRequestedRegion, largestRegion.GetIndex());
+
+    const ImageIOBase::Pointer           imageIO = m_PrefetchImageIO;
+    std::packaged_task<PrefetchedData()> task([imageIO, ioRequestedRegion]() {
+      PrefetchedData data;
+      data.m_IORegion = imageIO->GenerateStreamableReadRegionFromRequestedRegion(ioRequestedRegion);
+      imageIO->SetIORegion(data.m_IORegion);
+      data.m_Buffer.reset(new char[data.m_IORegion.GetNumberOfPixels() * imageIO->GetComponentSize() *
+                                   imageIO->GetNumberOfComponents()]);
+      imageIO->Read(static_cast<void *>(data.m_Buffer.get()));
+      return data;
+    });
+
+    PrefetchedRegion prefetchedRegion;
+    prefetchedRegion.m_RequestedRegion = region;
+    prefetchedRegion.m_Data = task.get_future();
+    m_PrefetchedRegions.push_back(std::move(prefetchedRegion));
+    {
+      const std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+      m_PrefetchTasks.push_back(std::move(task));
+    }
+    m_PrefetchCondition.notify_one();
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::RunPrefetchThread()
+{
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+  while (true)
+  {
+    m_PrefetchCondition.wait(lock, [this]() { return m_StopPrefetchThread || !m_PrefetchTasks.empty(); });
+    if (m_PrefetchTasks.empty())
+    {
+      return;
+    }
+    std::packaged_task<PrefetchedData()> task = std::move(m_PrefetchTasks.front());
+    m_PrefetchTasks.pop_front();
+    m_PrefetchReading = true;
+    lock.unlock();
+    task();
+    // The task is destroyed before the ImageIO is reported unused
+    task = std::packaged_task<PrefetchedData()>();
+    lock.lock();
+    m_PrefetchReading = false;
+    m_PrefetchIdleCondition.notify_all();
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::WaitForPrefetchThread()
+{
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+  m_PrefetchIdleCondition.wait(lock, [this]() { return !m_PrefetchReading && m_PrefetchTasks.empty(); });
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::CancelPrefetching()
+{
+  {
+    // The reads not started are abandoned
+    const std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    m_PrefetchTasks.clear();
+  }
+  this->WaitForPrefetchThread();
+  m_PrefetchedRegions.clear();
+  m_PrefetchedBuffer.reset();
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::GetNextRequestedRegion(const ImageRegionType & region,
+                                                                          ImageRegionType &       next) const
+{
+  const ImageRegionType largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return false;
+  }
+
+  for (int i = static_cast<int>(TOutputImage::ImageDimension) - 1; i >= 0; --i)
+  {
+    if (region.GetIndex(i) != largestRegion.GetIndex(i) || region.GetSize(i) != largestRegion.GetSize(i))
+    {
+      const IndexValueType nextIndex = region.GetIndex(i) + static_cast<IndexValueType>(region.GetSize(i));
+      const IndexValueType end = largestRegion.GetIndex(i) + static_cast<IndexValueType>(largestRegion.GetSize(i));
+      if (nextIndex >= end)
+      {
+        return false;
+      }
+      next = region;
+      next.SetIndex(i, nextIndex);
+      next.SetSize(i, std::min(region.GetSize(i), static_cast<SizeValueType>(end - nextIndex)));
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MemoryMapOutput()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using MappedPixelContainerType =
+    MemoryMappedImageContainer<typename PixelContainerType::ElementIdentifier, typename PixelContainerType::Element>;
+
+  typename TOutputImage::Pointer output = this->GetOutput();
+  const SizeValueType            numberOfPixels = output->GetRequestedRegion().GetNumberOfPixels();
+
+  // Only the whole image can be mapped, and only without conversion
+  if (!this->IsOutputComponentType() ||
+      m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents() ||
+      m_ActualIORegion.GetNumberOfPixels() != numberOfPixels ||
+      static_cast<ImageIOBase::SizeType>(numberOfPixels) != m_ImageIO->GetImageSizeInPixels() ||
+      static_cast<ImageIOBase::SizeType>(numberOfPixels * sizeof(OutputImagePixelType)) !=
+        m_ImageIO->GetImageSizeInBytes())
+  {
+    return false;
+  }
+
+  m_ImageIO->SetFileName(this->GetFileName().c_str());
+  m_ImageIO->SetIORegion(m_ActualIORegion);
+
+  std::string           dataFileName;
+  ImageIOBase::SizeType dataOffset = 0;
+  if (!m_ImageIO->GetRawPixelDataLocation(dataFileName, dataOffset) ||
+      dataOffset % alignof(typename PixelContainerType::Element) != 0)
+  {
+    return false;
+  }
+
+  const auto container = MappedPixelContainerType::New();
+  try
+  {
+    container->MapFile(dataFileName, static_cast<SizeValueType>(dataOffset), numberOfPixels);
+  }
+  catch (const ExceptionObject & err)
+  {
+    itkDebugMacro(<< "Reading instead of memory mapping: " << err.GetDescription());
+    return false;
+  }
+
+  itkDebugMacro(<< "Memory mapped " << numberOfPixels << " pixels at offset " << dataOffset << " of "
+                << dataFileName);
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->SetPixelContainer(container);
+  return true;
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::IsOutputComponentType() const
+{
+  using ComponentType = typename ConvertPixelTraits::ComponentType;
+  const IOComponentEnum componentType = m_ImageIO->GetComponentType();
+  const IOComponentEnum outputType = ImageIOBase::MapPixelType<ComponentType>::CType;
+  if (componentType == outputType)
+  {
+    return true;
+  }
+
+  bool isSignedInteger = false;
+  switch (componentType)
+  {
+    case IOComponentEnum::INT:
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      isSignedInteger = true;
+      break;
+    case IOComponentEnum::UINT:
+    case IOComponentEnum::ULONG:
+    case IOComponentEnum::ULONGLONG:
+      break;
+    default:
+      return false;
+  }
+  return NumericTraits<ComponentType>::IsInteger && NumericTraits<ComponentType>::is_signed == isSignedInteger &&
+         sizeof(ComponentType) == m_ImageIO->GetComponentSize();
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void * inputData, size_t numberOfPixels)
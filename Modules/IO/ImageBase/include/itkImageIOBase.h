@@ -24,6 +24,7 @@
 #include "itkLightProcessObject.h"
 #include "itkIndent.h"
 #include "itkImageIORegion.h"
+#include "itkBlockCompressor.h"
 #include "itkRGBPixel.h"
 #include "itkRGBAPixel.h"
 #include "itkCovariantVector.h"
@@ -86,6 +87,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(ImageIOBase, Superclass);
 
+  /** Create a copy of this ImageIO. See CanCloneForReading(). */
+  itkCloneMacro(Self);
+
   /** Set/Get the name of the file to be read. */
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
@@ -281,6 +285,16 @@ public:
   SetCompressor(std::string _c);
   itkGetConstReferenceMacro(Compressor, std::string);
 
+  /** \brief Set/Get the number of bytes per compressed block
+   *
+   * ImageIOs that compress with a BlockCompressor split the pixel data
+   * into blocks of this many bytes, 1 MiB by default, which are compressed
+   * independently and in parallel. Larger blocks compress slightly better,
+   * smaller ones keep more threads busy on small images.
+   **/
+  itkSetClampMacro(CompressionBlockSize, ::itk::intmax_t, 1, ::itk::intmax_t{ 1 } << 30);
+  itkGetConstMacro(CompressionBlockSize, ::itk::intmax_t);
+
   /** Set/Get a boolean to use streaming while reading or not. */
   itkSetMacro(UseStreamedReading, bool);
   itkGetConstMacro(UseStreamedReading, bool);
@@ -429,6 +443,15 @@ public:
     return false;
   }
 
+  /** Determine if Clone() returns an ImageIO with the reading settings of
+      this one, so that several files can be read at once, each one by its
+      own clone. Default is false. */
+  virtual bool
+  CanCloneForReading() const
+  {
+    return false;
+  }
+
   /** Read the spacing and dimensions of the image.
    * Assumes SetFileName has been called with a valid file name. */
   virtual void
@@ -438,6 +461,19 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine whether the pixel data of the file, as described by the
+   * last call to ReadImageInformation(), is stored uncompressed, in a
+   * single contiguous block, in the byte order of this machine and
+   * exactly as Read() would return the whole image. If so, the name of the
+   * file holding the pixel data and the byte offset of the first pixel in
+   * it are returned, so that the data can be memory mapped instead of
+   * read. Default is false. */
+  virtual bool
+  GetRawPixelDataLocation(std::string & itkNotUsed(fileName), SizeType & itkNotUsed(offset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -706,6 +742,8 @@ protected:
   int         m_MaximumCompressionLevel{ 100 };
   std::string m_Compressor{ "uninitialized" };
 
+  ::itk::intmax_t m_CompressionBlockSize{ ::itk::intmax_t{ 1 } << 20 };
+
   /** Set/Get enforced maximum compression level value to limit range  */
   virtual void
   SetMaximumCompressionLevel(int);
@@ -717,6 +755,11 @@ protected:
   virtual void
   InternalSetCompressor(const std::string & COMPRESSOR);
 
+  /** Set the compression level and block size of a compressor to those of
+   * this ImageIO. */
+  void
+  ConfigureBlockCompressor(BlockCompressor & compressor) const;
+
   /** Should we use streaming for reading */
   bool m_UseStreamedReading;
 
@@ -865,6 +908,29 @@ protected:
                                          unsigned int          numberOfActualSplits,
                                          const ImageIORegion & pasteRegion) const;
 
+  /** The number of pieces, at most numberOfRequestedSplits, the paste region
+   * of a chunked file can be written in, so that each piece is made of whole
+   * chunks of chunkSize. The pieces are split along the slowest moving
+   * dimension that the paste region spans several chunks of. */
+  unsigned int
+  GetActualNumberOfSplitsForWritingChunks(unsigned int                    numberOfRequestedSplits,
+                                          const ImageIORegion &           pasteRegion,
+                                          const ImageIORegion::SizeType & chunkSize) const;
+
+  /** The ith of these pieces, made of whole chunks apart from the chunks
+   * partly in the paste region. */
+  ImageIORegion
+  GetSplitRegionForWritingChunks(unsigned int                    ithPiece,
+                                 unsigned int                    numberOfActualSplits,
+                                 const ImageIORegion &           pasteRegion,
+                                 const ImageIORegion::SizeType & chunkSize) const;
+
+  /** Enlarges the region to the boundaries of the chunks of chunkSize it
+   * intersects, within the image. The dimensions beyond chunkSize, or with
+   * a chunk size of 0, are left as they are. */
+  ImageIORegion
+  EnlargeRegionToChunks(const ImageIORegion & region, const ImageIORegion::SizeType & chunkSize) const;
+
 private:
   bool
   HasSupportedExtension(const char *, const ArrayOfExtensionsType &, bool tolower = true);
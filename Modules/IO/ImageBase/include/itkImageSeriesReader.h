@@ -22,6 +22,8 @@
 #include "itkSize.h"
 #include <vector>
 #include <string>
+#include <functional>
+#include <memory>
 #include "itkMetaDataDictionary.h"
 #include "itkImageFileReader.h"
 
@@ -35,6 +37,17 @@ namespace itk
  * the files, but the image data must have the same Size for all
  * dimensions.
  *
+ * The files are read concurrently by the work units of the MultiThreader,
+ * at most NumberOfWorkUnits at a time. Each file is read by its own
+ * ImageFileReader, directly into its slice of the output buffer, with an
+ * ImageIO of its own unless one is set. When an ImageIO is set with
+ * SetImageIO(), the work units read with clones of it
+ * if its CanCloneForReading() is true, one clone per work unit, and the
+ * last file with the ImageIO set itself. Otherwise that single ImageIO
+ * reads all the files, one after another. Either way the slice order,
+ * the MetaDataDictionaryArray and the progress are those of a sequential
+ * read.
+ *
  * \sa GDCMSeriesFileNames
  * \sa NumericSeriesFileNames
  * \ingroup IOFilters
@@ -221,6 +234,32 @@ private:
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** Read slice i of the output from its file with imageIO, or with an
+   * ImageIO from the factory when it is null, or only the information of
+   * the file when the slice is outside the requested region. Returns a copy
+   * of the MetaDataDictionary of the file, and the origin of the slice
+   * when it is read. Called concurrently for different slices. */
+  std::unique_ptr<DictionaryType>
+  ReadSlice(int                                i,
+            ImageIOBase *                      imageIO,
+            bool                               insideRequestedRegion,
+            const ImageRegionType &            sliceRegionToRequest,
+            const SizeType &                   validSize,
+            typename TOutputImage::PointType & sliceOrigin);
+
+  /** Copy of the MetaDataDictionary of the ImageIO of reader. */
+  static std::unique_ptr<DictionaryType>
+  CopyMetaDataDictionary(ReaderType * reader);
+
+  /** Call function for each of the given slices, with the ImageIO to read
+   * it; concurrently, unless a single ImageIO that can not be cloned was
+   * set. A clone of the ImageIO set is made for each work unit, not for
+   * each slice. The last slice is read with the ImageIO set, so that it is
+   * left with the information of the last file as in a sequential read.
+   * Exceptions are rethrown in slice order. */
+  void
+  ForEachSlice(const std::vector<int> & slices, const std::function<void(int, ImageIOBase *)> & function);
+
   /** Modified time of the MetaDataDictionaryArray */
   TimeStamp m_MetaDataDictionaryArrayMTime;
 
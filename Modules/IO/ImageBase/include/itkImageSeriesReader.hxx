@@ -24,9 +24,11 @@
 #include "itkArray.h"
 #include "itkVector.h"
 #include "itkMath.h"
-#include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include "itkMetaDataObject.h"
 #include <iomanip>
+#include <exception>
+#include <mutex>
 
 namespace itk
 {
@@ -283,194 +285,138 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->Allocate();
 
   // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
+  const SizeValueType numberOfSlicesToRead = requestedRegion.GetSize(TOutputImage::ImageDimension - 1);
 
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
   // information is updated so should the meta array.
   // Each file can not be read in the UpdateOutputInformation methods
   // due to the poor performance of reading each file a second time there.
-  bool needToUpdateMetaDataDictionaryArray =
+  const bool updateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
+  bool needToUpdateMetaDataDictionaryArray = updateMetaDataDictionaryArray;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
-
-  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
-  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
-  double                             maxSpacingDeviation = 0.0;
-  bool                               prevSliceIsValid = false;
+  IndexType  sliceStartIndex = requestedRegion.GetIndex();
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
 
+  // Find the slices to read, and those of which only the information is
+  // needed for the MetaDataDictionaryArray
+  std::vector<char> insideRequestedRegion(numberOfFiles, 0);
+  std::vector<int>  slicesToRead;
   for (int i = 0; i != numberOfFiles; ++i)
   {
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
+    insideRequestedRegion[i] = requestedRegion.IsInside(sliceStartIndex);
+    if (insideRequestedRegion[i] || needToUpdateMetaDataDictionaryArray)
+    {
+      slicesToRead.push_back(i);
+    }
+  }
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
-
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+  // Read the slices, each one directly into its part of the output buffer
+  std::vector<std::unique_ptr<DictionaryType>>  sliceDictionaries(numberOfFiles);
+  std::vector<typename TOutputImage::PointType> sliceOrigins(numberOfFiles);
+  this->ForEachSlice(slicesToRead, [&](int i, ImageIOBase * imageIO) {
+    sliceDictionaries[i] =
+      this->ReadSlice(i, imageIO, insideRequestedRegion[i] != 0, sliceRegionToRequest, validSize, sliceOrigins[i]);
+    if (insideRequestedRegion[i])
     {
-      continue;
+      // report progress for read slices
+      TotalProgressReporter progress(this, numberOfSlicesToRead);
+      progress.CompletedPixel();
     }
+  });
 
-    // configure reader
-    typename ReaderType::Pointer reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
+  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
+  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
+  double                             maxSpacingDeviation = 0.0;
+  bool                               prevSliceIsValid = false;
+  std::vector<double>                spacingDeviations(numberOfFiles, -1.0);
 
-    TOutputImage * readerOutput = reader->GetOutput();
+  // Slices that were skipped are needed as soon as non uniform sampling
+  // is detected, for the MetaDataDictionaryArray
+  int firstSliceInMetaDataDictionaryArray = updateMetaDataDictionaryArray ? 0 : numberOfFiles;
 
-    if (m_ImageIO)
+  for (int i : slicesToRead)
+  {
+    if (!insideRequestedRegion[i])
     {
-      reader->SetImageIO(m_ImageIO);
+      continue;
     }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
 
-    // update the data or info
-    if (!insideRequestedRegion)
+    // verify that slice spacing is the expected one
+    // since we can be skipping some slices because they are outside of requested region
+    // I am using additional variable
+    if (prevSliceIsValid)
     {
-      reader->UpdateOutputInformation();
-    }
-    else
-    {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
-
-      // propagate the requested region to determin what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
-
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
-      {
-        itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
-
-      // get the size of the region to be read
-      SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
-
-      if (readSize == sliceRegionToRequest.GetSize())
-      {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
-
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
-
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
-        {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
-      }
-      else
+      const typename TOutputImage::PointType & sliceOrigin = sliceOrigins[i];
+      using SpacingScalarType = typename TOutputImage::SpacingValueType;
+      Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
+      for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
       {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
-
-        reader->Update();
-
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
-
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
-
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
       }
+      SpacingScalarType dirNnorm = dirN.GetNorm();
 
-      // verify that slice spacing is the expected one
-      // since we can be skipping some slices because they are outside of requested region
-      // I am using additional variable
-      if (prevSliceIsValid)
+      if (this->m_SpacingDefined &&
+          !Math::AlmostEquals(dirNnorm,
+                              outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or
+                                                                                 // missing slice
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
-        using SpacingScalarType = typename TOutputImage::SpacingValueType;
-        Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
-        for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
+        spacingDeviations[i] = Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
+        if (spacingDeviations[i] > maxSpacingDeviation)
         {
-          dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
+          maxSpacingDeviation = spacingDeviations[i];
         }
-        SpacingScalarType dirNnorm = dirN.GetNorm();
 
-        if (this->m_SpacingDefined &&
-            !Math::AlmostEquals(
-              dirNnorm,
-              outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
+        if (!needToUpdateMetaDataDictionaryArray)
         {
-          nonUniformSampling = true;
-          spacingDeviation = Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
-          if (spacingDeviation > maxSpacingDeviation)
-          {
-            maxSpacingDeviation = spacingDeviation;
-          }
-
           needToUpdateMetaDataDictionaryArray = true;
+          firstSliceInMetaDataDictionaryArray = i;
         }
-        prevSliceOrigin = sliceOrigin;
       }
-      else
+      prevSliceOrigin = sliceOrigin;
+    }
+    else
+    {
+      prevSliceOrigin = sliceOrigins[i];
+      prevSliceIsValid = true;
+    }
+  }
+
+  // Read the information of the skipped slices that are needed
+  std::vector<int> slicesToReadInformation;
+  if (!updateMetaDataDictionaryArray)
+  {
+    for (int i = firstSliceInMetaDataDictionaryArray + 1; i < numberOfFiles; ++i)
+    {
+      if (!insideRequestedRegion[i])
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
-        prevSliceIsValid = true;
+        slicesToReadInformation.push_back(i);
       }
+    }
+  }
+  this->ForEachSlice(slicesToReadInformation, [&](int i, ImageIOBase * imageIO) {
+    sliceDictionaries[i] = this->ReadSlice(i, imageIO, false, sliceRegionToRequest, validSize, sliceOrigins[i]);
+  });
 
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insidedRequestedRegion
-
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+  // Move the MetaDataDictionaries into the array, in slice order
+  for (int i = firstSliceInMetaDataDictionaryArray; i < numberOfFiles; ++i)
+  {
+    if (sliceDictionaries[i])
     {
-      auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
-      if (nonUniformSampling)
+      if (spacingDeviations[i] >= 0.0)
       {
         // slice-specific information
-        EncapsulateMetaData<double>(*newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        EncapsulateMetaData<double>(
+          *sliceDictionaries[i], "ITK_non_uniform_sampling_deviation", spacingDeviations[i]);
       }
-      m_MetaDataDictionaryArray.push_back(newDictionary);
+      m_MetaDataDictionaryArray.push_back(sliceDictionaries[i].release());
     }
-  } // end per slice loop
+  }
 
 
   if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage &&
@@ -494,6 +440,212 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   }
 }
 
+template <typename TOutputImage>
+std::unique_ptr<typename ImageSeriesReader<TOutputImage>::DictionaryType>
+ImageSeriesReader<TOutputImage>::ReadSlice(int                                i,
+                                           ImageIOBase *                      imageIO,
+                                           bool                               insideRequestedRegion,
+                                           const ImageRegionType &            sliceRegionToRequest,
+                                           const SizeType &                   validSize,
+                                           typename TOutputImage::PointType & sliceOrigin)
+{
+  TOutputImage *        output = this->GetOutput();
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+  const auto            numberOfFiles = static_cast<int>(m_FileNames.size());
+  const int             iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
+
+  // configure reader
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(m_FileNames[iFileName].c_str());
+
+  TOutputImage * readerOutput = reader->GetOutput();
+
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->SetUseStreaming(m_UseStreaming);
+  readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+  // update the data or info
+  if (!insideRequestedRegion)
+  {
+    reader->UpdateOutputInformation();
+    return CopyMetaDataDictionary(reader);
+  }
+
+  // read the meta data information
+  readerOutput->UpdateOutputInformation();
+
+  // propagate the requested region to determin what the region
+  // will actually be read
+  readerOutput->PropagateRequestedRegion();
+
+  // check that the size of each slice is the same
+  if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+  {
+    itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
+                      << readerOutput->GetLargestPossibleRegion().GetSize() << " and does not match the required size "
+                      << validSize << " from file " << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+  }
+
+  // get the size of the region to be read
+  SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+
+  if (readSize == sliceRegionToRequest.GetSize())
+  {
+    // if the buffer of the ImageReader is going to match that of
+    // ourselves, then set the ImageReader's buffer to a section
+    // of ours
+
+    const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+    using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+    const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+    const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                    ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                    : 0;
+
+    const ptrdiff_t numberOfPixelComponentsUpToSlice =
+      numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+    const bool bufferDelete = false;
+
+    typename TOutputImage::InternalPixelType * outputSliceBuffer =
+      output->GetBufferPointer() + numberOfPixelComponentsUpToSlice;
+
+    if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+    {
+      // if the input image type is a vector image then the number
+      // of components needs to be set for the size
+      readerOutput->GetPixelContainer()->SetImportPointer(
+        outputSliceBuffer,
+        static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+        bufferDelete);
+    }
+    else
+    {
+      // otherwise the actual number of pixels needs to be passed
+      readerOutput->GetPixelContainer()->SetImportPointer(
+        outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+    }
+    readerOutput->UpdateOutputData();
+  }
+  else
+  {
+    // the read region isn't going to match exactly what we need
+    // to update to buffer created by the reader, then copy
+
+    reader->Update();
+
+    // output of buffer copy
+    ImageRegionType outRegion = requestedRegion;
+
+    // set the moving dimension to the slice, with a size of 1
+    if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+    {
+      outRegion.SetIndex(this->m_NumberOfDimensionsInImage, i);
+      outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+    }
+
+    ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+  }
+
+  sliceOrigin = readerOutput->GetOrigin();
+  return CopyMetaDataDictionary(reader);
+}
+
+template <typename TOutputImage>
+std::unique_ptr<typename ImageSeriesReader<TOutputImage>::DictionaryType>
+ImageSeriesReader<TOutputImage>::CopyMetaDataDictionary(ReaderType * reader)
+{
+  // Deep copy the MetaDataDictionary, before a shared ImageIO reads the
+  // next file
+  std::unique_ptr<DictionaryType> dictionary;
+  if (reader->GetImageIO())
+  {
+    dictionary.reset(new DictionaryType(reader->GetImageIO()->GetMetaDataDictionary()));
+  }
+  return dictionary;
+}
+
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::ForEachSlice(const std::vector<int> &                        slices,
+                                              const std::function<void(int, ImageIOBase *)> & function)
+{
+  // A single ImageIO set by the user can not read several files at once
+  if ((m_ImageIO && !m_ImageIO->CanCloneForReading()) || slices.size() < 2 || this->GetNumberOfWorkUnits() < 2)
+  {
+    for (int i : slices)
+    {
+      function(i, m_ImageIO);
+    }
+    return;
+  }
+
+  // The slices but the last one are read by clones of the ImageIO set, one
+  // per work unit reading at the same time rather than one per slice. They
+  // are cloned from a prototype, as the ImageIO set reads the last slice
+  // meanwhile.
+  ImageIOBase::Pointer              prototypeImageIO;
+  std::vector<ImageIOBase::Pointer> freeImageIOs;
+  std::mutex                        freeImageIOsMutex;
+  if (m_ImageIO)
+  {
+    prototypeImageIO = m_ImageIO->Clone();
+  }
+
+  std::vector<std::exception_ptr> exceptions(slices.size());
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    slices.size(),
+    [&](SizeValueType k) {
+      ImageIOBase::Pointer imageIO;
+      if (prototypeImageIO && k + 1 < slices.size())
+      {
+        std::lock_guard<std::mutex> lock(freeImageIOsMutex);
+        if (freeImageIOs.empty())
+        {
+          imageIO = prototypeImageIO->Clone();
+        }
+        else
+        {
+          imageIO = freeImageIOs.back();
+          freeImageIOs.pop_back();
+        }
+      }
+      else
+      {
+        imageIO = m_ImageIO;
+      }
+      try
+      {
+        function(slices[k], imageIO);
+      }
+      catch (...)
+      {
+        exceptions[k] = std::current_exception();
+      }
+      if (imageIO != m_ImageIO)
+      {
+        std::lock_guard<std::mutex> lock(freeImageIOsMutex);
+        freeImageIOs.push_back(imageIO);
+      }
+    },
+    nullptr);
+
+  for (const auto & exception : exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
 template <typename TOutputImage>
 typename ImageSeriesReader<TOutputImage>::DictionaryArrayRawPointer
 ImageSeriesReader<TOutputImage>::GetMetaDataDictionaryArray() const
@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIndexedGzipFileReader_h
+#define itkIndexedGzipFileReader_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class IndexedGzipFileReader
+ * \brief Read arbitrary byte ranges of the uncompressed content of a file.
+ *
+ * Plain files are read directly. For gzip compressed files an index of
+ * access points is built while the file is decompressed: every
+ * AccessPointSpacing uncompressed bytes, at a deflate block boundary, the
+ * compressed position and the preceding 32 KiB of uncompressed data are
+ * recorded. A later read resumes decompression at the closest access point
+ * before the requested range, so that only a bounded amount of data is
+ * decompressed per read, and nothing beyond the end of the requested range
+ * is ever decompressed. Only the first read of a part of the file pays for
+ * decompressing everything before it. The decompression state is kept
+ * between reads, so that a sequence of reads at increasing offsets, such as
+ * the rows of a subregion, decompresses the file only once. Files made of
+ * several concatenated gzip members are read as a whole.
+ *
+ * This is what ImageIO classes need to stream regions out of compressed
+ * files without decompressing, or holding, the whole image.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT IndexedGzipFileReader : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IndexedGzipFileReader);
+
+  /** Standard class type aliases. */
+  using Self = IndexedGzipFileReader;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(IndexedGzipFileReader, Object);
+
+  /** Type for representing sizes and positions in bytes. */
+  using SizeType = ::itk::intmax_t;
+
+  /** Open a file, gzip (or zlib) compressed or not, discarding the index
+   * of any previous file. The content starts at dataOffset in the file,
+   * after any uncompressed header, and offsets given to Read() are relative
+   * to it. Throws an ExceptionObject when the file cannot be read. */
+  void
+  Open(const std::string & fileName, bool compressed, SizeType dataOffset = 0);
+
+  /** Close the file and discard its index. */
+  void
+  Close();
+
+  /** Read numberOfBytes bytes of the uncompressed content, starting at
+   * offset. Throws an ExceptionObject when the range is not within the
+   * content or the compressed data is corrupted. */
+  void
+  Read(void * buffer, SizeType offset, SizeType numberOfBytes);
+
+  /** Get the name of the open file. */
+  itkGetStringMacro(FileName);
+
+  /** Whether the open file is compressed. */
+  itkGetConstMacro(Compressed, bool);
+
+  /** Set/Get the number of uncompressed bytes between access points of
+   * the index, 4 MiB by default. Each access point takes 32 KiB. */
+  itkSetMacro(AccessPointSpacing, SizeType);
+  itkGetConstMacro(AccessPointSpacing, SizeType);
+
+  /** Get the number of access points indexed so far. */
+  SizeValueType
+  GetNumberOfAccessPoints() const
+  {
+    return static_cast<SizeValueType>(m_AccessPoints.size());
+  }
+
+protected:
+  IndexedGzipFileReader();
+  ~IndexedGzipFileReader() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** A position from which decompression can resume. */
+  struct AccessPoint
+  {
+    SizeType                   m_UncompressedOffset;
+    SizeType                   m_CompressedOffset;
+    int                        m_Bits;
+    std::vector<unsigned char> m_Window;
+  };
+
+  /** The zlib state of an ongoing decompression. */
+  struct InflateState;
+
+  void
+  ReadCompressed(char * buffer, SizeType offset, SizeType numberOfBytes);
+
+  void
+  StartInflate(const AccessPoint * start);
+
+  /** Continue with the next member of a gzip file at the end of one;
+   * returns false at the end of the file. */
+  bool
+  StartNextMember();
+
+  std::ifstream            m_File;
+  std::string              m_FileName;
+  SizeType                 m_DataOffset{ 0 };
+  bool                     m_Compressed{ false };
+  SizeType                 m_AccessPointSpacing;
+  std::vector<AccessPoint> m_AccessPoints;
+
+  std::unique_ptr<InflateState> m_InflateState;
+};
+} // end namespace itk
+
+#endif // itkIndexedGzipFileReader_h
@@ -11,10 +11,16 @@ itk_module(ITKIOImageBase
   ENABLE_SHARED
   DEPENDS
     ITKCommon
+  PRIVATE_DEPENDS
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
+    ITKZLIB
     ITKIOGDCM
     ITKIOMeta
+    ITKIONIFTI
+    ITKIONRRD
+    ITKIOVTK
     ITKImageIntensity
   DESCRIPTION
     "${DOCUMENTATION}"
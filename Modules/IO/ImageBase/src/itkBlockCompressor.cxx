@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBlockCompressor.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+
+namespace itk
+{
+BlockCompressor::BlockCompressor()
+  : m_BlockSize(SizeType{ 1 } << 20)
+  , m_NumberOfWorkUnits(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+{}
+
+BlockCompressor::~BlockCompressor() = default;
+
+void
+BlockCompressor::Compress(const void *            data,
+                          SizeType                numberOfBytes,
+                          std::vector<char> &     compressed,
+                          std::vector<SizeType> * blockOffsets) const
+{
+  if (numberOfBytes < 0 || (data == nullptr && numberOfBytes > 0))
+  {
+    itkExceptionMacro(<< "Invalid input: " << numberOfBytes << " bytes at " << data);
+  }
+
+  // An empty input still makes one (empty) block, to get a complete stream
+  const SizeType      blockSize = m_BlockSize;
+  const SizeValueType numberOfBlocks =
+    numberOfBytes == 0 ? 1 : static_cast<SizeValueType>((numberOfBytes + blockSize - 1) / blockSize);
+  const char * const           input = static_cast<const char *>(data);
+  std::vector<CompressedBlock> blocks(numberOfBlocks);
+
+  auto compressBlock = [this, input, numberOfBytes, blockSize, numberOfBlocks, &blocks](SizeValueType i) {
+    const SizeType begin = static_cast<SizeType>(i) * blockSize;
+    this->CompressBlock(
+      input + begin, std::min(blockSize, numberOfBytes - begin), i + 1 == numberOfBlocks, blocks[i]);
+  };
+  this->ForEachBlock(numberOfBlocks, compressBlock);
+
+  SizeType compressedSize = 0;
+  for (const auto & block : blocks)
+  {
+    compressedSize += static_cast<SizeType>(block.m_Data.size());
+  }
+  compressed.clear();
+  compressed.reserve(static_cast<size_t>(compressedSize) + 32);
+  this->AppendHeader(compressed);
+  if (blockOffsets != nullptr)
+  {
+    blockOffsets->clear();
+    blockOffsets->reserve(numberOfBlocks);
+  }
+  for (auto & block : blocks)
+  {
+    if (blockOffsets != nullptr)
+    {
+      blockOffsets->push_back(static_cast<SizeType>(compressed.size()));
+    }
+    compressed.insert(compressed.end(), block.m_Data.begin(), block.m_Data.end());
+    // Release the memory as early as possible
+    std::vector<char>().swap(block.m_Data);
+  }
+  this->AppendTrailer(blocks, compressed);
+}
+
+void
+BlockCompressor::Decompress(const void *                  compressed,
+                            SizeType                      compressedSize,
+                            const std::vector<SizeType> & blockOffsets,
+                            void *                        data,
+                            SizeType                      numberOfBytes) const
+{
+  const SizeType      blockSize = m_BlockSize;
+  const SizeValueType numberOfBlocks = blockOffsets.size();
+  // As written by Compress(), empty data is one empty block
+  if (numberOfBytes < 0 ||
+      std::max<SizeType>((numberOfBytes + blockSize - 1) / blockSize, 1) != static_cast<SizeType>(numberOfBlocks))
+  {
+    itkExceptionMacro(<< "Invalid output: " << numberOfBytes << " bytes in " << numberOfBlocks << " blocks of "
+                      << blockSize << " bytes.");
+  }
+  for (SizeValueType i = 0; i < numberOfBlocks; ++i)
+  {
+    const SizeType end = i + 1 < numberOfBlocks ? blockOffsets[i + 1] : compressedSize;
+    if (blockOffsets[i] < 0 || blockOffsets[i] > end || end > compressedSize)
+    {
+      itkExceptionMacro(<< "Invalid offset of block " << i << ": " << blockOffsets[i]);
+    }
+  }
+
+  const char * const input = static_cast<const char *>(compressed);
+  char * const       output = static_cast<char *>(data);
+  auto decompressBlock = [this, input, output, compressedSize, numberOfBytes, blockSize, numberOfBlocks, &blockOffsets](
+                           SizeValueType i) {
+    const SizeType begin = static_cast<SizeType>(i) * blockSize;
+    const SizeType end = i + 1 < numberOfBlocks ? blockOffsets[i + 1] : compressedSize;
+    this->DecompressBlock(
+      input + blockOffsets[i], end - blockOffsets[i], output + begin, std::min(blockSize, numberOfBytes - begin));
+  };
+  this->ForEachBlock(numberOfBlocks, decompressBlock);
+}
+
+void
+BlockCompressor::ForEachBlock(SizeValueType numberOfBlocks, const std::function<void(SizeValueType)> & function) const
+{
+  if (numberOfBlocks == 1 || m_NumberOfWorkUnits == 1)
+  {
+    for (SizeValueType i = 0; i < numberOfBlocks; ++i)
+    {
+      function(i);
+    }
+  }
+  else
+  {
+    MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+    multiThreader->ParallelizeArray(0, numberOfBlocks, function, nullptr);
+  }
+}
+
+void
+BlockCompressor::AppendHeader(std::vector<char> &) const
+{}
+
+void
+BlockCompressor::AppendTrailer(const std::vector<CompressedBlock> &, std::vector<char> &) const
+{}
+
+void
+BlockCompressor::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+}
+} // end namespace itk
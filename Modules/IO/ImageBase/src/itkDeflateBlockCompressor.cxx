@@ -0,0 +1,273 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkDeflateBlockCompressor.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace itk
+{
+namespace
+{
+// zlib counts bytes with 32-bit integers
+constexpr SizeValueType MaximumChunkSize = SizeValueType{ 1 } << 30;
+
+void
+AppendBigEndian32(std::vector<char> & compressed, uint32_t value)
+{
+  for (int shift = 24; shift >= 0; shift -= 8)
+  {
+    compressed.push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+void
+AppendLittleEndian32(std::vector<char> & compressed, uint32_t value)
+{
+  for (int shift = 0; shift < 32; shift += 8)
+  {
+    compressed.push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+} // namespace
+
+DeflateBlockCompressor::DeflateBlockCompressor()
+{
+  this->SetCompressionLevel(6);
+}
+
+DeflateBlockCompressor::~DeflateBlockCompressor() = default;
+
+void
+DeflateBlockCompressor::CompressBlock(const char *      data,
+                                      SizeType          numberOfBytes,
+                                      bool              isLastBlock,
+                                      CompressedBlock & block) const
+{
+  int strategy = Z_DEFAULT_STRATEGY;
+  if (m_Strategy == StrategyEnum::RunLength)
+  {
+    strategy = Z_RLE;
+  }
+  else if (m_Strategy == StrategyEnum::HuffmanOnly)
+  {
+    strategy = Z_HUFFMAN_ONLY;
+  }
+
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // Negative window bits: raw deflate, without zlib header and trailer
+  if (deflateInit2(&stream, this->GetCompressionLevel(), Z_DEFLATED, -15, 8, strategy) != Z_OK)
+  {
+    itkExceptionMacro(<< "Could not initialize zlib with compression level " << this->GetCompressionLevel());
+  }
+
+  const auto *       input = reinterpret_cast<const Bytef *>(data);
+  std::vector<char> & output = block.m_Data;
+  output.resize(deflateBound(&stream, static_cast<uLong>(std::min<SizeType>(numberOfBytes, MaximumChunkSize))) + 16);
+  uint32_t check = m_Format == FormatEnum::Gzip ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+
+  SizeType inputPosition = 0;
+  SizeType outputPosition = 0;
+  int      flush = Z_NO_FLUSH;
+  do
+  {
+    const auto inputChunk = static_cast<uInt>(std::min<SizeType>(numberOfBytes - inputPosition, MaximumChunkSize));
+    stream.next_in = const_cast<Bytef *>(input + inputPosition);
+    stream.avail_in = inputChunk;
+    check = m_Format == FormatEnum::Gzip ? crc32(check, stream.next_in, inputChunk)
+                                         : adler32(check, stream.next_in, inputChunk);
+    inputPosition += inputChunk;
+    if (inputPosition == numberOfBytes)
+    {
+      // A sync flush ends the block on a byte boundary, with an empty
+      // stored block, so that the next block can follow it
+      flush = isLastBlock ? Z_FINISH : Z_SYNC_FLUSH;
+    }
+    do
+    {
+      if (outputPosition == static_cast<SizeType>(output.size()))
+      {
+        output.resize(2 * output.size());
+      }
+      const auto outputChunk =
+        static_cast<uInt>(std::min<SizeType>(static_cast<SizeType>(output.size()) - outputPosition, MaximumChunkSize));
+      stream.next_out = reinterpret_cast<Bytef *>(&output[outputPosition]);
+      stream.avail_out = outputChunk;
+      if (deflate(&stream, flush) == Z_STREAM_ERROR)
+      {
+        deflateEnd(&stream);
+        itkExceptionMacro(<< "Compression failed.");
+      }
+      outputPosition += outputChunk - stream.avail_out;
+    } while (stream.avail_out == 0);
+  } while (flush == Z_NO_FLUSH);
+  deflateEnd(&stream);
+
+  output.resize(outputPosition);
+  output.shrink_to_fit();
+  block.m_UncompressedSize = numberOfBytes;
+  block.m_Check = check;
+}
+
+void
+DeflateBlockCompressor::DecompressBlock(const char * compressed,
+                                        SizeType     compressedSize,
+                                        char *       data,
+                                        SizeType     numberOfBytes) const
+{
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  if (inflateInit2(&stream, -15) != Z_OK)
+  {
+    itkExceptionMacro(<< "Could not initialize zlib.");
+  }
+
+  const auto * input = reinterpret_cast<const Bytef *>(compressed);
+  SizeType     inputPosition = 0;
+  SizeType     outputPosition = 0;
+  int          ret = Z_OK;
+  while (outputPosition < numberOfBytes && ret != Z_STREAM_END)
+  {
+    if (stream.avail_in == 0)
+    {
+      if (inputPosition == compressedSize)
+      {
+        break;
+      }
+      const auto inputChunk = static_cast<uInt>(std::min<SizeType>(compressedSize - inputPosition, MaximumChunkSize));
+      stream.next_in = const_cast<Bytef *>(input + inputPosition);
+      stream.avail_in = inputChunk;
+      inputPosition += inputChunk;
+    }
+    const auto outputChunk = static_cast<uInt>(std::min<SizeType>(numberOfBytes - outputPosition, MaximumChunkSize));
+    stream.next_out = reinterpret_cast<Bytef *>(data + outputPosition);
+    stream.avail_out = outputChunk;
+    ret = inflate(&stream, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+    {
+      inflateEnd(&stream);
+      itkExceptionMacro(<< "Corrupted compressed data.");
+    }
+    outputPosition += outputChunk - stream.avail_out;
+  }
+  inflateEnd(&stream);
+
+  if (outputPosition != numberOfBytes)
+  {
+    itkExceptionMacro(<< "Corrupted compressed data: a block holds " << outputPosition << " bytes instead of "
+                      << numberOfBytes);
+  }
+}
+
+void
+DeflateBlockCompressor::AppendHeader(std::vector<char> & compressed) const
+{
+  const int level = this->GetCompressionLevel();
+  if (m_Format == FormatEnum::Gzip)
+  {
+    // Deflate, no flags, no modification time, unknown operating system
+    const unsigned char header[10] = {
+      0x1f, 0x8b, 8, 0, 0, 0, 0, 0, static_cast<unsigned char>(level == 9 ? 2 : (level == 1 ? 4 : 0)), 255
+    };
+    compressed.insert(compressed.end(), header, header + 10);
+  }
+  else
+  {
+    // Deflate with a 32 KiB window, and the level hint; the header is a
+    // multiple of 31
+    const unsigned int compressionMethod = 0x78;
+    unsigned int       flags = (level < 2 ? 0U : (level < 6 ? 1U : (level == 6 ? 2U : 3U))) << 6;
+    flags += 31 - (compressionMethod * 256 + flags) % 31;
+    compressed.push_back(static_cast<char>(compressionMethod));
+    compressed.push_back(static_cast<char>(flags));
+  }
+}
+
+void
+DeflateBlockCompressor::AppendTrailer(const std::vector<CompressedBlock> & blocks,
+                                      std::vector<char> &                  compressed) const
+{
+  if (m_Format == FormatEnum::Gzip)
+  {
+    uLong    crc = crc32(0L, Z_NULL, 0);
+    uint32_t size = 0;
+    for (const auto & block : blocks)
+    {
+      crc = crc32_combine(crc, block.m_Check, static_cast<z_off_t>(block.m_UncompressedSize));
+      // the size modulo 2^32
+      size += static_cast<uint32_t>(block.m_UncompressedSize);
+    }
+    AppendLittleEndian32(compressed, static_cast<uint32_t>(crc));
+    AppendLittleEndian32(compressed, size);
+  }
+  else
+  {
+    uLong adler = adler32(0L, Z_NULL, 0);
+    for (const auto & block : blocks)
+    {
+      adler = adler32_combine(adler, block.m_Check, static_cast<z_off_t>(block.m_UncompressedSize));
+    }
+    AppendBigEndian32(compressed, static_cast<uint32_t>(adler));
+  }
+}
+
+void
+DeflateBlockCompressor::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Format: " << m_Format << std::endl;
+  os << indent << "Strategy: " << m_Strategy << std::endl;
+}
+
+std::ostream &
+operator<<(std::ostream & out, const DeflateBlockCompressorEnums::Format value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case DeflateBlockCompressorEnums::Format::Zlib:
+        return "itk::DeflateBlockCompressorEnums::Format::Zlib";
+      case DeflateBlockCompressorEnums::Format::Gzip:
+        return "itk::DeflateBlockCompressorEnums::Format::Gzip";
+      default:
+        return "INVALID VALUE FOR itk::DeflateBlockCompressorEnums::Format";
+    }
+  }();
+}
+
+std::ostream &
+operator<<(std::ostream & out, const DeflateBlockCompressorEnums::Strategy value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case DeflateBlockCompressorEnums::Strategy::Default:
+        return "itk::DeflateBlockCompressorEnums::Strategy::Default";
+      case DeflateBlockCompressorEnums::Strategy::RunLength:
+        return "itk::DeflateBlockCompressorEnums::Strategy::RunLength";
+      case DeflateBlockCompressorEnums::Strategy::HuffmanOnly:
+        return "itk::DeflateBlockCompressorEnums::Strategy::HuffmanOnly";
+      default:
+        return "INVALID VALUE FOR itk::DeflateBlockCompressorEnums::Strategy";
+    }
+  }();
+}
+} // end namespace itk
@@ -21,6 +21,7 @@
 #include <mutex>
 #include "itksys/SystemTools.hxx"
 #include "itkPrintHelper.h"
+#include <algorithm>
 
 
 namespace itk
@@ -365,6 +366,13 @@ ImageIOBase::InternalSetCompressor(const std::string & _compressor)
   }
 }
 
+void
+ImageIOBase::ConfigureBlockCompressor(BlockCompressor & compressor) const
+{
+  compressor.SetCompressionLevel(this->GetCompressionLevel());
+  compressor.SetBlockSize(this->GetCompressionBlockSize());
+}
+
 unsigned int
 ImageIOBase::GetComponentSize() const
 {
@@ -1074,6 +1082,100 @@ ImageIOBase::GetSplitRegionForWriting(unsigned int          ithPiece,
   return largestPossibleRegion;
 }
 
+namespace
+{
+// The slowest moving dimension along which the region spans several chunks,
+// and the number of chunks it spans along it
+unsigned int
+GetChunkSplitDimension(const ImageIORegion &           region,
+                       const ImageIORegion::SizeType & chunkSize,
+                       SizeValueType &                 numberOfChunks)
+{
+  for (unsigned int i = std::min<unsigned int>(region.GetImageDimension(), chunkSize.size()); i > 0; --i)
+  {
+    const auto dim = i - 1;
+    if (chunkSize[dim] == 0)
+    {
+      continue;
+    }
+    const SizeValueType start = region.GetIndex(dim);
+    const SizeValueType end = start + region.GetSize(dim);
+    if (end > start)
+    {
+      numberOfChunks = (end - 1) / chunkSize[dim] - start / chunkSize[dim] + 1;
+      if (numberOfChunks > 1)
+      {
+        return dim;
+      }
+    }
+  }
+  numberOfChunks = 1;
+  return 0;
+}
+} // namespace
+
+unsigned int
+ImageIOBase::GetActualNumberOfSplitsForWritingChunks(unsigned int                    numberOfRequestedSplits,
+                                                     const ImageIORegion &           pasteRegion,
+                                                     const ImageIORegion::SizeType & chunkSize) const
+{
+  SizeValueType numberOfChunks;
+  GetChunkSplitDimension(pasteRegion, chunkSize, numberOfChunks);
+  return static_cast<unsigned int>(std::min<SizeValueType>(numberOfRequestedSplits, numberOfChunks));
+}
+
+ImageIORegion
+ImageIOBase::GetSplitRegionForWritingChunks(unsigned int                    ithPiece,
+                                            unsigned int                    numberOfActualSplits,
+                                            const ImageIORegion &           pasteRegion,
+                                            const ImageIORegion::SizeType & chunkSize) const
+{
+  SizeValueType      numberOfChunks;
+  const unsigned int dim = GetChunkSplitDimension(pasteRegion, chunkSize, numberOfChunks);
+  if (numberOfChunks <= 1)
+  {
+    return pasteRegion;
+  }
+
+  const SizeValueType pasteStart = pasteRegion.GetIndex(dim);
+  const SizeValueType pasteEnd = pasteStart + pasteRegion.GetSize(dim);
+  const SizeValueType firstChunk = pasteStart / chunkSize[dim];
+  const SizeValueType start =
+    std::max((firstChunk + ithPiece * numberOfChunks / numberOfActualSplits) * chunkSize[dim], pasteStart);
+  const SizeValueType end =
+    std::min((firstChunk + (ithPiece + 1) * numberOfChunks / numberOfActualSplits) * chunkSize[dim], pasteEnd);
+
+  ImageIORegion splitRegion = pasteRegion;
+  splitRegion.SetIndex(dim, start);
+  splitRegion.SetSize(dim, end - start);
+  return splitRegion;
+}
+
+ImageIORegion
+ImageIOBase::EnlargeRegionToChunks(const ImageIORegion & region, const ImageIORegion::SizeType & chunkSize) const
+{
+  ImageIORegion      enlargedRegion = region;
+  const unsigned int numberOfDimensions = std::min<unsigned int>(
+    std::min<unsigned int>(enlargedRegion.GetImageDimension(), chunkSize.size()), this->GetNumberOfDimensions());
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    if (chunkSize[i] == 0)
+    {
+      continue;
+    }
+    const SizeValueType start = enlargedRegion.GetIndex(i) / chunkSize[i] * chunkSize[i];
+    const SizeValueType end = std::min<SizeValueType>(
+      (enlargedRegion.GetIndex(i) + enlargedRegion.GetSize(i) + chunkSize[i] - 1) / chunkSize[i] * chunkSize[i],
+      this->GetDimensions(i));
+    if (end > start)
+    {
+      enlargedRegion.SetIndex(i, start);
+      enlargedRegion.SetSize(i, end - start);
+    }
+  }
+  return enlargedRegion;
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
@@ -1186,6 +1288,7 @@ ImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
   os << indent << "MaximumCompressionLevel: " << m_MaximumCompressionLevel << std::endl;
   os << indent << "Compressor: " << m_Compressor << std::endl;
+  os << indent << "CompressionBlockSize: " << m_CompressionBlockSize << std::endl;
   if (m_UseStreamedReading)
   {
     os << indent << "UseStreamedReading: On" << std::endl;
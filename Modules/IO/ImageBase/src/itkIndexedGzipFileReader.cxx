@@ -0,0 +1,332 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkIndexedGzipFileReader.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace itk
+{
+namespace
+{
+// deflate references at most 32 KiB of previous output
+constexpr unsigned int WindowSize = 32768U;
+constexpr unsigned int InputChunkSize = 16384U;
+} // namespace
+
+struct IndexedGzipFileReader::InflateState
+{
+  InflateState()
+    : m_Window(WindowSize, 0)
+    , m_Input(InputChunkSize)
+  {
+    std::memset(&m_Stream, 0, sizeof(m_Stream));
+  }
+  ~InflateState() { inflateEnd(&m_Stream); }
+
+  z_stream m_Stream;
+  // The circular output window; holds the last 32 KiB of uncompressed data
+  std::vector<unsigned char> m_Window;
+  std::vector<unsigned char> m_Input;
+  SizeType                   m_TotalIn{ 0 };
+  SizeType                   m_TotalOut{ 0 };
+  // Whether the stream was resumed from an access point, without header
+  bool m_Raw{ false };
+};
+
+IndexedGzipFileReader::IndexedGzipFileReader()
+  : m_AccessPointSpacing(SizeType{ 4 } * 1024 * 1024)
+{}
+
+IndexedGzipFileReader::~IndexedGzipFileReader() = default;
+
+void
+IndexedGzipFileReader::Open(const std::string & fileName, bool compressed, SizeType dataOffset)
+{
+  this->Close();
+
+  m_File.open(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!m_File.is_open() || m_File.fail())
+  {
+    itkExceptionMacro(<< "Could not open file: " << fileName << " for reading." << std::endl
+                      << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  m_FileName = fileName;
+  m_DataOffset = dataOffset;
+  m_Compressed = compressed;
+}
+
+void
+IndexedGzipFileReader::Close()
+{
+  if (m_File.is_open())
+  {
+    m_File.close();
+  }
+  m_File.clear();
+  m_FileName.clear();
+  m_DataOffset = 0;
+  m_Compressed = false;
+  m_AccessPoints.clear();
+  m_InflateState.reset();
+}
+
+void
+IndexedGzipFileReader::Read(void * buffer, SizeType offset, SizeType numberOfBytes)
+{
+  if (!m_File.is_open())
+  {
+    itkExceptionMacro(<< "No file is open.");
+  }
+  if (offset < 0 || numberOfBytes < 0)
+  {
+    itkExceptionMacro(<< "Invalid range: offset " << offset << ", " << numberOfBytes << " bytes.");
+  }
+  if (numberOfBytes == 0)
+  {
+    return;
+  }
+
+  if (m_Compressed)
+  {
+    this->ReadCompressed(static_cast<char *>(buffer), offset, numberOfBytes);
+    return;
+  }
+
+  m_File.clear();
+  m_File.seekg(static_cast<std::streamoff>(m_DataOffset + offset), std::ios::beg);
+  m_File.read(static_cast<char *>(buffer), static_cast<std::streamsize>(numberOfBytes));
+  if (m_File.gcount() != static_cast<std::streamsize>(numberOfBytes))
+  {
+    m_File.clear();
+    itkExceptionMacro(<< "Read failed: wanted " << numberOfBytes << " bytes at offset " << offset << ", but read "
+                      << m_File.gcount() << " bytes from " << m_FileName);
+  }
+}
+
+void
+IndexedGzipFileReader::StartInflate(const AccessPoint * start)
+{
+  m_InflateState.reset();
+  std::unique_ptr<InflateState> state(new InflateState);
+  z_stream &                    stream = state->m_Stream;
+
+  m_File.clear();
+  if (start == nullptr)
+  {
+    // 47: automatic zlib or gzip header detection, 32 KiB window
+    if (inflateInit2(&stream, 47) != Z_OK)
+    {
+      itkExceptionMacro(<< "Could not initialize zlib.");
+    }
+    // compressed offsets are positions in the file
+    state->m_TotalIn = m_DataOffset;
+    m_File.seekg(static_cast<std::streamoff>(m_DataOffset), std::ios::beg);
+  }
+  else
+  {
+    // Raw deflate, starting mid-stream
+    if (inflateInit2(&stream, -15) != Z_OK)
+    {
+      itkExceptionMacro(<< "Could not initialize zlib.");
+    }
+    state->m_Raw = true;
+    state->m_TotalIn = start->m_CompressedOffset;
+    state->m_TotalOut = start->m_UncompressedOffset;
+    m_File.seekg(static_cast<std::streamoff>(state->m_TotalIn - (start->m_Bits ? 1 : 0)), std::ios::beg);
+    if (start->m_Bits)
+    {
+      const int byte = m_File.get();
+      if (byte == std::char_traits<char>::eof())
+      {
+        itkExceptionMacro(<< "Unexpected end of file in " << m_FileName);
+      }
+      inflatePrime(&stream, start->m_Bits, byte >> (8 - start->m_Bits));
+    }
+    inflateSetDictionary(&stream, start->m_Window.data(), WindowSize);
+    state->m_Window = start->m_Window;
+  }
+  m_InflateState = std::move(state);
+}
+
+void
+IndexedGzipFileReader::ReadCompressed(char * buffer, SizeType offset, SizeType numberOfBytes)
+{
+  const SizeType end = offset + numberOfBytes;
+
+  // The last access point at or before the requested offset
+  const AccessPoint * start = nullptr;
+  for (const auto & point : m_AccessPoints)
+  {
+    if (point.m_UncompressedOffset > offset)
+    {
+      break;
+    }
+    start = &point;
+  }
+
+  // Continue the ongoing decompression if it has not passed the requested
+  // offset yet and no access point is closer to it.
+  if (!m_InflateState || m_InflateState->m_TotalOut > offset ||
+      (start != nullptr && start->m_UncompressedOffset > m_InflateState->m_TotalOut))
+  {
+    this->StartInflate(start);
+  }
+
+  InflateState & state = *m_InflateState;
+  z_stream &     stream = state.m_Stream;
+  try
+  {
+    while (state.m_TotalOut < end)
+    {
+      if (stream.avail_in == 0)
+      {
+        m_File.read(reinterpret_cast<char *>(state.m_Input.data()), InputChunkSize);
+        stream.avail_in = static_cast<uInt>(m_File.gcount());
+        stream.next_in = state.m_Input.data();
+        if (stream.avail_in == 0)
+        {
+          itkExceptionMacro(<< "Unexpected end of compressed data in " << m_FileName << ": requested bytes up to "
+                            << end << ", but only " << state.m_TotalOut << " are available.");
+        }
+      }
+      if (stream.avail_out == 0)
+      {
+        stream.avail_out = WindowSize;
+        stream.next_out = state.m_Window.data();
+      }
+
+      // Decompress until the end of the input, the end of the window or the
+      // end of a deflate block, whichever comes first.
+      unsigned char * const outBegin = stream.next_out;
+      const uInt            inBefore = stream.avail_in;
+      const int             ret = inflate(&stream, Z_BLOCK);
+      if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR)
+      {
+        itkExceptionMacro(<< "Corrupted compressed data in " << m_FileName << (stream.msg != nullptr ? ": " : "")
+                          << (stream.msg != nullptr ? stream.msg : ""));
+      }
+      state.m_TotalIn += inBefore - stream.avail_in;
+
+      // Copy the part of the new output that overlaps the requested range
+      const SizeType produced = stream.next_out - outBegin;
+      const SizeType copyBegin = std::max(state.m_TotalOut, offset);
+      const SizeType copyEnd = std::min(state.m_TotalOut + produced, end);
+      if (copyBegin < copyEnd)
+      {
+        std::memcpy(buffer + (copyBegin - offset), outBegin + (copyBegin - state.m_TotalOut), copyEnd - copyBegin);
+      }
+      state.m_TotalOut += produced;
+
+      if (ret == Z_STREAM_END)
+      {
+        if (this->StartNextMember())
+        {
+          continue;
+        }
+        if (state.m_TotalOut < end)
+        {
+          itkExceptionMacro(<< "Unexpected end of compressed data in " << m_FileName << ": requested bytes up to "
+                            << end << ", but only " << state.m_TotalOut << " are available.");
+        }
+        break;
+      }
+
+      // At the end of a deflate block that is not the last one, record an
+      // access point if the previous one is far enough behind.
+      const bool     atBlockBoundary = (stream.data_type & 128) && !(stream.data_type & 64);
+      const SizeType lastIndexed = m_AccessPoints.empty() ? 0 : m_AccessPoints.back().m_UncompressedOffset;
+      if (atBlockBoundary && state.m_TotalOut >= lastIndexed + m_AccessPointSpacing)
+      {
+        AccessPoint point;
+        point.m_UncompressedOffset = state.m_TotalOut;
+        point.m_CompressedOffset = state.m_TotalIn;
+        point.m_Bits = stream.data_type & 7;
+        point.m_Window.resize(WindowSize);
+        // Unroll the circular window, oldest data first
+        const uInt left = stream.avail_out;
+        if (left != 0)
+        {
+          std::memcpy(point.m_Window.data(), state.m_Window.data() + WindowSize - left, left);
+        }
+        if (left < WindowSize)
+        {
+          std::memcpy(point.m_Window.data() + left, state.m_Window.data(), WindowSize - left);
+        }
+        m_AccessPoints.push_back(std::move(point));
+      }
+    }
+  }
+  catch (...)
+  {
+    m_InflateState.reset();
+    throw;
+  }
+}
+
+bool
+IndexedGzipFileReader::StartNextMember()
+{
+  InflateState & state = *m_InflateState;
+  z_stream &     stream = state.m_Stream;
+
+  // Raw decompression stops in front of the gzip trailer (CRC-32 and
+  // size), which has to be skipped.
+  uInt skip = state.m_Raw ? 8 : 0;
+  for (;;)
+  {
+    const uInt skipped = std::min(stream.avail_in, skip);
+    stream.next_in += skipped;
+    stream.avail_in -= skipped;
+    state.m_TotalIn += skipped;
+    skip -= skipped;
+    if (skip == 0 && stream.avail_in > 0)
+    {
+      break;
+    }
+    m_File.read(reinterpret_cast<char *>(state.m_Input.data()), InputChunkSize);
+    stream.avail_in = static_cast<uInt>(m_File.gcount());
+    stream.next_in = state.m_Input.data();
+    if (stream.avail_in == 0)
+    {
+      return false;
+    }
+  }
+
+  if ((state.m_Raw ? inflateReset2(&stream, 47) : inflateReset(&stream)) != Z_OK)
+  {
+    itkExceptionMacro(<< "Could not initialize zlib.");
+  }
+  state.m_Raw = false;
+  return true;
+}
+
+void
+IndexedGzipFileReader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "DataOffset: " << m_DataOffset << std::endl;
+  os << indent << "Compressed: " << (m_Compressed ? "On" : "Off") << std::endl;
+  os << indent << "AccessPointSpacing: " << m_AccessPointSpacing << std::endl;
+  os << indent << "NumberOfAccessPoints: " << m_AccessPoints.size() << std::endl;
+}
+} // end namespace itk
@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConvertPixelBuffer.h"
+#include "itkMultiThreaderBase.h"
+#include "itkRGBAPixel.h"
+#include "itkTimeProbe.h"
+#include <iomanip>
+#include <vector>
+
+namespace
+{
+
+template <typename TInputPixel, typename TOutputPixel>
+void
+TimeConversion(const char * name, int inputNumberOfComponents, size_t numberOfPixels, bool vectorImage)
+{
+  using ConverterType =
+    itk::ConvertPixelBuffer<TInputPixel, TOutputPixel, itk::DefaultConvertPixelTraits<TOutputPixel>>;
+  const size_t outputSize = vectorImage ? numberOfPixels * inputNumberOfComponents : numberOfPixels;
+
+  std::vector<TInputPixel> input(numberOfPixels * inputNumberOfComponents);
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = static_cast<TInputPixel>((i * 7919) % 251);
+  }
+  std::vector<TOutputPixel> output(outputSize);
+
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  itk::TimeProbe          referenceProbe;
+  itk::TimeProbe          probe;
+  const auto convert = [&]() {
+    if (vectorImage)
+    {
+      ConverterType::ConvertVectorImage(input.data(), inputNumberOfComponents, output.data(), numberOfPixels);
+    }
+    else
+    {
+      ConverterType::Convert(input.data(), inputNumberOfComponents, output.data(), numberOfPixels);
+    }
+  };
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+    referenceProbe.Start();
+    convert();
+    referenceProbe.Stop();
+
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+    probe.Start();
+    convert();
+    probe.Stop();
+  }
+  std::cout << std::setw(30) << name << std::setw(16) << referenceProbe.GetMean() << std::setw(16) << probe.GetMean()
+            << std::setw(10) << referenceProbe.GetMean() / probe.GetMean() << std::endl;
+}
+
+} // namespace
+
+// Measures the speedup of the parallel pixel buffer conversions over the
+// single threaded ones. Only built with ITK_BUILD_BENCHMARKS, as a test
+// run by ctest -L BENCHMARK; itkConvertBufferParallelTest checks the
+// converted pixels.
+//
+// Usage: itkConvertBufferParallelBenchmark [numberOfPixels]
+int
+main(int argc, char * argv[])
+{
+  size_t numberOfPixels = size_t{ 1 } << 24;
+  if (argc > 1)
+  {
+    numberOfPixels = static_cast<size_t>(std::stoull(argv[1]));
+  }
+
+  using RGBType = itk::RGBPixel<unsigned char>;
+  using RGBAType = itk::RGBAPixel<unsigned char>;
+
+  std::cout << std::setw(30) << "conversion" << std::setw(16) << "1 thread [s]" << std::setw(16) << "threads [s]"
+            << std::setw(10) << "speedup" << std::endl;
+  TimeConversion<unsigned short, float>("unsigned short to float", 1, numberOfPixels, false);
+  TimeConversion<unsigned char, float>("RGB to float", 3, numberOfPixels, false);
+  TimeConversion<unsigned char, unsigned char>("RGBA to gray", 4, numberOfPixels, false);
+  TimeConversion<unsigned char, RGBType>("RGBA to RGB", 4, numberOfPixels, false);
+  TimeConversion<unsigned char, RGBAType>("RGB to RGBA", 3, numberOfPixels, false);
+  TimeConversion<short, RGBAType>("intensity and alpha to RGBA", 2, numberOfPixels, false);
+  TimeConversion<short, double>("vector image components", 3, numberOfPixels, true);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConvertPixelBuffer.h"
+#include "itkMultiThreaderBase.h"
+#include "itkRGBAPixel.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <vector>
+
+// Compares the parallel conversions with the single threaded ones. The
+// timings are reported by itkConvertBufferParallelBenchmark.
+namespace
+{
+
+template <typename TInputPixel, typename TOutputPixel>
+bool
+CompareWithSingleThreaded(const char * name, int inputNumberOfComponents, size_t numberOfPixels, bool vectorImage)
+{
+  using ConverterType =
+    itk::ConvertPixelBuffer<TInputPixel, TOutputPixel, itk::DefaultConvertPixelTraits<TOutputPixel>>;
+  const size_t outputSize = vectorImage ? numberOfPixels * inputNumberOfComponents : numberOfPixels;
+
+  std::vector<TInputPixel> input(numberOfPixels * inputNumberOfComponents);
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = static_cast<TInputPixel>((i * 7919) % 251);
+  }
+  std::vector<TOutputPixel> reference(outputSize);
+  std::vector<TOutputPixel> output(outputSize);
+
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+  if (vectorImage)
+  {
+    ConverterType::ConvertVectorImage(input.data(), inputNumberOfComponents, reference.data(), numberOfPixels);
+  }
+  else
+  {
+    ConverterType::Convert(input.data(), inputNumberOfComponents, reference.data(), numberOfPixels);
+  }
+
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+  if (vectorImage)
+  {
+    ConverterType::ConvertVectorImage(input.data(), inputNumberOfComponents, output.data(), numberOfPixels);
+  }
+  else
+  {
+    ConverterType::Convert(input.data(), inputNumberOfComponents, output.data(), numberOfPixels);
+  }
+
+  if (!std::equal(reference.begin(), reference.end(), output.begin()))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << name << ": the parallel conversion differs from the single threaded one" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Two components, an intensity and an alpha, give the RGBA pixel {i,i,i,a}.
+// This conversion used to leave its output pointer on the first pixel, so
+// that every pixel was written to it and the others were left untouched.
+bool
+CheckIntensityAlphaToRGBA()
+{
+  using RGBAType = itk::RGBAPixel<unsigned char>;
+  using ConverterType = itk::ConvertPixelBuffer<short, RGBAType, itk::DefaultConvertPixelTraits<RGBAType>>;
+
+  short                 input[] = { 10, 200, 20, 150, 30, 100, 40, 50 };
+  constexpr size_t      numberOfPixels = 4;
+  std::vector<RGBAType> output(numberOfPixels);
+  for (auto & pixel : output)
+  {
+    pixel.Fill(0);
+  }
+  ConverterType::Convert(input, 2, output.data(), numberOfPixels);
+
+  for (size_t i = 0; i < numberOfPixels; ++i)
+  {
+    const auto intensity = static_cast<unsigned char>(input[2 * i]);
+    const auto alpha = static_cast<unsigned char>(input[2 * i + 1]);
+    if (output[i].GetRed() != intensity || output[i].GetGreen() != intensity || output[i].GetBlue() != intensity ||
+        output[i].GetAlpha() != alpha)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Intensity and alpha to RGBA: pixel " << i << " is " << output[i] << ", expected {"
+                << static_cast<int>(intensity) << ", " << static_cast<int>(intensity) << ", "
+                << static_cast<int>(intensity) << ", " << static_cast<int>(alpha) << "}" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkConvertBufferParallelTest(int, char *[])
+{
+  // Not a multiple of the chunks converted by each work unit
+  const size_t numberOfPixels = (size_t{ 1 } << 21) + 17;
+
+  using RGBType = itk::RGBPixel<unsigned char>;
+  using RGBAType = itk::RGBAPixel<unsigned char>;
+
+  ITK_TEST_EXPECT_TRUE(
+    (CompareWithSingleThreaded<unsigned short, float>("unsigned short to float", 1, numberOfPixels, false)));
+  ITK_TEST_EXPECT_TRUE((CompareWithSingleThreaded<unsigned char, float>("RGB to float", 3, numberOfPixels, false)));
+  ITK_TEST_EXPECT_TRUE(
+    (CompareWithSingleThreaded<unsigned char, unsigned char>("RGBA to gray", 4, numberOfPixels, false)));
+  ITK_TEST_EXPECT_TRUE((CompareWithSingleThreaded<unsigned char, RGBType>("RGBA to RGB", 4, numberOfPixels, false)));
+  ITK_TEST_EXPECT_TRUE((CompareWithSingleThreaded<unsigned char, RGBAType>("RGB to RGBA", 3, numberOfPixels, false)));
+  ITK_TEST_EXPECT_TRUE(
+    (CompareWithSingleThreaded<short, RGBAType>("intensity and alpha to RGBA", 2, numberOfPixels, false)));
+  ITK_TEST_EXPECT_TRUE((CompareWithSingleThreaded<short, double>("vector image components", 3, numberOfPixels, true)));
+
+  ITK_TEST_EXPECT_TRUE(CheckIntensityAlphaToRGBA());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDeflateBlockCompressor.h"
+#include "itkTestingMacros.h"
+#include "itk_zlib.h"
+
+namespace
+{
+// Inflate data with the given zlib window bits, and compare it to the
+// expected data
+bool
+Inflate(const char * compressed, size_t compressedSize, int windowBits, const std::vector<char> & expected)
+{
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  if (inflateInit2(&stream, windowBits) != Z_OK)
+  {
+    return false;
+  }
+  std::vector<char> uncompressed(expected.size() + 1);
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed));
+  stream.avail_in = static_cast<uInt>(compressedSize);
+  stream.next_out = reinterpret_cast<Bytef *>(uncompressed.data());
+  stream.avail_out = static_cast<uInt>(uncompressed.size());
+  // Raw deflate data of a block that does not end the stream ends with a
+  // sync flush, not with the end of the stream
+  const int  ret = inflate(&stream, windowBits < 0 ? Z_SYNC_FLUSH : Z_FINISH);
+  const bool ended = windowBits < 0 ? ret == Z_OK || ret == Z_STREAM_END : ret == Z_STREAM_END && stream.avail_in == 0;
+  const bool same = ended && stream.total_out == expected.size() &&
+                    std::equal(expected.begin(), expected.end(), uncompressed.begin());
+  inflateEnd(&stream);
+  if (!same)
+  {
+    std::cerr << "Inflating " << compressedSize << " bytes returned " << ret << ", and " << stream.total_out
+              << " bytes instead of the expected " << expected.size() << std::endl;
+  }
+  return same;
+}
+} // namespace
+
+int
+itkDeflateBlockCompressorTest(int, char *[])
+{
+  using CompressorType = itk::DeflateBlockCompressor;
+  using SizeType = CompressorType::SizeType;
+
+  auto compressor = CompressorType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(compressor, DeflateBlockCompressor, BlockCompressor);
+
+  ITK_TEST_EXPECT_EQUAL(compressor->GetBlockSize(), SizeType{ 1 } << 20);
+  ITK_TEST_EXPECT_EQUAL(compressor->GetCompressionLevel(), 6);
+  ITK_TEST_EXPECT_EQUAL(compressor->GetFormat(), CompressorType::FormatEnum::Zlib);
+  ITK_TEST_EXPECT_EQUAL(compressor->GetStrategy(), CompressorType::StrategyEnum::Default);
+  ITK_TEST_SET_GET_VALUE(itk::ThreadIdType{ 3 }, (compressor->SetNumberOfWorkUnits(3), compressor->GetNumberOfWorkUnits()));
+
+  // Runs of values, and some noise
+  std::vector<char> data(100000);
+  unsigned int      noise = 1;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    noise = noise * 1103515245U + 12345U;
+    data[i] = static_cast<char>(i % 3000 < 2000 ? (i / 700) : (noise >> 16));
+  }
+
+  const CompressorType::FormatEnum   formats[] = { CompressorType::FormatEnum::Zlib, CompressorType::FormatEnum::Gzip };
+  const CompressorType::StrategyEnum strategies[] = { CompressorType::StrategyEnum::Default,
+                                                      CompressorType::StrategyEnum::RunLength,
+                                                      CompressorType::StrategyEnum::HuffmanOnly };
+  const SizeType                     sizes[] = { 0, 1, 4096, 4097, 100000 };
+  for (const auto format : formats)
+  {
+    for (const auto strategy : strategies)
+    {
+      for (const auto size : sizes)
+      {
+        std::cout << format << ", " << strategy << ", " << size << " bytes" << std::endl;
+        compressor->SetFormat(format);
+        compressor->SetStrategy(strategy);
+        compressor->SetBlockSize(4096);
+        std::vector<char>     compressed;
+        std::vector<SizeType> blockOffsets;
+        ITK_TRY_EXPECT_NO_EXCEPTION(compressor->Compress(data.data(), size, compressed, &blockOffsets));
+
+        // A single stream of the format
+        const std::vector<char> expected(data.begin(), data.begin() + size);
+        ITK_TEST_EXPECT_TRUE(Inflate(
+          compressed.data(), compressed.size(), format == CompressorType::FormatEnum::Gzip ? 31 : 15, expected));
+
+        // Blocks can be decompressed on their own
+        ITK_TEST_EXPECT_EQUAL(blockOffsets.size(), size == 0 ? 1 : static_cast<size_t>((size + 4095) / 4096));
+        for (size_t block = 0; block < blockOffsets.size(); ++block)
+        {
+          const SizeType          begin = static_cast<SizeType>(block) * 4096;
+          const std::vector<char> expectedBlock(data.begin() + begin,
+                                                data.begin() + std::min(begin + 4096, size));
+          const SizeType          blockEnd =
+            block + 1 < blockOffsets.size() ? blockOffsets[block + 1] : static_cast<SizeType>(compressed.size());
+          ITK_TEST_EXPECT_TRUE(Inflate(
+            compressed.data() + blockOffsets[block], blockEnd - blockOffsets[block], -15, expectedBlock));
+        }
+
+        // Decompress all the blocks, and the blocks after the first one
+        std::vector<char> decompressed(static_cast<size_t>(size));
+        ITK_TRY_EXPECT_NO_EXCEPTION(compressor->Decompress(compressed.data(),
+                                                           static_cast<SizeType>(compressed.size()),
+                                                           blockOffsets,
+                                                           decompressed.data(),
+                                                           size));
+        ITK_TEST_EXPECT_TRUE(decompressed == expected);
+        if (blockOffsets.size() > 1)
+        {
+          std::vector<SizeType> laterOffsets;
+          for (size_t block = 1; block < blockOffsets.size(); ++block)
+          {
+            laterOffsets.push_back(blockOffsets[block] - blockOffsets[1]);
+          }
+          std::vector<char> later(static_cast<size_t>(size - 4096));
+          ITK_TRY_EXPECT_NO_EXCEPTION(compressor->Decompress(compressed.data() + blockOffsets[1],
+                                                             static_cast<SizeType>(compressed.size()) - blockOffsets[1],
+                                                             laterOffsets,
+                                                             later.data(),
+                                                             size - 4096));
+          ITK_TEST_EXPECT_TRUE(std::equal(later.begin(), later.end(), expected.begin() + 4096));
+        }
+      }
+    }
+  }
+
+  // Serial and parallel compression give the same result
+  std::vector<char> serial;
+  std::vector<char> parallel;
+  compressor->SetNumberOfWorkUnits(1);
+  compressor->Compress(data.data(), static_cast<SizeType>(data.size()), serial);
+  compressor->SetNumberOfWorkUnits(4);
+  compressor->Compress(data.data(), static_cast<SizeType>(data.size()), parallel);
+  ITK_TEST_EXPECT_TRUE(serial == parallel);
+
+  // Corrupted data is reported
+  std::vector<itk::intmax_t> offsets;
+  compressor->Compress(data.data(), static_cast<SizeType>(data.size()), serial, &offsets);
+  serial[offsets[2] + 1] = static_cast<char>(~serial[offsets[2] + 1]);
+  serial[offsets[2] + 2] = static_cast<char>(~serial[offsets[2] + 2]);
+  std::vector<char> decompressed(data.size());
+  ITK_TRY_EXPECT_EXCEPTION(compressor->Decompress(
+    serial.data(), static_cast<SizeType>(serial.size()), offsets, decompressed.data(), static_cast<SizeType>(data.size())));
+
+  // Invalid compression levels are reported
+  compressor->SetCompressionLevel(42);
+  std::vector<char> compressed;
+  ITK_TRY_EXPECT_EXCEPTION(compressor->Compress(data.data(), 10, compressed));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMemoryMappedImageContainer.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using PixelType = unsigned char;
+using ImageType = itk::Image<PixelType, 3>;
+using MappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, PixelType>;
+
+bool
+SameImage(const ImageType * test, const ImageType * baseline)
+{
+  if (test->GetBufferedRegion() != baseline->GetLargestPossibleRegion())
+  {
+    std::cerr << "Buffered region " << test->GetBufferedRegion() << " differs from "
+              << baseline->GetLargestPossibleRegion() << std::endl;
+    return false;
+  }
+  itk::ImageRegionConstIterator<ImageType> testIt(test, test->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> baselineIt(baseline, baseline->GetLargestPossibleRegion());
+  for (; !testIt.IsAtEnd(); ++testIt, ++baselineIt)
+  {
+    if (testIt.Get() != baselineIt.Get())
+    {
+      std::cerr << "Pixel " << testIt.GetIndex() << " is " << static_cast<int>(testIt.Get()) << " instead of "
+                << static_cast<int>(baselineIt.Get()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+WriteImage(const ImageType * image, const std::string & fileName, bool useCompression)
+{
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(useCompression);
+  writer->Update();
+}
+
+ImageType::Pointer
+ReadImage(const std::string & fileName, bool useMemoryMapping)
+{
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetUseMemoryMapping(useMemoryMapping);
+  reader->Update();
+  return reader->GetOutput();
+}
+} // namespace
+
+int
+itkImageFileReaderMemoryMappingTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFile canCompress" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+  const bool        canCompress = std::stoi(argv[2]) != 0;
+
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize({ { 31, 17, 9 } });
+  image->SetRegions(region);
+  image->Allocate();
+  itk::ImageRegionIterator<ImageType> it(image, region);
+  for (PixelType value = 0; !it.IsAtEnd(); ++it, value += 7)
+  {
+    it.Set(value);
+  }
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteImage(image, fileName, false));
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  ITK_TEST_SET_GET_BOOLEAN(reader, UseMemoryMapping, false);
+
+  // Read and memory mapped images are identical
+  ImageType::Pointer readImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage(fileName, false));
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<MappedContainerType *>(readImage->GetPixelContainer()) == nullptr);
+  ITK_TEST_EXPECT_TRUE(SameImage(readImage, image));
+
+  ImageType::Pointer mappedImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(mappedImage = ReadImage(fileName, true));
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<MappedContainerType *>(mappedImage->GetPixelContainer()) != nullptr);
+  ITK_TEST_EXPECT_TRUE(SameImage(mappedImage, image));
+
+  // Modifying the mapped image leaves the file untouched
+  mappedImage->FillBuffer(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage(fileName, true));
+  ITK_TEST_EXPECT_TRUE(SameImage(readImage, image));
+  mappedImage = nullptr;
+  readImage = nullptr;
+
+  // Compressed data is read
+  if (canCompress)
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteImage(image, fileName, true));
+    ITK_TRY_EXPECT_NO_EXCEPTION(mappedImage = ReadImage(fileName, true));
+    ITK_TEST_EXPECT_TRUE(dynamic_cast<MappedContainerType *>(mappedImage->GetPixelContainer()) == nullptr);
+    ITK_TEST_EXPECT_TRUE(SameImage(mappedImage, image));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
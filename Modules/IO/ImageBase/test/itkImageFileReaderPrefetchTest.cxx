@@ -0,0 +1,294 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image<PixelType, 3>;
+
+// The regions read by the clones of the CountingMetaImageIO
+std::atomic<unsigned int> numberOfClonedReads{ 0 };
+
+// MetaIO parses the headers with a global state, so that distinct ImageIOs,
+// as the clones, or the ImageIOs of distinct readers, do not read at once
+std::mutex metaIOMutex;
+
+// Counts the regions read, the ones read by another thread than the one
+// which created it, and the calls made while another one is in progress
+class CountingMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingMetaImageIO);
+
+  using Self = CountingMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  bool
+  CanCloneForReading() const override
+  {
+    return m_CanCloneForReading;
+  }
+
+  itk::ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const itk::ImageIORegion & requested) const override
+  {
+    const UseGuard guard(*this);
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+
+  void
+  ReadImageInformation() override
+  {
+    const std::lock_guard<std::mutex> lock(metaIOMutex);
+    Superclass::ReadImageInformation();
+  }
+
+  void
+  Read(void * buffer) override
+  {
+    const UseGuard guard(*this);
+    if (m_IsClone)
+    {
+      ++numberOfClonedReads;
+      const std::lock_guard<std::mutex> lock(metaIOMutex);
+      Superclass::Read(buffer);
+      return;
+    }
+    ++m_NumberOfReads;
+    if (std::this_thread::get_id() != m_CreatorThreadId)
+    {
+      ++m_NumberOfBackgroundReads;
+    }
+    if (m_SlowReads)
+    {
+      // Leaves the time to use the ImageIO meanwhile
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    const std::lock_guard<std::mutex> lock(metaIOMutex);
+    Superclass::Read(buffer);
+  }
+
+  std::atomic<unsigned int>         m_NumberOfReads{ 0 };
+  std::atomic<unsigned int>         m_NumberOfBackgroundReads{ 0 };
+  mutable std::atomic<unsigned int> m_NumberOfConcurrentUses{ 0 };
+  std::atomic<bool>                 m_SlowReads{ false };
+  bool                              m_CanCloneForReading{ false };
+
+protected:
+  CountingMetaImageIO() = default;
+
+  itk::LightObject::Pointer
+  InternalClone() const override
+  {
+    Pointer clone = Self::New();
+    clone->m_IsClone = true;
+    return clone.GetPointer();
+  }
+
+private:
+  // Counts the calls made while another one is in progress
+  class UseGuard
+  {
+  public:
+    explicit UseGuard(const CountingMetaImageIO & imageIO)
+      : m_ImageIO(imageIO)
+    {
+      if (m_ImageIO.m_NumberOfUsers++ > 0)
+      {
+        ++m_ImageIO.m_NumberOfConcurrentUses;
+      }
+    }
+    ~UseGuard() { --m_ImageIO.m_NumberOfUsers; }
+
+  private:
+    const CountingMetaImageIO & m_ImageIO;
+  };
+
+  const std::thread::id             m_CreatorThreadId{ std::this_thread::get_id() };
+  bool                              m_IsClone{ false };
+  mutable std::atomic<unsigned int> m_NumberOfUsers{ 0 };
+};
+
+PixelType
+PixelValue(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[2] * 1000 + index[1] * 40 + index[0]);
+}
+
+template <typename TImage>
+bool
+CheckPixels(const TImage * image, const typename TImage::RegionType & region)
+{
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Buffered region " << image->GetBufferedRegion() << " differs from " << region << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != static_cast<typename TImage::PixelType>(PixelValue(it.GetIndex())))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << it.GetIndex() << ": expected " << PixelValue(it.GetIndex()) << ", but got "
+                << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkImageFileReaderPrefetchTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkImageFileReaderPrefetchTest.mha";
+
+  const ImageType::RegionType largestRegion({ { 0, 0, 0 } }, { { 40, 30, 20 } });
+  auto                        image = ImageType::New();
+  image->SetRegions(largestRegion);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, largestRegion); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PixelValue(it.GetIndex()));
+  }
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // Each of the pieces streamed is read once, all but the first one in the
+  // background
+  auto imageIO = CountingMetaImageIO::New();
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(imageIO);
+  ITK_TEST_SET_GET_VALUE(0u, reader->GetNumberOfPrefetchedRegions());
+  reader->SetNumberOfPrefetchedRegions(2);
+  ITK_TEST_SET_GET_VALUE(2u, reader->GetNumberOfPrefetchedRegions());
+
+  auto monitor = itk::PipelineMonitorImageFilter<ImageType>::New();
+  monitor->SetInput(reader->GetOutput());
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(monitor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  ITK_TEST_EXPECT_TRUE(monitor->VerifyAllInputCanStream(5));
+  ITK_TEST_EXPECT_TRUE(CheckPixels(streamer->GetOutput(), largestRegion));
+  ITK_TEST_EXPECT_EQUAL(imageIO->m_NumberOfReads.load(), 5u);
+  ITK_TEST_EXPECT_EQUAL(imageIO->m_NumberOfBackgroundReads.load(), 4u);
+
+  // The regions prefetched after the first one are discarded when another
+  // is requested, and the one following it is prefetched. The discarded
+  // regions whose read has not started yet are not read at all.
+  ImageType * output = reader->GetOutput();
+  imageIO->m_NumberOfReads = 0;
+  imageIO->m_NumberOfBackgroundReads = 0;
+  const ImageType::RegionType firstRegion({ { 0, 0, 0 } }, { { 40, 30, 4 } });
+  output->SetRequestedRegion(firstRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(output->Update());
+  ITK_TEST_EXPECT_TRUE(CheckPixels(output, firstRegion));
+
+  const ImageType::RegionType unexpectedRegion({ { 0, 0, 12 } }, { { 40, 30, 4 } });
+  output->SetRequestedRegion(unexpectedRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(output->Update());
+  ITK_TEST_EXPECT_TRUE(CheckPixels(output, unexpectedRegion));
+
+  const ImageType::RegionType lastRegion({ { 0, 0, 16 } }, { { 40, 30, 4 } });
+  output->SetRequestedRegion(lastRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(output->Update());
+  ITK_TEST_EXPECT_TRUE(CheckPixels(output, lastRegion));
+  ITK_TEST_EXPECT_EQUAL(imageIO->m_NumberOfReads.load() - imageIO->m_NumberOfBackgroundReads.load(), 2u);
+  ITK_TEST_EXPECT_TRUE(imageIO->m_NumberOfBackgroundReads.load() >= 1u);
+  ITK_TEST_EXPECT_TRUE(imageIO->m_NumberOfBackgroundReads.load() <= 3u);
+
+  // Regions which are never the ones expected, as requested by a filter
+  // padding them, while the regions prefetched are still being read. The
+  // reader does not use the ImageIO before the prefetch thread is done
+  // with it.
+  imageIO->m_SlowReads = true;
+  for (unsigned int pass = 0; pass < 3; ++pass)
+  {
+    for (itk::IndexValueType z = 0; z + 3 <= 20; z += 2)
+    {
+      const ImageType::RegionType paddedRegion({ { 0, 0, z } }, { { 40, 30, 3 } });
+      output->SetRequestedRegion(paddedRegion);
+      ITK_TRY_EXPECT_NO_EXCEPTION(output->Update());
+      ITK_TEST_EXPECT_TRUE(CheckPixels(output, paddedRegion));
+    }
+  }
+  imageIO->m_SlowReads = false;
+  ITK_TEST_EXPECT_EQUAL(imageIO->m_NumberOfConcurrentUses.load(), 0u);
+
+  // An ImageIO that can be cloned for reading only reads the regions
+  // requested, its clone reading the ones prefetched
+  auto cloneableIO = CountingMetaImageIO::New();
+  cloneableIO->m_CanCloneForReading = true;
+  auto cloneReader = itk::ImageFileReader<ImageType>::New();
+  cloneReader->SetFileName(fileName);
+  cloneReader->SetImageIO(cloneableIO);
+  cloneReader->SetNumberOfPrefetchedRegions(2);
+  auto cloneStreamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  cloneStreamer->SetInput(cloneReader->GetOutput());
+  cloneStreamer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(cloneStreamer->Update());
+  ITK_TEST_EXPECT_TRUE(CheckPixels(cloneStreamer->GetOutput(), largestRegion));
+  ITK_TEST_EXPECT_EQUAL(cloneableIO->m_NumberOfReads.load(), 1u);
+  ITK_TEST_EXPECT_EQUAL(cloneableIO->m_NumberOfBackgroundReads.load(), 0u);
+  ITK_TEST_EXPECT_EQUAL(numberOfClonedReads.load(), 4u);
+
+  // The pixels prefetched are converted
+  using FloatImageType = itk::Image<float, 3>;
+  auto floatReader = itk::ImageFileReader<FloatImageType>::New();
+  floatReader->SetFileName(fileName);
+  floatReader->SetNumberOfPrefetchedRegions(3);
+  auto floatStreamer = itk::StreamingImageFilter<FloatImageType, FloatImageType>::New();
+  floatStreamer->SetInput(floatReader->GetOutput());
+  floatStreamer->SetNumberOfStreamDivisions(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(floatStreamer->Update());
+  ITK_TEST_EXPECT_TRUE(CheckPixels(floatStreamer->GetOutput(), largestRegion));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
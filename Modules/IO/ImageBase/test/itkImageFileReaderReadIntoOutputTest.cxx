@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// Records the buffer it reads into
+class BufferRecordingMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BufferRecordingMetaImageIO);
+
+  using Self = BufferRecordingMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  void
+  Read(void * buffer) override
+  {
+    m_Buffer = buffer;
+    Superclass::Read(buffer);
+  }
+
+  const void * m_Buffer{ nullptr };
+
+protected:
+  BufferRecordingMetaImageIO() = default;
+};
+
+template <typename TInputPixel, typename TOutputPixel>
+bool
+ReadsIntoOutputBuffer(const std::string & fileName, bool expectedIntoOutputBuffer)
+{
+  using InputImageType = itk::Image<TInputPixel, 3>;
+  using OutputImageType = itk::Image<TOutputPixel, 3>;
+
+  const typename InputImageType::SizeType size = { { 23, 17, 5 } };
+  auto                                    image = InputImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const typename InputImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<TInputPixel>(index[2] * 1000 + index[1] * 30 + index[0]));
+  }
+
+  auto writer = itk::ImageFileWriter<InputImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->Update();
+
+  auto imageIO = BufferRecordingMetaImageIO::New();
+  auto reader = itk::ImageFileReader<OutputImageType>::New();
+  reader->SetImageIO(imageIO);
+  reader->SetFileName(fileName);
+  reader->Update();
+  const OutputImageType * output = reader->GetOutput();
+
+  const bool intoOutputBuffer = imageIO->m_Buffer == output->GetBufferPointer();
+  if (intoOutputBuffer != expectedIntoOutputBuffer)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << fileName << (intoOutputBuffer ? " was" : " was not") << " read into the output buffer" << std::endl;
+    return false;
+  }
+
+  itk::ImageRegionConstIterator<InputImageType>  inputIt(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<OutputImageType> outputIt(output, output->GetLargestPossibleRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    if (static_cast<TOutputPixel>(inputIt.Get()) != outputIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << outputIt.GetIndex() << " of " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkImageFileReaderReadIntoOutputTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  // The same component type is read into the output buffer, other ones are
+  // converted
+  ITK_TEST_EXPECT_TRUE((ReadsIntoOutputBuffer<unsigned short, unsigned short>(
+    directory + "/itkImageFileReaderReadIntoOutputTestUShort.mha", true)));
+  ITK_TEST_EXPECT_TRUE((ReadsIntoOutputBuffer<unsigned short, float>(
+    directory + "/itkImageFileReaderReadIntoOutputTestFloat.mha", false)));
+
+  // As well as integers of the same size and signedness
+  ITK_TEST_EXPECT_TRUE((ReadsIntoOutputBuffer<long long, long>(
+    directory + "/itkImageFileReaderReadIntoOutputTestLongLong.mha", sizeof(long) == sizeof(long long))));
+  ITK_TEST_EXPECT_TRUE((ReadsIntoOutputBuffer<unsigned int, unsigned long>(
+    directory + "/itkImageFileReaderReadIntoOutputTestUInt.mha", sizeof(unsigned long) == sizeof(unsigned int))));
+  ITK_TEST_EXPECT_TRUE(
+    (ReadsIntoOutputBuffer<int, unsigned int>(directory + "/itkImageFileReaderReadIntoOutputTestInt.mha", false)));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageIOFactory.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Write and read back images compressed in blocks, by the ImageIOs that
+// compress with a BlockCompressor.
+int
+itkImageFileWriterBlockCompressionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFile [compressor]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+  const std::string compressor = argc > 2 ? argv[2] : "";
+
+  using PixelType = short;
+  using ImageType = itk::Image<PixelType, 3>;
+
+  // A label-like image, with noise in one corner
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize({ { 41, 37, 23 } });
+  image->SetRegions(region);
+  image->Allocate();
+  unsigned int noise = 12345;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    auto                       value = static_cast<PixelType>(index[0] / 10 + 4 * (index[1] / 9) + 16 * (index[2] / 6));
+    if (index[0] < 8 && index[1] < 8)
+    {
+      noise = noise * 1103515245U + 12345U;
+      value = static_cast<PixelType>((noise >> 16) & 0x7fff);
+    }
+    it.Set(value);
+  }
+
+  itk::ImageIOBase::Pointer imageIO =
+    itk::ImageIOFactory::CreateImageIO(fileName.c_str(), itk::ImageIOFactory::IOFileModeEnum::WriteMode);
+  ITK_TEST_EXPECT_TRUE(imageIO.IsNotNull());
+  ITK_TEST_EXPECT_EQUAL(imageIO->GetCompressionBlockSize(), itk::intmax_t{ 1 } << 20);
+  // Many blocks, which are compressed in parallel
+  imageIO->SetCompressionBlockSize(1000);
+  imageIO->SetCompressor(compressor);
+
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(imageIO);
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  ImageType::ConstPointer readImage = reader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), region);
+  itk::ImageRegionConstIterator<ImageType> readIt(readImage, region);
+  itk::ImageRegionConstIterator<ImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it, ++readIt)
+  {
+    if (readIt.Get() != it.Get())
+    {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << readIt.Get() << " instead of " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMetaDataObject.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using SliceType = itk::Image<unsigned short, 2>;
+using VolumeType = itk::Image<unsigned short, 3>;
+using SeriesReaderType = itk::ImageSeriesReader<VolumeType>;
+
+// Read the series with the given number of work units, and check the
+// pixels, the progress and the MetaDataDictionaryArray
+VolumeType::Pointer
+ReadSeries(const SeriesReaderType::FileNamesContainer & fileNames,
+           itk::ThreadIdType                            numberOfWorkUnits,
+           bool                                         useImageIO,
+           bool                                         reverseOrder,
+           const VolumeType::RegionType *               requestedRegion,
+           bool &                                       success)
+{
+  auto reader = SeriesReaderType::New();
+  reader->SetFileNames(fileNames);
+  reader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  reader->SetReverseOrder(reverseOrder);
+  if (useImageIO)
+  {
+    reader->SetImageIO(itk::MetaImageIO::New());
+  }
+  reader->UpdateOutputInformation();
+  if (requestedRegion)
+  {
+    reader->GetOutput()->SetRequestedRegion(*requestedRegion);
+  }
+  reader->GetOutput()->Update();
+
+  const auto numberOfFiles = static_cast<unsigned int>(fileNames.size());
+
+  VolumeType::Pointer output = reader->GetOutput();
+  for (itk::ImageRegionConstIterator<VolumeType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const VolumeType::IndexType index = it.GetIndex();
+    const unsigned int          slice = reverseOrder ? numberOfFiles - 1 - index[2] : index[2];
+    const auto                  expected = static_cast<unsigned short>(1000 * slice + 10 * index[1] + index[0]);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << index << " with " << numberOfWorkUnits << " work units: expected "
+                << expected << ", but got " << it.Get() << std::endl;
+      success = false;
+      break;
+    }
+  }
+
+  if (reader->GetProgress() != 1.0f)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Progress is " << reader->GetProgress() << " instead of 1 with " << numberOfWorkUnits
+              << " work units" << std::endl;
+    success = false;
+  }
+
+  // The dictionaries are in slice order, whatever the order they were read
+  const SeriesReaderType::DictionaryArrayType & dictionaries = *reader->GetMetaDataDictionaryArray();
+  if (dictionaries.size() != numberOfFiles)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "MetaDataDictionaryArray has " << dictionaries.size() << " dictionaries instead of "
+              << numberOfFiles << std::endl;
+    success = false;
+    return output;
+  }
+  for (unsigned int i = 0; i < numberOfFiles; ++i)
+  {
+    const unsigned int slice = reverseOrder ? numberOfFiles - 1 - i : i;
+    std::string        sliceNumber;
+    itk::ExposeMetaData<std::string>(*dictionaries[i], "SliceNumber", sliceNumber);
+    if (sliceNumber != std::to_string(slice))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Dictionary " << i << " is the one of slice \"" << sliceNumber << "\" instead of " << slice
+                << std::endl;
+      success = false;
+    }
+  }
+
+  return output;
+}
+} // namespace
+
+int
+itkImageSeriesReaderParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int numberOfFiles = 23;
+
+  // Write the series, each slice with its own pixel values and meta data
+  SeriesReaderType::FileNamesContainer fileNames;
+  for (unsigned int i = 0; i < numberOfFiles; ++i)
+  {
+    auto                  slice = SliceType::New();
+    SliceType::RegionType region;
+    region.SetSize(0, 10);
+    region.SetSize(1, 7);
+    slice->SetRegions(region);
+    slice->Allocate();
+    for (itk::ImageRegionIterator<SliceType> it(slice, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<unsigned short>(1000 * i + 10 * it.GetIndex()[1] + it.GetIndex()[0]));
+    }
+    SliceType::PointType origin;
+    origin[0] = 0.0;
+    origin[1] = 0.0;
+    slice->SetOrigin(origin);
+    itk::EncapsulateMetaData<std::string>(slice->GetMetaDataDictionary(), "SliceNumber", std::to_string(i));
+
+    fileNames.push_back(std::string(argv[1]) + "/itkImageSeriesReaderParallelReadTest" + std::to_string(i) + ".mha");
+    auto writer = itk::ImageFileWriter<SliceType>::New();
+    writer->SetInput(slice);
+    writer->SetFileName(fileNames.back());
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  bool success = true;
+
+  VolumeType::RegionType requestedRegion;
+  requestedRegion.SetIndex(0, 2);
+  requestedRegion.SetIndex(1, 1);
+  requestedRegion.SetIndex(2, 5);
+  requestedRegion.SetSize(0, 6);
+  requestedRegion.SetSize(1, 5);
+  requestedRegion.SetSize(2, 11);
+
+  for (bool reverseOrder : { false, true })
+  {
+    for (itk::ThreadIdType numberOfWorkUnits : { 1, 2, 5, 64 })
+    {
+      VolumeType::Pointer image;
+      ITK_TRY_EXPECT_NO_EXCEPTION(image =
+                                    ReadSeries(fileNames, numberOfWorkUnits, false, reverseOrder, nullptr, success));
+      ITK_TEST_EXPECT_EQUAL(image->GetBufferedRegion(), image->GetLargestPossibleRegion());
+
+      ITK_TRY_EXPECT_NO_EXCEPTION(
+        image = ReadSeries(fileNames, numberOfWorkUnits, false, reverseOrder, &requestedRegion, success));
+      ITK_TEST_EXPECT_EQUAL(image->GetBufferedRegion(), requestedRegion);
+    }
+
+    // A single ImageIO reads the slices one after another
+    ITK_TRY_EXPECT_NO_EXCEPTION(ReadSeries(fileNames, 4, true, reverseOrder, &requestedRegion, success));
+  }
+
+  // A failing slice is reported
+  SeriesReaderType::FileNamesContainer missingFileNames = fileNames;
+  missingFileNames[numberOfFiles / 2] = std::string(argv[1]) + "/itkImageSeriesReaderParallelReadTestMissing.mha";
+  auto reader = SeriesReaderType::New();
+  reader->SetFileNames(missingFileNames);
+  reader->SetNumberOfWorkUnits(4);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
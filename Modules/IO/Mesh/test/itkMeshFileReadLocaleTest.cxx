@@ -0,0 +1,126 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBYUMeshIO.h"
+#include "itkMesh.h"
+#include "itkMeshFileTestHelper.h"
+#include "itkOBJMeshIO.h"
+#include "itkOFFMeshIO.h"
+#include "itkTestingMacros.h"
+#include "itkTriangleCell.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <clocale>
+#include <cstdlib>
+
+// Reads ASCII meshes while the C locale of the process uses a comma as
+// decimal separator, and checks that the fractional coordinates are kept
+int
+itkMeshFileReadLocaleTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/itkMeshFileReadLocaleTest";
+
+  using MeshType = itk::Mesh<float, 3>;
+  auto mesh = MeshType::New();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    MeshType::PointType point;
+    point[0] = 1.5f + i;
+    point[1] = -0.25f * i;
+    point[2] = 0.125f;
+    mesh->SetPoint(i, point);
+  }
+  MeshType::CellType::CellAutoPointer cell;
+  cell.TakeOwnership(new itk::TriangleCell<MeshType::CellType>);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    cell->SetPointId(i, i);
+  }
+  mesh->SetCell(0, cell);
+
+  struct FormatType
+  {
+    const char *             m_Extension;
+    itk::MeshIOBase::Pointer m_MeshIO;
+  };
+  const FormatType formats[] = { { ".vtk", itk::VTKPolyDataMeshIO::New() },
+                                 { ".obj", itk::OBJMeshIO::New() },
+                                 { ".off", itk::OFFMeshIO::New() },
+                                 { ".byu", itk::BYUMeshIO::New() } };
+  for (const auto & format : formats)
+  {
+    auto writer = itk::MeshFileWriter<MeshType>::New();
+    writer->SetInput(mesh);
+    writer->SetFileName(directory + format.m_Extension);
+    writer->SetMeshIO(format.m_MeshIO);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  }
+
+  const std::string previousLocale = std::setlocale(LC_NUMERIC, nullptr);
+  const char *      commaLocale = nullptr;
+  for (const char * name : { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German" })
+  {
+    if (std::setlocale(LC_NUMERIC, name) != nullptr && std::strtod("1.5", nullptr) == 1.0)
+    {
+      commaLocale = name;
+      break;
+    }
+  }
+  if (commaLocale == nullptr)
+  {
+    std::setlocale(LC_NUMERIC, previousLocale.c_str());
+    std::cout << "No locale with a comma decimal separator is installed, the test is skipped." << std::endl;
+    return EXIT_SUCCESS;
+  }
+  std::cout << "Reading with the " << commaLocale << " locale" << std::endl;
+
+  int status = EXIT_SUCCESS;
+  for (const auto & format : formats)
+  {
+    auto reader = itk::MeshFileReader<MeshType>::New();
+    reader->SetFileName(directory + format.m_Extension);
+    reader->SetMeshIO(format.m_MeshIO);
+    try
+    {
+      reader->Update();
+    }
+    catch (const itk::ExceptionObject & exception)
+    {
+      std::cerr << format.m_Extension << ": " << exception << std::endl;
+      status = EXIT_FAILURE;
+      continue;
+    }
+    if (reader->GetOutput()->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+        TestPointsContainer<MeshType>(mesh->GetPoints(), reader->GetOutput()->GetPoints()) == EXIT_FAILURE)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << format.m_Extension << ": the points read depend on the locale" << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  std::setlocale(LC_NUMERIC, previousLocale.c_str());
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBYUMeshIO.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMultiThreaderBase.h"
+#include "itkOBJMeshIO.h"
+#include "itkOFFMeshIO.h"
+#include "itkTimeProbe.h"
+#include "itkVTKPolyDataMeshIO.h"
+#include <iomanip>
+
+// Measures the speedup of reading meshes with the default number of threads
+// over reading them with one thread. With ITK_BUILD_BENCHMARKS, ctest -L
+// BENCHMARK runs it on the sphere_curv VTK meshes. The meshes read are
+// checked by itkMeshFileReadParallelTest, which leaves meshes of each
+// format in its output directory.
+//
+// Usage: itkMeshFileReadParallelBenchmark meshFile [meshFile ...]
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " meshFile [meshFile ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using MeshType = itk::Mesh<float, 3>;
+  using ReaderType = itk::MeshFileReader<MeshType>;
+  const itk::MeshIOBase::Pointer meshIOs[] = { itk::VTKPolyDataMeshIO::New(),
+                                               itk::OBJMeshIO::New(),
+                                               itk::OFFMeshIO::New(),
+                                               itk::BYUMeshIO::New() };
+
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  std::cout << std::setw(40) << "file" << std::setw(16) << "1 thread [s]" << std::setw(16) << "threads [s]"
+            << std::setw(10) << "speedup" << std::endl;
+  for (int i = 1; i < argc; ++i)
+  {
+    itk::MeshIOBase::Pointer meshIO;
+    for (const auto & candidate : meshIOs)
+    {
+      if (candidate->CanReadFile(argv[i]))
+      {
+        meshIO = candidate;
+        break;
+      }
+    }
+    if (meshIO.IsNull())
+    {
+      std::cerr << "No mesh IO reads " << argv[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    itk::TimeProbe referenceProbe;
+    itk::TimeProbe probe;
+    try
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+        auto reference = ReaderType::New();
+        reference->SetFileName(argv[i]);
+        reference->SetMeshIO(meshIO);
+        referenceProbe.Start();
+        reference->Update();
+        referenceProbe.Stop();
+
+        itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+        auto reader = ReaderType::New();
+        reader->SetFileName(argv[i]);
+        reader->SetMeshIO(meshIO);
+        probe.Start();
+        reader->Update();
+        probe.Stop();
+      }
+    }
+    catch (const itk::ExceptionObject & err)
+    {
+      std::cerr << err << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << std::setw(40) << argv[i] << std::setw(16) << referenceProbe.GetMean() << std::setw(16)
+              << probe.GetMean() << std::setw(10) << referenceProbe.GetMean() / probe.GetMean() << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
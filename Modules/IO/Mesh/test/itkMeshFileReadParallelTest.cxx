@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBYUMeshIO.h"
+#include "itkMesh.h"
+#include "itkMeshFileTestHelper.h"
+#include "itkMultiThreaderBase.h"
+#include "itkOBJMeshIO.h"
+#include "itkOFFMeshIO.h"
+#include "itkTestingMacros.h"
+#include "itkTriangleCell.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <fstream>
+
+// Reads meshes of the supported formats with one thread and with the
+// default number of threads, and checks that both give the same mesh. The
+// timings are reported by itkMeshFileReadParallelBenchmark.
+namespace
+{
+
+using MeshType = itk::Mesh<float, 3>;
+using ReaderType = itk::MeshFileReader<MeshType>;
+
+// A triangulated height field of size x size points
+MeshType::Pointer
+MakeMesh(unsigned int size)
+{
+  auto mesh = MeshType::New();
+  for (unsigned int j = 0; j < size; ++j)
+  {
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      MeshType::PointType point;
+      point[0] = 0.5f * i;
+      point[1] = -0.25f * j;
+      point[2] = 0.125f * ((i * 7 + j * 13) % 64);
+      mesh->SetPoint(j * size + i, point);
+    }
+  }
+
+  using CellAutoPointer = MeshType::CellType::CellAutoPointer;
+  using TriangleType = itk::TriangleCell<MeshType::CellType>;
+  MeshType::CellIdentifier cellId = 0;
+  for (unsigned int j = 0; j + 1 < size; ++j)
+  {
+    for (unsigned int i = 0; i + 1 < size; ++i)
+    {
+      const MeshType::PointIdentifier corner = j * size + i;
+      for (unsigned int k = 0; k < 2; ++k)
+      {
+        CellAutoPointer cell;
+        cell.TakeOwnership(new TriangleType);
+        cell->SetPointId(0, corner);
+        cell->SetPointId(1, k == 0 ? corner + 1 : corner + size + 1);
+        cell->SetPointId(2, k == 0 ? corner + size + 1 : corner + size);
+        mesh->SetCell(cellId++, cell);
+      }
+    }
+  }
+  return mesh;
+}
+
+int
+CompareWithSingleThreaded(MeshType *          mesh,
+                          const std::string & name,
+                          const std::string & fileName,
+                          itk::MeshIOBase *   meshIO,
+                          bool                binary)
+{
+  auto writer = itk::MeshFileWriter<MeshType>::New();
+  writer->SetInput(mesh);
+  writer->SetFileName(fileName);
+  writer->SetMeshIO(meshIO);
+  if (binary)
+  {
+    writer->SetFileTypeAsBINARY();
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+  auto reference = ReaderType::New();
+  reference->SetFileName(fileName);
+  reference->SetMeshIO(meshIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetMeshIO(meshIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  MeshType * output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != mesh->GetNumberOfCells() ||
+      TestPointsContainer<MeshType>(mesh->GetPoints(), output->GetPoints()) == EXIT_FAILURE ||
+      TestPointsContainer<MeshType>(reference->GetOutput()->GetPoints(), output->GetPoints()) == EXIT_FAILURE ||
+      TestCellsContainer<MeshType>(reference->GetOutput()->GetCells(), output->GetCells()) == EXIT_FAILURE)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << name << ": the mesh read in parallel differs from the single threaded one" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Writes the mesh as an ASCII OFF file whose face indices span several
+// lines, followed by a color on the line of the last index
+int
+ReadOFFWithMultilineFaces(MeshType * mesh, const std::string & fileName)
+{
+  {
+    std::ofstream outputFile(fileName.c_str());
+    outputFile << "OFF\n" << mesh->GetNumberOfPoints() << ' ' << mesh->GetNumberOfCells() << " 0\n";
+    for (const auto & point : *mesh->GetPoints())
+    {
+      outputFile << point[0] << ' ' << point[1] << ' ' << point[2] << '\n';
+    }
+    for (auto it = mesh->GetCells()->Begin(); it != mesh->GetCells()->End(); ++it)
+    {
+      const MeshType::CellType * cell = it.Value();
+      outputFile << cell->GetNumberOfPoints();
+      for (auto pointId = cell->PointIdsBegin(); pointId != cell->PointIdsEnd(); ++pointId)
+      {
+        outputFile << "\n  " << *pointId;
+      }
+      outputFile << " 0.5 0.5 0.5\n";
+    }
+  }
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetMeshIO(itk::OFFMeshIO::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  MeshType * output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != mesh->GetNumberOfCells() ||
+      TestCellsContainer<MeshType>(mesh->GetCells(), output->GetCells()) == EXIT_FAILURE)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The OFF faces spanning several lines of " << fileName << " are not read back" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkMeshFileReadParallelTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/itkMeshFileReadParallelTest";
+
+  struct FormatType
+  {
+    const char *             m_Name;
+    const char *             m_Extension;
+    itk::MeshIOBase::Pointer m_MeshIO;
+    bool                     m_Binary;
+  };
+  const FormatType formats[] = { { "VTK ASCII", ".vtk", itk::VTKPolyDataMeshIO::New(), false },
+                                 { "VTK binary", "b.vtk", itk::VTKPolyDataMeshIO::New(), true },
+                                 { "OBJ", ".obj", itk::OBJMeshIO::New(), false },
+                                 { "OFF ASCII", ".off", itk::OFFMeshIO::New(), false },
+                                 { "OFF binary", "b.off", itk::OFFMeshIO::New(), true },
+                                 { "BYU", ".byu", itk::BYUMeshIO::New(), false } };
+
+  // A mesh smaller than a chunk of text, and a mesh of many chunks
+  for (const unsigned int size : { 10u, 400u })
+  {
+    const MeshType::Pointer mesh = MakeMesh(size);
+    const std::string       suffix = std::to_string(size);
+    for (const auto & format : formats)
+    {
+      ITK_TEST_EXPECT_EQUAL(CompareWithSingleThreaded(mesh,
+                                                      format.m_Name + std::string(" ") + suffix,
+                                                      directory + suffix + format.m_Extension,
+                                                      format.m_MeshIO,
+                                                      format.m_Binary),
+                            EXIT_SUCCESS);
+    }
+    ITK_TEST_EXPECT_EQUAL(ReadOFFWithMultilineFaces(mesh, directory + suffix + "m.off"), EXIT_SUCCESS);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
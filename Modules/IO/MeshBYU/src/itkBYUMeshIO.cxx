@@ -199,16 +199,7 @@ BYUMeshIO ::ReadPoints(void * buffer)
   auto * data = static_cast<double *>(buffer);
 
   // Read points
-  inputFile.precision(12);
-
-  SizeValueType index = 0;
-  for (SizeValueType id = 0; id < this->m_NumberOfPoints; id++)
-  {
-    for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
-    {
-      inputFile >> data[index++];
-    }
-  }
+  this->ReadBufferAsAscii(data, inputFile, this->m_NumberOfPoints * this->m_PointDimension);
 
   // Determine cells start position
   m_FilePosition = inputFile.tellg();
@@ -168,6 +168,13 @@ protected:
   void
   ConvertCellPixelBuffer(void * inputData, T * outputData, size_t numberOfPixels);
 
+  /** Read the points straight into the points container of the output,
+   * without intermediate buffer, when the file stores the coordinates of
+   * the output points and the container stores them contiguously. Returns
+   * false, reading nothing, otherwise. */
+  bool
+  ReadPointsIntoContainer();
+
   /** Test whether the given filename exist and it is readable, this
    * is intended to be called before attempting to use  MeshIO
    * classes for actually reading the file. If the file doesn't exist
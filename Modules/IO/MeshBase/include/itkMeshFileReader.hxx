@@ -29,6 +29,8 @@
 
 #include <itksys/SystemTools.hxx>
 #include <fstream>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -127,6 +129,31 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
   }
 }
 
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+bool
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPointsIntoContainer()
+{
+  using PointsContainer = typename OutputMeshType::PointsContainer;
+
+  // The points of a VectorContainer are contiguous in memory
+  if (!std::is_base_of<std::vector<OutputPointType>, PointsContainer>::value ||
+      sizeof(OutputPointType) != sizeof(OutputCoordRepType) * OutputPointDimension ||
+      m_MeshIO->GetPointComponentType() != MeshIOBase::MapComponentType<OutputCoordRepType>::CType ||
+      m_MeshIO->GetPointDimension() != OutputPointDimension)
+  {
+    return false;
+  }
+
+  typename TOutputMesh::Pointer output = this->GetOutput();
+  PointsContainer *             points = output->GetPoints();
+  points->Reserve(m_MeshIO->GetNumberOfPoints());
+  if (m_MeshIO->GetNumberOfPoints() > 0)
+  {
+    m_MeshIO->ReadPoints(static_cast<void *>(points->ElementAt(0).GetDataPointer()));
+  }
+  return true;
+}
+
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
 template <typename T>
 void
@@ -546,7 +573,7 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Ge
   m_MeshIO->ReadMeshInformation();
 
   // Read points
-  if (m_MeshIO->GetUpdatePoints())
+  if (m_MeshIO->GetUpdatePoints() && !this->ReadPointsIntoContainer())
   {
     switch (m_MeshIO->GetPointComponentType())
     {
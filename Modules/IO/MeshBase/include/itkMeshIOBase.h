@@ -35,9 +35,15 @@
 #include "itkNumberToString.h"
 #include "itkCommonEnums.h"
 
+#include <algorithm>
 #include <string>
+#include <cctype>
 #include <complex>
+#include <cstdlib>
 #include <fstream>
+#include <functional>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -610,14 +616,154 @@ protected:
   void
   AddSupportedWriteExtension(const char * extension);
 
-  /** Read data from input file stream to buffer with ascii style */
+  /** Range of characters of a text, made of whole lines. */
+  using TextChunkType = std::pair<const char *, const char *>;
+
+  /** Split the text [begin, end) into chunks of whole lines, of about
+   * 512 KiB each, to be parsed in parallel. */
+  static std::vector<TextChunkType>
+  SplitIntoLineChunks(const char * begin, const char * end);
+
+  /** Call function(i) for every one of the numberOfChunks chunks, in
+   * parallel through MultiThreaderBase when there are several. */
+  static void
+  ParallelizeChunks(SizeValueType numberOfChunks, const std::function<void(SizeValueType)> & function);
+
+  /** Read the text from the current position of the input stream, up to at
+   * least numberOfCharacters characters and then to the end of the line.
+   * Returns false when there was nothing left to read. */
+  static bool
+  ReadTextLines(std::istream & inputFile, SizeValueType numberOfCharacters, std::string & text);
+
+  /** Read the text from the current position of the input stream to its
+   * end. The stream is left at its end, in a good state. */
+  static void
+  ReadRemainingText(std::istream & inputFile, std::string & text);
+
+  /** Number of whitespace separated tokens in the characters [begin, end). */
+  static SizeValueType
+  CountAsciiTokens(const char * begin, const char * end);
+
+  /** Parse the integer starting at token into value, as the stream operator
+   * would, and set token past it. Returns false when token does not start
+   * with a number. The token must be followed by a character that cannot
+   * continue the number, which the end of a line and the terminating null
+   * character of a std::string are. */
+  template <typename T>
+  static bool
+  ParseAsciiNumber(const char *& token, T & value)
+  {
+    char * numberEnd = nullptr;
+    if (std::is_signed<T>::value)
+    {
+      value = static_cast<T>(std::strtoll(token, &numberEnd, 10));
+    }
+    else
+    {
+      value = static_cast<T>(std::strtoull(token, &numberEnd, 10));
+    }
+    if (numberEnd == token)
+    {
+      return false;
+    }
+    token = numberEnd;
+    return true;
+  }
+
+  /** Parse the floating point number starting at token into value, in the
+   * classic "C" notation whatever the locale of the process, and set token
+   * past it. Returns false when token does not start with a number. */
+  static bool
+  ParseAsciiNumber(const char *& token, float & value);
+  static bool
+  ParseAsciiNumber(const char *& token, double & value);
+  static bool
+  ParseAsciiNumber(const char *& token, long double & value);
+
+  /** Parse the first numberOfValues whitespace separated numbers of the
+   * characters [begin, end) into values. Returns the position after the
+   * last number parsed, or nullptr when a token is not a number. */
+  template <typename T>
+  static const char *
+  ParseAsciiNumbers(const char * begin, const char * end, T * values, SizeValueType numberOfValues)
+  {
+    const char * position = begin;
+    for (SizeValueType i = 0; i < numberOfValues; ++i)
+    {
+      while (position != end && std::isspace(static_cast<unsigned char>(*position)))
+      {
+        ++position;
+      }
+      if (position == end || !ParseAsciiNumber(position, values[i]) || position > end)
+      {
+        return nullptr;
+      }
+    }
+    return position;
+  }
+
+  /** Read data from input file stream to buffer with ascii style. The text
+   * is read by blocks of whole lines, whose numbers are parsed in parallel,
+   * and the stream is left after the last number read. */
   template <typename T>
   void
   ReadBufferAsAscii(T * buffer, std::ifstream & inputFile, SizeValueType numberOfComponents)
   {
-    for (SizeValueType i = 0; i < numberOfComponents; i++)
+    // Characters are read one at a time by the stream operator
+    if (sizeof(T) == 1)
     {
-      inputFile >> buffer[i];
+      for (SizeValueType i = 0; i < numberOfComponents; i++)
+      {
+        inputFile >> buffer[i];
+      }
+      return;
+    }
+
+    std::string   text;
+    SizeValueType numberOfValuesRead = 0;
+    while (numberOfValuesRead < numberOfComponents)
+    {
+      const std::istream::pos_type textPosition = inputFile.tellg();
+      if (!ReadTextLines(inputFile, SizeValueType{ 32 } << 20, text))
+      {
+        itkExceptionMacro(<< "Unexpected end of file after " << numberOfValuesRead << " of " << numberOfComponents
+                          << " values in " << m_FileName);
+      }
+
+      // The numbers are counted in every chunk, to know where each chunk
+      // stores its values, and then parsed
+      const std::vector<TextChunkType> chunks = SplitIntoLineChunks(text.data(), text.data() + text.size());
+      std::vector<SizeValueType>       counts(chunks.size());
+      ParallelizeChunks(chunks.size(), [&chunks, &counts](SizeValueType i) {
+        counts[i] = CountAsciiTokens(chunks[i].first, chunks[i].second);
+      });
+      std::vector<SizeValueType> offsets;
+      SizeValueType              offset = numberOfValuesRead;
+      for (SizeValueType i = 0; i < chunks.size() && offset < numberOfComponents; ++i)
+      {
+        offsets.push_back(offset);
+        offset += counts[i];
+      }
+      std::vector<const char *> ends(offsets.size());
+      ParallelizeChunks(offsets.size(), [&](SizeValueType i) {
+        ends[i] = ParseAsciiNumbers(chunks[i].first,
+                                    chunks[i].second,
+                                    buffer + offsets[i],
+                                    std::min(counts[i], numberOfComponents - offsets[i]));
+      });
+      if (std::find(ends.begin(), ends.end(), nullptr) != ends.end())
+      {
+        itkExceptionMacro(<< "Invalid number in " << m_FileName);
+      }
+      numberOfValuesRead = std::min(offset, numberOfComponents);
+
+      // Past the last number read, which the text may be beyond
+      if (numberOfValuesRead == numberOfComponents)
+      {
+        inputFile.clear();
+        inputFile.seekg(textPosition);
+        inputFile.ignore(static_cast<std::streamsize>(ends.empty() ? 0 : ends.back() - text.data()));
+      }
     }
   }
 
@@ -679,7 +825,7 @@ protected:
         itk::ByteSwapper<TInput>::SwapRangeFromSystemToLittleEndian(buffer, numberOfComponents);
       }
 
-      outputFile.write(reinterpret_cast<char *>(buffer), numberOfComponents);
+      outputFile.write(reinterpret_cast<char *>(buffer), numberOfComponents * sizeof(TInput));
     }
     else
     {
@@ -698,7 +844,7 @@ protected:
         itk::ByteSwapper<TOutput>::SwapRangeFromSystemToLittleEndian(data, numberOfComponents);
       }
 
-      outputFile.write(reinterpret_cast<char *>(data), numberOfComponents);
+      outputFile.write(reinterpret_cast<char *>(data), numberOfComponents * sizeof(TOutput));
       delete[] data;
     }
   }
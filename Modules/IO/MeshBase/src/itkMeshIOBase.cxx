@@ -17,9 +17,48 @@
  *=========================================================================*/
 
 #include "itkMeshIOBase.h"
+#include "itkMultiThreaderBase.h"
+#include "double-conversion/double-conversion.h"
+
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
 
 namespace itk
 {
+namespace
+{
+// Skip the leading whitespace of token, as strtod does, and return the
+// length of the following run of non whitespace characters.
+int
+SkipToAsciiToken(const char *& token)
+{
+  while (*token != '\0' && std::isspace(static_cast<unsigned char>(*token)))
+  {
+    ++token;
+  }
+  const char * tokenEnd = token;
+  while (*tokenEnd != '\0' && !std::isspace(static_cast<unsigned char>(*tokenEnd)))
+  {
+    ++tokenEnd;
+  }
+  return static_cast<int>(std::min<std::ptrdiff_t>(tokenEnd - token, std::numeric_limits<int>::max()));
+}
+
+const double_conversion::StringToDoubleConverter &
+GetAsciiNumberConverter()
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::ALLOW_TRAILING_JUNK,
+    0.0,
+    std::numeric_limits<double>::quiet_NaN(),
+    "inf",
+    "nan");
+  return converter;
+}
+} // namespace
+
 MeshIOBase ::MeshIOBase()
   : m_NumberOfPoints(itk::NumericTraits<SizeValueType>::ZeroValue())
   , m_NumberOfCells(itk::NumericTraits<SizeValueType>::ZeroValue())
@@ -53,6 +92,137 @@ MeshIOBase ::AddSupportedWriteExtension(const char * extension)
   this->m_SupportedWriteExtensions.push_back(extension);
 }
 
+bool
+MeshIOBase::ParseAsciiNumber(const char *& token, float & value)
+{
+  const char * position = token;
+  const int    length = SkipToAsciiToken(position);
+  int          processed = 0;
+  value = GetAsciiNumberConverter().StringToFloat(position, length, &processed);
+  if (processed == 0)
+  {
+    return false;
+  }
+  token = position + processed;
+  return true;
+}
+
+bool
+MeshIOBase::ParseAsciiNumber(const char *& token, double & value)
+{
+  const char * position = token;
+  const int    length = SkipToAsciiToken(position);
+  int          processed = 0;
+  value = GetAsciiNumberConverter().StringToDouble(position, length, &processed);
+  if (processed == 0)
+  {
+    return false;
+  }
+  token = position + processed;
+  return true;
+}
+
+bool
+MeshIOBase::ParseAsciiNumber(const char *& token, long double & value)
+{
+  // double-conversion has no long double, so a stream in the classic locale
+  // keeps the extended precision
+  const char *       position = token;
+  const int          length = SkipToAsciiToken(position);
+  std::istringstream stream(std::string(position, static_cast<size_t>(length)));
+  stream.imbue(std::locale::classic());
+  if (!(stream >> value))
+  {
+    return false;
+  }
+  const std::streampos processed = stream.tellg();
+  token = position + (processed == std::streampos(-1) ? length : static_cast<std::streamoff>(processed));
+  return true;
+}
+
+std::vector<MeshIOBase::TextChunkType>
+MeshIOBase::SplitIntoLineChunks(const char * begin, const char * end)
+{
+  constexpr size_t           chunkSize = 512 * 1024;
+  std::vector<TextChunkType> chunks;
+  while (begin != end)
+  {
+    const char * chunkEnd = begin + std::min(chunkSize, static_cast<size_t>(end - begin));
+    if (chunkEnd != end)
+    {
+      const void * newLine = std::memchr(chunkEnd, '\n', static_cast<size_t>(end - chunkEnd));
+      chunkEnd = newLine != nullptr ? static_cast<const char *>(newLine) + 1 : end;
+    }
+    chunks.emplace_back(begin, chunkEnd);
+    begin = chunkEnd;
+  }
+  return chunks;
+}
+
+void
+MeshIOBase::ParallelizeChunks(SizeValueType numberOfChunks, const std::function<void(SizeValueType)> & function)
+{
+  if (numberOfChunks == 1)
+  {
+    function(0);
+  }
+  else if (numberOfChunks > 1)
+  {
+    MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, function, nullptr);
+  }
+}
+
+bool
+MeshIOBase::ReadTextLines(std::istream & inputFile, SizeValueType numberOfCharacters, std::string & text)
+{
+  // Do not allocate more than the rest of the file
+  const std::streampos position = inputFile.tellg();
+  if (position != std::streampos(-1) && inputFile.seekg(0, std::ios::end))
+  {
+    const std::streamoff remaining = inputFile.tellg() - position;
+    inputFile.seekg(position);
+    numberOfCharacters = std::min(numberOfCharacters, static_cast<SizeValueType>(remaining) + 1);
+  }
+  inputFile.clear();
+  text.resize(numberOfCharacters);
+  inputFile.read(&text[0], static_cast<std::streamsize>(numberOfCharacters));
+  text.resize(static_cast<size_t>(inputFile.gcount()));
+  if (text.size() == numberOfCharacters)
+  {
+    std::string endOfLine;
+    std::getline(inputFile, endOfLine);
+    text += endOfLine;
+    text += '\n';
+  }
+  return !text.empty();
+}
+
+void
+MeshIOBase::ReadRemainingText(std::istream & inputFile, std::string & text)
+{
+  text.clear();
+  char buffer[65536];
+  while (inputFile.read(buffer, sizeof(buffer)) || inputFile.gcount() > 0)
+  {
+    text.append(buffer, static_cast<size_t>(inputFile.gcount()));
+  }
+  inputFile.clear();
+}
+
+SizeValueType
+MeshIOBase::CountAsciiTokens(const char * begin, const char * end)
+{
+  SizeValueType numberOfTokens = 0;
+  bool          inToken = false;
+  for (const char * position = begin; position != end; ++position)
+  {
+    const bool isSpace = std::isspace(static_cast<unsigned char>(*position)) != 0;
+    numberOfTokens += !isSpace && !inToken;
+    inToken = !isSpace;
+  }
+  return numberOfTokens;
+}
+
 unsigned int
 MeshIOBase ::GetComponentSize(IOComponentEnum componentType) const
 {
@@ -187,6 +187,16 @@ protected:
   CloseFile();
 
 private:
+  /** Read the whole file into text, and split it into chunks of lines
+   * parsed in parallel. */
+  std::vector<TextChunkType>
+  ReadTextChunks(std::string & text);
+
+  /** Read the coordinates of the lines of the given type, "v" or "vn", into
+   * data. */
+  void
+  ReadVectorLines(const char * type, float * data);
+
   std::ifstream  m_InputFile;
   std::streampos m_PointsStartPosition; // file position for points rlative to
                                         // std::ios::beg
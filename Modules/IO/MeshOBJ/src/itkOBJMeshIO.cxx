@@ -19,7 +19,9 @@
 #include "itkOBJMeshIO.h"
 #include "itkNumericTraits.h"
 #include <itksys/SystemTools.hxx>
+#include <cstring>
 #include <locale>
+#include <memory>
 #include <vector>
 
 
@@ -125,46 +127,103 @@ OBJMeshIO ::SplitLine(const std::string & line, std::string & type, std::string
   return true;
 }
 
+namespace
+{
+// Call function(lineBegin, typeEnd, lineEnd) for the lines of [begin, end)
+// with a type followed by some content, as SplitLine() finds them
+template <typename TFunction>
 void
-OBJMeshIO ::ReadMeshInformation()
+ForEachTypedLine(const char * begin, const char * end, const TFunction & function)
+{
+  while (begin != end)
+  {
+    const void * newLine = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+    const char * lineEnd = newLine != nullptr ? static_cast<const char *>(newLine) : end;
+    const char * typeBegin = begin;
+    while (typeBegin != lineEnd && std::isspace(static_cast<unsigned char>(*typeBegin)))
+    {
+      ++typeBegin;
+    }
+    const char * typeEnd = typeBegin;
+    while (typeEnd != lineEnd && !std::isspace(static_cast<unsigned char>(*typeEnd)))
+    {
+      ++typeEnd;
+    }
+    if (typeEnd != lineEnd)
+    {
+      function(typeBegin, typeEnd, lineEnd);
+    }
+    begin = newLine != nullptr ? lineEnd + 1 : end;
+  }
+}
+
+bool
+IsLineType(const char * typeBegin, const char * typeEnd, const char * type)
+{
+  const size_t length = std::strlen(type);
+  return static_cast<size_t>(typeEnd - typeBegin) == length && std::memcmp(typeBegin, type, length) == 0;
+}
+
+// The number of lines of each type, and of the points of the faces
+struct LineCounts
+{
+  SizeValueType m_NumberOfPoints{ 0 };
+  SizeValueType m_NumberOfCells{ 0 };
+  SizeValueType m_NumberOfCellPoints{ 0 };
+  SizeValueType m_NumberOfPointPixels{ 0 };
+};
+} // namespace
+
+std::vector<MeshIOBase::TextChunkType>
+OBJMeshIO::ReadTextChunks(std::string & text)
 {
-  // Define input file stream and attach it to input file
   OpenFile();
+  this->ReadRemainingText(m_InputFile, text);
+  CloseFile();
+  return SplitIntoLineChunks(text.data(), text.data() + text.size());
+}
+
+void
+OBJMeshIO ::ReadMeshInformation()
+{
+  // The lines are counted in parallel chunks
+  std::string                      text;
+  const std::vector<TextChunkType> chunks = this->ReadTextChunks(text);
+  std::vector<LineCounts>          chunkCounts(chunks.size());
+  ParallelizeChunks(chunks.size(), [&chunks, &chunkCounts](SizeValueType i) {
+    LineCounts & counts = chunkCounts[i];
+    ForEachTypedLine(
+      chunks[i].first, chunks[i].second, [&counts](const char * typeBegin, const char * typeEnd, const char * lineEnd) {
+        if (IsLineType(typeBegin, typeEnd, "v"))
+        {
+          counts.m_NumberOfPoints++;
+        }
+        else if (IsLineType(typeBegin, typeEnd, "f"))
+        {
+          counts.m_NumberOfCells++;
+          counts.m_NumberOfCellPoints += CountAsciiTokens(typeEnd, lineEnd);
+        }
+        else if (IsLineType(typeBegin, typeEnd, "vn"))
+        {
+          counts.m_NumberOfPointPixels++;
+        }
+      });
+  });
 
-  // Read and analyze the first line in the file
   SizeValueType numberOfCellPoints = 0;
   this->m_NumberOfPoints = 0;
   this->m_NumberOfCells = 0;
   this->m_NumberOfPointPixels = 0;
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        this->m_NumberOfPoints++;
-      }
-      else if (type == "f")
-      {
-        this->m_NumberOfCells++;
-
-        std::stringstream ss(inputLine);
-        std::string       item;
-        while (ss >> item)
-        {
-          numberOfCellPoints++;
-        }
-      }
-      else if (type == "vn")
-      {
-        this->m_NumberOfPointPixels++;
-        this->m_UpdatePointData = true;
-      }
-    }
+  for (const LineCounts & counts : chunkCounts)
+  {
+    this->m_NumberOfPoints += counts.m_NumberOfPoints;
+    this->m_NumberOfCells += counts.m_NumberOfCells;
+    numberOfCellPoints += counts.m_NumberOfCellPoints;
+    this->m_NumberOfPointPixels += counts.m_NumberOfPointPixels;
+  }
+  if (this->m_NumberOfPointPixels)
+  {
+    this->m_UpdatePointData = true;
   }
 
   this->m_PointDimension = 3;
@@ -207,130 +266,148 @@ OBJMeshIO ::ReadMeshInformation()
   this->m_CellPixelType = IOPixelEnum::VECTOR;
   this->m_NumberOfCellPixelComponents = 3;
   this->m_UpdateCellData = false;
-
-  CloseFile();
 }
 
 void
-OBJMeshIO ::ReadPoints(void * buffer)
+OBJMeshIO::ReadVectorLines(const char * type, float * data)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
-
-  // Read and analyze the first line in the file
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
+  // The lines of the type are counted in each chunk, to know where to store
+  // their coordinates, and then parsed
+  std::string                      text;
+  const std::vector<TextChunkType> chunks = this->ReadTextChunks(text);
+  std::vector<SizeValueType>       firstLines(chunks.size() + 1);
+  ParallelizeChunks(chunks.size(), [&chunks, &firstLines, type](SizeValueType i) {
+    ForEachTypedLine(chunks[i].first,
+                     chunks[i].second,
+                     [&firstLines, i, type](const char * typeBegin, const char * typeEnd, const char *) {
+                       firstLines[i + 1] += IsLineType(typeBegin, typeEnd, type);
+                     });
+  });
+  for (SizeValueType i = 0; i < chunks.size(); ++i)
   {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
+    firstLines[i + 1] += firstLines[i];
+  }
+
+  const unsigned int pointDimension = this->m_PointDimension;
+  ParallelizeChunks(chunks.size(), [&chunks, &firstLines, type, data, pointDimension](SizeValueType i) {
+    float * values = data + firstLines[i] * pointDimension;
+    ForEachTypedLine(
+      chunks[i].first,
+      chunks[i].second,
+      [&values, type, pointDimension](const char * typeBegin, const char * typeEnd, const char * lineEnd) {
+        if (IsLineType(typeBegin, typeEnd, type))
         {
-          ss >> data[index++];
+          // Missing coordinates are zero
+          const char * position = typeEnd;
+          for (unsigned int ii = 0; ii < pointDimension; ii++)
+          {
+            values[ii] = 0.0f;
+            while (position != lineEnd && std::isspace(static_cast<unsigned char>(*position)))
+            {
+              ++position;
+            }
+            if (position != lineEnd)
+            {
+              ParseAsciiNumber(position, values[ii]);
+            }
+          }
+          values += pointDimension;
         }
-      }
-    }
-  }
+      });
+  });
+}
 
-  CloseFile();
+void
+OBJMeshIO ::ReadPoints(void * buffer)
+{
+  this->ReadVectorLines("v", static_cast<float *>(buffer));
 }
 
 void
 OBJMeshIO ::ReadCells(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Read and analyze the first line in the file
-  auto *        data = new long[this->m_CellBufferSize - this->m_NumberOfCells];
-  SizeValueType index = 0;
-
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "f")
-      {
-        std::stringstream ss(inputLine);
-        std::string       item;
-        std::vector<long> idList;
-        while (ss >> item)
+  // The faces and their points are counted in each chunk, to know where to
+  // store them, and then parsed
+  std::string                      text;
+  const std::vector<TextChunkType> chunks = this->ReadTextChunks(text);
+  std::vector<SizeValueType>       firstValues(chunks.size() + 1);
+  ParallelizeChunks(chunks.size(), [&chunks, &firstValues](SizeValueType i) {
+    ForEachTypedLine(
+      chunks[i].first,
+      chunks[i].second,
+      [&firstValues, i](const char * typeBegin, const char * typeEnd, const char * lineEnd) {
+        if (IsLineType(typeBegin, typeEnd, "f"))
         {
-          long                   id;
-          std::string::size_type pos = item.find('/');
-          while (pos != std::string::npos)
-          {
-            item.replace(pos, 1, " ");
-            pos = item.find('/', pos);
-          }
-
-          std::stringstream st(item);
-          st >> id;
-
-          idList.push_back(id);
+          firstValues[i + 1] += 1 + CountAsciiTokens(typeEnd, lineEnd);
         }
+      });
+  });
+  for (SizeValueType i = 0; i < chunks.size(); ++i)
+  {
+    firstValues[i + 1] += firstValues[i];
+  }
+  const SizeValueType numberOfValues = this->m_CellBufferSize - this->m_NumberOfCells;
+  if (firstValues.back() != numberOfValues)
+  {
+    itkExceptionMacro(<< "The faces of " << this->m_FileName << " changed since its information was read");
+  }
 
-        data[index++] = static_cast<long>(idList.size());
-        for (long it : idList)
+  const std::unique_ptr<long[]> data(new long[numberOfValues]);
+  std::vector<char>             validChunks(chunks.size(), true);
+  ParallelizeChunks(chunks.size(), [&chunks, &firstValues, &validChunks, &data](SizeValueType i) {
+    long * values = data.get() + firstValues[i];
+    ForEachTypedLine(
+      chunks[i].first,
+      chunks[i].second,
+      [&values, &validChunks, i](const char * typeBegin, const char * typeEnd, const char * lineEnd) {
+        if (!IsLineType(typeBegin, typeEnd, "f"))
         {
-          data[index++] = (it - 1);
+          return;
         }
-      }
-    }
+        // Each item is a vertex index, possibly followed by "/" and the
+        // indices of its texture coordinates and normal
+        long *       numberOfPoints = values++;
+        const char * position = typeEnd;
+        *numberOfPoints = 0;
+        while (true)
+        {
+          while (position != lineEnd && std::isspace(static_cast<unsigned char>(*position)))
+          {
+            ++position;
+          }
+          if (position == lineEnd)
+          {
+            break;
+          }
+          long id = 0;
+          if (!ParseAsciiNumber(position, id))
+          {
+            validChunks[i] = false;
+          }
+          *values++ = id - 1;
+          ++*numberOfPoints;
+          while (position != lineEnd && !std::isspace(static_cast<unsigned char>(*position)))
+          {
+            ++position;
+          }
+        }
+      });
+  });
+  if (std::find(validChunks.begin(), validChunks.end(), false) != validChunks.end())
+  {
+    itkExceptionMacro(<< "Invalid face in " << this->m_FileName);
   }
 
-  CloseFile();
-
-  this->WriteCellsBuffer(data, static_cast<long *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
+  this->WriteCellsBuffer(
+    data.get(), static_cast<long *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
   // this->WriteCellsBuffer(data, static_cast<unsigned int *>(buffer),
   // CellGeometryEnum::TRIANGLE_CELL, 3, this->m_NumberOfCells);
-  delete[] data;
 }
 
 void
 OBJMeshIO ::ReadPointData(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
-
-  // Read and analyze the first line in the file
-  std::string line;
-  std::string inputLine;
-  std::string type;
-  std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "vn")
-      {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ii++)
-        {
-          ss >> data[index++];
-        }
-      }
-    }
-  }
-
-  CloseFile();
+  this->ReadVectorLines("vn", static_cast<float *>(buffer));
 }
 
 void
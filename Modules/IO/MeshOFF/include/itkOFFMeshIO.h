@@ -22,6 +22,7 @@
 
 #include "itkMeshIOBase.h"
 
+#include <cstring>
 #include <fstream>
 
 namespace itk
@@ -112,24 +113,140 @@ public:
   Write() override;
 
 protected:
-  /** Read buffer as ascii stream */
+  /** Number of cells, and of the values describing them, on cell lines. */
+  struct CellLinesInformation
+  {
+    SizeValueType m_NumberOfCells{ 0 };
+    SizeValueType m_NumberOfValues{ 0 };
+    bool          m_TriangleCells{ true };
+    bool          m_Valid{ true };
+  };
+
+  /** Scan at most maximumNumberOfCells cells in the text [begin, end), from
+   * values "n i0 ... i(n-1)" which may span several lines, and whose other
+   * values on the line of i(n-1), such as colors, are ignored. Their values
+   * n, i0, ..., i(n-1) are stored in cells, unless it is null. */
   template <typename T>
-  void
-  ReadCellsBufferAsAscii(T * buffer, std::ifstream & inputFile)
+  static CellLinesInformation
+  ScanCellLines(const char * begin, const char * end, SizeValueType maximumNumberOfCells, T * cells)
   {
-    SizeValueType index = 0;
-    unsigned int  numberOfPoints = 0;
-    std::string   line;
+    CellLinesInformation information;
+    const char *         position = begin;
+    auto                 skipWhitespace = [&position, end]() {
+      while (position != end && std::isspace(static_cast<unsigned char>(*position)))
+      {
+        ++position;
+      }
+      return position != end;
+    };
+    while (information.m_NumberOfCells < maximumNumberOfCells && skipWhitespace())
+    {
+      unsigned int numberOfPoints = 0;
+      if (!ParseAsciiNumber(position, numberOfPoints))
+      {
+        information.m_Valid = false;
+        break;
+      }
+      if (cells != nullptr)
+      {
+        cells[information.m_NumberOfValues] = static_cast<T>(numberOfPoints);
+      }
+      for (unsigned int jj = 0; jj < numberOfPoints && information.m_Valid; ++jj)
+      {
+        information.m_Valid = skipWhitespace();
+        if (cells != nullptr)
+        {
+          information.m_Valid = information.m_Valid &&
+                                ParseAsciiNumber(position, cells[information.m_NumberOfValues + 1 + jj]);
+        }
+        while (position != end && !std::isspace(static_cast<unsigned char>(*position)))
+        {
+          ++position;
+        }
+      }
+      if (!information.m_Valid)
+      {
+        break;
+      }
+      information.m_NumberOfValues += numberOfPoints + 1;
+      ++information.m_NumberOfCells;
+      information.m_TriangleCells = information.m_TriangleCells && numberOfPoints == 3;
 
-    for (SizeValueType ii = 0; ii < this->m_NumberOfCells; ii++)
+      // Past the rest of the line
+      const void * newLine = std::memchr(position, '\n', static_cast<size_t>(end - position));
+      position = newLine != nullptr ? static_cast<const char *>(newLine) + 1 : end;
+    }
+    return information;
+  }
+
+  /** Scan the cells of the lines of the text [begin, end), in parallel
+   * chunks. When cells is not null, their values are stored in it, and
+   * there must be numberOfValues of them. A cell whose values span several
+   * lines may cross the end of a chunk, which is then invalid: the text is
+   * scanned serially instead. */
+  template <typename T>
+  CellLinesInformation
+  ScanCellLinesInParallel(const char * begin, const char * end, T * cells, SizeValueType numberOfValues)
+  {
+    const std::vector<TextChunkType>  chunks = SplitIntoLineChunks(begin, end);
+    std::vector<CellLinesInformation> chunkInformation(chunks.size());
+    const SizeValueType               numberOfCells = this->m_NumberOfCells;
+    ParallelizeChunks(chunks.size(), [&chunks, &chunkInformation, numberOfCells](SizeValueType i) {
+      chunkInformation[i] = ScanCellLines<T>(chunks[i].first, chunks[i].second, numberOfCells, nullptr);
+    });
+
+    // The first cell and value of each chunk, up to the chunk of the last cell
+    CellLinesInformation       information;
+    std::vector<SizeValueType> firstCells;
+    std::vector<SizeValueType> firstValues;
+    for (SizeValueType i = 0; i < chunks.size() && information.m_NumberOfCells < numberOfCells; ++i)
     {
-      inputFile >> numberOfPoints;
-      buffer[index++] = static_cast<T>(numberOfPoints);
-      for (unsigned int jj = 0; jj < numberOfPoints; jj++)
+      if (information.m_NumberOfCells + chunkInformation[i].m_NumberOfCells > numberOfCells)
       {
-        inputFile >> buffer[index++];
+        chunkInformation[i] = ScanCellLines<T>(
+          chunks[i].first, chunks[i].second, numberOfCells - information.m_NumberOfCells, nullptr);
       }
-      std::getline(inputFile, line, '\n');
+      firstCells.push_back(information.m_NumberOfCells);
+      firstValues.push_back(information.m_NumberOfValues);
+      information.m_NumberOfCells += chunkInformation[i].m_NumberOfCells;
+      information.m_NumberOfValues += chunkInformation[i].m_NumberOfValues;
+      information.m_TriangleCells = information.m_TriangleCells && chunkInformation[i].m_TriangleCells;
+      information.m_Valid = information.m_Valid && chunkInformation[i].m_Valid;
+    }
+
+    if (!information.m_Valid)
+    {
+      information = ScanCellLines<T>(begin, end, numberOfCells, nullptr);
+      if (cells != nullptr && information.m_Valid && information.m_NumberOfValues == numberOfValues)
+      {
+        ScanCellLines(begin, end, numberOfCells, cells);
+      }
+      return information;
+    }
+
+    if (cells != nullptr && information.m_NumberOfValues == numberOfValues)
+    {
+      ParallelizeChunks(firstCells.size(), [&](SizeValueType i) {
+        ScanCellLines(chunks[i].first, chunks[i].second, numberOfCells - firstCells[i], cells + firstValues[i]);
+      });
+    }
+    return information;
+  }
+
+  /** Read buffer as ascii stream */
+  template <typename T>
+  void
+  ReadCellsBufferAsAscii(T * buffer, std::ifstream & inputFile)
+  {
+    std::string text;
+    ReadRemainingText(inputFile, text);
+    const SizeValueType        numberOfValues = this->m_CellBufferSize - this->m_NumberOfCells;
+    const CellLinesInformation information =
+      this->ScanCellLinesInParallel(text.data(), text.data() + text.size(), buffer, numberOfValues);
+    if (!information.m_Valid || information.m_NumberOfCells != this->m_NumberOfCells ||
+        information.m_NumberOfValues != numberOfValues)
+    {
+      itkExceptionMacro(<< "Invalid cells in " << this->m_FileName);
     }
   }
 
@@ -134,16 +134,16 @@ OFFMeshIO ::ReadMeshInformation()
     this->m_PointDimension = 3;
   }
 
-  // Ignore comment lines
-  std::getline(m_InputFile, line, '\n');
-  while (line.find("#") != std::string::npos)
-  {
-    std::getline(m_InputFile, line, '\n');
-  }
-
   // Read points and cells information
   if (this->m_FileType == IOFileEnum::ASCII)
   {
+    // Ignore comment lines
+    std::getline(m_InputFile, line, '\n');
+    while (line.find("#") != std::string::npos)
+    {
+      std::getline(m_InputFile, line, '\n');
+    }
+
     // Put the last line with output '#' into a stringstream.
     std::stringstream ss;
     ss << line;
@@ -161,27 +161,26 @@ OFFMeshIO ::ReadMeshInformation()
     // Read points start position in the file
     m_PointsStartPosition = m_InputFile.tellg();
 
-    for (SizeValueType id = 0; id < this->m_NumberOfPoints; id++)
+    // The cells follow the lines of the points
+    std::string text;
+    this->ReadRemainingText(m_InputFile, text);
+    const char *       cellsBegin = text.data();
+    const char * const textEnd = text.data() + text.size();
+    for (SizeValueType id = 0; id < this->m_NumberOfPoints && cellsBegin != textEnd; id++)
     {
-      std::getline(m_InputFile, line, '\n');
+      const void * newLine = std::memchr(cellsBegin, '\n', static_cast<size_t>(textEnd - cellsBegin));
+      cellsBegin = newLine != nullptr ? static_cast<const char *>(newLine) + 1 : textEnd;
     }
 
-    // Set default cell component type
-    this->m_CellBufferSize = this->m_NumberOfCells * 2;
-
-    // Read each ecll's number of points and put them to cell buffer size
-    unsigned int numberOfCellPoints = 0;
-    for (SizeValueType id = 0; id < this->m_NumberOfCells; id++)
+    // Read each cell's number of points and put them to cell buffer size
+    const CellLinesInformation information =
+      this->ScanCellLinesInParallel<itk::uint32_t>(cellsBegin, textEnd, nullptr, 0);
+    if (!information.m_Valid || information.m_NumberOfCells != this->m_NumberOfCells)
     {
-      m_InputFile >> numberOfCellPoints;
-      this->m_CellBufferSize += numberOfCellPoints;
-      std::getline(m_InputFile, line, '\n');
-
-      if (numberOfCellPoints != 3)
-      {
-        m_TriangleCellType = false;
-      }
+      itkExceptionMacro(<< "Invalid cells in " << this->m_FileName);
     }
+    this->m_CellBufferSize = this->m_NumberOfCells + information.m_NumberOfValues;
+    m_TriangleCellType = information.m_TriangleCells;
   }
   // Read points and cells information from binary mesh
   else if (this->m_FileType == IOFileEnum::BINARY)
@@ -203,28 +202,40 @@ OFFMeshIO ::ReadMeshInformation()
     // Get points start position
     m_PointsStartPosition = m_InputFile.tellg();
 
-    // Read points
-    auto * pointsBuffer = new float[this->m_NumberOfPoints * this->m_PointDimension];
-    this->ReadBufferAsBinary(pointsBuffer, m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
-    delete[] pointsBuffer;
+    // Skip points
+    m_InputFile.seekg(static_cast<std::streamoff>(this->m_NumberOfPoints * this->m_PointDimension * sizeof(float)),
+                      std::ios::cur);
 
     // Set default cell component type
     this->m_CellBufferSize = this->m_NumberOfCells * 2;
 
-    // Read cells
-    itk::uint32_t numberOfCellPoints = 0;
-    auto *        cellsBuffer = new itk::uint32_t[this->m_NumberOfCells];
-    for (unsigned long id = 0; id < this->m_NumberOfCells; id++)
+    // Read cells at once, and walk through them
+    std::string text;
+    this->ReadRemainingText(m_InputFile, text);
+    SizeValueType position = 0;
+    for (SizeValueType id = 0; id < this->m_NumberOfCells; id++)
     {
-      this->ReadBufferAsBinary(&numberOfCellPoints, m_InputFile, 1);
+      itk::uint32_t numberOfCellPoints = 0;
+      if (position > text.size() || text.size() - position < sizeof(numberOfCellPoints))
+      {
+        itkExceptionMacro(<< "Unexpected end of file " << this->m_FileName);
+      }
+      std::memcpy(&numberOfCellPoints, text.data() + position, sizeof(numberOfCellPoints));
+      if (m_ByteOrder == IOByteOrderEnum::BigEndian)
+      {
+        itk::ByteSwapper<itk::uint32_t>::SwapFromSystemToBigEndian(&numberOfCellPoints);
+      }
+      else if (m_ByteOrder == IOByteOrderEnum::LittleEndian)
+      {
+        itk::ByteSwapper<itk::uint32_t>::SwapFromSystemToLittleEndian(&numberOfCellPoints);
+      }
+      position += (SizeValueType{ numberOfCellPoints } + 1) * sizeof(itk::uint32_t);
       this->m_CellBufferSize += numberOfCellPoints;
-      this->ReadBufferAsBinary(cellsBuffer, m_InputFile, numberOfCellPoints);
       if (numberOfCellPoints != 3)
       {
         m_TriangleCellType = false;
       }
     }
-    delete[] cellsBuffer;
   }
 
   // Set default point component type
@@ -349,8 +360,15 @@ OFFMeshIO ::WriteMeshInformation()
                       << this->m_FileName);
   }
 
-  // Write Object file format header
-  outputFile << "OFF " << std::endl;
+  // Write Object file format header, the binary counts follow it
+  if (this->m_FileType == IOFileEnum::BINARY)
+  {
+    outputFile << "OFF BINARY" << std::endl;
+  }
+  else
+  {
+    outputFile << "OFF " << std::endl;
+  }
 
   // Read points and cells information
   if (this->m_FileType == IOFileEnum::ASCII)
@@ -202,10 +202,9 @@ protected:
       {
         /**  Load the point coordinates into the itk::Mesh */
         SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
+        this->ReadBufferAsAscii(buffer, inputFile, numberOfComponents);
+        // There is a single POINTS section, no need to scan the cells
+        return;
       }
     }
   }
@@ -229,6 +228,8 @@ protected:
         {
           itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
         }
+        // There is a single POINTS section, no need to scan the cells
+        return;
       }
     }
   }
@@ -278,10 +279,7 @@ protected:
 
         /** for VECTORS or NORMALS or TENSORS, we could read them directly */
         SizeValueType numberOfComponents = this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
+        this->ReadBufferAsAscii(buffer, inputFile, numberOfComponents);
       }
     }
   }
@@ -373,10 +371,7 @@ protected:
 
         /** for VECTORS or NORMALS or TENSORS, we could read them directly */
         SizeValueType numberOfComponents = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
-        for (SizeValueType ii = 0; ii < numberOfComponents; ii++)
-        {
-          inputFile >> buffer[ii];
-        }
+        this->ReadBufferAsAscii(buffer, inputFile, numberOfComponents);
       }
     }
   }
@@ -20,6 +20,7 @@
 
 #include <itksys/SystemTools.hxx>
 #include <fstream>
+#include <memory>
 
 namespace itk
 {
@@ -848,66 +849,57 @@ VTKPolyDataMeshIO ::ReadCells(void * buffer)
 void
 VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void * buffer)
 {
-  std::string   line;
-  SizeValueType index = 0;
-  unsigned int  numPoints; // number of point in each cell
+  if (!this->m_CellBufferSize)
+  {
+    return;
+  }
 
+  // The cells of each section are read in bulk, as for binary files, and
+  // then given their type
+  const std::unique_ptr<unsigned int[]> inputBuffer(new unsigned int[this->m_CellBufferSize - this->m_NumberOfCells]);
+  unsigned int *                        data = inputBuffer.get();
+  auto *                                outputBuffer = static_cast<unsigned int *>(buffer);
+
+  std::string          line;
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-  using GeometryIntegerType = unsigned int;
-  auto * data = static_cast<GeometryIntegerType *>(buffer);
 
   while (!inputFile.eof())
   {
     std::getline(inputFile, line, '\n');
+    CellGeometryEnum cellType;
+    const char *     numberOfCellsKey;
+    const char *     numberOfIndicesKey;
     if (line.find("VERTICES") != std::string::npos)
     {
-      unsigned int numberOfVertices = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfVertices", numberOfVertices);
-
-      for (unsigned int ii = 0; ii < numberOfVertices; ii++)
-      {
-        inputFile >> numPoints;
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::VERTEX_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      cellType = CellGeometryEnum::VERTEX_CELL;
+      numberOfCellsKey = "numberOfVertices";
+      numberOfIndicesKey = "numberOfVertexIndices";
     }
     else if (line.find("LINES") != std::string::npos)
     {
-      unsigned int numberOfLines = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfLines", numberOfLines);
-
-      for (unsigned int ii = 0; ii < numberOfLines; ii++)
-      {
-        inputFile >> numPoints;
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::LINE_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      cellType = CellGeometryEnum::LINE_CELL;
+      numberOfCellsKey = "numberOfLines";
+      numberOfIndicesKey = "numberOfLineIndices";
     }
     else if (line.find("POLYGONS") != std::string::npos)
     {
-      unsigned int numberOfPolygons = 0;
-      ExposeMetaData<unsigned int>(metaDic, "numberOfPolygons", numberOfPolygons);
-
-      for (unsigned int ii = 0; ii < numberOfPolygons; ii++)
-      {
-        inputFile >> numPoints;
-
-        data[index++] = static_cast<GeometryIntegerType>(CellGeometryEnum::POLYGON_CELL);
-        data[index++] = numPoints;
-        for (unsigned int jj = 0; jj < numPoints; jj++)
-        {
-          inputFile >> data[index++];
-        }
-      }
+      cellType = CellGeometryEnum::POLYGON_CELL;
+      numberOfCellsKey = "numberOfPolygons";
+      numberOfIndicesKey = "numberOfPolygonIndices";
     }
+    else
+    {
+      continue;
+    }
+
+    unsigned int numberOfCells = 0;
+    unsigned int numberOfIndices = 0;
+    ExposeMetaData<unsigned int>(metaDic, numberOfCellsKey, numberOfCells);
+    ExposeMetaData<unsigned int>(metaDic, numberOfIndicesKey, numberOfIndices);
+    this->ReadBufferAsAscii(data, inputFile, numberOfIndices);
+    this->WriteCellsBuffer(data, outputBuffer, cellType, numberOfCells);
+    data += numberOfIndices;
+    outputBuffer += numberOfIndices + numberOfCells;
   }
 }
 
@@ -946,7 +938,7 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
       }
       this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::VERTEX_CELL, numberOfVertices);
       startBuffer += numberOfVertexIndices * sizeof(unsigned int);
-      outputBuffer += (numberOfVertexIndices + numberOfVertices) * sizeof(unsigned int);
+      outputBuffer += numberOfVertexIndices + numberOfVertices;
     }
     else if (line.find("LINES") != std::string::npos)
     {
@@ -964,7 +956,7 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
       }
       this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::LINE_CELL, numberOfLines);
       startBuffer += numberOfLineIndices * sizeof(unsigned int);
-      outputBuffer += (numberOfLineIndices + numberOfLines) * sizeof(unsigned int);
+      outputBuffer += numberOfLineIndices + numberOfLines;
     }
     else if (line.find("POLYGONS") != std::string::npos)
     {
@@ -983,7 +975,7 @@ VTKPolyDataMeshIO ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void * bu
 
       this->WriteCellsBuffer(data, outputBuffer, CellGeometryEnum::POLYGON_CELL, numberOfPolygons);
       startBuffer += numberOfPolygonIndices * sizeof(unsigned int);
-      outputBuffer += (numberOfPolygonIndices + numberOfPolygons) * sizeof(unsigned int);
+      outputBuffer += numberOfPolygonIndices + numberOfPolygons;
     }
   }
 
@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include "itkImageIOBase.h"
+#include "itkDeflateBlockCompressor.h"
 #include "itkSingletonMacro.h"
 #include "itkMetaDataObject.h"
 #include "metaObject.h"
@@ -37,6 +38,19 @@ namespace itk
  *  For a detailed description of using this format, please see
  *  https://www.itk.org/Wiki/ITK/MetaIO/Documentation
  *
+ *  Compressed pixel data is written by a DeflateBlockCompressor, in
+ *  blocks of CompressionBlockSize bytes that are compressed in parallel.
+ *  The compressor "RLE" selects the faster run-length deflate strategy,
+ *  which suits label images; the files remain regular zlib streams.
+ *
+ *  With WriteCompressedDataBlockTable on, the header also lists where each
+ *  block starts in the compressed data, in a CompressedDataBlockSize field
+ *  and CompressedDataBlockOffsets0, CompressedDataBlockOffsets1, ... fields
+ *  of a few offsets each. Files with such a table are read by decompressing
+ *  their blocks in parallel, and regions are streamed by decompressing only
+ *  the blocks that hold them. Other readers take these fields for ordinary
+ *  user fields, and still read the data as a single zlib stream.
+ *
  *  \ingroup IOFilters
  * \ingroup ITKIOMeta
  */
@@ -82,6 +96,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Uncompressed binary data in the header file (LOCAL) or in a single
+   * data file can be memory mapped. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -134,14 +153,14 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
-   *  CanRead must be called prior to this function. */
+   *  file. Compressed data can only be streamed when the header has a
+   *  table of its blocks. CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
     if (m_MetaImage.CompressedData())
     {
-      return false;
+      return this->CanReadCompressedDataBlocks();
     }
     return true;
   }
@@ -167,6 +186,13 @@ public:
   itkSetMacro(SubSamplingFactor, unsigned int);
   itkGetConstMacro(SubSamplingFactor, unsigned int);
 
+  /** Set/Get whether compressed data is written with a table of the
+   * offsets of its blocks in the header, which lets readers decompress the
+   * blocks in parallel and stream regions. Off by default. */
+  itkSetMacro(WriteCompressedDataBlockTable, bool);
+  itkGetConstMacro(WriteCompressedDataBlockTable, bool);
+  itkBooleanMacro(WriteCompressedDataBlockTable);
+
   /**
    * Set the default precision when writing out the MetaImage header.
    * MetaImage header contains values stored in memory as double,
@@ -191,14 +217,87 @@ protected:
   bool
   WriteMatrixInMetaData(std::ostringstream & strs, const MetaDataDictionary & metaDict, const std::string & metaString);
 
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
 private:
+  /** MetaImage that writes element data which MetaImageIO compressed
+   * already, with the table of its blocks, instead of compressing the data
+   * as a single stream. */
+  class PrecompressedMetaImage : public MetaImage
+  {
+  public:
+    /** Write the header and the compressed data of a binary image that is
+     * not split into files of slices; blockOffsets may be empty. */
+    bool
+    WritePrecompressed(const char *                                   headName,
+                       const std::vector<char> &                      compressedData,
+                       BlockCompressor::SizeType                      blockSize,
+                       const std::vector<BlockCompressor::SizeType> & blockOffsets);
+
+    /** The CompressedDataSize of the header that was read last, or 0. */
+    std::streamoff
+    CompressedDataSize() const
+    {
+      return m_CompressedDataSize;
+    }
+
+  protected:
+    void
+    M_SetupWriteFields() override;
+
+    bool
+    M_Write() override;
+
+  private:
+    const std::vector<char> *                      m_PrecompressedData{ nullptr };
+    BlockCompressor::SizeType                      m_PrecompressedBlockSize{ 0 };
+    const std::vector<BlockCompressor::SizeType> * m_PrecompressedBlockOffsets{ nullptr };
+  };
+
+  /** Compress the data with a DeflateBlockCompressor, and return the size
+   * of its blocks; blockOffsets receives the table of the blocks when
+   * WriteCompressedDataBlockTable is on. */
+  BlockCompressor::SizeType
+  CompressElementData(const void *                             buffer,
+                      std::vector<char> &                      compressed,
+                      std::vector<BlockCompressor::SizeType> & blockOffsets) const;
+
+  /** Take the table of compressed blocks from the header that was read,
+   * unless it does not match the image and its compressed data. */
+  void
+  ReadCompressedDataBlockTable();
+
+  /** Locate the data of a single element data file the way MetaImage does;
+   * dataSize is the size of the data in the file, used when the data is at
+   * its end (HeaderSize -1), or -1 when unknown. */
+  bool
+  GetElementDataLocation(std::string & fileName, SizeType & offset, SizeType dataSize) const;
+
+  /** Whether the compressed data has a table of blocks that Read() can
+   * decompress in parallel, one region at a time. */
+  bool
+  CanReadCompressedDataBlocks() const;
+
+  /** Read the IORegion by decompressing the blocks that hold it. */
+  void
+  ReadCompressedDataBlocks(void * buffer, const ImageIORegion & region);
+
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
-  MetaImage m_MetaImage;
+  PrecompressedMetaImage m_MetaImage;
 
   unsigned int m_SubSamplingFactor;
 
+  bool m_WriteCompressedDataBlockTable{ false };
+
+  DeflateBlockCompressorEnums::Strategy m_CompressionStrategy{ DeflateBlockCompressorEnums::Strategy::Default };
+
+  /** The table of compressed blocks of the file that was read, if any. */
+  BlockCompressor::SizeType              m_CompressedDataBlockSize{ 0 };
+  std::vector<BlockCompressor::SizeType> m_CompressedDataBlockOffsets;
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
@@ -23,6 +23,9 @@
 #include "itkMath.h"
 #include "itkSingleton.h"
 
+#include <cstring>
+#include <map>
+
 namespace itk
 {
 // Explicitly set std::numeric_limits<double>::max_digits10 this will provide
@@ -31,6 +34,24 @@ itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
 
 unsigned int * MetaImageIO::m_DefaultDoublePrecision;
 
+namespace
+{
+// The table of compressed blocks is written in header fields of a few
+// offsets each, well within the line length that MetaIO reads, for a
+// limited number of blocks
+constexpr BlockCompressor::SizeType MaximumNumberOfCompressedDataBlocks = 1024;
+constexpr size_t                    CompressedDataBlockOffsetsPerField = 20;
+const std::string                   CompressedDataBlockSizeField = "CompressedDataBlockSize";
+const std::string                   CompressedDataBlockOffsetsField = "CompressedDataBlockOffsets";
+
+bool
+IsCompressedDataBlockTableField(const std::string & key)
+{
+  return key.compare(0, CompressedDataBlockSizeField.size(), CompressedDataBlockSizeField) == 0 ||
+         key.compare(0, CompressedDataBlockOffsetsField.size(), CompressedDataBlockOffsetsField) == 0;
+}
+} // namespace
+
 MetaImageIO::MetaImageIO()
 {
   itkInitGlobalsMacro(DefaultDoublePrecision);
@@ -66,6 +87,127 @@ MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << "\n";
+  os << indent << "CompressionStrategy: " << m_CompressionStrategy << "\n";
+  os << indent << "WriteCompressedDataBlockTable: " << (m_WriteCompressedDataBlockTable ? "On" : "Off") << "\n";
+}
+
+void
+MetaImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "ZLIB")
+  {
+    m_CompressionStrategy = DeflateBlockCompressorEnums::Strategy::Default;
+  }
+  else if (_compressor == "RLE")
+  {
+    m_CompressionStrategy = DeflateBlockCompressorEnums::Strategy::RunLength;
+  }
+  else
+  {
+    this->Superclass::InternalSetCompressor(_compressor);
+  }
+}
+
+BlockCompressor::SizeType
+MetaImageIO::CompressElementData(const void *                             buffer,
+                                 std::vector<char> &                      compressed,
+                                 std::vector<BlockCompressor::SizeType> & blockOffsets) const
+{
+  DeflateBlockCompressor::Pointer compressor = DeflateBlockCompressor::New();
+  this->ConfigureBlockCompressor(*compressor);
+  compressor->SetStrategy(m_CompressionStrategy);
+  const auto dataSize = static_cast<BlockCompressor::SizeType>(this->GetImageSizeInBytes());
+  if (m_WriteCompressedDataBlockTable)
+  {
+    // The header holds a limited number of offsets
+    const BlockCompressor::SizeType minimumBlockSize =
+      (dataSize + MaximumNumberOfCompressedDataBlocks - 1) / MaximumNumberOfCompressedDataBlocks;
+    if (compressor->GetBlockSize() < minimumBlockSize)
+    {
+      compressor->SetBlockSize(minimumBlockSize);
+    }
+    compressor->Compress(buffer, dataSize, compressed, &blockOffsets);
+  }
+  else
+  {
+    compressor->Compress(buffer, dataSize, compressed);
+  }
+  return compressor->GetBlockSize();
+}
+
+bool
+MetaImageIO::PrecompressedMetaImage::WritePrecompressed(const char *                                   headName,
+                                                        const std::vector<char> &                      compressedData,
+                                                        BlockCompressor::SizeType                      blockSize,
+                                                        const std::vector<BlockCompressor::SizeType> & blockOffsets)
+{
+  // MetaImage::Write neither compresses nor writes data that is not
+  // binary; M_SetupWriteFields and M_Write restore BinaryData, and write
+  // the compressed data after the header
+  m_PrecompressedData = &compressedData;
+  m_PrecompressedBlockSize = blockSize;
+  m_PrecompressedBlockOffsets = &blockOffsets;
+  this->BinaryData(false);
+  const bool result = this->Write(headName, nullptr, false);
+  this->BinaryData(true);
+  m_PrecompressedData = nullptr;
+  m_PrecompressedBlockOffsets = nullptr;
+  return result;
+}
+
+void
+MetaImageIO::PrecompressedMetaImage::M_SetupWriteFields()
+{
+  if (m_PrecompressedData == nullptr)
+  {
+    MetaImage::M_SetupWriteFields();
+    return;
+  }
+
+  m_BinaryData = true;
+  m_CompressedDataSize = static_cast<std::streamoff>(m_PrecompressedData->size());
+  MetaImage::M_SetupWriteFields();
+  m_CompressedDataSize = 0;
+  if (m_PrecompressedBlockOffsets->empty())
+  {
+    return;
+  }
+
+  // The table goes before ElementDataFile, which ends the header
+  auto       fieldIt = m_Fields.end() - 1;
+  const auto insertField = [this, &fieldIt](const std::string & name, const std::string & value) {
+    auto * field = new MET_FieldRecordType;
+    MET_InitWriteField(field, name.c_str(), MET_STRING, value.size(), value.c_str());
+    fieldIt = m_Fields.insert(fieldIt, field) + 1;
+  };
+  insertField(CompressedDataBlockSizeField, std::to_string(m_PrecompressedBlockSize));
+  const size_t numberOfBlocks = m_PrecompressedBlockOffsets->size();
+  for (size_t first = 0; first < numberOfBlocks; first += CompressedDataBlockOffsetsPerField)
+  {
+    std::ostringstream offsets;
+    for (size_t block = first; block < std::min(first + CompressedDataBlockOffsetsPerField, numberOfBlocks); ++block)
+    {
+      offsets << (block == first ? "" : " ") << (*m_PrecompressedBlockOffsets)[block];
+    }
+    insertField(CompressedDataBlockOffsetsField + std::to_string(first / CompressedDataBlockOffsetsPerField),
+                offsets.str());
+  }
+}
+
+bool
+MetaImageIO::PrecompressedMetaImage::M_Write()
+{
+  if (!MetaImage::M_Write())
+  {
+    return false;
+  }
+  if (m_PrecompressedData != nullptr)
+  {
+    return this->M_WriteElements(m_WriteStream,
+                                 m_PrecompressedData->data(),
+                                 static_cast<std::streamoff>(m_PrecompressedData->size()));
+  }
+  return true;
 }
 
 void
@@ -411,8 +553,13 @@ MetaImageIO::ReadImageInformation()
   {
     std::string key(m_MetaImage.GetAdditionalReadFieldName(f));
     std::string value(m_MetaImage.GetAdditionalReadFieldValue(f));
+    if (IsCompressedDataBlockTableField(key))
+    {
+      continue;
+    }
     EncapsulateMetaData<std::string>(thisMetaDict, key, value);
   }
+  this->ReadCompressedDataBlockTable();
 
   //
   // Read some metadata
@@ -448,7 +595,26 @@ MetaImageIO::Read(void * buffer)
     largestRegion.SetSize(i, this->GetDimensions(i));
   }
 
-  if (largestRegion != m_IORegion)
+  if (this->CanReadCompressedDataBlocks() && (m_SubSamplingFactor == 1 || largestRegion == m_IORegion))
+  {
+    ImageIORegion region = largestRegion;
+    if (largestRegion != m_IORegion)
+    {
+      for (unsigned int i = 0; i < nDims && i < m_IORegion.GetImageDimension(); i++)
+      {
+        region.SetIndex(i, m_IORegion.GetIndex(i));
+        region.SetSize(i, m_IORegion.GetSize(i));
+      }
+      for (unsigned int i = m_IORegion.GetImageDimension(); i < nDims; i++)
+      {
+        region.SetSize(i, 1);
+      }
+    }
+    this->ReadCompressedDataBlocks(buffer, region);
+    m_MetaImage.ElementData(buffer, false);
+    m_MetaImage.ElementByteOrderFix(region.GetNumberOfPixels());
+  }
+  else if (largestRegion != m_IORegion)
   {
     auto * indexMin = new int[nDims];
     auto * indexMax = new int[nDims];
@@ -493,6 +659,256 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() ||
+      (this->GetComponentSize() > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB()))
+  {
+    return false;
+  }
+
+  return this->GetElementDataLocation(fileName, offset, this->GetImageSizeInBytes());
+}
+
+bool
+MetaImageIO::GetElementDataLocation(std::string & fileName, SizeType & offset, SizeType dataSize) const
+{
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  const bool        isLocal = itksys::SystemTools::UpperCase(elementDataFileName) == "LOCAL";
+  if (isLocal)
+  {
+    fileName = m_FileName;
+  }
+  else if (elementDataFileName.compare(0, 4, "LIST") == 0 || elementDataFileName.find('%') != std::string::npos)
+  {
+    // The data is spread over several files
+    return false;
+  }
+  else
+  {
+    fileName = itksys::SystemTools::CollapseFullPath(elementDataFileName,
+                                                     itksys::SystemTools::GetFilenamePath(m_FileName));
+  }
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    return false;
+  }
+
+  // Locate the data the same way MetaImage::M_ReadElements does
+  const int headerSize = m_MetaImage.HeaderSize();
+  if (headerSize > 0)
+  {
+    offset = headerSize;
+  }
+  else if (headerSize == -1)
+  {
+    if (dataSize < 0)
+    {
+      return false;
+    }
+    offset = static_cast<SizeType>(itksys::SystemTools::FileLength(fileName)) - dataSize;
+  }
+  else if (isLocal)
+  {
+    // The data follows the header
+    std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::in);
+    MetaImage     header;
+    if (!file.is_open() || !header.ReadStream(0, &file, false))
+    {
+      return false;
+    }
+    offset = static_cast<SizeType>(file.tellg());
+  }
+  else
+  {
+    offset = 0;
+  }
+  return offset >= 0;
+}
+
+bool
+MetaImageIO::CanReadCompressedDataBlocks() const
+{
+  std::string fileName;
+  SizeType    offset;
+  return m_MetaImage.BinaryData() && m_MetaImage.CompressedData() && !m_CompressedDataBlockOffsets.empty() &&
+         this->GetElementDataLocation(fileName, offset, -1);
+}
+
+void
+MetaImageIO::ReadCompressedDataBlockTable()
+{
+  m_CompressedDataBlockSize = 0;
+  m_CompressedDataBlockOffsets.clear();
+  const auto compressedDataSize = static_cast<BlockCompressor::SizeType>(m_MetaImage.CompressedDataSize());
+  if (!m_MetaImage.BinaryData() || !m_MetaImage.CompressedData() || compressedDataSize <= 0)
+  {
+    return;
+  }
+  std::map<std::string, std::string> fields;
+  const int                          numberOfFields = m_MetaImage.GetNumberOfAdditionalReadFields();
+  for (int f = 0; f < numberOfFields; f++)
+  {
+    const std::string key(m_MetaImage.GetAdditionalReadFieldName(f));
+    if (IsCompressedDataBlockTableField(key))
+    {
+      fields[key] = m_MetaImage.GetAdditionalReadFieldValue(f);
+    }
+  }
+  if (fields.count(CompressedDataBlockSizeField) == 0)
+  {
+    return;
+  }
+
+  // The block size must be one that the decompressor accepts, and the
+  // offsets must cover the data of the image
+  BlockCompressor::SizeType blockSize = 0;
+  std::istringstream(fields[CompressedDataBlockSizeField]) >> blockSize;
+  DeflateBlockCompressor::Pointer decompressor = DeflateBlockCompressor::New();
+  decompressor->SetBlockSize(blockSize);
+  auto imageSizeInBytes =
+    static_cast<BlockCompressor::SizeType>(this->GetComponentSize() * this->GetNumberOfComponents());
+  for (int i = 0; i < m_MetaImage.NDims(); i++)
+  {
+    imageSizeInBytes *= m_MetaImage.DimSize(i);
+  }
+  if (blockSize <= 0 || decompressor->GetBlockSize() != blockSize || imageSizeInBytes <= 0)
+  {
+    return;
+  }
+  const BlockCompressor::SizeType numberOfBlocks = (imageSizeInBytes + blockSize - 1) / blockSize;
+  if (numberOfBlocks > MaximumNumberOfCompressedDataBlocks)
+  {
+    return;
+  }
+  std::vector<BlockCompressor::SizeType> offsets;
+  for (size_t line = 0; static_cast<BlockCompressor::SizeType>(offsets.size()) < numberOfBlocks; ++line)
+  {
+    const auto field = fields.find(CompressedDataBlockOffsetsField + std::to_string(line));
+    if (field == fields.end())
+    {
+      return;
+    }
+    std::istringstream        values(field->second);
+    BlockCompressor::SizeType offset = 0;
+    while (values >> offset)
+    {
+      offsets.push_back(offset);
+    }
+    const size_t expectedSize = (line + 1) * CompressedDataBlockOffsetsPerField;
+    if (offsets.size() != std::min(expectedSize, static_cast<size_t>(numberOfBlocks)))
+    {
+      return;
+    }
+  }
+  for (size_t block = 0; block < offsets.size(); ++block)
+  {
+    if (offsets[block] < (block == 0 ? 0 : offsets[block - 1]) || offsets[block] >= compressedDataSize)
+    {
+      return;
+    }
+  }
+
+  m_CompressedDataBlockSize = blockSize;
+  m_CompressedDataBlockOffsets.swap(offsets);
+}
+
+void
+MetaImageIO::ReadCompressedDataBlocks(void * buffer, const ImageIORegion & region)
+{
+  std::string fileName;
+  SizeType    dataOffset = 0;
+  if (!this->GetElementDataLocation(fileName, dataOffset, -1))
+  {
+    itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                              << "Reason: the data file is not found.");
+  }
+
+  const SizeType                                 imageSizeInBytes = this->GetImageSizeInBytes();
+  const SizeType                                 blockSize = m_CompressedDataBlockSize;
+  const std::vector<BlockCompressor::SizeType> & offsets = m_CompressedDataBlockOffsets;
+  const auto                                     numberOfBlocks = static_cast<SizeType>(offsets.size());
+  DeflateBlockCompressor::Pointer                decompressor = DeflateBlockCompressor::New();
+  decompressor->SetBlockSize(blockSize);
+
+  // The range of the data that holds the region, in bytes
+  const unsigned int    nDims = this->GetNumberOfDimensions();
+  const SizeType        pixelSize = static_cast<SizeType>(this->GetPixelSize());
+  std::vector<SizeType> strides(nDims);
+  SizeType              regionBegin = 0;
+  SizeType              regionEnd = pixelSize;
+  for (unsigned int i = 0; i < nDims; i++)
+  {
+    strides[i] = i == 0 ? pixelSize : strides[i - 1] * static_cast<SizeType>(this->GetDimensions(i - 1));
+    regionBegin += region.GetIndex(i) * strides[i];
+    regionEnd += (region.GetIndex(i) + static_cast<SizeType>(region.GetSize(i)) - 1) * strides[i];
+  }
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // Read the compressed data of the blocks that overlap that range; the
+  // last block of the data ends at the end of the file at the latest
+  const SizeType firstBlock = regionBegin / blockSize;
+  const SizeType endBlock = (regionEnd + blockSize - 1) / blockSize;
+  const SizeType compressedBegin = offsets[firstBlock];
+  const SizeType compressedEnd =
+    endBlock < numberOfBlocks ? offsets[endBlock] : static_cast<SizeType>(m_MetaImage.CompressedDataSize());
+  std::vector<char> compressed(static_cast<size_t>(compressedEnd - compressedBegin));
+  std::ifstream     file(fileName.c_str(), std::ios::in | std::ios::binary);
+  file.seekg(static_cast<std::streamoff>(dataOffset + compressedBegin), std::ios::beg);
+  file.read(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+  if (!file.is_open() || file.gcount() != static_cast<std::streamsize>(compressed.size()))
+  {
+    itkExceptionMacro("File cannot be read: " << fileName << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  std::vector<BlockCompressor::SizeType> blockOffsets;
+  for (SizeType block = firstBlock; block < endBlock; ++block)
+  {
+    blockOffsets.push_back(offsets[block] - compressedBegin);
+  }
+
+  // Decompress the blocks in parallel, straight into the buffer when it
+  // receives them all
+  const SizeType dataBegin = firstBlock * blockSize;
+  const SizeType dataSize = std::min(endBlock * blockSize, imageSizeInBytes) - dataBegin;
+  if (regionBegin == 0 && regionEnd == imageSizeInBytes)
+  {
+    decompressor->Decompress(compressed.data(), compressedEnd - compressedBegin, blockOffsets, buffer, dataSize);
+    return;
+  }
+  std::vector<char> data(static_cast<size_t>(dataSize));
+  decompressor->Decompress(compressed.data(), compressedEnd - compressedBegin, blockOffsets, data.data(), dataSize);
+  std::vector<char>().swap(compressed);
+
+  // Copy the region, one line along the first dimension at a time
+  const SizeType             lineSize = static_cast<SizeType>(region.GetSize(0)) * pixelSize;
+  const SizeValueType        numberOfLines = region.GetNumberOfPixels() / region.GetSize(0);
+  std::vector<SizeValueType> lineIndex(nDims, 0);
+  char *                     output = static_cast<char *>(buffer);
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    SizeType lineBegin = regionBegin - dataBegin;
+    for (unsigned int i = 1; i < nDims; i++)
+    {
+      lineBegin += static_cast<SizeType>(lineIndex[i]) * strides[i];
+    }
+    std::memcpy(output, data.data() + lineBegin, static_cast<size_t>(lineSize));
+    output += lineSize;
+    for (unsigned int i = 1; i < nDims; i++)
+    {
+      if (++lineIndex[i] < region.GetSize(i))
+      {
+        break;
+      }
+      lineIndex[i] = 0;
+    }
+  }
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -564,7 +980,7 @@ MetaImageIO ::WriteImageInformation()
   std::vector<std::string>::const_iterator keyIt;
   for (keyIt = keys.begin(); keyIt != keys.end(); ++keyIt)
   {
-    if (*keyIt == ITK_ExperimentDate || *keyIt == ITK_VoxelUnits)
+    if (*keyIt == ITK_ExperimentDate || *keyIt == ITK_VoxelUnits || IsCompressedDataBlockTableField(*keyIt))
     {
       continue;
     }
@@ -1120,7 +1536,23 @@ MetaImageIO ::Write(const void * buffer)
   }
   else
   {
-    if (!m_MetaImage.Write(m_FileName.c_str()))
+    // Compress the data in blocks in parallel, unless it is split into
+    // files of slices that MetaImage compresses one by one
+    const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+    bool              written = false;
+    if (m_UseCompression && elementDataFileName.find('%') == std::string::npos &&
+        elementDataFileName.compare(0, 4, "LIST") != 0)
+    {
+      std::vector<char>                      compressed;
+      std::vector<BlockCompressor::SizeType> blockOffsets;
+      const BlockCompressor::SizeType        blockSize = this->CompressElementData(buffer, compressed, blockOffsets);
+      written = m_MetaImage.WritePrecompressed(m_FileName.c_str(), compressed, blockSize, blockOffsets);
+    }
+    else
+    {
+      written = m_MetaImage.Write(m_FileName.c_str());
+    }
+    if (!written)
     {
       delete[] dSize;
       delete[] eSpacing;
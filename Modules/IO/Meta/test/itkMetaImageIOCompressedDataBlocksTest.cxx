@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+ExpectedValue(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[0] * 7 + index[1] * 311 + index[2] * 1009);
+}
+
+bool
+HasExpectedValues(const ImageType * image, const ImageType::RegionType & region)
+{
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    std::cerr << "Region " << region << " is not buffered." << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue(it.GetIndex()))
+    {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of " << ExpectedValue(it.GetIndex())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// Write compressed MetaImages with a table of blocks, and read them as a
+// whole, streamed and by region.
+int
+itkMetaImageIOCompressedDataBlocksTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+
+  auto                  image = ImageType::New();
+  ImageType::RegionType largestRegion;
+  largestRegion.SetSize({ { 40, 30, 20 } });
+  image->SetRegions(largestRegion);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, largestRegion); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue(it.GetIndex()));
+  }
+
+  auto writerIO = itk::MetaImageIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(writerIO, WriteCompressedDataBlockTable, true);
+  writerIO->SetCompressionBlockSize(1000);
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(writerIO);
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // The whole image
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto readerIO = itk::MetaImageIO::New();
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_TRUE(HasExpectedValues(reader->GetOutput(), largestRegion));
+  ITK_TEST_EXPECT_TRUE(readerIO->CanStreamRead());
+  ITK_TEST_EXPECT_TRUE(!readerIO->GetMetaDataDictionary().HasKey("CompressedDataBlockSize"));
+
+  // The offsets of the 48 blocks are in short header lines
+  std::string header;
+  {
+    std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+    std::string   line;
+    while (std::getline(file, line) && line.compare(0, 15, "ElementDataFile") != 0)
+    {
+      ITK_TEST_EXPECT_TRUE(line.size() < 500);
+      header += line + "\n";
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(header.find("CompressedDataBlockSize = 1000\n") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(header.find("CompressedDataBlockOffsets2 = ") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(header.find("CompressedDataBlockOffsets3") == std::string::npos);
+
+  // Streamed pieces, whose bytes do not start and end at block boundaries
+  auto streamingReader = ReaderType::New();
+  streamingReader->SetFileName(fileName);
+  streamingReader->SetImageIO(itk::MetaImageIO::New());
+  streamingReader->SetUseStreaming(true);
+  using StreamingFilterType = itk::StreamingImageFilter<ImageType, ImageType>;
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(streamingReader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+  ITK_TEST_EXPECT_TRUE(HasExpectedValues(streamer->GetOutput(), largestRegion));
+
+  // A region inside the image
+  ImageType::RegionType region;
+  region.SetIndex({ { 3, 5, 7 } });
+  region.SetSize({ { 20, 11, 6 } });
+  auto regionReader = ReaderType::New();
+  regionReader->SetFileName(fileName);
+  regionReader->SetImageIO(itk::MetaImageIO::New());
+  regionReader->SetUseStreaming(true);
+  regionReader->UpdateOutputInformation();
+  regionReader->GetOutput()->SetRequestedRegion(region);
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionReader->Update());
+  ITK_TEST_EXPECT_EQUAL(regionReader->GetOutput()->GetBufferedRegion(), region);
+  ITK_TEST_EXPECT_TRUE(HasExpectedValues(regionReader->GetOutput(), region));
+
+  // A table that does not match the data is ignored
+  {
+    std::fstream file(fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(header.find("CompressedDataBlockSize = 1000")));
+    file << "CompressedDataBlockSize = 2000";
+  }
+  auto mismatchReader = ReaderType::New();
+  mismatchReader->SetFileName(fileName);
+  mismatchReader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(mismatchReader->Update());
+  ITK_TEST_EXPECT_TRUE(HasExpectedValues(mismatchReader->GetOutput(), largestRegion));
+  ITK_TEST_EXPECT_TRUE(!readerIO->CanStreamRead());
+
+  // Without the table, compressed data is read as a whole
+  writerIO->WriteCompressedDataBlockTableOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  auto plainReader = ReaderType::New();
+  plainReader->SetFileName(fileName);
+  plainReader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(plainReader->Update());
+  ITK_TEST_EXPECT_TRUE(HasExpectedValues(plainReader->GetOutput(), largestRegion));
+  ITK_TEST_EXPECT_TRUE(!readerIO->CanStreamRead());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -24,6 +24,8 @@
 #include <fstream>
 #include <memory>
 #include "itkImageIOBase.h"
+#include "itkIndexedGzipFileReader.h"
+#include "itkDeflateBlockCompressor.h"
 
 namespace itk
 {
@@ -123,6 +125,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Uncompressed data which is neither rescaled, byte swapped nor stored
+   * as separate component volumes can be memory mapped. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
@@ -146,6 +153,16 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Regions are read without reading the rest of the file. For
+   * compressed files only the data up to the end of the region is
+   * decompressed, and an index of the compressed stream lets later regions
+   * of the same file resume decompression close to where they start. */
+  bool
+  CanStreamRead() override
+  {
+    return true;
+  }
+
   /** Calculate the region of the image that can be efficiently read
    *  in response to a given requested region. */
   ImageIORegion
@@ -174,6 +191,9 @@ protected:
     return false;
   }
 
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
 private:
   // Try to use the Q and S form codes from MetaDataDictionary if they are specified
   // there, otherwise default to the backwards compatible values from earlier
@@ -199,6 +219,16 @@ private:
   void
   SetImageIOMetadataFromNIfTI();
 
+  /** Read a subregion of the pixel data, given as NIfTI start indices and
+   * sizes of all seven dimensions, into a buffer allocated with malloc. */
+  void *
+  ReadSubregion(const int * start, const int * size);
+
+  /** Write the header and the given pixel data, in NIfTI layout. The pixel
+   * data of gzip compressed files is compressed in parallel. */
+  void
+  WriteNiftiImage(const void * data);
+
   // This proxy class provides a nifti_image pointer interface to the internal implementation
   // of itk::NiftiImageIO, while hiding the niftilib interface from the external ITK interface.
   class NiftiImageProxy;
@@ -215,6 +245,17 @@ private:
   IOComponentEnum m_OnDiskComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
 
   Analyze75Flavor m_LegacyAnalyze75Mode;
+
+  DeflateBlockCompressorEnums::Strategy m_CompressionStrategy{ DeflateBlockCompressorEnums::Strategy::Default };
+
+  /** Where ReadImageInformation() found mappable pixel data, an empty
+   * file name if the pixel data cannot be mapped. */
+  std::string m_RawPixelDataFileName;
+  SizeType    m_RawPixelDataOffset{ 0 };
+
+  /** Reads the pixel data of subregions; kept between the reads of one
+   * update, so that streamed regions share the index of a compressed file. */
+  IndexedGzipFileReader::Pointer m_SubregionReader;
 };
 
 
@@ -424,6 +424,10 @@ SymMatDim(int count)
 ImageIORegion
 NiftiImageIO ::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
 {
+  if (!m_UseStreamedReading)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
   return requestedRegion;
 }
 
@@ -460,6 +464,12 @@ NiftiImageIO::NiftiImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+
+  // gzip compression is chosen by the file name; the level defaults to
+  // that of zlib
+  this->Self::SetCompressor("");
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(6);
 }
 
 NiftiImageIO::~NiftiImageIO()
@@ -472,6 +482,24 @@ NiftiImageIO ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "LegacyAnalyze75Mode: " << this->m_LegacyAnalyze75Mode << std::endl;
+  os << indent << "CompressionStrategy: " << this->m_CompressionStrategy << std::endl;
+}
+
+void
+NiftiImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "GZIP")
+  {
+    m_CompressionStrategy = DeflateBlockCompressorEnums::Strategy::Default;
+  }
+  else if (_compressor == "RLE")
+  {
+    m_CompressionStrategy = DeflateBlockCompressorEnums::Strategy::RunLength;
+  }
+  else
+  {
+    this->Superclass::InternalSetCompressor(_compressor);
+  }
 }
 
 bool
@@ -515,6 +543,96 @@ CastCopy(float * to, const void * from, size_t pixelcount)
   }
 }
 
+void *
+NiftiImageIO::ReadSubregion(const int * start, const int * size)
+{
+  nifti_image * const nim = this->m_NiftiImage;
+
+  if (nim->iname == nullptr || nim->iname_offset < 0)
+  {
+    // the data offset depends on the file size; leave it to niftilib
+    void * data = nullptr;
+    if (nifti_read_subregion_image(nim, const_cast<int *>(start), const_cast<int *>(size), &data) == -1)
+    {
+      itkExceptionMacro(<< "nifti_read_subregion_image failed for file: " << this->GetFileName());
+    }
+    return data;
+  }
+
+  using OffsetType = IndexedGzipFileReader::SizeType;
+  OffsetType dims[7];
+  OffsetType strides[7];
+  OffsetType numberOfBytes = nim->nbyper;
+  for (unsigned int d = 0; d < 7; ++d)
+  {
+    dims[d] = (static_cast<int>(d) < nim->dim[0]) ? nim->dim[d + 1] : 1;
+    strides[d] = (d == 0) ? nim->nbyper : strides[d - 1] * dims[d - 1];
+    if (start[d] < 0 || size[d] < 1 || start[d] + size[d] > dims[d])
+    {
+      itkExceptionMacro(<< "Region to read exceeds the image in dimension " << d << " of file: " << this->GetFileName());
+    }
+    numberOfBytes *= size[d];
+  }
+
+  // Leading dimensions that are read in full form a single contiguous run
+  // together with the first one that is not.
+  OffsetType   runBytes = size[0] * strides[0];
+  unsigned int firstOuter = 1;
+  while (firstOuter < 7 && size[firstOuter - 1] == dims[firstOuter - 1])
+  {
+    runBytes *= size[firstOuter];
+    ++firstOuter;
+  }
+
+  auto * data = static_cast<char *>(malloc(static_cast<size_t>(numberOfBytes)));
+  if (data == nullptr)
+  {
+    itkExceptionMacro(<< "Failed to allocate " << numberOfBytes << " bytes for reading file: " << this->GetFileName());
+  }
+
+  try
+  {
+    if (m_SubregionReader.IsNull() || nim->iname != std::string(m_SubregionReader->GetFileName()))
+    {
+      m_SubregionReader = IndexedGzipFileReader::New();
+      m_SubregionReader->Open(nim->iname, nifti_is_gzfile(nim->iname) != 0);
+    }
+
+    // Read the runs in file order, which lets a compressed file be
+    // decompressed in a single pass.
+    int        index[7] = { 0, 0, 0, 0, 0, 0, 0 };
+    char *     out = data;
+    const auto end = data + numberOfBytes;
+    while (out != end)
+    {
+      OffsetType offset = nim->iname_offset;
+      for (unsigned int d = 0; d < 7; ++d)
+      {
+        offset += (start[d] + index[d]) * strides[d];
+      }
+      m_SubregionReader->Read(out, offset, runBytes);
+      out += runBytes;
+
+      for (unsigned int d = firstOuter; d < 7 && ++index[d] == size[d]; ++d)
+      {
+        index[d] = 0;
+      }
+    }
+  }
+  catch (...)
+  {
+    free(data);
+    m_SubregionReader = nullptr;
+    throw;
+  }
+
+  if (nim->swapsize > 1 && nim->byteorder != nifti_short_order())
+  {
+    nifti_swap_Nbytes(static_cast<size_t>(numberOfBytes) / nim->swapsize, nim->swapsize, data);
+  }
+  return data;
+}
+
 void
 NiftiImageIO::Read(void * buffer)
 {
@@ -587,10 +705,7 @@ NiftiImageIO::Read(void * buffer)
   else
   {
     // read in a subregion
-    if (nifti_read_subregion_image(this->m_NiftiImage, _origin, _size, &data) == -1)
-    {
-      itkExceptionMacro(<< "nifti_read_subregion_image failed for file: " << this->GetFileName());
-    }
+    data = this->ReadSubregion(_origin, _size);
   }
   unsigned int pixelSize = this->m_NiftiImage->nbyper;
   //
@@ -677,10 +792,12 @@ NiftiImageIO::Read(void * buffer)
     // vec x y z t l m o
     const auto * niftibuf = (const char *)data;
     auto *       itkbuf = (char *)buffer;
-    const size_t rowdist = this->m_NiftiImage->dim[1];
-    const size_t slicedist = rowdist * this->m_NiftiImage->dim[2];
-    const size_t volumedist = slicedist * this->m_NiftiImage->dim[3];
-    const size_t seriesdist = volumedist * this->m_NiftiImage->dim[4];
+    // the distances are within the region that was read, which is the
+    // whole image when all dimensions match
+    const size_t rowdist = _size[0];
+    const size_t slicedist = rowdist * _size[1];
+    const size_t volumedist = slicedist * _size[2];
+    const size_t seriesdist = volumedist * _size[3];
     //
     // as per ITK bug 0007485
     // NIfTI is lower triangular, ITK is upper triangular.
@@ -699,13 +816,13 @@ NiftiImageIO::Read(void * buffer)
         vecOrder[i] = i;
       }
     }
-    for (int t = 0; t < this->m_NiftiImage->dim[4]; t++)
+    for (int t = 0; t < _size[3]; t++)
     {
-      for (int z = 0; z < this->m_NiftiImage->dim[3]; z++)
+      for (int z = 0; z < _size[2]; z++)
       {
-        for (int y = 0; y < this->m_NiftiImage->dim[2]; y++)
+        for (int y = 0; y < _size[1]; y++)
         {
-          for (int x = 0; x < this->m_NiftiImage->dim[1]; x++)
+          for (int x = 0; x < _size[0]; x++)
           {
             for (unsigned int c = 0; c < numComponents; c++)
             {
@@ -787,6 +904,18 @@ NiftiImageIO::Read(void * buffer)
   }
 }
 
+bool
+NiftiImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (m_RawPixelDataFileName.empty())
+  {
+    return false;
+  }
+  fileName = m_RawPixelDataFileName;
+  offset = m_RawPixelDataOffset;
+  return true;
+}
+
 NiftiImageIO::FileType
 NiftiImageIO::DetermineFileType(const char * FileNameToRead)
 {
@@ -994,6 +1123,9 @@ NiftiImageIO::SetImageIOMetadataFromNIfTI()
 void
 NiftiImageIO ::ReadImageInformation()
 {
+  // The file may have changed since the last read
+  m_SubregionReader = nullptr;
+
   const int image_FTYPE = is_nifti_file(this->GetFileName());
   if (image_FTYPE == 0)
   {
@@ -1350,6 +1482,20 @@ NiftiImageIO ::ReadImageInformation()
   const std::string description(this->m_NiftiImage->descrip);
   EncapsulateMetaData<std::string>(this->GetMetaDataDictionary(), ITK_FileNotes, description);
 
+  // Read() copies the data unchanged unless it is compressed, rescaled,
+  // byte swapped, or a vector image whose components are stored in
+  // separate volumes.
+  m_RawPixelDataFileName.clear();
+  const unsigned int numComponents = this->GetNumberOfComponents();
+  if (this->m_NiftiImage->iname != nullptr && !nifti_is_gzfile(this->m_NiftiImage->iname) && !this->MustRescale() &&
+      (this->m_NiftiImage->swapsize <= 1 || this->m_NiftiImage->byteorder == nifti_short_order()) &&
+      (numComponents == 1 || this->GetPixelType() == IOPixelEnum::COMPLEX ||
+       this->GetPixelType() == IOPixelEnum::RGB || this->GetPixelType() == IOPixelEnum::RGBA))
+  {
+    m_RawPixelDataFileName = this->m_NiftiImage->iname;
+    m_RawPixelDataOffset = this->m_NiftiImage->iname_offset;
+  }
+
   // We don't need the image anymore
   nifti_image_free(this->m_NiftiImage);
   this->m_NiftiImage = nullptr;
@@ -2171,6 +2317,8 @@ NiftiImageIO::SetNIfTIOrientationFromImageIO(unsigned short int origdims, unsign
 void
 NiftiImageIO ::Write(const void * buffer)
 {
+  m_SubregionReader = nullptr;
+
   // Write the image Information before writing data
   this->WriteImageInformation();
   const unsigned int numComponents = this->GetNumberOfComponents();
@@ -2178,12 +2326,7 @@ NiftiImageIO ::Write(const void * buffer)
       (numComponents == 3 && this->GetPixelType() == IOPixelEnum::RGB) ||
       (numComponents == 4 && this->GetPixelType() == IOPixelEnum::RGBA))
   {
-    // Need a const cast here so that we don't have to copy the memory
-    // for writing.
-    this->m_NiftiImage->data = const_cast<void *>(buffer);
-    nifti_image_write(this->m_NiftiImage);
-    this->m_NiftiImage->data = nullptr; // if left pointing to data buffer
-    // nifti_image_free will try and free this memory
+    this->WriteNiftiImage(buffer);
   }
   else /// Image intent is vector image
   {
@@ -2258,15 +2401,52 @@ NiftiImageIO ::Write(const void * buffer)
     }
     delete[] vecOrder;
     dumpdata(buffer);
-    // Need a const cast here so that we don't have to copy the memory for
-    // writing.
-    this->m_NiftiImage->data = static_cast<void *>(nifti_buf);
-    nifti_image_write(this->m_NiftiImage);
-    this->m_NiftiImage->data = nullptr; // if left pointing to data buffer
+    this->WriteNiftiImage(nifti_buf);
     delete[] nifti_buf;
   }
 }
 
+void
+NiftiImageIO::WriteNiftiImage(const void * data)
+{
+  nifti_image * nim = this->m_NiftiImage;
+  if (nim->nifti_type == NIFTI_FTYPE_ASCII || !nifti_is_gzfile(nim->iname))
+  {
+    // Need a const cast here so that we don't have to copy the memory
+    // for writing.
+    nim->data = const_cast<void *>(data);
+    nifti_image_write(nim);
+    nim->data = nullptr; // if left pointing to data buffer
+    // nifti_image_free will try and free this memory
+    return;
+  }
+
+  // niftilib writes the header, the extensions and the padding up to the
+  // pixel data as a gzip member of its own. The pixel data is appended as a
+  // second member, compressed in parallel; gzip readers, including niftilib,
+  // read concatenated members as one stream.
+  znzFile file = nifti_image_write_hdr_img(nim, 2, "wb");
+  if (znz_isnull(file))
+  {
+    itkExceptionMacro("Could not write the header of " << this->GetFileName());
+  }
+  znzclose(file);
+
+  DeflateBlockCompressor::Pointer compressor = DeflateBlockCompressor::New();
+  this->ConfigureBlockCompressor(*compressor);
+  compressor->SetFormat(DeflateBlockCompressorEnums::Format::Gzip);
+  compressor->SetStrategy(m_CompressionStrategy);
+  std::vector<char> compressed;
+  compressor->Compress(data, static_cast<SizeType>(nifti_get_volsize(nim)), compressed);
+
+  std::ofstream dataFile(nim->iname, std::ios::out | std::ios::binary | std::ios::app);
+  dataFile.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+  if (!dataFile.is_open() || dataFile.fail())
+  {
+    itkExceptionMacro("Could not write the pixel data of " << this->GetFileName() << " to " << nim->iname);
+  }
+}
+
 /** Define how to print enumerations */
 std::ostream &
 operator<<(std::ostream & out, const Analyze75Flavor value)
@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNiftiImageIO.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+// Streamed reading of subregions from uncompressed and compressed NIfTI
+// files, of scalar and vector images.
+
+namespace
+{
+using ScalarImageType = itk::Image<short, 4>;
+using VectorImageType = itk::VectorImage<float, 3>;
+
+short
+ExpectedValue(const ScalarImageType::IndexType & index)
+{
+  return static_cast<short>(index[0] + 7 * index[1] - 13 * index[2] + 101 * index[3]);
+}
+
+float
+ExpectedValue(const VectorImageType::IndexType & index, unsigned int component)
+{
+  return static_cast<float>(index[0] + 10 * index[1] + 100 * index[2]) + 0.5f * component;
+}
+
+template <typename TImage>
+void
+WriteImage(const TImage * image, const std::string & fileName)
+{
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(itk::NiftiImageIO::New());
+  writer->Update();
+}
+
+// Read the region of the file, and check that only the region was read
+template <typename TImage>
+typename TImage::Pointer
+ReadRegion(const std::string & fileName, const typename TImage::RegionType & region)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::NiftiImageIO::New());
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  typename TImage::Pointer image = reader->GetOutput();
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Buffered region " << image->GetBufferedRegion() << " of " << fileName << " is not the requested region "
+              << region << std::endl;
+    return nullptr;
+  }
+  image->DisconnectPipeline();
+  return image;
+}
+
+bool
+CheckScalarRegion(const std::string & fileName, const ScalarImageType::RegionType & region)
+{
+  ScalarImageType::Pointer image = ReadRegion<ScalarImageType>(fileName, region);
+  if (image.IsNull())
+  {
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ScalarImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue(it.GetIndex()))
+    {
+      std::cerr << "Wrong value " << it.Get() << " at " << it.GetIndex() << " in " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+CheckVectorRegion(const std::string & fileName, const VectorImageType::RegionType & region)
+{
+  VectorImageType::Pointer image = ReadRegion<VectorImageType>(fileName, region);
+  if (image.IsNull())
+  {
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<VectorImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const VectorImageType::PixelType value = it.Get();
+    for (unsigned int c = 0; c < value.GetSize(); ++c)
+    {
+      if (value[c] != ExpectedValue(it.GetIndex(), c))
+      {
+        std::cerr << "Wrong value " << value << " at " << it.GetIndex() << " in " << fileName << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNiftiImageIOStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  itk::NiftiImageIO::Pointer niftiIO = itk::NiftiImageIO::New();
+  ITK_TEST_EXPECT_TRUE(niftiIO->CanStreamRead());
+
+  // A time series of volumes
+  ScalarImageType::SizeType scalarSize = { { 19, 11, 7, 40 } };
+  auto                      scalarImage = ScalarImageType::New();
+  scalarImage->SetRegions(scalarSize);
+  scalarImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ScalarImageType> it(scalarImage, scalarImage->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(ExpectedValue(it.GetIndex()));
+  }
+
+  // A volume of vectors
+  VectorImageType::SizeType vectorSize = { { 13, 9, 6 } };
+  auto                      vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(vectorSize);
+  vectorImage->SetNumberOfComponentsPerPixel(2);
+  vectorImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<VectorImageType> it(vectorImage, vectorImage->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    VectorImageType::PixelType value(2);
+    value[0] = ExpectedValue(it.GetIndex(), 0);
+    value[1] = ExpectedValue(it.GetIndex(), 1);
+    it.Set(value);
+  }
+
+  bool success = true;
+  for (const char * extension : { ".nii", ".nii.gz" })
+  {
+    const std::string scalarFileName = outputDirectory + "/itkNiftiImageIOStreamingTest" + extension;
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteImage(scalarImage.GetPointer(), scalarFileName));
+
+    // One volume of the series
+    ScalarImageType::RegionType volume({ { 0, 0, 0, 23 } }, { { 19, 11, 7, 1 } });
+    success &= CheckScalarRegion(scalarFileName, volume);
+    // The last volume
+    volume.SetIndex(3, 39);
+    success &= CheckScalarRegion(scalarFileName, volume);
+    // A region that is not contiguous in any dimension
+    ScalarImageType::RegionType block({ { 3, 2, 1, 5 } }, { { 8, 5, 4, 30 } });
+    success &= CheckScalarRegion(scalarFileName, block);
+    // The whole series
+    success &= CheckScalarRegion(scalarFileName, scalarImage->GetLargestPossibleRegion());
+
+    const std::string vectorFileName = outputDirectory + "/itkNiftiImageIOStreamingTestVector" + extension;
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteImage(vectorImage.GetPointer(), vectorFileName));
+
+    VectorImageType::RegionType slab({ { 2, 1, 3 } }, { { 10, 7, 2 } });
+    success &= CheckVectorRegion(vectorFileName, slab);
+    success &= CheckVectorRegion(vectorFileName, vectorImage->GetLargestPossibleRegion());
+
+    // Without streaming, the whole image is read
+    auto reader = itk::ImageFileReader<ScalarImageType>::New();
+    reader->SetFileName(scalarFileName);
+    reader->SetImageIO(itk::NiftiImageIO::New());
+    reader->UseStreamingOff();
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(volume);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), scalarImage->GetLargestPossibleRegion());
+  }
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
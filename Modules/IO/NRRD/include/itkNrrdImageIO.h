@@ -21,7 +21,10 @@
 
 
 #include "itkImageIOBase.h"
+#include "itkIndexedGzipFileReader.h"
+#include "itkDeflateBlockCompressor.h"
 #include <fstream>
+#include <memory>
 
 struct NrrdEncoding_t;
 
@@ -36,7 +39,15 @@ namespace itk
  *
  * The compressor supported may include "gzip" (default) and
  * "bzip2".  Only the "gzip" compressor support the compression level
- * in the range 0-9.
+ * in the range 0-9. The "RLE" compressor is gzip with the faster
+ * run-length deflate strategy, which suits label images. Gzip data is
+ * compressed in parallel, in blocks of CompressionBlockSize bytes.
+ *
+ * Regions of raw and gzip encoded data in a single data file can be
+ * streamed. Raw data can be read and written by arbitrary regions, and
+ * pasted into existing files. Gzip encoded data is read through an index of
+ * the compressed stream, and written by slabs in file order, as produced by
+ * the default splitter of ImageFileWriter.
  *
  *  \ingroup IOFilters
  * \ingroup ITKIONRRD
@@ -78,6 +89,37 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Whether regions of the file read by ReadImageInformation() can be
+   * read without reading the whole image. */
+  bool
+  CanStreamRead() override
+  {
+    return !m_PixelDataFileName.empty();
+  }
+
+  /** Whether the file can be written by regions, which depends on the
+   * encoding: raw and gzip encoded data can be streamed. */
+  bool
+  CanStreamWrite() override;
+
+  /** The whole image is read unless streamed reading is enabled and the
+   * file supports it. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
+  /** Verifies that a file to paste into is compatible, and removes an
+   * existing file before streaming into a new one. Compressed files cannot
+   * be pasted into. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Raw encoded data in the header file or in a single detached data
+   * file can be memory mapped. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -110,6 +152,52 @@ protected:
   NrrdToITKComponentType(const int) const;
 
   const NrrdEncoding_t * m_NrrdCompressionEncoding{ nullptr };
+
+  DeflateBlockCompressorEnums::Strategy m_CompressionStrategy{ DeflateBlockCompressorEnums::Strategy::Default };
+
+private:
+  /** The state of a streamed write, kept from one region to the next. */
+  struct StreamedWriteState;
+
+  /** Whether data is written with a compressed encoding. */
+  bool
+  UsesCompressedEncoding() const;
+
+  /** Whether the IORegion is the whole image. */
+  bool
+  IORegionIsWholeImage() const;
+
+  /** Read the IORegion from the data file found by ReadImageInformation(). */
+  void
+  ReadRegion(void * buffer);
+
+  /** Write the IORegion into a file that is written by regions, which is
+   * started anew by the first region when replaceFile is true. */
+  void
+  WriteRegion(const void * buffer, bool replaceFile = false);
+
+  /** Save the image with nrrdSave, or only its header. Returns the name of
+   * the data file, which is the header file unless the header is detached. */
+  std::string
+  SaveNrrd(const void * buffer, bool headerOnly);
+
+  /** Where ReadImageInformation() found pixel data that can be read by
+   * region: a single data file with raw or gzip encoding, in the layout of
+   * the ITK buffer. An empty file name if only Read() of the whole image can
+   * handle the file. */
+  std::string m_PixelDataFileName;
+  /** Offset of the raw data, or of the gzip stream, in the data file. */
+  SizeType m_PixelDataOffset{ 0 };
+  /** Offset of the pixel data in the decompressed stream. */
+  SizeType m_PixelDataDecompressedOffset{ 0 };
+  bool     m_PixelDataCompressed{ false };
+  bool     m_PixelDataInSystemByteOrder{ false };
+
+  /** Reads regions of the pixel data; kept between the streamed reads of
+   * one update, so that they share the index of a compressed file. */
+  IndexedGzipFileReader::Pointer m_PixelDataReader;
+
+  std::unique_ptr<StreamedWriteState> m_StreamedWriteState;
 };
 } // end namespace itk
 
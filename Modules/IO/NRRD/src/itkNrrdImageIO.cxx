@@ -21,12 +21,129 @@
 
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
+#include "itkByteSwapper.h"
 #include "itkFloatingPointExceptions.h"
+#include "itksys/SystemTools.hxx"
+#include <cstring>
 
 namespace itk
 {
 #define KEY_PREFIX "NRRD_"
 
+namespace
+{
+// Calls function(offset, numberOfBytes) for the contiguous runs of bytes
+// that make up the region in the pixel data of the whole image, in file
+// order. The pixel data of the region is the concatenation of the runs.
+template <typename TFunction>
+void
+ForEachPixelDataRun(const ImageIOBase & io, const ImageIORegion & region, TFunction function)
+{
+  using SizeType = ImageIOBase::SizeType;
+
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const unsigned int    numberOfDimensions = io.GetNumberOfDimensions();
+  std::vector<SizeType> index(numberOfDimensions, 0);
+  std::vector<SizeType> size(numberOfDimensions, 1);
+  std::vector<SizeType> strides(numberOfDimensions);
+  for (unsigned int d = 0; d < numberOfDimensions; ++d)
+  {
+    if (d < region.GetImageDimension())
+    {
+      index[d] = region.GetIndex(d);
+      size[d] = region.GetSize(d);
+    }
+    strides[d] = (d == 0) ? static_cast<SizeType>(io.GetComponentSize() * io.GetNumberOfComponents())
+                          : strides[d - 1] * io.GetDimensions(d - 1);
+  }
+
+  // Leading dimensions that are covered in full form a single run together
+  // with the first one that is not.
+  SizeType     runBytes = size[0] * strides[0];
+  unsigned int firstOuter = 1;
+  while (firstOuter < numberOfDimensions &&
+         size[firstOuter - 1] == static_cast<SizeType>(io.GetDimensions(firstOuter - 1)))
+  {
+    runBytes *= size[firstOuter];
+    ++firstOuter;
+  }
+
+  std::vector<SizeType> position(index);
+  unsigned int          d;
+  do
+  {
+    SizeType offset = 0;
+    for (d = 0; d < numberOfDimensions; ++d)
+    {
+      offset += position[d] * strides[d];
+    }
+    function(offset, runBytes);
+
+    for (d = firstOuter; d < numberOfDimensions; ++d)
+    {
+      if (++position[d] < index[d] + size[d])
+      {
+        break;
+      }
+      position[d] = index[d];
+    }
+  } while (d < numberOfDimensions);
+}
+
+template <typename T>
+void
+SwapRange(void * buffer, ImageIOBase::SizeType numberOfComponents, IOByteOrderEnum byteOrder)
+{
+  if (byteOrder == IOByteOrderEnum::BigEndian)
+  {
+    ByteSwapper<T>::SwapRangeFromSystemToBigEndian(static_cast<T *>(buffer), numberOfComponents);
+  }
+  else if (byteOrder == IOByteOrderEnum::LittleEndian)
+  {
+    ByteSwapper<T>::SwapRangeFromSystemToLittleEndian(static_cast<T *>(buffer), numberOfComponents);
+  }
+}
+
+// Converts components between the byte order of a file and that of the
+// system, in place
+void
+SwapBytes(void *                buffer,
+          unsigned int          componentSize,
+          ImageIOBase::SizeType numberOfComponents,
+          IOByteOrderEnum       byteOrder)
+{
+  switch (componentSize)
+  {
+    case 2:
+      SwapRange<uint16_t>(buffer, numberOfComponents, byteOrder);
+      break;
+    case 4:
+      SwapRange<uint32_t>(buffer, numberOfComponents, byteOrder);
+      break;
+    case 8:
+      SwapRange<uint64_t>(buffer, numberOfComponents, byteOrder);
+      break;
+    default:
+      break;
+  }
+}
+} // namespace
+
+struct NrrdImageIO::StreamedWriteState
+{
+  std::string     m_DataFileName;
+  SizeType        m_DataOffset{ 0 };
+  IOByteOrderEnum m_ByteOrder{ IOByteOrderEnum::OrderNotApplicable };
+  // Whether the data is gzip compressed, and the number of uncompressed
+  // bytes written so far
+  bool     m_Compressed{ false };
+  SizeType m_BytesWritten{ 0 };
+};
+
 NrrdImageIO::NrrdImageIO()
 {
   this->SetNumberOfDimensions(3);
@@ -63,16 +180,22 @@ void
 NrrdImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "CompressionStrategy: " << m_CompressionStrategy << std::endl;
 }
 
 void
 NrrdImageIO::InternalSetCompressor(const std::string & _compressor)
 {
   this->m_NrrdCompressionEncoding = nullptr;
+  this->m_CompressionStrategy = DeflateBlockCompressorEnums::Strategy::Default;
 
-  // set default to gzip
-  if (_compressor.empty())
+  // set default to gzip; RLE is gzip with the run-length deflate strategy
+  if (_compressor.empty() || _compressor == "RLE")
   {
+    if (_compressor == "RLE")
+    {
+      this->m_CompressionStrategy = DeflateBlockCompressorEnums::Strategy::RunLength;
+    }
     if (nrrdEncodingGzip->available())
     {
       this->m_NrrdCompressionEncoding = nrrdEncodingGzip;
@@ -278,6 +401,11 @@ NrrdImageIO::ReadImageInformation()
     // this is the mechanism by which we tell nrrdLoad to read
     // just the header, and none of the data
     nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+    // a single data file is then left open at the first pixel, which
+    // tells where the data could be memory mapped
+    nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+    m_PixelDataFileName.clear();
+    m_PixelDataReader = nullptr;
     if (nrrdLoad(nrrd, this->GetFileName(), nio) != 0)
     {
       char * err = biffGetDone(NRRD);
@@ -298,6 +426,32 @@ NrrdImageIO::ReadImageInformation()
       FloatingPointExceptions::SetEnabled(saveFPEState);
     }
 
+    if (nio->dataFile)
+    {
+      // the file is left after any skipped lines, and for raw data after
+      // any skipped bytes; gzip encoded data skips bytes after
+      // decompression, and the negative skips from the end of the data
+      // cannot be streamed
+      const long dataPosition = ftell(nio->dataFile);
+      const bool gzip = nio->encoding == nrrdEncodingGzip && nio->byteSkip >= 0;
+      if ((nio->encoding == nrrdEncodingRaw || gzip) && dataPosition >= 0)
+      {
+        if (nio->dataFNArr->len == 0)
+        {
+          m_PixelDataFileName = this->GetFileName();
+        }
+        else
+        {
+          // detached data file names are relative to the header
+          const std::string dataFileName = nio->dataFN[0];
+          m_PixelDataFileName = itksys::SystemTools::CollapseFullPath(dataFileName, nio->path ? nio->path : "");
+        }
+        m_PixelDataOffset = dataPosition;
+        m_PixelDataCompressed = gzip;
+        m_PixelDataDecompressedOffset = gzip ? nio->byteSkip : 0;
+      }
+      nio->dataFile = airFclose(nio->dataFile);
+    }
 
     if (nrrdTypeBlock == nrrd->type)
     {
@@ -444,6 +598,15 @@ NrrdImageIO::ReadImageInformation()
                                                           << " dependent axis (not 1); not currently handled");
     }
 
+    // the data cannot be read by region when Read() has to permute the axes
+    // or crop out a tensor mask
+    if (1 == rangeAxisNum &&
+        (0 != rangeAxisIdx[0] || nrrdKind3DMaskedSymMatrix == nrrd->axis[rangeAxisIdx[0]].kind))
+    {
+      m_PixelDataFileName.clear();
+    }
+    m_PixelDataInSystemByteOrder = nrrdElementSize(nrrd) == 1 || nio->endian == airMyEndian();
+
     double              spacing;
     double              spaceDir[NRRD_SPACE_DIM_MAX];
     std::vector<double> spaceDirStd(domainAxisNum);
@@ -712,6 +875,12 @@ NrrdImageIO::ReadImageInformation()
 void
 NrrdImageIO::Read(void * buffer)
 {
+  if (!this->IORegionIsWholeImage())
+  {
+    this->ReadRegion(buffer);
+    return;
+  }
+
   Nrrd * nrrd = nrrdNew();
   bool   nrrdAllocated;
 
@@ -847,6 +1016,69 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::IORegionIsWholeImage() const
+{
+  return static_cast<ImageIOBase::SizeType>(this->GetIORegion().GetNumberOfPixels()) == this->GetImageSizeInPixels();
+}
+
+void
+NrrdImageIO::ReadRegion(void * buffer)
+{
+  if (m_PixelDataFileName.empty())
+  {
+    itkExceptionMacro("Read: Cannot read a region of "
+                      << this->GetFileName() << "; its encoding or layout only allows reading the whole image");
+  }
+
+  try
+  {
+    if (m_PixelDataReader.IsNull())
+    {
+      m_PixelDataReader = IndexedGzipFileReader::New();
+      m_PixelDataReader->Open(m_PixelDataFileName, m_PixelDataCompressed, m_PixelDataOffset);
+    }
+    auto * out = static_cast<char *>(buffer);
+    ForEachPixelDataRun(*this, this->GetIORegion(), [this, &out](SizeType offset, SizeType runBytes) {
+      m_PixelDataReader->Read(out, m_PixelDataDecompressedOffset + offset, runBytes);
+      out += runBytes;
+    });
+  }
+  catch (...)
+  {
+    m_PixelDataReader = nullptr;
+    throw;
+  }
+
+  if (!m_PixelDataInSystemByteOrder)
+  {
+    const SizeType numberOfComponents = this->GetIORegion().GetNumberOfPixels() * this->GetNumberOfComponents();
+    SwapBytes(buffer, this->GetComponentSize(), numberOfComponents, this->GetByteOrder());
+  }
+}
+
+ImageIORegion
+NrrdImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!m_UseStreamedReading || m_PixelDataFileName.empty())
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
+}
+
+bool
+NrrdImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (m_PixelDataFileName.empty() || m_PixelDataCompressed || !m_PixelDataInSystemByteOrder)
+  {
+    return false;
+  }
+  fileName = m_PixelDataFileName;
+  offset = m_PixelDataOffset;
+  return true;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
@@ -866,8 +1098,266 @@ NrrdImageIO::WriteImageInformation()
   // Nothing needs doing here.
 }
 
+bool
+NrrdImageIO::UsesCompressedEncoding() const
+{
+  return this->GetUseCompression() && m_NrrdCompressionEncoding != nullptr && m_NrrdCompressionEncoding->available();
+}
+
+bool
+NrrdImageIO::CanStreamWrite()
+{
+  if (this->UsesCompressedEncoding())
+  {
+    return m_NrrdCompressionEncoding == nrrdEncodingGzip;
+  }
+  return this->GetFileType() != IOFileEnum::ASCII;
+}
+
+unsigned int
+NrrdImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // a new write starts
+  m_StreamedWriteState.reset();
+
+  if (!this->CanStreamWrite())
+  {
+    return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  }
+
+  const bool fileExists = itksys::SystemTools::FileExists(this->GetFileName());
+  if (pasteRegion != largestPossibleRegion)
+  {
+    if (this->UsesCompressedEncoding())
+    {
+      itkExceptionMacro("Pasting and compression is not supported! Can't write:" << this->GetFileName());
+    }
+    if (fileExists)
+    {
+      // the pixel data of the existing file must have the layout of the image
+      std::string errorMessage;
+      Pointer     headerImageIOReader = Self::New();
+      try
+      {
+        headerImageIOReader->SetFileName(this->GetFileName());
+        headerImageIOReader->ReadImageInformation();
+      }
+      catch (...)
+      {
+        errorMessage = "Unable to read information from file: " + std::string(this->GetFileName());
+      }
+
+      if (!errorMessage.empty())
+      {
+        // Can't read file
+      }
+      else if (!headerImageIOReader->CanStreamRead() || headerImageIOReader->m_PixelDataCompressed)
+      {
+        errorMessage = "Pixel data is not raw encoded in a single data file: " + std::string(this->GetFileName());
+      }
+      else if (headerImageIOReader->GetNumberOfComponents() != this->GetNumberOfComponents() ||
+               headerImageIOReader->GetComponentType() != this->GetComponentType())
+      {
+        errorMessage = "Component type does not match in file: " + std::string(this->GetFileName());
+      }
+      else if (headerImageIOReader->GetNumberOfDimensions() != this->GetNumberOfDimensions())
+      {
+        errorMessage = "Dimensions does not match in file: " + std::string(this->GetFileName());
+      }
+      else
+      {
+        for (unsigned int i = 0; i < this->GetNumberOfDimensions(); ++i)
+        {
+          if (headerImageIOReader->GetDimensions(i) != this->GetDimensions(i))
+          {
+            errorMessage = "Size does not match in file: " + std::string(this->GetFileName());
+            break;
+          }
+        }
+      }
+
+      if (!errorMessage.empty())
+      {
+        itkExceptionMacro("Unable to paste because pasting file exists and is different. " << errorMessage);
+      }
+    }
+  }
+  else if (numberOfRequestedSplits != 1 && fileExists)
+  {
+    // the first region writes a new header
+    if (!itksys::SystemTools::RemoveFile(this->GetFileName()))
+    {
+      itkExceptionMacro("Unable to remove file for streaming: " << this->GetFileName());
+    }
+  }
+
+  return this->GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+}
+
+void
+NrrdImageIO::WriteRegion(const void * buffer, bool replaceFile)
+{
+  if (!this->CanStreamWrite())
+  {
+    itkExceptionMacro("Write: Only raw and gzip encoded data can be written by region: " << this->GetFileName());
+  }
+
+  if (!m_StreamedWriteState)
+  {
+    std::unique_ptr<StreamedWriteState> state(new StreamedWriteState);
+    if (replaceFile || !itksys::SystemTools::FileExists(this->GetFileName()))
+    {
+      // A new file: write the header, then allocate the raw data, or start
+      // the compressed data
+      state->m_DataFileName = this->SaveNrrd(buffer, true);
+      state->m_ByteOrder = this->GetByteOrder();
+      const bool attached = state->m_DataFileName == this->GetFileName();
+      if (attached)
+      {
+        state->m_DataOffset = static_cast<SizeType>(itksys::SystemTools::FileLength(this->GetFileName()));
+      }
+
+      if (this->UsesCompressedEncoding())
+      {
+        state->m_Compressed = true;
+        if (!attached)
+        {
+          std::ofstream file;
+          this->OpenFileForWriting(file, state->m_DataFileName, true);
+        }
+      }
+      else
+      {
+        // write one byte at the end of the data to allocate the file, which
+        // is sparse if the system supports it
+        std::ofstream file;
+        this->OpenFileForWriting(file, state->m_DataFileName, !attached);
+        file.seekp(static_cast<std::streamoff>(state->m_DataOffset + this->GetImageSizeInBytes() - 1), std::ios::beg);
+        file.write("\0", 1);
+      }
+    }
+    else
+    {
+      // Pasting into the existing file
+      if (this->UsesCompressedEncoding())
+      {
+        itkExceptionMacro("Pasting and compression is not supported! Can't write:" << this->GetFileName());
+      }
+      Pointer headerImageIOReader = Self::New();
+      headerImageIOReader->SetFileName(this->GetFileName());
+      headerImageIOReader->ReadImageInformation();
+      if (!headerImageIOReader->CanStreamRead() || headerImageIOReader->m_PixelDataCompressed)
+      {
+        itkExceptionMacro("Unable to paste because pixel data is not raw encoded in a single data file: "
+                          << this->GetFileName());
+      }
+      state->m_DataFileName = headerImageIOReader->m_PixelDataFileName;
+      state->m_DataOffset = headerImageIOReader->m_PixelDataOffset;
+      state->m_ByteOrder = headerImageIOReader->GetByteOrder();
+    }
+    m_StreamedWriteState = std::move(state);
+  }
+  StreamedWriteState & state = *m_StreamedWriteState;
+
+  const SizeType numberOfComponents = this->GetIORegion().GetNumberOfPixels() * this->GetNumberOfComponents();
+  const SizeType numberOfBytes = numberOfComponents * this->GetComponentSize();
+
+  // the pixels in the byte order of the file
+  const char *      data = static_cast<const char *>(buffer);
+  std::vector<char> swapped;
+  const bool        systemIsBigEndian = ByteSwapper<uint16_t>::SystemIsBigEndian();
+  if (this->GetComponentSize() > 1 && ((state.m_ByteOrder == IOByteOrderEnum::BigEndian && !systemIsBigEndian) ||
+                                       (state.m_ByteOrder == IOByteOrderEnum::LittleEndian && systemIsBigEndian)))
+  {
+    swapped.assign(data, data + numberOfBytes);
+    SwapBytes(swapped.data(), this->GetComponentSize(), numberOfComponents, state.m_ByteOrder);
+    data = swapped.data();
+  }
+
+  if (state.m_Compressed)
+  {
+    // the compressed data is written in file order, by regions that are
+    // contiguous in the file, like the slabs of the default splitter. Each
+    // region is appended as a gzip member, compressed in parallel; gzip
+    // readers, including NrrdIO, read concatenated members as one stream.
+    SizeType     regionOffset = 0;
+    unsigned int numberOfRuns = 0;
+    ForEachPixelDataRun(*this, this->GetIORegion(), [&regionOffset, &numberOfRuns](SizeType offset, SizeType) {
+      if (numberOfRuns++ == 0)
+      {
+        regionOffset = offset;
+      }
+    });
+    if (numberOfRuns != 1 || regionOffset != state.m_BytesWritten)
+    {
+      m_StreamedWriteState.reset();
+      itkExceptionMacro(
+        "Write: Compressed data must be written by consecutive regions that are contiguous in the file: "
+        << this->GetFileName());
+    }
+
+    DeflateBlockCompressor::Pointer compressor = DeflateBlockCompressor::New();
+    this->ConfigureBlockCompressor(*compressor);
+    compressor->SetFormat(DeflateBlockCompressorEnums::Format::Gzip);
+    compressor->SetStrategy(m_CompressionStrategy);
+    std::vector<char> compressed;
+    compressor->Compress(data, numberOfBytes, compressed);
+
+    std::ofstream file(state.m_DataFileName.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+    file.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    if (!file.is_open() || file.fail())
+    {
+      m_StreamedWriteState.reset();
+      itkExceptionMacro("Write: Error writing compressed data to " << state.m_DataFileName);
+    }
+    state.m_BytesWritten += numberOfBytes;
+
+    if (state.m_BytesWritten == static_cast<SizeType>(this->GetImageSizeInBytes()))
+    {
+      m_StreamedWriteState.reset();
+    }
+  }
+  else
+  {
+    std::ofstream file;
+    this->OpenFileForWriting(file, state.m_DataFileName, false);
+    const SizeType dataOffset = state.m_DataOffset;
+    ForEachPixelDataRun(
+      *this, this->GetIORegion(), [&file, &data, dataOffset](SizeType offset, SizeType runBytes) {
+        file.seekp(static_cast<std::streamoff>(dataOffset + offset), std::ios::beg);
+        file.write(data, static_cast<std::streamsize>(runBytes));
+        data += runBytes;
+      });
+    if (file.fail())
+    {
+      itkExceptionMacro("Write: Error writing " << state.m_DataFileName);
+    }
+  }
+}
+
 void
 NrrdImageIO::Write(const void * buffer)
+{
+  if (!this->IORegionIsWholeImage())
+  {
+    this->WriteRegion(buffer);
+    return;
+  }
+  m_StreamedWriteState.reset();
+
+  if (this->CanStreamWrite() && this->UsesCompressedEncoding())
+  {
+    // gzip data is compressed in parallel, as a single region
+    this->WriteRegion(buffer, true);
+    return;
+  }
+  this->SaveNrrd(buffer, false);
+}
+
+std::string
+NrrdImageIO::SaveNrrd(const void * buffer, bool headerOnly)
 {
   Nrrd *        nrrd = nrrdNew();
   NrrdIoState * nio = nrrdIoStateNew();
@@ -1109,6 +1599,24 @@ NrrdImageIO::Write(const void * buffer)
       break;
   }
 
+  // NrrdIO writes the data as it is in memory, so data that is to be stored
+  // in the other byte order is swapped in a copy
+  std::unique_ptr<char[]> swappedData;
+  if (!headerOnly && nio->endian != airEndianUnknown && nio->endian != airMyEndian() &&
+      nio->encoding->endianMatters && this->GetComponentSize() > 1)
+  {
+    const SizeType numberOfBytes = this->GetImageSizeInBytes();
+    swappedData.reset(new char[numberOfBytes]);
+    std::memcpy(swappedData.get(), buffer, numberOfBytes);
+    SwapBytes(swappedData.get(), this->GetComponentSize(), this->GetImageSizeInComponents(), byteOrder);
+    nrrd->data = swappedData.get();
+  }
+
+  if (headerOnly)
+  {
+    nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  }
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
   {
@@ -1116,9 +1624,18 @@ NrrdImageIO::Write(const void * buffer)
     itkExceptionMacro("Write: Error writing " << this->GetFileName() << ":\n" << err);
   }
 
+  std::string dataFileName = this->GetFileName();
+  if (nio->detachedHeader && nio->dataFNArr->len == 1)
+  {
+    // detached data file names are relative to the header
+    dataFileName = itksys::SystemTools::CollapseFullPath(nio->dataFN[0], nio->path ? nio->path : "");
+  }
+
   // Free the nrrd struct but don't touch nrrd->data
   nrrdNix(nrrd);
   nrrdIoStateNix(nio);
+
+  return dataFileName;
 }
 
 } // end namespace itk
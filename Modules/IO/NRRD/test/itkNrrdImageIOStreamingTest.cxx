@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNrrdImageIO.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+// Streamed reading and writing of raw or gzip encoded NRRD files, with a
+// byte order that is not that of the system on little endian systems.
+
+namespace
+{
+using ImageType = itk::VectorImage<short, 3>;
+using ReaderType = itk::ImageFileReader<ImageType>;
+using WriterType = itk::ImageFileWriter<ImageType>;
+using MonitorType = itk::PipelineMonitorImageFilter<ImageType>;
+
+short
+ExpectedValue(const ImageType::IndexType & index, unsigned int component, short sign)
+{
+  return static_cast<short>(sign * (index[0] + 30 * index[1] + 600 * index[2] + 7 * component + 1));
+}
+
+itk::NrrdImageIO::Pointer
+CreateImageIO(bool useCompression)
+{
+  itk::NrrdImageIO::Pointer imageIO = itk::NrrdImageIO::New();
+  imageIO->SetByteOrderToBigEndian();
+  imageIO->SetUseCompression(useCompression);
+  return imageIO;
+}
+
+// Check the values of the region of the image, which were written with the
+// given sign
+bool
+CheckRegion(const ImageType * image, const ImageType::RegionType & region, short sign)
+{
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::PixelType value = it.Get();
+    for (unsigned int c = 0; c < value.GetSize(); ++c)
+    {
+      if (value[c] != ExpectedValue(it.GetIndex(), c, sign))
+      {
+        std::cerr << "Wrong value " << value << " at " << it.GetIndex() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNrrdImageIOStreamingTest(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " wholeFile streamedFile useCompression"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string wholeFileName = argv[1];
+  const std::string streamedFileName = argv[2];
+  const bool        useCompression = std::stoi(argv[3]) != 0;
+
+  ImageType::SizeType size = { { 23, 17, 12 } };
+  auto                image = ImageType::New();
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(2);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ImageType::PixelType value(2);
+    value[0] = ExpectedValue(it.GetIndex(), 0, 1);
+    value[1] = ExpectedValue(it.GetIndex(), 1, 1);
+    it.Set(value);
+  }
+
+  // Write the whole image at once
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(wholeFileName);
+  writer->SetImageIO(CreateImageIO(useCompression));
+  writer->SetUseCompression(useCompression);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // Stream it into another file, reading and writing by regions
+  auto reader = ReaderType::New();
+  reader->SetFileName(wholeFileName);
+  reader->SetImageIO(itk::NrrdImageIO::New());
+  auto readerMonitor = MonitorType::New();
+  readerMonitor->SetInput(reader->GetOutput());
+  auto streamedWriter = WriterType::New();
+  streamedWriter->SetInput(readerMonitor->GetOutput());
+  streamedWriter->SetFileName(streamedFileName);
+  streamedWriter->SetImageIO(CreateImageIO(useCompression));
+  streamedWriter->SetUseCompression(useCompression);
+  streamedWriter->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedWriter->Update());
+  ITK_TEST_EXPECT_TRUE(readerMonitor->VerifyAllInputCanStream(4));
+
+  // Read the streamed file at once, which is done by nrrdLoad
+  reader = ReaderType::New();
+  reader->SetFileName(streamedFileName);
+  reader->SetImageIO(itk::NrrdImageIO::New());
+  reader->UseStreamingOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_TRUE(CheckRegion(reader->GetOutput(), image->GetLargestPossibleRegion(), 1));
+
+  // Read the streamed file by regions, sharing the index of compressed data
+  reader = ReaderType::New();
+  reader->SetFileName(streamedFileName);
+  reader->SetImageIO(itk::NrrdImageIO::New());
+  readerMonitor = MonitorType::New();
+  readerMonitor->SetInput(reader->GetOutput());
+  using StreamingFilterType = itk::StreamingImageFilter<ImageType, ImageType>;
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(readerMonitor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(6);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+  ITK_TEST_EXPECT_TRUE(readerMonitor->VerifyAllInputCanStream(6));
+  ITK_TEST_EXPECT_TRUE(CheckRegion(streamer->GetOutput(), image->GetLargestPossibleRegion(), 1));
+
+  // A region that is not contiguous in the file
+  const ImageType::RegionType block({ { 3, 4, 5 } }, { { 11, 6, 4 } });
+  reader = ReaderType::New();
+  reader->SetFileName(streamedFileName);
+  reader->SetImageIO(itk::NrrdImageIO::New());
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(block);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), block);
+  ITK_TEST_EXPECT_TRUE(CheckRegion(reader->GetOutput(), block, 1));
+
+  // Paste a block of negated values into the streamed file, which is only
+  // supported for raw data. The values are read from a file, as the writer
+  // does not paste an input that is already buffered.
+  auto negated = ImageType::New();
+  negated->SetRegions(size);
+  negated->SetNumberOfComponentsPerPixel(2);
+  negated->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(negated, negated->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ImageType::PixelType value(2);
+    value[0] = ExpectedValue(it.GetIndex(), 0, -1);
+    value[1] = ExpectedValue(it.GetIndex(), 1, -1);
+    it.Set(value);
+  }
+  writer->SetInput(negated);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  reader = ReaderType::New();
+  reader->SetFileName(wholeFileName);
+  reader->SetImageIO(itk::NrrdImageIO::New());
+
+  itk::ImageIORegion pasteRegion(3);
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    pasteRegion.SetIndex(d, block.GetIndex(d));
+    pasteRegion.SetSize(d, block.GetSize(d));
+  }
+  auto pasteWriter = WriterType::New();
+  pasteWriter->SetInput(reader->GetOutput());
+  pasteWriter->SetFileName(streamedFileName);
+  pasteWriter->SetImageIO(CreateImageIO(useCompression));
+  pasteWriter->SetUseCompression(useCompression);
+  pasteWriter->SetIORegion(pasteRegion);
+  if (useCompression)
+  {
+    ITK_TRY_EXPECT_EXCEPTION(pasteWriter->Update());
+  }
+  else
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(pasteWriter->Update());
+
+    reader = ReaderType::New();
+    reader->SetFileName(streamedFileName);
+  reader->SetImageIO(itk::NrrdImageIO::New());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_TRUE(CheckRegion(reader->GetOutput(), block, -1));
+    ImageType::RegionType below = image->GetLargestPossibleRegion();
+    below.SetSize(2, block.GetIndex(2));
+    ITK_TEST_EXPECT_TRUE(CheckRegion(reader->GetOutput(), below, 1));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
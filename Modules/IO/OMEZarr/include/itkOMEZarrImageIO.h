@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkOMEZarrImageIO_h
+#define itkOMEZarrImageIO_h
+#include "ITKIOOMEZarrExport.h"
+
+#include "itkImageIOBase.h"
+#include <memory>
+
+namespace itk
+{
+class OMEZarrArray;
+
+/**
+ *\class OMEZarrImageIO
+ *
+ * \brief Read and write multiscale images stored as OME-Zarr.
+ *
+ * An OME-Zarr store is a directory, named with the extension .zarr, that
+ * holds a Zarr version 2 group whose attributes describe, following the
+ * version 0.4 of the OME-NGFF specification, a pyramid of resolution
+ * levels. Each level is a chunked Zarr array, stored in the subdirectory
+ * named after the level, 0 for the full resolution, with one file per
+ * chunk:
+ *
+ * \li \<store\>\/.zgroup         the Zarr group
+ * \li \<store\>\/.zattrs         the "multiscales" attributes: the axes, and
+ *                               the path, scale and translation of each level
+ * \li \<store\>\/\<level\>\/.zarray  the shape, chunks, data type and compressor
+ * \li \<store\>\/\<level\>\/\<i\>\/\<j\>\/... the chunks, in C order
+ *
+ * The image dimensions map to the axes x, y, z and t, slowest moving axis
+ * first in the store, and the pixel components, if several, to a channel
+ * axis "c" that precedes the spatial axes. The spacing and the origin are
+ * stored as the scale and the translation of the levels; the direction is
+ * not stored and is read as the identity.
+ *
+ * SetResolutionLevel() selects the level read. When writing,
+ * NumberOfResolutionLevels levels are written, each level after the first
+ * halving the size of the previous one along the spatial dimensions larger
+ * than one pixel, by averaging blocks of 2 pixels along them.
+ *
+ * Chunks are decompressed when reading, and compressed when writing, in
+ * parallel. Regions are streamed along the boundaries of the chunks: read
+ * regions are enlarged to whole chunks, and written pieces are made of
+ * whole chunks of every level. Chunks are compressed with zlib when
+ * compression is enabled; stores whose arrays are compressed with zlib or
+ * gzip, or not compressed, can be read, but not those compressed with
+ * other codecs, such as Blosc.
+ *
+ * \ingroup IOFilters
+ *
+ * \ingroup ITKIOOMEZarr
+ */
+class ITKIOOMEZarr_EXPORT OMEZarrImageIO : public ImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OMEZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = OMEZarrImageIO;
+  using Superclass = ImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(OMEZarrImageIO, ImageIOBase);
+
+  /*-------- This part of the interfaces deals with reading data. ----- */
+
+  /** Determine if the file can be read with this ImageIO implementation.
+   * \param FileNameToRead The name of the store directory to test for reading.
+   * \return Returns true if this ImageIO can read the file specified.
+   */
+  bool
+  CanReadFile(const char * FileNameToRead) override;
+
+  /** Set the spacing and dimension information for the selected
+   * resolution level. */
+  void
+  ReadImageInformation() override;
+
+  /** Reads the data from disk into the memory buffer provided. */
+  void
+  Read(void * buffer) override;
+
+  /** Enlarges the requested region to the boundaries of the chunks of the
+   * resolution level read, when streaming. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
+  bool
+  CanStreamRead() override
+  {
+    return true;
+  }
+
+  /*-------- This part of the interfaces deals with writing data. ----- */
+
+  /** Determine if the file can be written with this ImageIO implementation.
+   * \param FileNameToWrite The name of the store directory to test for writing.
+   * \return Returns true if this ImageIO can write the file specified.
+   */
+  bool
+  CanWriteFile(const char * FileNameToWrite) override;
+
+  /** Create the store and write the metadata of its resolution levels,
+   * replacing those already in the store. */
+  void
+  WriteImageInformation() override;
+
+  /** Writes the data to disk from the memory buffer provided, and the
+   * corresponding region of the lower resolution levels. */
+  void
+  Write(const void * buffer) override;
+
+  bool
+  CanStreamWrite() override
+  {
+    return true;
+  }
+
+  /** The pieces written are made of whole chunks of every resolution level,
+   * split along the slowest moving dimension that spans several of them.
+   * Pasting is supported in stores of a single resolution level. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the resolution level read, 0, the default, being the full
+   * resolution. */
+  itkSetMacro(ResolutionLevel, unsigned int);
+  itkGetConstMacro(ResolutionLevel, unsigned int);
+
+  /** Set/Get the number of resolution levels written, 1 by default.
+   * ReadImageInformation() sets it to the number of levels of the store. */
+  itkSetClampMacro(NumberOfResolutionLevels, unsigned int, 1, 32);
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
+  /** Set/Get the size of the chunks of the written arrays, in pixels,
+   * fastest moving dimension first. The chunks are at most the size of each
+   * level, and hold all the components of the pixels. By default, empty,
+   * chunks are 64 pixels wide along each dimension of images of 3
+   * dimensions or more, and 256 pixels for images of 1 or 2 dimensions. */
+  void
+  SetChunkSize(const ImageIORegion::SizeType & chunkSize)
+  {
+    if (this->m_ChunkSize != chunkSize)
+    {
+      this->m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  itkGetConstReferenceMacro(ChunkSize, ImageIORegion::SizeType);
+
+protected:
+  OMEZarrImageIO();
+  ~OMEZarrImageIO() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Path of the store, without trailing separator. */
+  std::string
+  GetStorePath() const;
+
+  /** Size of the chunks written, clamped to the image. */
+  ImageIORegion::SizeType
+  GetChunkSizeForWriting() const;
+
+  unsigned int                  m_ResolutionLevel{ 0 };
+  unsigned int                  m_NumberOfResolutionLevels{ 1 };
+  ImageIORegion::SizeType       m_ChunkSize;
+  ImageIORegion::SizeType       m_WrittenChunkSize;
+  int                           m_ChannelAxis{ -1 };
+  bool                          m_MetadataWritten{ false };
+  std::unique_ptr<OMEZarrArray> m_Array;
+};
+
+} // end namespace itk
+
+#endif // itkOMEZarrImageIO_h
@@ -0,0 +1,18 @@
+set(DOCUMENTATION "This module contains ImageIO classes for reading and
+writing chunked, multiscale images stored in directories in the OME-Zarr
+format, version 0.4, over Zarr version 2 arrays.
+https://ngff.openmicroscopy.org/0.4/")
+
+itk_module(ITKIOOMEZarr
+  ENABLE_SHARED
+  DEPENDS
+    ITKIOImageBase
+  PRIVATE_DEPENDS
+    ITKZLIB
+  TEST_DEPENDS
+    ITKTestKernel
+  FACTORY_NAMES
+    ImageIO::OMEZarr
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
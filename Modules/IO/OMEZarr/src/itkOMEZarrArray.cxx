@@ -0,0 +1,449 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkOMEZarrArray.h"
+#include "itkOMEZarrJSON.h"
+#include "itkByteSwapper.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_zlib.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+template <typename T>
+void
+FillChunk(std::vector<char> & chunk, SizeValueType numberOfElements, double value)
+{
+  chunk.resize(numberOfElements * sizeof(T));
+  // NaN and infinite fill values are only meaningful for floating point
+  // arrays
+  const T element = std::isfinite(value) || !std::numeric_limits<T>::is_integer ? static_cast<T>(value) : T{};
+  std::fill_n(reinterpret_cast<T *>(chunk.data()), numberOfElements, element);
+}
+
+// Swaps the elements between the byte order of the system and the one of
+// the array, in place. The swap is its own inverse, so that it converts
+// both ways.
+template <typename TWord>
+void
+SwapChunkBytes(char * data, size_t numberOfBytes, bool bigEndian)
+{
+  auto * const words = reinterpret_cast<TWord *>(data);
+  const size_t numberOfWords = numberOfBytes / sizeof(TWord);
+  if (bigEndian)
+  {
+    ByteSwapper<TWord>::SwapRangeFromSystemToBigEndian(words, numberOfWords);
+  }
+  else
+  {
+    ByteSwapper<TWord>::SwapRangeFromSystemToLittleEndian(words, numberOfWords);
+  }
+}
+
+void
+SwapChunkBytes(char * data, size_t numberOfBytes, unsigned int elementSize, bool bigEndian)
+{
+  switch (elementSize)
+  {
+    case 2:
+      SwapChunkBytes<uint16_t>(data, numberOfBytes, bigEndian);
+      break;
+    case 4:
+      SwapChunkBytes<uint32_t>(data, numberOfBytes, bigEndian);
+      break;
+    case 8:
+      SwapChunkBytes<uint64_t>(data, numberOfBytes, bigEndian);
+      break;
+    default:
+      // single bytes have no byte order
+      break;
+  }
+}
+
+double
+GetFillValue(const OMEZarrJSONValue * value)
+{
+  if (value == nullptr || value->IsNull())
+  {
+    return 0.0;
+  }
+  if (value->GetType() == OMEZarrJSONValue::Type::String)
+  {
+    if (value->GetString() == "NaN")
+    {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (value->GetString() == "Infinity")
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    if (value->GetString() == "-Infinity")
+    {
+      return -std::numeric_limits<double>::infinity();
+    }
+  }
+  if (value->GetType() == OMEZarrJSONValue::Type::Boolean)
+  {
+    return value->GetBoolean() ? 1.0 : 0.0;
+  }
+  return value->GetNumber();
+}
+
+OMEZarrArray::ShapeType
+GetShape(const OMEZarrJSONValue & metadata, const char * key)
+{
+  const OMEZarrJSONValue * value = metadata.Find(key);
+  if (value == nullptr)
+  {
+    itkGenericExceptionMacro(<< "Missing " << key);
+  }
+  OMEZarrArray::ShapeType shape;
+  for (const auto & element : value->GetElements())
+  {
+    shape.push_back(static_cast<SizeValueType>(element.GetNumber()));
+  }
+  return shape;
+}
+} // namespace
+
+void
+OMEZarrArray::ReadMetadata(const std::string & path)
+{
+  m_Path = path;
+  const std::string        fileName = path + "/.zarray";
+  const OMEZarrJSONValue   metadata = OMEZarrJSONValue::ReadFile(fileName);
+  const OMEZarrJSONValue * format = metadata.Find("zarr_format");
+  if (format == nullptr || format->GetType() != OMEZarrJSONValue::Type::Number || format->GetNumber() != 2)
+  {
+    itkGenericExceptionMacro(<< fileName << " is not the metadata of a Zarr version 2 array.");
+  }
+
+  try
+  {
+    m_Shape = GetShape(metadata, "shape");
+    m_Chunks = GetShape(metadata, "chunks");
+    if (m_Shape.empty() || m_Chunks.size() != m_Shape.size() ||
+        std::find(m_Chunks.begin(), m_Chunks.end(), 0) != m_Chunks.end())
+    {
+      itkGenericExceptionMacro(<< "Invalid shape or chunks");
+    }
+
+    // the data type, such as "<u2", is made of the byte order, the kind
+    // and the size of the elements
+    const OMEZarrJSONValue * dtype = metadata.Find("dtype");
+    const std::string        dataType = dtype != nullptr ? dtype->GetString() : "";
+    const std::string        kind = dataType.size() > 1 ? dataType.substr(1) : "";
+    m_BigEndian = !dataType.empty() && dataType[0] == '>';
+    if (kind == "b1" || kind == "u1")
+    {
+      m_ComponentType = IOComponentEnum::UCHAR;
+    }
+    else if (kind == "i1")
+    {
+      m_ComponentType = IOComponentEnum::CHAR;
+    }
+    else if (kind == "u2")
+    {
+      m_ComponentType = IOComponentEnum::USHORT;
+    }
+    else if (kind == "i2")
+    {
+      m_ComponentType = IOComponentEnum::SHORT;
+    }
+    else if (kind == "u4")
+    {
+      m_ComponentType = IOComponentEnum::UINT;
+    }
+    else if (kind == "i4")
+    {
+      m_ComponentType = IOComponentEnum::INT;
+    }
+    else if (kind == "u8")
+    {
+      m_ComponentType = IOComponentEnum::ULONGLONG;
+    }
+    else if (kind == "i8")
+    {
+      m_ComponentType = IOComponentEnum::LONGLONG;
+    }
+    else if (kind == "f4")
+    {
+      m_ComponentType = IOComponentEnum::FLOAT;
+    }
+    else if (kind == "f8")
+    {
+      m_ComponentType = IOComponentEnum::DOUBLE;
+    }
+    else
+    {
+      itkGenericExceptionMacro(<< "Unsupported data type " << dataType);
+    }
+    m_ComponentSize = static_cast<unsigned int>(kind[1] - '0');
+
+    const OMEZarrJSONValue * order = metadata.Find("order");
+    if (order != nullptr && order->GetString() != "C")
+    {
+      itkGenericExceptionMacro(<< "Only arrays in C order are supported");
+    }
+    const OMEZarrJSONValue * filters = metadata.Find("filters");
+    if (filters != nullptr && !filters->IsNull() && !filters->GetElements().empty())
+    {
+      itkGenericExceptionMacro(<< "Filters are not supported");
+    }
+
+    const OMEZarrJSONValue * compressor = metadata.Find("compressor");
+    m_Compressor.clear();
+    if (compressor != nullptr && !compressor->IsNull())
+    {
+      const OMEZarrJSONValue * id = compressor->Find("id");
+      m_Compressor = id != nullptr ? id->GetString() : "";
+      if (m_Compressor != "zlib" && m_Compressor != "gzip")
+      {
+        itkGenericExceptionMacro(<< "Unsupported compressor \"" << m_Compressor
+                                 << "\"; only zlib and gzip compressed arrays are supported");
+      }
+      const OMEZarrJSONValue * level = compressor->Find("level");
+      m_CompressionLevel = level != nullptr ? static_cast<int>(level->GetNumber()) : 1;
+    }
+
+    const OMEZarrJSONValue * separator = metadata.Find("dimension_separator");
+    m_DimensionSeparator = separator != nullptr && separator->GetString() == "/" ? '/' : '.';
+    m_FillValue = GetFillValue(metadata.Find("fill_value"));
+  }
+  catch (ExceptionObject & error)
+  {
+    itkGenericExceptionMacro(<< "Could not read " << fileName << ". " << error.GetDescription());
+  }
+}
+
+void
+OMEZarrArray::WriteMetadata() const
+{
+  OMEZarrJSONValue chunks = OMEZarrJSONValue::MakeArray();
+  OMEZarrJSONValue shape = OMEZarrJSONValue::MakeArray();
+  for (size_t i = 0; i < m_Shape.size(); ++i)
+  {
+    chunks.Append(static_cast<double>(m_Chunks[i]));
+    shape.Append(static_cast<double>(m_Shape[i]));
+  }
+
+  OMEZarrJSONValue compressor;
+  if (!m_Compressor.empty())
+  {
+    compressor = OMEZarrJSONValue::MakeObject();
+    compressor.Set("id", m_Compressor);
+    compressor.Set("level", static_cast<double>(m_CompressionLevel));
+  }
+
+  std::string dataType = m_ComponentSize == 1 ? "|" : m_BigEndian ? ">" : "<";
+  switch (m_ComponentType)
+  {
+    case IOComponentEnum::FLOAT:
+    case IOComponentEnum::DOUBLE:
+      dataType += 'f';
+      break;
+    case IOComponentEnum::CHAR:
+    case IOComponentEnum::SHORT:
+    case IOComponentEnum::INT:
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      dataType += 'i';
+      break;
+    default:
+      dataType += 'u';
+  }
+  dataType += static_cast<char>('0' + m_ComponentSize);
+
+  OMEZarrJSONValue metadata = OMEZarrJSONValue::MakeObject();
+  metadata.Set("chunks", chunks);
+  metadata.Set("compressor", compressor);
+  metadata.Set("dimension_separator", std::string(1, m_DimensionSeparator));
+  metadata.Set("dtype", dataType);
+  metadata.Set("fill_value", m_FillValue);
+  metadata.Set("filters", OMEZarrJSONValue());
+  metadata.Set("order", "C");
+  metadata.Set("shape", shape);
+  metadata.Set("zarr_format", 2.0);
+
+  itksys::SystemTools::MakeDirectory(m_Path);
+  metadata.WriteFile(m_Path + "/.zarray");
+}
+
+SizeValueType
+OMEZarrArray::GetNumberOfChunkElements() const
+{
+  SizeValueType numberOfElements = 1;
+  for (const auto chunk : m_Chunks)
+  {
+    numberOfElements *= chunk;
+  }
+  return numberOfElements;
+}
+
+std::string
+OMEZarrArray::GetChunkFileName(const ShapeType & chunkIndex) const
+{
+  std::ostringstream fileName;
+  fileName << m_Path << '/';
+  for (size_t i = 0; i < chunkIndex.size(); ++i)
+  {
+    if (i > 0)
+    {
+      fileName << m_DimensionSeparator;
+    }
+    fileName << chunkIndex[i];
+  }
+  return fileName.str();
+}
+
+void
+OMEZarrArray::ReadChunk(const ShapeType & chunkIndex, std::vector<char> & chunk) const
+{
+  const SizeValueType numberOfElements = this->GetNumberOfChunkElements();
+  const std::string   fileName = this->GetChunkFileName(chunkIndex);
+  std::ifstream       file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    // chunks made only of the fill value may be missing
+    switch (m_ComponentType)
+    {
+      case IOComponentEnum::UCHAR:
+        FillChunk<uint8_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::CHAR:
+        FillChunk<int8_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::USHORT:
+        FillChunk<uint16_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::SHORT:
+        FillChunk<int16_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::UINT:
+        FillChunk<uint32_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::INT:
+        FillChunk<int32_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::ULONGLONG:
+        FillChunk<uint64_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::LONGLONG:
+        FillChunk<int64_t>(chunk, numberOfElements, m_FillValue);
+        break;
+      case IOComponentEnum::FLOAT:
+        FillChunk<float>(chunk, numberOfElements, m_FillValue);
+        break;
+      default:
+        FillChunk<double>(chunk, numberOfElements, m_FillValue);
+    }
+    return;
+  }
+
+  std::vector<char> encoded((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  chunk.resize(numberOfElements * m_ComponentSize);
+  if (m_Compressor.empty())
+  {
+    if (encoded.size() != chunk.size())
+    {
+      itkGenericExceptionMacro(<< "Chunk " << fileName << " has " << encoded.size() << " bytes instead of "
+                               << chunk.size());
+    }
+    chunk.swap(encoded);
+  }
+  else
+  {
+    // both zlib and gzip streams, told apart by their header
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+      itkGenericExceptionMacro(<< "Could not initialize the decompression of " << fileName);
+    }
+    stream.next_in = reinterpret_cast<Bytef *>(encoded.data());
+    stream.avail_in = static_cast<uInt>(encoded.size());
+    stream.next_out = reinterpret_cast<Bytef *>(chunk.data());
+    stream.avail_out = static_cast<uInt>(chunk.size());
+    const int result = inflate(&stream, Z_FINISH);
+    const bool complete = result == Z_STREAM_END && stream.avail_out == 0;
+    inflateEnd(&stream);
+    if (!complete)
+    {
+      itkGenericExceptionMacro(<< "Chunk " << fileName << " is corrupted");
+    }
+  }
+  SwapChunkBytes(chunk.data(), chunk.size(), m_ComponentSize, m_BigEndian);
+}
+
+void
+OMEZarrArray::WriteChunk(const ShapeType & chunkIndex, const std::vector<char> & chunk) const
+{
+  const char *      data = chunk.data();
+  size_t            numberOfBytes = chunk.size();
+  std::vector<char> swapped;
+  if (m_ComponentSize > 1 && ByteSwapper<uint8_t>::SystemIsBigEndian() != m_BigEndian)
+  {
+    swapped = chunk;
+    SwapChunkBytes(swapped.data(), swapped.size(), m_ComponentSize, m_BigEndian);
+    data = swapped.data();
+  }
+
+  std::vector<char> encoded;
+  if (!m_Compressor.empty())
+  {
+    z_stream stream{};
+    // a gzip stream has a longer header and trailer than a zlib one
+    if (deflateInit2(&stream, m_CompressionLevel, Z_DEFLATED, m_Compressor == "gzip" ? 15 + 16 : 15, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      itkGenericExceptionMacro(<< "Could not initialize the compression of " << this->GetChunkFileName(chunkIndex));
+    }
+    encoded.resize(deflateBound(&stream, static_cast<uLong>(numberOfBytes)) + 32);
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in = static_cast<uInt>(numberOfBytes);
+    stream.next_out = reinterpret_cast<Bytef *>(encoded.data());
+    stream.avail_out = static_cast<uInt>(encoded.size());
+    const int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END)
+    {
+      itkGenericExceptionMacro(<< "Could not compress " << this->GetChunkFileName(chunkIndex));
+    }
+    encoded.resize(stream.total_out);
+    data = encoded.data();
+    numberOfBytes = encoded.size();
+  }
+
+  const std::string fileName = this->GetChunkFileName(chunkIndex);
+  std::ofstream     file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(data, numberOfBytes);
+  file.close();
+  if (file.fail())
+  {
+    itkGenericExceptionMacro(<< "Could not write " << fileName);
+  }
+}
+
+} // namespace itk
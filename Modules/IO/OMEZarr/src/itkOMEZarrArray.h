@@ -0,0 +1,86 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkOMEZarrArray_h
+#define itkOMEZarrArray_h
+
+#include "ITKIOOMEZarrExport.h"
+#include "itkImageIOBase.h"
+#include <string>
+#include <vector>
+
+
+namespace itk
+{
+
+/** \class OMEZarrArray
+ *
+ * \brief A Zarr version 2 array stored in a directory: its metadata, read
+ * from and written to the .zarray file, and its chunks, one file each.
+ *
+ * The shape and the chunks are in the order of Zarr, slowest moving axis
+ * first. Chunks are read and written whole, in the byte order of the
+ * system, and may be read and written concurrently.
+ *
+ * \ingroup ITKIOOMEZarr
+ */
+class ITKIOOMEZarr_HIDDEN OMEZarrArray
+{
+public:
+  using ShapeType = std::vector<SizeValueType>;
+
+  /** Read the metadata of the array stored in the directory path. */
+  void
+  ReadMetadata(const std::string & path);
+
+  /** Create the directory of the array and write its metadata. */
+  void
+  WriteMetadata() const;
+
+  /** Number of elements of a chunk, including those past the end of the
+   * array in the chunks at its end. */
+  SizeValueType
+  GetNumberOfChunkElements() const;
+
+  /** Name of the file of the chunk of the given index. */
+  std::string
+  GetChunkFileName(const ShapeType & chunkIndex) const;
+
+  /** Read the chunk of the given index, decompressed. A chunk that was never
+   * written is made of the fill value. */
+  void
+  ReadChunk(const ShapeType & chunkIndex, std::vector<char> & chunk) const;
+
+  /** Compress and write the chunk of the given index. */
+  void
+  WriteChunk(const ShapeType & chunkIndex, const std::vector<char> & chunk) const;
+
+  std::string     m_Path;
+  ShapeType       m_Shape;
+  ShapeType       m_Chunks;
+  IOComponentEnum m_ComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  unsigned int    m_ComponentSize{ 0 };
+  bool            m_BigEndian{ false };
+  std::string     m_Compressor;
+  int             m_CompressionLevel{ 1 };
+  char            m_DimensionSeparator{ '/' };
+  double          m_FillValue{ 0.0 };
+};
+
+} // namespace itk
+
+#endif // itkOMEZarrArray_h
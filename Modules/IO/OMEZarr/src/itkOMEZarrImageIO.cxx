@@ -0,0 +1,1108 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkOMEZarrImageIO.h"
+#include "itkOMEZarrArray.h"
+#include "itkOMEZarrJSON.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+using ShapeType = OMEZarrArray::ShapeType;
+
+// A region of an image buffered in memory, in the axes of an array: the first
+// position and the end of the region along each axis, and the distance, in
+// elements, between consecutive positions along each axis in the buffer
+struct BufferedArrayRegion
+{
+  ShapeType m_First;
+  ShapeType m_End;
+  ShapeType m_Strides;
+};
+
+// The image dimension of each axis of an array, slowest moving first, or -1
+// for the channel axis, which holds the components of the pixels
+std::vector<int>
+GetAxisDimensions(unsigned int numberOfDimensions, int channelAxis)
+{
+  const unsigned int numberOfAxes = numberOfDimensions + (channelAxis >= 0 ? 1 : 0);
+  std::vector<int>   axisDimensions(numberOfAxes);
+  auto               dimension = static_cast<int>(numberOfDimensions);
+  for (unsigned int axis = 0; axis < numberOfAxes; ++axis)
+  {
+    axisDimensions[axis] = static_cast<int>(axis) == channelAxis ? -1 : --dimension;
+  }
+  return axisDimensions;
+}
+
+// Index and size of a region along the numberOfDimensions dimensions of the
+// image, the dimensions the region lacks being one pixel wide
+void
+GetRegionIndexAndSize(const ImageIORegion & region,
+                      unsigned int          numberOfDimensions,
+                      ShapeType &           index,
+                      ShapeType &           size)
+{
+  index.assign(numberOfDimensions, 0);
+  size.assign(numberOfDimensions, 1);
+  for (unsigned int i = 0; i < std::min(numberOfDimensions, region.GetImageDimension()); ++i)
+  {
+    index[i] = region.GetIndex(i);
+    size[i] = region.GetSize(i);
+  }
+}
+
+ShapeType
+GetArrayShape(const ShapeType & size, unsigned int numberOfComponents, const std::vector<int> & axisDimensions)
+{
+  ShapeType shape(axisDimensions.size());
+  for (size_t axis = 0; axis < axisDimensions.size(); ++axis)
+  {
+    shape[axis] = axisDimensions[axis] < 0 ? numberOfComponents : size[axisDimensions[axis]];
+  }
+  return shape;
+}
+
+BufferedArrayRegion
+GetBufferedArrayRegion(const ShapeType &        index,
+                       const ShapeType &        size,
+                       unsigned int             numberOfComponents,
+                       const std::vector<int> & axisDimensions)
+{
+  // the components of a pixel are contiguous in the buffer
+  ShapeType     dimensionStrides(index.size());
+  SizeValueType stride = numberOfComponents;
+  for (size_t i = 0; i < index.size(); ++i)
+  {
+    dimensionStrides[i] = stride;
+    stride *= size[i];
+  }
+
+  BufferedArrayRegion region;
+  for (const int dimension : axisDimensions)
+  {
+    if (dimension < 0)
+    {
+      region.m_First.push_back(0);
+      region.m_End.push_back(numberOfComponents);
+      region.m_Strides.push_back(1);
+    }
+    else
+    {
+      region.m_First.push_back(index[dimension]);
+      region.m_End.push_back(index[dimension] + size[dimension]);
+      region.m_Strides.push_back(dimensionStrides[dimension]);
+    }
+  }
+  return region;
+}
+
+// The indices of the chunks of the array that hold a part of the region
+std::vector<ShapeType>
+GetChunkIndices(const OMEZarrArray & array, const BufferedArrayRegion & region)
+{
+  const size_t numberOfAxes = array.m_Shape.size();
+  ShapeType    firstChunk(numberOfAxes);
+  ShapeType    lastChunk(numberOfAxes);
+  for (size_t axis = 0; axis < numberOfAxes; ++axis)
+  {
+    if (region.m_End[axis] <= region.m_First[axis] || region.m_End[axis] > array.m_Shape[axis])
+    {
+      return std::vector<ShapeType>();
+    }
+    firstChunk[axis] = region.m_First[axis] / array.m_Chunks[axis];
+    lastChunk[axis] = (region.m_End[axis] - 1) / array.m_Chunks[axis];
+  }
+
+  std::vector<ShapeType> chunkIndices;
+  ShapeType              chunkIndex = firstChunk;
+  while (true)
+  {
+    chunkIndices.push_back(chunkIndex);
+    size_t axis = numberOfAxes;
+    while (true)
+    {
+      if (axis == 0)
+      {
+        return chunkIndices;
+      }
+      --axis;
+      if (++chunkIndex[axis] <= lastChunk[axis])
+      {
+        break;
+      }
+      chunkIndex[axis] = firstChunk[axis];
+    }
+  }
+}
+
+// Whether the region holds all the elements of the chunk within the array
+bool
+IsChunkInRegion(const OMEZarrArray & array, const ShapeType & chunkIndex, const BufferedArrayRegion & region)
+{
+  for (size_t axis = 0; axis < chunkIndex.size(); ++axis)
+  {
+    const SizeValueType chunkStart = chunkIndex[axis] * array.m_Chunks[axis];
+    const SizeValueType chunkEnd = std::min(chunkStart + array.m_Chunks[axis], array.m_Shape[axis]);
+    if (region.m_First[axis] > chunkStart || region.m_End[axis] < chunkEnd)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy the elements of the chunk that are in the region, from the chunk to
+// the buffer of the region, or from the buffer to the chunk
+void
+CopyChunkRegion(const OMEZarrArray &        array,
+                const ShapeType &           chunkIndex,
+                char *                      chunk,
+                const BufferedArrayRegion & region,
+                char *                      buffer,
+                bool                        toBuffer)
+{
+  const size_t  numberOfAxes = chunkIndex.size();
+  const size_t  elementSize = array.m_ComponentSize;
+  ShapeType     chunkStart(numberOfAxes);
+  ShapeType     first(numberOfAxes);
+  ShapeType     end(numberOfAxes);
+  ShapeType     chunkStrides(numberOfAxes);
+  SizeValueType chunkStride = 1;
+  for (size_t axis = numberOfAxes; axis > 0; --axis)
+  {
+    const size_t a = axis - 1;
+    chunkStrides[a] = chunkStride;
+    chunkStride *= array.m_Chunks[a];
+    chunkStart[a] = chunkIndex[a] * array.m_Chunks[a];
+    first[a] = std::max(chunkStart[a], region.m_First[a]);
+    end[a] = std::min(chunkStart[a] + array.m_Chunks[a], region.m_End[a]);
+  }
+
+  // copy the rows along the fastest moving axis of the array, which are
+  // contiguous in the chunk
+  const size_t        lastAxis = numberOfAxes - 1;
+  const SizeValueType rowLength = end[lastAxis] - first[lastAxis];
+  const SizeValueType bufferStride = region.m_Strides[lastAxis];
+  ShapeType           position = first;
+  while (true)
+  {
+    SizeValueType chunkOffset = 0;
+    SizeValueType bufferOffset = 0;
+    for (size_t axis = 0; axis < numberOfAxes; ++axis)
+    {
+      chunkOffset += (position[axis] - chunkStart[axis]) * chunkStrides[axis];
+      bufferOffset += (position[axis] - region.m_First[axis]) * region.m_Strides[axis];
+    }
+    char * chunkRow = chunk + chunkOffset * elementSize;
+    char * bufferRow = buffer + bufferOffset * elementSize;
+    if (bufferStride == 1)
+    {
+      if (toBuffer)
+      {
+        std::memcpy(bufferRow, chunkRow, rowLength * elementSize);
+      }
+      else
+      {
+        std::memcpy(chunkRow, bufferRow, rowLength * elementSize);
+      }
+    }
+    else
+    {
+      for (SizeValueType i = 0; i < rowLength; ++i)
+      {
+        char * chunkElement = chunkRow + i * elementSize;
+        char * bufferElement = bufferRow + i * bufferStride * elementSize;
+        if (toBuffer)
+        {
+          std::memcpy(bufferElement, chunkElement, elementSize);
+        }
+        else
+        {
+          std::memcpy(chunkElement, bufferElement, elementSize);
+        }
+      }
+    }
+
+    size_t axis = lastAxis;
+    while (true)
+    {
+      if (axis == 0)
+      {
+        return;
+      }
+      --axis;
+      if (++position[axis] < end[axis])
+      {
+        break;
+      }
+      position[axis] = first[axis];
+    }
+  }
+}
+
+void
+ReadArrayRegion(const OMEZarrArray & array, const BufferedArrayRegion & region, void * buffer)
+{
+  const std::vector<ShapeType> chunkIndices = GetChunkIndices(array, region);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    chunkIndices.size(),
+    [&](SizeValueType i) {
+      std::vector<char> chunk;
+      array.ReadChunk(chunkIndices[i], chunk);
+      CopyChunkRegion(array, chunkIndices[i], chunk.data(), region, static_cast<char *>(buffer), true);
+    },
+    nullptr);
+}
+
+void
+WriteArrayRegion(const OMEZarrArray & array, const BufferedArrayRegion & region, const void * buffer)
+{
+  const std::vector<ShapeType> chunkIndices = GetChunkIndices(array, region);
+
+  // the nested directories of the chunks are created beforehand
+  std::set<std::string> directories;
+  for (const auto & chunkIndex : chunkIndices)
+  {
+    directories.insert(itksys::SystemTools::GetFilenamePath(array.GetChunkFileName(chunkIndex)));
+  }
+  for (const auto & directory : directories)
+  {
+    itksys::SystemTools::MakeDirectory(directory);
+  }
+
+  const SizeValueType chunkBytes = array.GetNumberOfChunkElements() * array.m_ComponentSize;
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    chunkIndices.size(),
+    [&](SizeValueType i) {
+      // the elements of chunks partly in the region are kept
+      std::vector<char> chunk;
+      if (IsChunkInRegion(array, chunkIndices[i], region))
+      {
+        chunk.assign(chunkBytes, 0);
+      }
+      else
+      {
+        array.ReadChunk(chunkIndices[i], chunk);
+      }
+      CopyChunkRegion(
+        array, chunkIndices[i], chunk.data(), region, static_cast<char *>(const_cast<void *>(buffer)), false);
+      array.WriteChunk(chunkIndices[i], chunk);
+    },
+    nullptr);
+}
+
+// Whether a level is half the size of the previous one along a dimension
+bool
+IsDownsampled(unsigned int dimension, SizeValueType size)
+{
+  // time is not downsampled
+  return dimension < 3 && size > 1;
+}
+
+// The size of the blocks of pixels of the full resolution that make a chunk
+// of every level
+ImageIORegion::SizeType
+GetBlockSize(const ImageIORegion::SizeType & chunkSize, unsigned int numberOfLevels)
+{
+  ImageIORegion::SizeType blockSize = chunkSize;
+  for (unsigned int i = 0; i < blockSize.size() && i < 3; ++i)
+  {
+    blockSize[i] <<= (numberOfLevels - 1);
+  }
+  return blockSize;
+}
+
+// The channels precede the spatial axes, and follow the time
+int
+GetChannelAxisForWriting(unsigned int numberOfDimensions, unsigned int numberOfComponents)
+{
+  return numberOfComponents > 1 ? (numberOfDimensions > 3 ? 1 : 0) : -1;
+}
+
+ShapeType
+GetNextLevelSize(const ShapeType & size)
+{
+  ShapeType nextSize = size;
+  for (unsigned int i = 0; i < size.size(); ++i)
+  {
+    if (IsDownsampled(i, size[i]))
+    {
+      nextSize[i] = (size[i] + 1) / 2;
+    }
+  }
+  return nextSize;
+}
+
+template <typename T>
+T
+RoundMean(double mean)
+{
+  return static_cast<T>(std::numeric_limits<T>::is_integer ? std::floor(mean + 0.5) : mean);
+}
+
+// Each pixel of the output is the mean of the block of 2 pixels, or 1 at the
+// end of the image, along each downsampled dimension of the input
+template <typename T>
+void
+Downsample(const T *         input,
+           const ShapeType & inputIndex,
+           const ShapeType & inputSize,
+           const ShapeType & levelSize,
+           unsigned int      numberOfComponents,
+           T *               output,
+           const ShapeType & outputIndex,
+           const ShapeType & outputSize)
+{
+  const unsigned int numberOfDimensions = static_cast<unsigned int>(inputIndex.size());
+  ShapeType          factors(numberOfDimensions);
+  ShapeType          inputStrides(numberOfDimensions);
+  SizeValueType      inputStride = 1;
+  SizeValueType      outputSliceSize = 1;
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    factors[i] = IsDownsampled(i, levelSize[i]) ? 2 : 1;
+    inputStrides[i] = inputStride;
+    inputStride *= inputSize[i];
+    if (i + 1 < numberOfDimensions)
+    {
+      outputSliceSize *= outputSize[i];
+    }
+  }
+
+  const unsigned int lastDimension = numberOfDimensions - 1;
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    outputSize[lastDimension],
+    [&](SizeValueType slice) {
+      std::vector<double> sums(numberOfComponents);
+      ShapeType           position(numberOfDimensions, 0);
+      ShapeType           first(numberOfDimensions);
+      ShapeType           end(numberOfDimensions);
+      ShapeType           inputPosition(numberOfDimensions);
+      position[lastDimension] = slice;
+      T * outputPixel = output + slice * outputSliceSize * numberOfComponents;
+      for (SizeValueType p = 0; p < outputSliceSize; ++p)
+      {
+        for (unsigned int i = 0; i < numberOfDimensions; ++i)
+        {
+          first[i] = (outputIndex[i] + position[i]) * factors[i] - inputIndex[i];
+          end[i] = std::min((outputIndex[i] + position[i] + 1) * factors[i], levelSize[i]) - inputIndex[i];
+        }
+        std::fill(sums.begin(), sums.end(), 0.0);
+        SizeValueType count = 0;
+        inputPosition = first;
+        while (true)
+        {
+          SizeValueType offset = 0;
+          for (unsigned int i = 0; i < numberOfDimensions; ++i)
+          {
+            offset += inputPosition[i] * inputStrides[i];
+          }
+          const T * inputPixel = input + offset * numberOfComponents;
+          for (unsigned int k = 0; k < numberOfComponents; ++k)
+          {
+            sums[k] += static_cast<double>(inputPixel[k]);
+          }
+          ++count;
+
+          unsigned int i = 0;
+          while (i < numberOfDimensions && ++inputPosition[i] == end[i])
+          {
+            inputPosition[i] = first[i];
+            ++i;
+          }
+          if (i == numberOfDimensions)
+          {
+            break;
+          }
+        }
+        for (unsigned int k = 0; k < numberOfComponents; ++k)
+        {
+          outputPixel[k] = RoundMean<T>(sums[k] / count);
+        }
+        outputPixel += numberOfComponents;
+
+        unsigned int i = 0;
+        while (i < lastDimension && ++position[i] == outputSize[i])
+        {
+          position[i] = 0;
+          ++i;
+        }
+      }
+    },
+    nullptr);
+}
+
+// Apply the scale and translation transformations of the list to those of
+// each axis
+void
+ApplyCoordinateTransformations(const OMEZarrJSONValue * transformations,
+                               std::vector<double> &    scale,
+                               std::vector<double> &    translation)
+{
+  if (transformations == nullptr)
+  {
+    return;
+  }
+  for (const auto & transformation : transformations->GetElements())
+  {
+    const OMEZarrJSONValue * type = transformation.Find("type");
+    const std::string        typeName = type != nullptr ? type->GetString() : "";
+    const OMEZarrJSONValue * values = transformation.Find(typeName);
+    if (values == nullptr || (typeName != "scale" && typeName != "translation"))
+    {
+      continue;
+    }
+    const std::vector<OMEZarrJSONValue> & elements = values->GetElements();
+    if (elements.size() != scale.size())
+    {
+      itkGenericExceptionMacro(<< "The " << typeName << " has " << elements.size() << " values for "
+                               << scale.size() << " axes");
+    }
+    for (size_t axis = 0; axis < scale.size(); ++axis)
+    {
+      if (typeName == "scale")
+      {
+        scale[axis] *= elements[axis].GetNumber();
+        translation[axis] *= elements[axis].GetNumber();
+      }
+      else
+      {
+        translation[axis] += elements[axis].GetNumber();
+      }
+    }
+  }
+}
+} // namespace
+
+OMEZarrImageIO::OMEZarrImageIO()
+{
+  this->AddSupportedReadExtension(".zarr");
+  this->AddSupportedWriteExtension(".zarr");
+
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(1);
+}
+
+OMEZarrImageIO::~OMEZarrImageIO() = default;
+
+void
+OMEZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ResolutionLevel: " << m_ResolutionLevel << std::endl;
+  os << indent << "NumberOfResolutionLevels: " << m_NumberOfResolutionLevels << std::endl;
+  os << indent << "ChunkSize: [";
+  for (size_t i = 0; i < m_ChunkSize.size(); ++i)
+  {
+    os << (i > 0 ? ", " : "") << m_ChunkSize[i];
+  }
+  os << "]" << std::endl;
+}
+
+std::string
+OMEZarrImageIO::GetStorePath() const
+{
+  std::string path = this->GetFileName();
+  while (path.size() > 1 && (path.back() == '/' || path.back() == '\\'))
+  {
+    path.pop_back();
+  }
+  return path;
+}
+
+bool
+OMEZarrImageIO::CanReadFile(const char * file)
+{
+  this->SetFileName(file);
+  const std::string path = this->GetStorePath();
+  if (path.empty() || !itksys::SystemTools::FileIsDirectory(path))
+  {
+    return false;
+  }
+
+  if (itksys::SystemTools::FileExists(path + "/.zattrs", true))
+  {
+    try
+    {
+      const OMEZarrJSONValue attributes = OMEZarrJSONValue::ReadFile(path + "/.zattrs");
+      if (attributes.Find("multiscales") != nullptr)
+      {
+        return true;
+      }
+    }
+    catch (ExceptionObject &)
+    {
+      return false;
+    }
+  }
+  // a single array
+  return itksys::SystemTools::FileExists(path + "/.zarray", true);
+}
+
+void
+OMEZarrImageIO::ReadImageInformation()
+{
+  const std::string path = this->GetStorePath();
+  m_Array.reset(new OMEZarrArray);
+
+  std::vector<std::string> axisTypes;
+  std::vector<double>      scale;
+  std::vector<double>      translation;
+  const OMEZarrJSONValue * multiscale = nullptr;
+  OMEZarrJSONValue         attributes;
+  if (itksys::SystemTools::FileExists(path + "/.zattrs", true))
+  {
+    attributes = OMEZarrJSONValue::ReadFile(path + "/.zattrs");
+    const OMEZarrJSONValue * multiscales = attributes.Find("multiscales");
+    if (multiscales != nullptr && !multiscales->GetElements().empty())
+    {
+      multiscale = &multiscales->GetElements().front();
+    }
+  }
+
+  if (multiscale != nullptr)
+  {
+    const OMEZarrJSONValue * datasets = multiscale->Find("datasets");
+    if (datasets == nullptr || datasets->GetElements().empty())
+    {
+      itkExceptionMacro(<< "The multiscale image of " << path << " has no dataset");
+    }
+    m_NumberOfResolutionLevels = static_cast<unsigned int>(datasets->GetElements().size());
+    if (m_ResolutionLevel >= m_NumberOfResolutionLevels)
+    {
+      itkExceptionMacro(<< "Resolution level " << m_ResolutionLevel << " requested, but " << path << " has "
+                        << m_NumberOfResolutionLevels << " resolution levels");
+    }
+    const OMEZarrJSONValue & dataset = datasets->GetElements()[m_ResolutionLevel];
+    const OMEZarrJSONValue * datasetPath = dataset.Find("path");
+    if (datasetPath == nullptr)
+    {
+      itkExceptionMacro(<< "The dataset " << m_ResolutionLevel << " of " << path << " has no path");
+    }
+    m_Array->ReadMetadata(path + "/" + datasetPath->GetString());
+
+    // before version 0.4, the axes are names, the type of which is implied
+    const OMEZarrJSONValue * axes = multiscale->Find("axes");
+    if (axes != nullptr)
+    {
+      for (const auto & axis : axes->GetElements())
+      {
+        const OMEZarrJSONValue * type = axis.Find("type");
+        const OMEZarrJSONValue * name = axis.Find("name");
+        const std::string        axisName = name != nullptr ? name->GetString()
+                                            : axis.GetType() == OMEZarrJSONValue::Type::String ? axis.GetString()
+                                                                                                : "";
+        if (type != nullptr)
+        {
+          axisTypes.push_back(type->GetString());
+        }
+        else
+        {
+          axisTypes.push_back(axisName == "c" ? "channel" : axisName == "t" ? "time" : "space");
+        }
+      }
+    }
+    scale.assign(m_Array->m_Shape.size(), 1.0);
+    translation.assign(m_Array->m_Shape.size(), 0.0);
+    try
+    {
+      ApplyCoordinateTransformations(dataset.Find("coordinateTransformations"), scale, translation);
+      ApplyCoordinateTransformations(multiscale->Find("coordinateTransformations"), scale, translation);
+    }
+    catch (ExceptionObject & error)
+    {
+      itkExceptionMacro(<< "Could not read the coordinate transformations of " << path << ". "
+                        << error.GetDescription());
+    }
+  }
+  else if (itksys::SystemTools::FileExists(path + "/.zarray", true))
+  {
+    m_NumberOfResolutionLevels = 1;
+    if (m_ResolutionLevel > 0)
+    {
+      itkExceptionMacro(<< "Resolution level " << m_ResolutionLevel << " requested, but " << path
+                        << " is a single array");
+    }
+    m_Array->ReadMetadata(path);
+  }
+  else
+  {
+    itkExceptionMacro(<< path << " is not an OME-Zarr image");
+  }
+
+  const size_t numberOfAxes = m_Array->m_Shape.size();
+  if (axisTypes.empty())
+  {
+    axisTypes.assign(numberOfAxes, "space");
+  }
+  if (axisTypes.size() != numberOfAxes)
+  {
+    itkExceptionMacro(<< "The image of " << path << " has " << axisTypes.size() << " axes, but its array has "
+                      << numberOfAxes);
+  }
+  if (scale.empty())
+  {
+    scale.assign(numberOfAxes, 1.0);
+    translation.assign(numberOfAxes, 0.0);
+  }
+
+  m_ChannelAxis = -1;
+  for (size_t axis = 0; axis < numberOfAxes; ++axis)
+  {
+    if (axisTypes[axis] == "channel")
+    {
+      if (m_ChannelAxis >= 0)
+      {
+        itkExceptionMacro(<< "The image of " << path << " has several channel axes");
+      }
+      m_ChannelAxis = static_cast<int>(axis);
+    }
+  }
+  if (m_ChannelAxis >= 0 && numberOfAxes == 1)
+  {
+    itkExceptionMacro(<< "The image of " << path << " has no spatial axis");
+  }
+
+  const auto numberOfDimensions = static_cast<unsigned int>(numberOfAxes - (m_ChannelAxis >= 0 ? 1 : 0));
+  const std::vector<int> axisDimensions = GetAxisDimensions(numberOfDimensions, m_ChannelAxis);
+  this->SetNumberOfDimensions(numberOfDimensions);
+  for (size_t axis = 0; axis < numberOfAxes; ++axis)
+  {
+    const int dimension = axisDimensions[axis];
+    if (dimension >= 0)
+    {
+      this->SetDimensions(dimension, m_Array->m_Shape[axis]);
+      this->SetSpacing(dimension, scale[axis]);
+      this->SetOrigin(dimension, translation[axis]);
+      std::vector<double> direction(numberOfDimensions, 0.0);
+      direction[dimension] = 1.0;
+      this->SetDirection(dimension, direction);
+    }
+  }
+  const auto numberOfComponents = static_cast<unsigned int>(m_ChannelAxis >= 0 ? m_Array->m_Shape[m_ChannelAxis] : 1);
+  this->SetNumberOfComponents(numberOfComponents);
+  this->SetPixelType(numberOfComponents > 1 ? IOPixelEnum::VECTOR : IOPixelEnum::SCALAR);
+  this->SetComponentType(m_Array->m_ComponentType);
+}
+
+ImageIORegion
+OMEZarrImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (!m_UseStreamedReading || m_Array == nullptr)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+
+  // the size of the chunks along each dimension of the image
+  const unsigned int      numberOfDimensions = this->GetNumberOfDimensions();
+  const std::vector<int>  axisDimensions = GetAxisDimensions(numberOfDimensions, m_ChannelAxis);
+  ImageIORegion::SizeType chunkSize(numberOfDimensions, 0);
+  for (size_t axis = 0; axis < axisDimensions.size(); ++axis)
+  {
+    if (axisDimensions[axis] >= 0)
+    {
+      chunkSize[axisDimensions[axis]] = m_Array->m_Chunks[axis];
+    }
+  }
+  return this->EnlargeRegionToChunks(requested, chunkSize);
+}
+
+void
+OMEZarrImageIO::Read(void * buffer)
+{
+  if (m_Array == nullptr)
+  {
+    this->ReadImageInformation();
+  }
+
+  ShapeType index;
+  ShapeType size;
+  GetRegionIndexAndSize(this->GetIORegion(), this->GetNumberOfDimensions(), index, size);
+  const std::vector<int> axisDimensions = GetAxisDimensions(this->GetNumberOfDimensions(), m_ChannelAxis);
+  try
+  {
+    ReadArrayRegion(
+      *m_Array, GetBufferedArrayRegion(index, size, this->GetNumberOfComponents(), axisDimensions), buffer);
+  }
+  catch (ExceptionObject & error)
+  {
+    itkExceptionMacro(<< "Could not read " << this->GetStorePath() << ". " << error.GetDescription());
+  }
+}
+
+bool
+OMEZarrImageIO::CanWriteFile(const char * name)
+{
+  this->SetFileName(name);
+  const std::string path = this->GetStorePath();
+  return !path.empty() && this->HasSupportedWriteExtension(path.c_str());
+}
+
+ImageIORegion::SizeType
+OMEZarrImageIO::GetChunkSizeForWriting() const
+{
+  const unsigned int      numDims = this->GetNumberOfDimensions();
+  ImageIORegion::SizeType chunkSize(numDims);
+  for (unsigned int i = 0; i < numDims; ++i)
+  {
+    if (m_ChunkSize.empty())
+    {
+      chunkSize[i] = numDims > 2 ? 64 : 256;
+    }
+    else
+    {
+      chunkSize[i] = i < m_ChunkSize.size() ? m_ChunkSize[i] : 1;
+    }
+    chunkSize[i] = std::max<SizeValueType>(std::min<SizeValueType>(chunkSize[i], this->GetDimensions(i)), 1);
+  }
+  return chunkSize;
+}
+
+void
+OMEZarrImageIO::WriteImageInformation()
+{
+  const std::string  path = this->GetStorePath();
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  if (numberOfDimensions < 1 || numberOfDimensions > 4)
+  {
+    itkExceptionMacro(<< "OME-Zarr images have 1 to 4 dimensions, " << numberOfDimensions << " given");
+  }
+
+  m_ChannelAxis = GetChannelAxisForWriting(numberOfDimensions, numberOfComponents);
+  const std::vector<int> axisDimensions = GetAxisDimensions(numberOfDimensions, m_ChannelAxis);
+
+  // replace the levels of a previous image
+  itksys::SystemTools::MakeDirectory(path);
+  itksys::Directory directory;
+  if (directory.Load(path))
+  {
+    for (unsigned long i = 0; i < directory.GetNumberOfFiles(); ++i)
+    {
+      const std::string file = directory.GetFile(i);
+      const std::string level = path + "/" + file;
+      if (file != "." && file != ".." && itksys::SystemTools::FileIsDirectory(level) &&
+          itksys::SystemTools::FileExists(level + "/.zarray", true))
+      {
+        itksys::SystemTools::RemoveADirectory(level);
+      }
+    }
+  }
+
+  OMEZarrJSONValue group = OMEZarrJSONValue::MakeObject();
+  group.Set("zarr_format", 2.0);
+  group.WriteFile(path + "/.zgroup");
+
+  OMEZarrJSONValue axes = OMEZarrJSONValue::MakeArray();
+  for (const int dimension : axisDimensions)
+  {
+    static const char * const names[] = { "x", "y", "z", "t" };
+    OMEZarrJSONValue          axis = OMEZarrJSONValue::MakeObject();
+    axis.Set("name", dimension < 0 ? "c" : names[dimension]);
+    axis.Set("type", dimension < 0 ? "channel" : dimension < 3 ? "space" : "time");
+    axes.Append(axis);
+  }
+
+  m_WrittenChunkSize = this->GetChunkSizeForWriting();
+  OMEZarrJSONValue datasets = OMEZarrJSONValue::MakeArray();
+  ShapeType        levelSize(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    levelSize[i] = this->GetDimensions(i);
+  }
+  std::vector<double> factors(numberOfDimensions, 1.0);
+  for (unsigned int level = 0; level < m_NumberOfResolutionLevels; ++level)
+  {
+    OMEZarrArray array;
+    array.m_Path = path + "/" + std::to_string(level);
+    array.m_Shape = GetArrayShape(levelSize, numberOfComponents, axisDimensions);
+    array.m_ComponentType = this->GetComponentType();
+    array.m_ComponentSize = static_cast<unsigned int>(this->GetComponentSize());
+    array.m_Compressor = this->GetUseCompression() ? "zlib" : "";
+    array.m_CompressionLevel = this->GetCompressionLevel();
+
+    // the pixels of each level are centered on the blocks of pixels of the
+    // full resolution they average
+    OMEZarrJSONValue scale = OMEZarrJSONValue::MakeArray();
+    OMEZarrJSONValue translation = OMEZarrJSONValue::MakeArray();
+    for (size_t axis = 0; axis < axisDimensions.size(); ++axis)
+    {
+      const int dimension = axisDimensions[axis];
+      if (dimension < 0)
+      {
+        array.m_Chunks.push_back(numberOfComponents);
+        scale.Append(1.0);
+        translation.Append(0.0);
+      }
+      else
+      {
+        array.m_Chunks.push_back(std::min(m_WrittenChunkSize[dimension], levelSize[dimension]));
+        scale.Append(this->GetSpacing(dimension) * factors[dimension]);
+        translation.Append(this->GetOrigin(dimension) + (factors[dimension] - 1.0) / 2.0 * this->GetSpacing(dimension));
+      }
+    }
+    array.WriteMetadata();
+
+    OMEZarrJSONValue scaleTransformation = OMEZarrJSONValue::MakeObject();
+    scaleTransformation.Set("type", "scale");
+    scaleTransformation.Set("scale", scale);
+    OMEZarrJSONValue translationTransformation = OMEZarrJSONValue::MakeObject();
+    translationTransformation.Set("type", "translation");
+    translationTransformation.Set("translation", translation);
+    OMEZarrJSONValue transformations = OMEZarrJSONValue::MakeArray();
+    transformations.Append(scaleTransformation);
+    transformations.Append(translationTransformation);
+    OMEZarrJSONValue dataset = OMEZarrJSONValue::MakeObject();
+    dataset.Set("path", std::to_string(level));
+    dataset.Set("coordinateTransformations", transformations);
+    datasets.Append(dataset);
+
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      if (IsDownsampled(i, levelSize[i]))
+      {
+        factors[i] *= 2.0;
+      }
+    }
+    levelSize = GetNextLevelSize(levelSize);
+  }
+
+  OMEZarrJSONValue multiscale = OMEZarrJSONValue::MakeObject();
+  multiscale.Set("version", "0.4");
+  multiscale.Set("name", itksys::SystemTools::GetFilenameWithoutLastExtension(path));
+  multiscale.Set("axes", axes);
+  multiscale.Set("datasets", datasets);
+  multiscale.Set("type", "mean");
+  OMEZarrJSONValue multiscales = OMEZarrJSONValue::MakeArray();
+  multiscales.Append(multiscale);
+  OMEZarrJSONValue attributes = OMEZarrJSONValue::MakeObject();
+  attributes.Set("multiscales", multiscales);
+  attributes.WriteFile(path + "/.zattrs");
+
+  m_MetadataWritten = true;
+}
+
+void
+OMEZarrImageIO::Write(const void * buffer)
+{
+  if (!m_MetadataWritten)
+  {
+    this->WriteImageInformation();
+  }
+
+  const std::string      path = this->GetStorePath();
+  const unsigned int     numberOfDimensions = this->GetNumberOfDimensions();
+  const unsigned int     numberOfComponents = this->GetNumberOfComponents();
+  const std::vector<int> axisDimensions = GetAxisDimensions(numberOfDimensions, m_ChannelAxis);
+
+  ShapeType index;
+  ShapeType size;
+  GetRegionIndexAndSize(this->GetIORegion(), numberOfDimensions, index, size);
+  ShapeType levelSize(numberOfDimensions);
+  bool      isLargestRegion = true;
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    levelSize[i] = this->GetDimensions(i);
+    isLargestRegion &= index[i] == 0 && size[i] == levelSize[i];
+  }
+
+  const SizeValueType pixelSize = this->GetComponentSize() * numberOfComponents;
+  const char *        levelBuffer = static_cast<const char *>(buffer);
+  std::vector<char>   downsampled;
+  std::vector<char>   previousLevel;
+  for (unsigned int level = 0; level < m_NumberOfResolutionLevels; ++level)
+  {
+    if (level > 0)
+    {
+      // the region of the next level, the pieces written being made of
+      // blocks of pixels that are averaged together
+      ShapeType     nextIndex(numberOfDimensions);
+      ShapeType     nextSize(numberOfDimensions);
+      SizeValueType numberOfPixels = 1;
+      for (unsigned int i = 0; i < numberOfDimensions; ++i)
+      {
+        const SizeValueType end = index[i] + size[i];
+        if (IsDownsampled(i, levelSize[i]))
+        {
+          if (index[i] % 2 != 0 || (end % 2 != 0 && end != levelSize[i]))
+          {
+            itkExceptionMacro(<< "The region written is not aligned on the blocks of pixels of the resolution level "
+                              << level << " of " << path);
+          }
+          nextIndex[i] = index[i] / 2;
+          nextSize[i] = (end + 1) / 2 - nextIndex[i];
+        }
+        else
+        {
+          nextIndex[i] = index[i];
+          nextSize[i] = size[i];
+        }
+        numberOfPixels *= nextSize[i];
+      }
+
+      downsampled.resize(numberOfPixels * pixelSize);
+      switch (this->GetComponentType())
+      {
+#define ITK_OMEZARR_DOWNSAMPLE(componentEnum, componentType)                                                          \
+  case IOComponentEnum::componentEnum:                                                                               \
+    Downsample(reinterpret_cast<const componentType *>(levelBuffer),                                                  \
+               index,                                                                                                 \
+               size,                                                                                                  \
+               levelSize,                                                                                             \
+               numberOfComponents,                                                                                    \
+               reinterpret_cast<componentType *>(downsampled.data()),                                                 \
+               nextIndex,                                                                                             \
+               nextSize);                                                                                             \
+    break
+        ITK_OMEZARR_DOWNSAMPLE(UCHAR, unsigned char);
+        ITK_OMEZARR_DOWNSAMPLE(CHAR, char);
+        ITK_OMEZARR_DOWNSAMPLE(USHORT, unsigned short);
+        ITK_OMEZARR_DOWNSAMPLE(SHORT, short);
+        ITK_OMEZARR_DOWNSAMPLE(UINT, unsigned int);
+        ITK_OMEZARR_DOWNSAMPLE(INT, int);
+        ITK_OMEZARR_DOWNSAMPLE(ULONG, unsigned long);
+        ITK_OMEZARR_DOWNSAMPLE(LONG, long);
+        ITK_OMEZARR_DOWNSAMPLE(ULONGLONG, unsigned long long);
+        ITK_OMEZARR_DOWNSAMPLE(LONGLONG, long long);
+        ITK_OMEZARR_DOWNSAMPLE(FLOAT, float);
+        ITK_OMEZARR_DOWNSAMPLE(DOUBLE, double);
+#undef ITK_OMEZARR_DOWNSAMPLE
+        default:
+          itkExceptionMacro(<< "Unsupported component type "
+                            << this->GetComponentTypeAsString(this->GetComponentType()));
+      }
+      previousLevel.swap(downsampled);
+      levelBuffer = previousLevel.data();
+      index = nextIndex;
+      size = nextSize;
+      levelSize = GetNextLevelSize(levelSize);
+    }
+
+    OMEZarrArray array;
+    try
+    {
+      array.ReadMetadata(path + "/" + std::to_string(level));
+    }
+    catch (ExceptionObject & error)
+    {
+      itkExceptionMacro(<< "Could not write " << path << ". " << error.GetDescription());
+    }
+    if (array.m_Shape != GetArrayShape(levelSize, numberOfComponents, axisDimensions) ||
+        array.m_ComponentSize != this->GetComponentSize())
+    {
+      itkExceptionMacro(<< "The image written does not match the array of the resolution level " << level << " of "
+                        << path);
+    }
+    try
+    {
+      WriteArrayRegion(array, GetBufferedArrayRegion(index, size, numberOfComponents, axisDimensions), levelBuffer);
+    }
+    catch (ExceptionObject & error)
+    {
+      itkExceptionMacro(<< "Could not write " << path << ". " << error.GetDescription());
+    }
+  }
+
+  // a new image is written next time
+  if (isLargestRegion)
+  {
+    m_MetadataWritten = false;
+  }
+}
+
+unsigned int
+OMEZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                                  const ImageIORegion & pasteRegion,
+                                                  const ImageIORegion & largestPossibleRegion)
+{
+  // a new write starts
+  m_MetadataWritten = false;
+  m_WrittenChunkSize = this->GetChunkSizeForWriting();
+  if (pasteRegion != largestPossibleRegion)
+  {
+    if (m_NumberOfResolutionLevels > 1)
+    {
+      itkExceptionMacro(<< "Pasting is only supported in stores of one resolution level. Can't write: "
+                        << this->GetFileName());
+    }
+
+    // the region is pasted in the chunks of the existing array
+    const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+    m_ChannelAxis = GetChannelAxisForWriting(numberOfDimensions, this->GetNumberOfComponents());
+    const std::vector<int> axisDimensions = GetAxisDimensions(numberOfDimensions, m_ChannelAxis);
+    OMEZarrArray           array;
+    try
+    {
+      array.ReadMetadata(this->GetStorePath() + "/0");
+    }
+    catch (ExceptionObject & error)
+    {
+      itkExceptionMacro(<< "Can't paste in " << this->GetFileName() << ". " << error.GetDescription());
+    }
+    if (array.m_Shape.size() != axisDimensions.size())
+    {
+      itkExceptionMacro(<< "Can't paste in " << this->GetFileName() << ", whose image has another dimension");
+    }
+    for (size_t axis = 0; axis < axisDimensions.size(); ++axis)
+    {
+      if (axisDimensions[axis] >= 0)
+      {
+        m_WrittenChunkSize[axisDimensions[axis]] = array.m_Chunks[axis];
+      }
+    }
+    m_MetadataWritten = true;
+  }
+
+  const unsigned int numberOfSplits =
+    Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  if (numberOfSplits <= 1)
+  {
+    return numberOfSplits;
+  }
+
+  return this->GetActualNumberOfSplitsForWritingChunks(
+    numberOfRequestedSplits, pasteRegion, GetBlockSize(m_WrittenChunkSize, m_NumberOfResolutionLevels));
+}
+
+ImageIORegion
+OMEZarrImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                         unsigned int          numberOfActualSplits,
+                                         const ImageIORegion & pasteRegion,
+                                         const ImageIORegion & itkNotUsed(largestPossibleRegion))
+{
+  // each piece is made of whole chunks of every level
+  return this->GetSplitRegionForWritingChunks(
+    ithPiece, numberOfActualSplits, pasteRegion, GetBlockSize(m_WrittenChunkSize, m_NumberOfResolutionLevels));
+}
+
+} // end namespace itk
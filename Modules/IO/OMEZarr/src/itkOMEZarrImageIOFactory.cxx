@@ -0,0 +1,59 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkOMEZarrImageIOFactory.h"
+#include "itkOMEZarrImageIO.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+OMEZarrImageIOFactory::OMEZarrImageIOFactory()
+{
+  this->RegisterOverride(
+    "itkImageIOBase", "itkOMEZarrImageIO", "OME-Zarr Image IO", true, CreateObjectFunction<OMEZarrImageIO>::New());
+}
+
+OMEZarrImageIOFactory::~OMEZarrImageIOFactory() = default;
+
+const char *
+OMEZarrImageIOFactory::GetITKSourceVersion() const
+{
+  return ITK_SOURCE_VERSION;
+}
+
+const char *
+OMEZarrImageIOFactory::GetDescription() const
+{
+  return "OME-Zarr ImageIO Factory, allows the loading of OME-Zarr images into Insight";
+}
+
+// Undocumented API used to register during static initialization.
+// DO NOT CALL DIRECTLY.
+
+static bool OMEZarrImageIOFactoryHasBeenRegistered;
+
+void ITKIOOMEZarr_EXPORT
+     OMEZarrImageIOFactoryRegister__Private()
+{
+  if (!OMEZarrImageIOFactoryHasBeenRegistered)
+  {
+    OMEZarrImageIOFactoryHasBeenRegistered = true;
+    OMEZarrImageIOFactory::RegisterOneFactory();
+  }
+}
+
+} // end namespace itk
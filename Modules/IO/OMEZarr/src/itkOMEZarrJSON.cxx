@@ -0,0 +1,640 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkOMEZarrJSON.h"
+#include "itkMacro.h"
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+class JSONParser
+{
+public:
+  explicit JSONParser(const std::string & text)
+    : m_Text(text)
+  {}
+
+  OMEZarrJSONValue
+  ParseDocument()
+  {
+    OMEZarrJSONValue value = this->ParseValue();
+    this->SkipWhitespace();
+    if (m_Position != m_Text.size())
+    {
+      this->Fail("unexpected characters after the value");
+    }
+    return value;
+  }
+
+private:
+  void
+  Fail(const char * reason) const
+  {
+    itkGenericExceptionMacro(<< "Invalid JSON at character " << m_Position << ": " << reason);
+  }
+
+  void
+  SkipWhitespace()
+  {
+    while (m_Position < m_Text.size() &&
+           (m_Text[m_Position] == ' ' || m_Text[m_Position] == '\t' || m_Text[m_Position] == '\n' ||
+            m_Text[m_Position] == '\r'))
+    {
+      ++m_Position;
+    }
+  }
+
+  bool
+  Consume(const char * token)
+  {
+    const std::string::size_type length = std::char_traits<char>::length(token);
+    if (m_Text.compare(m_Position, length, token) == 0)
+    {
+      m_Position += length;
+      return true;
+    }
+    return false;
+  }
+
+  OMEZarrJSONValue
+  ParseValue()
+  {
+    this->SkipWhitespace();
+    if (m_Position >= m_Text.size())
+    {
+      this->Fail("unexpected end");
+    }
+    const char c = m_Text[m_Position];
+    if (c == '{' || c == '[')
+    {
+      // Objects and arrays are parsed recursively, so their nesting is
+      // bounded to keep the stack from overflowing
+      if (++m_Depth > MaximumDepth)
+      {
+        this->Fail("values nested too deeply");
+      }
+      OMEZarrJSONValue value = (c == '{') ? this->ParseObject() : this->ParseArray();
+      --m_Depth;
+      return value;
+    }
+    if (c == '"')
+    {
+      return OMEZarrJSONValue(this->ParseString());
+    }
+    if (this->Consume("true"))
+    {
+      return OMEZarrJSONValue(true);
+    }
+    if (this->Consume("false"))
+    {
+      return OMEZarrJSONValue(false);
+    }
+    if (this->Consume("null"))
+    {
+      return OMEZarrJSONValue();
+    }
+    // written by Python for the fill values of floating point arrays
+    if (this->Consume("NaN"))
+    {
+      return OMEZarrJSONValue(std::numeric_limits<double>::quiet_NaN());
+    }
+    if (this->Consume("Infinity"))
+    {
+      return OMEZarrJSONValue(std::numeric_limits<double>::infinity());
+    }
+    if (this->Consume("-Infinity"))
+    {
+      return OMEZarrJSONValue(-std::numeric_limits<double>::infinity());
+    }
+    return this->ParseNumber();
+  }
+
+  OMEZarrJSONValue
+  ParseObject()
+  {
+    OMEZarrJSONValue object = OMEZarrJSONValue::MakeObject();
+    ++m_Position;
+    this->SkipWhitespace();
+    if (this->Consume("}"))
+    {
+      return object;
+    }
+    while (true)
+    {
+      this->SkipWhitespace();
+      if (m_Position >= m_Text.size() || m_Text[m_Position] != '"')
+      {
+        this->Fail("expected a member name");
+      }
+      const std::string key = this->ParseString();
+      this->SkipWhitespace();
+      if (!this->Consume(":"))
+      {
+        this->Fail("expected ':'");
+      }
+      object.Set(key, this->ParseValue());
+      this->SkipWhitespace();
+      if (this->Consume("}"))
+      {
+        return object;
+      }
+      if (!this->Consume(","))
+      {
+        this->Fail("expected ',' or '}'");
+      }
+    }
+  }
+
+  OMEZarrJSONValue
+  ParseArray()
+  {
+    OMEZarrJSONValue array = OMEZarrJSONValue::MakeArray();
+    ++m_Position;
+    this->SkipWhitespace();
+    if (this->Consume("]"))
+    {
+      return array;
+    }
+    while (true)
+    {
+      array.Append(this->ParseValue());
+      this->SkipWhitespace();
+      if (this->Consume("]"))
+      {
+        return array;
+      }
+      if (!this->Consume(","))
+      {
+        this->Fail("expected ',' or ']'");
+      }
+    }
+  }
+
+  unsigned int
+  ParseHexadecimal()
+  {
+    if (m_Position + 4 > m_Text.size())
+    {
+      this->Fail("truncated escape sequence");
+    }
+    unsigned int code = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      const char c = m_Text[m_Position++];
+      code <<= 4;
+      if (c >= '0' && c <= '9')
+      {
+        code += c - '0';
+      }
+      else if (c >= 'a' && c <= 'f')
+      {
+        code += c - 'a' + 10;
+      }
+      else if (c >= 'A' && c <= 'F')
+      {
+        code += c - 'A' + 10;
+      }
+      else
+      {
+        this->Fail("invalid escape sequence");
+      }
+    }
+    return code;
+  }
+
+  std::string
+  ParseString()
+  {
+    std::string value;
+    ++m_Position;
+    while (true)
+    {
+      if (m_Position >= m_Text.size())
+      {
+        this->Fail("unterminated string");
+      }
+      const char c = m_Text[m_Position++];
+      if (c == '"')
+      {
+        return value;
+      }
+      if (c != '\\')
+      {
+        value += c;
+        continue;
+      }
+      if (m_Position >= m_Text.size())
+      {
+        this->Fail("unterminated string");
+      }
+      const char escaped = m_Text[m_Position++];
+      switch (escaped)
+      {
+        case '"':
+        case '\\':
+        case '/':
+          value += escaped;
+          break;
+        case 'b':
+          value += '\b';
+          break;
+        case 'f':
+          value += '\f';
+          break;
+        case 'n':
+          value += '\n';
+          break;
+        case 'r':
+          value += '\r';
+          break;
+        case 't':
+          value += '\t';
+          break;
+        case 'u':
+        {
+          unsigned int code = this->ParseHexadecimal();
+          if (code >= 0xDC00 && code < 0xE000)
+          {
+            this->Fail("unpaired low surrogate");
+          }
+          if (code >= 0xD800 && code < 0xDC00)
+          {
+            // a high surrogate, which must be followed by a low one
+            if (!this->Consume("\\u"))
+            {
+              this->Fail("unpaired high surrogate");
+            }
+            const unsigned int low = this->ParseHexadecimal();
+            if (low < 0xDC00 || low >= 0xE000)
+            {
+              this->Fail("unpaired high surrogate");
+            }
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          }
+          // encoded in UTF-8
+          if (code < 0x80)
+          {
+            value += static_cast<char>(code);
+          }
+          else if (code < 0x800)
+          {
+            value += static_cast<char>(0xC0 | (code >> 6));
+            value += static_cast<char>(0x80 | (code & 0x3F));
+          }
+          else if (code < 0x10000)
+          {
+            value += static_cast<char>(0xE0 | (code >> 12));
+            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            value += static_cast<char>(0x80 | (code & 0x3F));
+          }
+          else
+          {
+            value += static_cast<char>(0xF0 | (code >> 18));
+            value += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            value += static_cast<char>(0x80 | (code & 0x3F));
+          }
+          break;
+        }
+        default:
+          this->Fail("invalid escape sequence");
+      }
+    }
+  }
+
+  OMEZarrJSONValue
+  ParseNumber()
+  {
+    const std::string::size_type start = m_Position;
+    while (m_Position < m_Text.size() && std::string("+-0123456789.eE").find(m_Text[m_Position]) != std::string::npos)
+    {
+      ++m_Position;
+    }
+    std::istringstream stream(m_Text.substr(start, m_Position - start));
+    stream.imbue(std::locale::classic());
+    double number;
+    stream >> number;
+    if (start == m_Position || stream.fail() || !stream.eof())
+    {
+      m_Position = start;
+      this->Fail("invalid value");
+    }
+    return OMEZarrJSONValue(number);
+  }
+
+  static constexpr unsigned int MaximumDepth = 512;
+
+  const std::string &    m_Text;
+  std::string::size_type m_Position{ 0 };
+  unsigned int           m_Depth{ 0 };
+};
+
+void
+WriteString(std::string & text, const std::string & value)
+{
+  text += '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        text += "\\\"";
+        break;
+      case '\\':
+        text += "\\\\";
+        break;
+      case '\n':
+        text += "\\n";
+        break;
+      case '\r':
+        text += "\\r";
+        break;
+      case '\t':
+        text += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          static const char digits[] = "0123456789abcdef";
+          text += "\\u00";
+          text += digits[(c >> 4) & 0xF];
+          text += digits[c & 0xF];
+        }
+        else
+        {
+          text += c;
+        }
+    }
+  }
+  text += '"';
+}
+} // namespace
+
+OMEZarrJSONValue::OMEZarrJSONValue(bool value)
+  : m_Type(Type::Boolean)
+  , m_Boolean(value)
+{}
+
+OMEZarrJSONValue::OMEZarrJSONValue(double value)
+  : m_Type(Type::Number)
+  , m_Number(value)
+{}
+
+OMEZarrJSONValue::OMEZarrJSONValue(const std::string & value)
+  : m_Type(Type::String)
+  , m_String(value)
+{}
+
+OMEZarrJSONValue::OMEZarrJSONValue(const char * value)
+  : m_Type(Type::String)
+  , m_String(value)
+{}
+
+OMEZarrJSONValue
+OMEZarrJSONValue::MakeArray()
+{
+  OMEZarrJSONValue array;
+  array.m_Type = Type::Array;
+  return array;
+}
+
+OMEZarrJSONValue
+OMEZarrJSONValue::MakeObject()
+{
+  OMEZarrJSONValue object;
+  object.m_Type = Type::Object;
+  return object;
+}
+
+bool
+OMEZarrJSONValue::GetBoolean() const
+{
+  if (m_Type != Type::Boolean)
+  {
+    itkGenericExceptionMacro(<< "JSON value is not a boolean");
+  }
+  return m_Boolean;
+}
+
+double
+OMEZarrJSONValue::GetNumber() const
+{
+  if (m_Type != Type::Number)
+  {
+    itkGenericExceptionMacro(<< "JSON value is not a number");
+  }
+  return m_Number;
+}
+
+const std::string &
+OMEZarrJSONValue::GetString() const
+{
+  if (m_Type != Type::String)
+  {
+    itkGenericExceptionMacro(<< "JSON value is not a string");
+  }
+  return m_String;
+}
+
+const std::vector<OMEZarrJSONValue> &
+OMEZarrJSONValue::GetElements() const
+{
+  if (m_Type != Type::Array && m_Type != Type::Object)
+  {
+    itkGenericExceptionMacro(<< "JSON value is not an array");
+  }
+  return m_Elements;
+}
+
+void
+OMEZarrJSONValue::Append(const OMEZarrJSONValue & value)
+{
+  m_Elements.push_back(value);
+}
+
+const OMEZarrJSONValue *
+OMEZarrJSONValue::Find(const std::string & key) const
+{
+  if (m_Type != Type::Object)
+  {
+    return nullptr;
+  }
+  for (size_t i = 0; i < m_Keys.size(); ++i)
+  {
+    if (m_Keys[i] == key)
+    {
+      return &m_Elements[i];
+    }
+  }
+  return nullptr;
+}
+
+void
+OMEZarrJSONValue::Set(const std::string & key, const OMEZarrJSONValue & value)
+{
+  for (size_t i = 0; i < m_Keys.size(); ++i)
+  {
+    if (m_Keys[i] == key)
+    {
+      m_Elements[i] = value;
+      return;
+    }
+  }
+  m_Keys.push_back(key);
+  m_Elements.push_back(value);
+}
+
+OMEZarrJSONValue
+OMEZarrJSONValue::Parse(const std::string & text)
+{
+  return JSONParser(text).ParseDocument();
+}
+
+std::string
+OMEZarrJSONValue::ToString() const
+{
+  std::string text;
+  this->Write(text, 0);
+  text += '\n';
+  return text;
+}
+
+OMEZarrJSONValue
+OMEZarrJSONValue::ReadFile(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    itkGenericExceptionMacro(<< "Could not open " << fileName << " for reading.");
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  try
+  {
+    return Parse(text.str());
+  }
+  catch (ExceptionObject & error)
+  {
+    itkGenericExceptionMacro(<< "Could not read " << fileName << ". " << error.GetDescription());
+  }
+}
+
+void
+OMEZarrJSONValue::WriteFile(const std::string & fileName) const
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  const std::string text = this->ToString();
+  file.write(text.data(), text.size());
+  file.close();
+  if (file.fail())
+  {
+    itkGenericExceptionMacro(<< "Could not write " << fileName << ".");
+  }
+}
+
+void
+OMEZarrJSONValue::Write(std::string & text, unsigned int indent) const
+{
+  switch (m_Type)
+  {
+    case Type::Null:
+      text += "null";
+      break;
+    case Type::Boolean:
+      text += m_Boolean ? "true" : "false";
+      break;
+    case Type::Number:
+    {
+      if (std::isnan(m_Number))
+      {
+        text += "\"NaN\"";
+      }
+      else if (std::isinf(m_Number))
+      {
+        text += m_Number > 0 ? "\"Infinity\"" : "\"-Infinity\"";
+      }
+      else
+      {
+        std::ostringstream stream;
+        stream.imbue(std::locale::classic());
+        // integers, as the shapes of the arrays, are written without decimals
+        if (m_Number == std::floor(m_Number) && std::abs(m_Number) < 1e15)
+        {
+          stream << static_cast<long long>(m_Number);
+        }
+        else
+        {
+          stream.precision(17);
+          stream << m_Number;
+        }
+        text += stream.str();
+      }
+      break;
+    }
+    case Type::String:
+      WriteString(text, m_String);
+      break;
+    case Type::Array:
+    case Type::Object:
+    {
+      const bool isObject = m_Type == Type::Object;
+      text += isObject ? '{' : '[';
+      // arrays of numbers, as shapes, are kept on one line
+      bool nested = isObject;
+      for (const auto & element : m_Elements)
+      {
+        nested |= element.m_Type == Type::Array || element.m_Type == Type::Object;
+      }
+      for (size_t i = 0; i < m_Elements.size(); ++i)
+      {
+        text += i > 0 ? "," : "";
+        if (nested)
+        {
+          text += '\n';
+          text.append(2 * (indent + 1), ' ');
+        }
+        else if (i > 0)
+        {
+          text += ' ';
+        }
+        if (isObject)
+        {
+          WriteString(text, m_Keys[i]);
+          text += ": ";
+        }
+        m_Elements[i].Write(text, indent + 1);
+      }
+      if (nested && !m_Elements.empty())
+      {
+        text += '\n';
+        text.append(2 * indent, ' ');
+      }
+      text += isObject ? '}' : ']';
+      break;
+    }
+  }
+}
+
+} // namespace itk
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkOMEZarrJSON_h
+#define itkOMEZarrJSON_h
+
+#include "ITKIOOMEZarrExport.h"
+#include <string>
+#include <vector>
+
+
+namespace itk
+{
+
+/** A JSON value, as the metadata of Zarr arrays and groups, which keeps the
+ * order of the members of objects. Parsing errors throw an
+ * ExceptionObject. */
+class ITKIOOMEZarr_HIDDEN OMEZarrJSONValue
+{
+public:
+  enum class Type
+  {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  OMEZarrJSONValue() = default;
+  OMEZarrJSONValue(bool value);
+  OMEZarrJSONValue(double value);
+  OMEZarrJSONValue(const std::string & value);
+  OMEZarrJSONValue(const char * value);
+
+  static OMEZarrJSONValue
+  MakeArray();
+  static OMEZarrJSONValue
+  MakeObject();
+
+  Type
+  GetType() const
+  {
+    return m_Type;
+  }
+  bool
+  IsNull() const
+  {
+    return m_Type == Type::Null;
+  }
+
+  bool
+  GetBoolean() const;
+  double
+  GetNumber() const;
+  const std::string &
+  GetString() const;
+
+  // Elements of an array, or values of the members of an object
+  const std::vector<OMEZarrJSONValue> &
+  GetElements() const;
+  void
+  Append(const OMEZarrJSONValue & value);
+
+  // Value of the member key of an object, nullptr when the object has none
+  const OMEZarrJSONValue *
+  Find(const std::string & key) const;
+  void
+  Set(const std::string & key, const OMEZarrJSONValue & value);
+
+  static OMEZarrJSONValue
+  Parse(const std::string & text);
+
+  // Serialize, with nested values indented
+  std::string
+  ToString() const;
+
+  // Parse the content of a file, or write it
+  static OMEZarrJSONValue
+  ReadFile(const std::string & fileName);
+  void
+  WriteFile(const std::string & fileName) const;
+
+private:
+  void
+  Write(std::string & text, unsigned int indent) const;
+
+  Type                          m_Type{ Type::Null };
+  bool                          m_Boolean{ false };
+  double                        m_Number{ 0.0 };
+  std::string                   m_String;
+  std::vector<std::string>      m_Keys;
+  std::vector<OMEZarrJSONValue> m_Elements;
+};
+
+} // namespace itk
+
+#endif // itkOMEZarrJSON_h
@@ -0,0 +1,415 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkOMEZarrImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image<PixelType, 3>;
+using MonitorFilterType = itk::PipelineMonitorImageFilter<ImageType>;
+using VectorImageType = itk::VectorImage<float, 2>;
+
+// The pixels of the first resolution level, and those of the second level,
+// the means of blocks of 2 x 2 x 2 pixels, rounded
+PixelType
+PixelValue(const ImageType::IndexType & index, unsigned int level)
+{
+  if (level == 0)
+  {
+    return static_cast<PixelType>(index[2] * 600 + index[1] * 20 + index[0]);
+  }
+  return static_cast<PixelType>(index[2] * 1200 + index[1] * 40 + index[0] * 2 + 311);
+}
+
+bool
+CheckPixels(const ImageType * image, unsigned int level)
+{
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != PixelValue(it.GetIndex(), level))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << it.GetIndex() << " of level " << level << ": expected "
+                << PixelValue(it.GetIndex(), level) << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+ReadLevel(const std::string & fileName, unsigned int level)
+{
+  auto imageIO = itk::OMEZarrImageIO::New();
+  imageIO->SetResolutionLevel(level);
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(imageIO);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+std::string
+ReadText(const std::string & fileName)
+{
+  std::ifstream      file(fileName.c_str());
+  std::ostringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+void
+WriteText(const std::string & fileName, const std::string & text)
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+  file << text;
+}
+
+// Reverses the bytes of the 4 byte elements of every chunk under the
+// directory, as a store written on a system of the other byte order
+void
+ReverseChunkBytes(const std::string & directory)
+{
+  itksys::Directory entries;
+  entries.Load(directory);
+  for (unsigned long i = 0; i < entries.GetNumberOfFiles(); ++i)
+  {
+    const std::string name = entries.GetFile(i);
+    const std::string path = directory + "/" + name;
+    if (name == "." || name == ".." || name == ".zarray")
+    {
+      continue;
+    }
+    if (itksys::SystemTools::FileIsDirectory(path))
+    {
+      ReverseChunkBytes(path);
+      continue;
+    }
+    std::string chunk = ReadText(path);
+    for (size_t j = 0; j + 4 <= chunk.size(); j += 4)
+    {
+      std::reverse(chunk.begin() + j, chunk.begin() + j + 4);
+    }
+    WriteText(path, chunk);
+  }
+}
+
+} // namespace
+
+int
+itkOMEZarrImageIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkOMEZarrImageIOTest.zarr";
+  const std::string streamedFileName = std::string(argv[1]) + "/itkOMEZarrImageIOTestStreamed.ome.zarr";
+  const std::string vectorFileName = std::string(argv[1]) + "/itkOMEZarrImageIOTestVector.zarr";
+  const std::string pastedFileName = std::string(argv[1]) + "/itkOMEZarrImageIOTestPasted.zarr";
+
+  auto imageIO = itk::OMEZarrImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(imageIO, OMEZarrImageIO, ImageIOBase);
+
+  ITK_TEST_SET_GET_VALUE(1u, imageIO->GetNumberOfResolutionLevels());
+  imageIO->SetNumberOfResolutionLevels(3);
+  ITK_TEST_SET_GET_VALUE(3u, imageIO->GetNumberOfResolutionLevels());
+  ITK_TEST_SET_GET_VALUE(0u, imageIO->GetResolutionLevel());
+  ITK_TEST_EXPECT_TRUE(imageIO->GetChunkSize().empty());
+  const itk::ImageIORegion::SizeType chunkSize{ 16, 16, 8 };
+  imageIO->SetChunkSize(chunkSize);
+  ITK_TEST_EXPECT_TRUE(imageIO->GetChunkSize() == chunkSize);
+
+  ITK_TEST_EXPECT_TRUE(imageIO->CanWriteFile(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(imageIO->CanWriteFile(streamedFileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!imageIO->CanWriteFile("image.mha"));
+
+  ImageType::SizeType      size = { { 40, 30, 70 } };
+  ImageType::SpacingType   spacing;
+  ImageType::PointType     origin;
+  auto                     image = ImageType::New();
+  spacing[0] = 0.5;
+  spacing[1] = 0.5;
+  spacing[2] = 2.0;
+  origin[0] = 1.0;
+  origin[1] = 2.0;
+  origin[2] = 3.0;
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PixelValue(it.GetIndex(), 0));
+  }
+
+  // Written whole, with three resolution levels
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(imageIO);
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + "/.zgroup", true));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + "/.zattrs", true));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + "/2/.zarray", true));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + "/0/8/1/2", true));
+  ITK_TEST_EXPECT_TRUE(!itksys::SystemTools::FileExists(fileName + "/3", false));
+  ITK_TEST_EXPECT_TRUE(ReadText(fileName + "/1/.zarray").find("\"shape\": [35, 15, 20]") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(ReadText(fileName + "/1/.zarray").find("\"id\": \"zlib\"") != std::string::npos);
+
+  auto readerIO = itk::OMEZarrImageIO::New();
+  ITK_TEST_EXPECT_TRUE(readerIO->CanReadFile(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!readerIO->CanReadFile(argv[1]));
+
+  // Each level
+  ImageType::Pointer level;
+  ITK_TRY_EXPECT_NO_EXCEPTION(level = ReadLevel<ImageType>(fileName, 0));
+  ITK_TEST_EXPECT_EQUAL(level->GetLargestPossibleRegion().GetSize(), size);
+  ITK_TEST_EXPECT_EQUAL(level->GetSpacing(), spacing);
+  ITK_TEST_EXPECT_EQUAL(level->GetOrigin(), origin);
+  ITK_TEST_EXPECT_TRUE(CheckPixels(level, 0));
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(level = ReadLevel<ImageType>(fileName, 1));
+  ImageType::SizeType levelSize = { { 20, 15, 35 } };
+  ITK_TEST_EXPECT_EQUAL(level->GetLargestPossibleRegion().GetSize(), levelSize);
+  ITK_TEST_EXPECT_EQUAL(level->GetSpacing(), spacing * 2.0);
+  ITK_TEST_EXPECT_TRUE(level->GetOrigin().EuclideanDistanceTo(origin + spacing * 0.5) < 1e-9);
+  ITK_TEST_EXPECT_TRUE(CheckPixels(level, 1));
+
+  // the sizes of odd levels are rounded up
+  ITK_TRY_EXPECT_NO_EXCEPTION(level = ReadLevel<ImageType>(fileName, 2));
+  levelSize = { { 10, 8, 18 } };
+  ITK_TEST_EXPECT_EQUAL(level->GetLargestPossibleRegion().GetSize(), levelSize);
+  ITK_TEST_EXPECT_EQUAL(level->GetSpacing(), spacing * 4.0);
+
+  ITK_TRY_EXPECT_EXCEPTION(ReadLevel<ImageType>(fileName, 3));
+
+  // The region read is enlarged to the chunks
+  readerIO->SetFileName(fileName);
+  readerIO->SetUseStreamedReading(true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readerIO->ReadImageInformation());
+  ITK_TEST_SET_GET_VALUE(3u, readerIO->GetNumberOfResolutionLevels());
+  itk::ImageIORegion requested(3);
+  itk::ImageIORegion expected(3);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    requested.SetIndex(i, 20);
+    requested.SetSize(i, 5);
+  }
+  expected.SetIndex(0, 16);
+  expected.SetSize(0, 16);
+  expected.SetIndex(1, 16);
+  expected.SetSize(1, 14);
+  expected.SetIndex(2, 16);
+  expected.SetSize(2, 16);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GenerateStreamableReadRegionFromRequestedRegion(requested), expected);
+
+  // Streamed from the first store, in pieces of whole chunks of every level:
+  // 8 slices per chunk, times 4 for the last level
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::OMEZarrImageIO::New());
+  reader->SetUseStreaming(true);
+  auto writerMonitor = MonitorFilterType::New();
+  writerMonitor->SetInput(reader->GetOutput());
+
+  auto streamedWriter = itk::ImageFileWriter<ImageType>::New();
+  streamedWriter->SetInput(writerMonitor->GetOutput());
+  streamedWriter->SetFileName(streamedFileName);
+  streamedWriter->SetImageIO(imageIO);
+  streamedWriter->SetNumberOfStreamDivisions(4);
+  streamedWriter->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedWriter->Update());
+
+  const MonitorFilterType::RegionVectorType writtenRegions = writerMonitor->GetUpdatedBufferedRegions();
+  ITK_TEST_EXPECT_EQUAL(writtenRegions.size(), 3u);
+  ITK_TEST_EXPECT_EQUAL(writtenRegions[0], ImageType::RegionType({ { 0, 0, 0 } }, { { 40, 30, 32 } }));
+  ITK_TEST_EXPECT_EQUAL(writtenRegions[1], ImageType::RegionType({ { 0, 0, 32 } }, { { 40, 30, 32 } }));
+  ITK_TEST_EXPECT_EQUAL(writtenRegions[2], ImageType::RegionType({ { 0, 0, 64 } }, { { 40, 30, 6 } }));
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(level = ReadLevel<ImageType>(streamedFileName, 1));
+  ITK_TEST_EXPECT_TRUE(CheckPixels(level, 1));
+
+  // Read in pieces enlarged to the chunks
+  auto streamedReader = itk::ImageFileReader<ImageType>::New();
+  streamedReader->SetFileName(streamedFileName);
+  streamedReader->SetImageIO(itk::OMEZarrImageIO::New());
+  streamedReader->SetUseStreaming(true);
+  auto readerMonitor = MonitorFilterType::New();
+  readerMonitor->SetInput(streamedReader->GetOutput());
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(readerMonitor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  ITK_TEST_EXPECT_TRUE(readerMonitor->VerifyAllInputCanStream(-1));
+  for (const auto & region : readerMonitor->GetUpdatedBufferedRegions())
+  {
+    ITK_TEST_EXPECT_EQUAL(region.GetIndex(2) % 8, 0);
+  }
+  ITK_TEST_EXPECT_TRUE(CheckPixels(streamer->GetOutput(), 0));
+
+  // Several components, in a channel axis, without compression
+  VectorImageType::SizeType vectorSize = { { 50, 40 } };
+  auto                      vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(vectorSize);
+  vectorImage->SetNumberOfComponentsPerPixel(3);
+  vectorImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<VectorImageType> it(vectorImage, vectorImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    VectorImageType::PixelType pixel(3);
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      pixel[k] = static_cast<float>(it.GetIndex()[0] + 100 * it.GetIndex()[1]) + 0.25f * k;
+    }
+    it.Set(pixel);
+  }
+
+  auto vectorIO = itk::OMEZarrImageIO::New();
+  vectorIO->SetChunkSize({ 16, 16 });
+  auto vectorWriter = itk::ImageFileWriter<VectorImageType>::New();
+  vectorWriter->SetInput(vectorImage);
+  vectorWriter->SetFileName(vectorFileName);
+  vectorWriter->SetImageIO(vectorIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vectorWriter->Update());
+  ITK_TEST_EXPECT_TRUE(ReadText(vectorFileName + "/0/.zarray").find("\"shape\": [3, 40, 50]") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(ReadText(vectorFileName + "/0/.zarray").find("\"compressor\": null") != std::string::npos);
+
+  // a region, streamed from the store, pasted in the chunks of another
+  VectorImageType::RegionType pasteRegion({ { 20, 10 } }, { { 20, 25 } });
+  VectorImageType::PixelType  pastedPixel(3);
+  pastedPixel.Fill(-1.0f);
+  auto pastedImage = VectorImageType::New();
+  pastedImage->SetRegions(vectorSize);
+  pastedImage->SetNumberOfComponentsPerPixel(3);
+  pastedImage->Allocate();
+  pastedImage->FillBuffer(pastedPixel);
+  vectorWriter->SetInput(pastedImage);
+  vectorWriter->SetFileName(pastedFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vectorWriter->Update());
+
+  auto vectorReader = itk::ImageFileReader<VectorImageType>::New();
+  vectorReader->SetFileName(vectorFileName);
+  vectorReader->SetImageIO(itk::OMEZarrImageIO::New());
+  vectorReader->SetUseStreaming(true);
+  vectorWriter->SetInput(vectorReader->GetOutput());
+  itk::ImageIORegion pasteIORegion(2);
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    pasteIORegion.SetIndex(i, pasteRegion.GetIndex(i));
+    pasteIORegion.SetSize(i, pasteRegion.GetSize(i));
+  }
+  vectorWriter->SetIORegion(pasteIORegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vectorWriter->Update());
+
+  VectorImageType::Pointer vectorRead;
+  ITK_TRY_EXPECT_NO_EXCEPTION(vectorRead = ReadLevel<VectorImageType>(pastedFileName, 0));
+  ITK_TEST_EXPECT_EQUAL(vectorRead->GetNumberOfComponentsPerPixel(), 3u);
+  for (itk::ImageRegionConstIterator<VectorImageType> it(vectorRead, vectorRead->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const VectorImageType::PixelType expectedPixel =
+      pasteRegion.IsInside(it.GetIndex()) ? vectorImage->GetPixel(it.GetIndex()) : pastedPixel;
+    if (it.Get() != expectedPixel)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong pixel at " << it.GetIndex() << ": expected " << expectedPixel << ", but got " << it.Get()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The elements are stored in the byte order of the data type, whatever
+  // the byte order of the system
+  for (const char * byteOrder : { ">", "<" })
+  {
+    std::string metadata = ReadText(vectorFileName + "/0/.zarray");
+    const auto  dataType = metadata.find("\"dtype\": \"");
+    ITK_TEST_EXPECT_TRUE(dataType != std::string::npos);
+    const auto byteOrderPosition = dataType + std::string("\"dtype\": \"").size();
+    if (metadata[byteOrderPosition] != byteOrder[0])
+    {
+      metadata[byteOrderPosition] = byteOrder[0];
+      WriteText(vectorFileName + "/0/.zarray", metadata);
+      ReverseChunkBytes(vectorFileName + "/0");
+    }
+    ITK_TRY_EXPECT_NO_EXCEPTION(vectorRead = ReadLevel<VectorImageType>(vectorFileName, 0));
+    for (itk::ImageRegionConstIterator<VectorImageType> it(vectorRead, vectorRead->GetLargestPossibleRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != vectorImage->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Wrong pixel at " << it.GetIndex() << " with the byte order " << byteOrder << ": expected "
+                  << vectorImage->GetPixel(it.GetIndex()) << ", but got " << it.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // pasting in several levels is not supported
+  imageIO->SetChunkSize(itk::ImageIORegion::SizeType());
+  vectorWriter->SetImageIO(imageIO);
+  ITK_TRY_EXPECT_EXCEPTION(vectorWriter->Update());
+
+  // Attributes that are not valid JSON are rejected: unpaired surrogates,
+  // and values nested too deeply to be parsed recursively
+  const std::string attributes = ReadText(fileName + "/.zattrs");
+  const auto        readWithAttribute = [&](const std::string & value) {
+    {
+      std::ofstream file((fileName + "/.zattrs").c_str());
+      file << "{\"name\": " << value << ", " << attributes.substr(attributes.find('{') + 1);
+    }
+    auto attributesIO = itk::OMEZarrImageIO::New();
+    attributesIO->SetFileName(fileName);
+    attributesIO->ReadImageInformation();
+  };
+  ITK_TRY_EXPECT_NO_EXCEPTION(readWithAttribute("\"\\ud83d\\ude00\""));
+  ITK_TRY_EXPECT_EXCEPTION(readWithAttribute("\"\\ud83d\""));
+  ITK_TRY_EXPECT_EXCEPTION(readWithAttribute("\"\\ud83d\\u0041\""));
+  ITK_TRY_EXPECT_EXCEPTION(readWithAttribute("\"\\ude00\\ud83d\""));
+  ITK_TRY_EXPECT_NO_EXCEPTION(readWithAttribute(std::string(100, '[') + std::string(100, ']')));
+  ITK_TRY_EXPECT_EXCEPTION(readWithAttribute(std::string(100000, '[') + std::string(100000, ']')));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@ namespace itk
 {
 // BTX
 class TIFFReaderInternal;
+class TIFFWriterInternal;
 // ETX
 
 /**
@@ -38,6 +39,19 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Images stored in strips or in tiles are decoded natively, only the
+ * strips or tiles intersecting the region being read, and independent
+ * strips or tiles are decoded in parallel, each work unit of the
+ * MultiThreaderBase with its own handle on the file. Regions of such
+ * images can be streamed. Other images are read whole through
+ * TIFFReadRGBAImage, as RGBA pixels.
+ *
+ * Images are written in strips, or in tiles when a tile size is set, and
+ * in the BigTIFF format when requested or when the image is larger than
+ * 2 GiB. PackBits and Deflate compressed strips or tiles are compressed in
+ * parallel. Images can be written in pieces of whole rows, in order, as
+ * ImageFileWriter does when streaming with the default region splitter.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -83,6 +97,19 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Regions of images decoded natively, by strips or by tiles, can be
+   * read. Known after ReadImageInformation(). */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** Returns the requested region when it can be streamed, the largest
+   * possible region otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -100,6 +127,32 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Pieces of whole rows of the image can be written, in order. */
+  bool
+  CanStreamWrite() override
+  {
+    return true;
+  }
+
+  /** Starts a new file. Pasting into an existing file is not supported. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the size of the tiles of the written images. Both must be
+   * multiples of 16. The default, 0, writes the images in strips. */
+  itkSetMacro(TileWidth, unsigned int);
+  itkGetConstMacro(TileWidth, unsigned int);
+  itkSetMacro(TileHeight, unsigned int);
+  itkGetConstMacro(TileHeight, unsigned int);
+
+  /** Set/Get whether the images are written in the BigTIFF format, which
+   * is always used for images larger than 2 GiB. Default is false. */
+  itkSetMacro(UseBigTIFF, bool);
+  itkGetConstMacro(UseBigTIFF, bool);
+  itkBooleanMacro(UseBigTIFF);
+
   enum
   {
     NOFORMAT,
@@ -252,12 +305,43 @@ private:
   void
   AllocateTiffPalette(uint16_t bps);
 
+  // Read the part of the current page within the first two dimensions of
+  // region, which must be the whole page for images not decoded natively
   void
-  ReadCurrentPage(void * out, size_t pixelOffset);
+  ReadCurrentPage(void * out, const ImageIORegion & region);
+
+  // Read the part of the current page within the first two dimensions of
+  // region, decoding the strips or tiles that it intersects
+  void
+  ReadCurrentPageRegion(void * out, const ImageIORegion & region);
 
   template <typename TComponent>
   void
-  ReadGenericImage(void * out, unsigned int width, unsigned int height);
+  ReadCurrentPageRegion(void * out, const ImageIORegion & region);
+
+  // Convert width pixels of a decoded strip or tile to the pixels of a row
+  template <typename TComponent>
+  void
+  PutRow(TComponent * to, void * from, unsigned int width, unsigned int format);
+
+  // Set the tags of a page of the written image
+  void
+  WritePageTags(uint16_t page);
+
+  // Write numberOfRows rows of the current page from its row firstRow,
+  // keeping the rows of an incomplete strip or row of tiles for the next
+  // piece
+  void
+  WritePageRows(const char * rows, uint32_t firstRow, uint32_t numberOfRows);
+
+  // Compress and write the strips or tiles of numberOfRows rows from the
+  // row firstRow, which starts a strip or a row of tiles
+  void
+  WriteStripsOrTiles(const char * rows, uint32_t firstRow, uint32_t numberOfRows);
+
+  // Directories of the pages that are not ignored subfiles
+  std::vector<uint16_t>
+  GetPageDirectories();
 
   template <typename TComponent>
   void
@@ -309,6 +393,12 @@ private:
   uint16_t *   m_ColorBlue;
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  bool         m_CanStreamRead{ false };
+
+  TIFFWriterInternal * m_InternalWriter;
+  unsigned int         m_TileWidth{ 0 };
+  unsigned int         m_TileHeight{ 0 };
+  bool                 m_UseBigTIFF{ false };
 };
 } // end namespace itk
 
@@ -7,8 +7,10 @@ itk_module(ITKIOTIFF
     ITKIOImageBase
   PRIVATE_DEPENDS
     ITKTIFF
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
+    ITKTIFF
   FACTORY_NAMES
     ImageIO::TIFF
   DESCRIPTION
@@ -18,11 +18,15 @@
 
 #include "itkTIFFImageIO.h"
 #include "itkTIFFReaderInternal.h"
+#include "itkTIFFWriterInternal.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -53,27 +57,36 @@ TIFFImageIO::CanReadFile(const char * file)
 
 void
 TIFFImageIO::ReadGenericImage(void * out, unsigned int width, unsigned int height)
+{
+  ImageIORegion region(2);
+  region.SetSize(0, width);
+  region.SetSize(1, height);
+  this->ReadCurrentPageRegion(out, region);
+}
+
+void
+TIFFImageIO::ReadCurrentPageRegion(void * out, const ImageIORegion & region)
 {
 
   if (m_ComponentType == IOComponentEnum::UCHAR)
   {
-    this->ReadGenericImage<unsigned char>(out, width, height);
+    this->ReadCurrentPageRegion<unsigned char>(out, region);
   }
   else if (m_ComponentType == IOComponentEnum::CHAR)
   {
-    this->ReadGenericImage<char>(out, width, height);
+    this->ReadCurrentPageRegion<char>(out, region);
   }
   else if (m_ComponentType == IOComponentEnum::USHORT)
   {
-    this->ReadGenericImage<unsigned short>(out, width, height);
+    this->ReadCurrentPageRegion<unsigned short>(out, region);
   }
   else if (m_ComponentType == IOComponentEnum::SHORT)
   {
-    this->ReadGenericImage<short>(out, width, height);
+    this->ReadCurrentPageRegion<short>(out, region);
   }
   else if (m_ComponentType == IOComponentEnum::FLOAT)
   {
-    this->ReadGenericImage<float>(out, width, height);
+    this->ReadCurrentPageRegion<float>(out, region);
   }
 }
 
@@ -144,13 +157,12 @@ TIFFImageIO::GetFormat()
 }
 
 
-/** Read a multipage tiff */
-void
-TIFFImageIO::ReadVolume(void * buffer)
+std::vector<uint16_t>
+TIFFImageIO::GetPageDirectories()
 {
-  const size_t width{ m_InternalImage->m_Width };
-  const size_t height{ m_InternalImage->m_Height };
+  std::vector<uint16_t> directories;
 
+  TIFFSetDirectory(m_InternalImage->m_Image, 0);
   for (uint16 page = 0; page < m_InternalImage->m_NumberOfPages; page++)
   {
     if (m_InternalImage->m_IgnoredSubFiles > 0)
@@ -167,12 +179,46 @@ TIFFImageIO::ReadVolume(void * buffer)
       }
     }
 
+    directories.push_back(page);
+
+    TIFFReadDirectory(m_InternalImage->m_Image);
+  }
+  return directories;
+}
+
 
-    const size_t pixelOffset = width * height * this->GetNumberOfComponents() * page;
+/** Read a multipage tiff */
+void
+TIFFImageIO::ReadVolume(void * buffer)
+{
+  const ImageIORegion & region = this->GetIORegion();
 
-    ReadCurrentPage(buffer, pixelOffset);
+  const std::vector<uint16_t> directories = this->GetPageDirectories();
 
-    TIFFReadDirectory(m_InternalImage->m_Image);
+  // The pages of the region
+  SizeValueType firstPage = 0;
+  SizeValueType numberOfPages = directories.size();
+  if (region.GetImageDimension() > 2)
+  {
+    firstPage = region.GetIndex(2);
+    numberOfPages = region.GetSize(2);
+  }
+  if (firstPage + numberOfPages > directories.size())
+  {
+    itkExceptionMacro(<< "Cannot read page " << firstPage + numberOfPages - 1 << " of the "
+                      << directories.size() << " pages of " << m_FileName);
+  }
+
+  const size_t pageSizeInBytes = region.GetSize(0) * region.GetSize(1) * this->GetPixelSize();
+
+  for (SizeValueType page = 0; page < numberOfPages; ++page)
+  {
+    if (!TIFFReaderInternal::SetDirectory(m_InternalImage->m_Image, directories[firstPage + page]))
+    {
+      itkExceptionMacro(<< "Cannot read page " << firstPage + page << " of " << m_FileName);
+    }
+
+    this->ReadCurrentPage(static_cast<char *>(buffer) + page * pageSizeInBytes, region);
   }
 }
 
@@ -197,7 +243,7 @@ TIFFImageIO::Read(void * buffer)
   }
   else
   {
-    this->ReadCurrentPage(buffer, 0);
+    this->ReadCurrentPage(buffer, this->GetIORegion());
   }
 
   m_InternalImage->Clean();
@@ -219,6 +265,7 @@ TIFFImageIO::TIFFImageIO()
   m_ColorBlue = nullptr;
 
   m_InternalImage = new TIFFReaderInternal;
+  m_InternalWriter = new TIFFWriterInternal;
 
   m_Spacing[0] = 1.0;
   m_Spacing[1] = 1.0;
@@ -239,6 +286,7 @@ TIFFImageIO::~TIFFImageIO()
 {
   m_InternalImage->Clean();
   delete m_InternalImage;
+  delete m_InternalWriter;
 }
 
 void
@@ -248,6 +296,9 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileWidth: " << m_TileWidth << std::endl;
+  os << indent << "TileHeight: " << m_TileHeight << std::endl;
+  os << indent << "UseBigTIFF: " << (m_UseBigTIFF ? "On" : "Off") << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:"
@@ -478,6 +529,8 @@ TIFFImageIO::ReadImageInformation()
   }
 
 
+  m_CanStreamRead = m_InternalImage->CanRead();
+
   if (!m_InternalImage->CanRead())
   {
     //  exception if compression is not supported
@@ -522,6 +575,16 @@ TIFFImageIO::ReadImageInformation()
   }
 }
 
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+  return requested;
+}
+
 bool
 TIFFImageIO::CanWriteFile(const char * name)
 {
@@ -552,12 +615,27 @@ TIFFImageIO::Write(const void * buffer)
   }
 }
 
+unsigned int
+TIFFImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // a new write starts
+  m_InternalWriter->Clean();
+
+  if (pasteRegion != largestPossibleRegion)
+  {
+    itkExceptionMacro("Pasting is not supported! Can't write:" << this->GetFileName());
+  }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
 void
 TIFFImageIO::InternalWrite(const void * buffer)
 {
   const auto * outPtr = static_cast<const char *>(buffer);
 
-  uint16 page, pages = 1;
+  uint16 pages = 1;
 
   const SizeValueType width = m_Dimensions[0];
   const SizeValueType height = m_Dimensions[1];
@@ -566,111 +644,46 @@ TIFFImageIO::InternalWrite(const void * buffer)
     pages = static_cast<uint16>(m_Dimensions[2]);
   }
 
-  auto   scomponents = static_cast<uint16>(this->GetNumberOfComponents());
-  double resolution_x{ m_Spacing[0] != 0.0 ? 25.4 / m_Spacing[0] : 0.0 };
-  double resolution_y{ m_Spacing[1] != 0.0 ? 25.4 / m_Spacing[1] : 0.0 };
-  // rowsperstrip is set to a default value but modified based on the tif scanlinesize before
-  // passing it into the TIFFSetField (see below).
-  auto     rowsperstrip = uint32{ 0 };
-  uint16_t bps;
-
-  switch (this->GetComponentType())
-  {
-    case IOComponentEnum::UCHAR:
-      bps = 8;
-      break;
-    case IOComponentEnum::CHAR:
-      bps = 8;
-      break;
-    case IOComponentEnum::USHORT:
-      bps = 16;
-      break;
-    case IOComponentEnum::SHORT:
-      bps = 16;
-      break;
-    case IOComponentEnum::FLOAT:
-      bps = 32;
-      break;
-    default:
-      itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, and float");
-  }
-
-  uint16_t predictor;
-
-  const char * mode = "w";
-
-  // If the size of the image is greater than 2 GiB then use big tiff
-  constexpr SizeType oneKibiByte = 1024;
-  const SizeType     oneMebiByte = 1024 * oneKibiByte;
-  const SizeType     oneGibiByte = 1024 * oneMebiByte;
-  const SizeType     twoGibiBytes = 2 * oneGibiByte;
-
-  if (this->GetImageSizeInBytes() > twoGibiBytes)
+  // The region written must be whole rows following the rows already
+  // written
+  const ImageIORegion & region = this->GetIORegion();
+  const SizeValueType   firstRow =
+    region.GetIndex(1) + (m_NumberOfDimensions == 3 ? height * region.GetIndex(2) : SizeValueType{ 0 });
+  const SizeValueType numberOfRows = region.GetSize(1) * (m_NumberOfDimensions == 3 ? region.GetSize(2) : 1);
+  if (region.GetIndex(0) != 0 || region.GetSize(0) != width ||
+      (numberOfRows > region.GetSize(1) && region.GetSize(1) != height))
   {
-#ifdef TIFF_INT64_T // detect if libtiff4
-    // Adding the "8" option enables the use of big tiff
-    mode = "w8";
-#else
-    itkExceptionMacro(<< "Size of image exceeds the limit of libtiff.");
-#endif
+    itkExceptionMacro(<< "TIFFImageIO can only write regions of whole rows: " << region);
   }
-
-  TIFF * tif = TIFFOpen(m_FileName.c_str(), mode);
-  if (!tif)
+  if (firstRow != m_InternalWriter->m_NumberOfWrittenRows)
   {
-    itkExceptionMacro("Error while trying to open file for writing: " << this->GetFileName() << std::endl
-                                                                      << "Reason: "
-                                                                      << itksys::SystemTools::GetLastSystemError());
+    itkExceptionMacro(<< "TIFFImageIO can only write the rows of an image in order, expected row "
+                      << m_InternalWriter->m_NumberOfWrittenRows << " but got row " << firstRow);
   }
-
-  if (this->GetComponentType() == IOComponentEnum::SHORT || this->GetComponentType() == IOComponentEnum::CHAR)
+  if ((m_TileWidth == 0) != (m_TileHeight == 0) || m_TileWidth % 16 != 0 || m_TileHeight % 16 != 0)
   {
-    TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_INT);
+    itkExceptionMacro(<< "The tile width and height must both be multiples of 16, or both 0, got " << m_TileWidth
+                      << " x " << m_TileHeight);
   }
-  else if (this->GetComponentType() == IOComponentEnum::FLOAT)
-  {
-    TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
-  }
-
-  auto w = static_cast<uint32>(width);
-  auto h = static_cast<uint32>(height);
 
-  if (m_NumberOfDimensions == 3)
+  if (firstRow == 0)
   {
-    TIFFCreateDirectory(tif);
-  }
-  for (page = 0; page < pages; page++)
-  {
-    TIFFSetDirectory(tif, page);
-    TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, w);
-    TIFFSetField(tif, TIFFTAG_IMAGELENGTH, h);
-    TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
-    TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, scomponents);
-    TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bps); // Fix for stype
-    TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
-    if (this->GetComponentType() == IOComponentEnum::SHORT || this->GetComponentType() == IOComponentEnum::CHAR)
-    {
-      TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_INT);
-    }
-    else if (this->GetComponentType() == IOComponentEnum::FLOAT)
-    {
-      TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
-    }
-    TIFFSetField(tif, TIFFTAG_SOFTWARE, "InsightToolkit");
-
-    if (scomponents > 3)
+    uint16_t bytesPerComponent;
+    switch (this->GetComponentType())
     {
-      // if number of scalar components is greater than 3, that means we assume
-      // there is alpha.
-      uint16 extra_samples = scomponents - 3;
-      auto * sample_info = new uint16[scomponents - 3];
-      sample_info[0] = EXTRASAMPLE_ASSOCALPHA;
-      for (uint16 cc = 1; cc < scomponents - 3; cc++)
-      {
-        sample_info[cc] = EXTRASAMPLE_UNSPECIFIED;
-      }
-      TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, extra_samples, sample_info);
-      delete[] sample_info;
+      case IOComponentEnum::UCHAR:
+      case IOComponentEnum::CHAR:
+        bytesPerComponent = 1;
+        break;
+      case IOComponentEnum::USHORT:
+      case IOComponentEnum::SHORT:
+        bytesPerComponent = 2;
+        break;
+      case IOComponentEnum::FLOAT:
+        bytesPerComponent = 4;
+        break;
+      default:
+        itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, and float");
     }
 
     uint16 compression;
@@ -701,43 +714,186 @@ TIFFImageIO::InternalWrite(const void * buffer)
       compression = COMPRESSION_NONE;
     }
 
-    TIFFSetField(tif, TIFFTAG_COMPRESSION, compression); // Fix for compression
+    const char * mode = "w";
+
+    // If the size of the image is greater than 2 GiB then use big tiff
+    constexpr SizeType oneKibiByte = 1024;
+    const SizeType     oneMebiByte = 1024 * oneKibiByte;
+    const SizeType     oneGibiByte = 1024 * oneMebiByte;
+    const SizeType     twoGibiBytes = 2 * oneGibiByte;
+
+    if (m_UseBigTIFF || this->GetImageSizeInBytes() > twoGibiBytes)
+    {
+#ifdef TIFF_INT64_T // detect if libtiff4
+      // Adding the "8" option enables the use of big tiff
+      mode = "w8";
+#else
+      itkExceptionMacro(<< "Size of image exceeds the limit of libtiff.");
+#endif
+    }
+
+    m_InternalWriter->Clean();
+    TIFF * tif = TIFFOpen(m_FileName.c_str(), mode);
+    if (!tif)
+    {
+      itkExceptionMacro("Error while trying to open file for writing: " << this->GetFileName() << std::endl
+                                                                        << "Reason: "
+                                                                        << itksys::SystemTools::GetLastSystemError());
+    }
 
-    bool paletteAllocated = false;
-    if (scomponents == 1)
+    if (this->GetComponentType() == IOComponentEnum::SHORT || this->GetComponentType() == IOComponentEnum::CHAR)
     {
-      if (this->GetWritePalette())
+      TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_INT);
+    }
+    else if (this->GetComponentType() == IOComponentEnum::FLOAT)
+    {
+      TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
+    }
+
+    if (m_NumberOfDimensions == 3)
+    {
+      TIFFCreateDirectory(tif);
+    }
+
+    m_InternalWriter->m_Image = tif;
+    m_InternalWriter->m_Width = static_cast<uint32>(width);
+    m_InternalWriter->m_Height = static_cast<uint32>(height);
+    m_InternalWriter->m_NumberOfPages = pages;
+    m_InternalWriter->m_Compression = compression;
+    m_InternalWriter->m_BytesPerPixel = bytesPerComponent * this->GetNumberOfComponents();
+    m_InternalWriter->m_TileWidth = m_TileWidth;
+    m_InternalWriter->m_TileHeight = m_TileHeight;
+  }
+
+  try
+  {
+    const SizeValueType rowLength = m_InternalWriter->m_BytesPerPixel * width; // in bytes
+    SizeValueType       remainingRows = numberOfRows;
+    while (remainingRows > 0)
+    {
+      const auto page = static_cast<uint16>(m_InternalWriter->m_NumberOfWrittenRows / height);
+      const auto row = static_cast<uint32>(m_InternalWriter->m_NumberOfWrittenRows % height);
+      if (row == 0)
       {
-        TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_PALETTE);
-        this->AllocateTiffPalette(bps);
-        TIFFSetField(tif, TIFFTAG_COLORMAP, m_ColorRed, m_ColorGreen, m_ColorBlue);
-        paletteAllocated = true;
+        this->WritePageTags(page);
       }
-      else
+
+      const auto rows = static_cast<uint32>(std::min<SizeValueType>(remainingRows, height - row));
+      this->WritePageRows(outPtr, row, rows);
+      outPtr += rows * rowLength;
+      remainingRows -= rows;
+      m_InternalWriter->m_NumberOfWrittenRows += rows;
+
+      if (row + rows == height && m_NumberOfDimensions == 3)
       {
-        TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+        TIFFWriteDirectory(m_InternalWriter->m_Image);
       }
     }
-    else
+  }
+  catch (...)
+  {
+    m_InternalWriter->Clean();
+    throw;
+  }
+
+  if (m_InternalWriter->m_NumberOfWrittenRows == height * pages)
+  {
+    m_InternalWriter->Clean();
+  }
+}
+
+void
+TIFFImageIO::WritePageTags(uint16_t page)
+{
+  TIFF * tif = m_InternalWriter->m_Image;
+
+  const auto     scomponents = static_cast<uint16>(this->GetNumberOfComponents());
+  const uint16_t bps = static_cast<uint16_t>(8 * m_InternalWriter->m_BytesPerPixel / scomponents);
+  const uint16   compression = m_InternalWriter->m_Compression;
+  double         resolution_x{ m_Spacing[0] != 0.0 ? 25.4 / m_Spacing[0] : 0.0 };
+  double         resolution_y{ m_Spacing[1] != 0.0 ? 25.4 / m_Spacing[1] : 0.0 };
+  // rowsperstrip is set to a default value but modified based on the tif scanlinesize before
+  // passing it into the TIFFSetField (see below).
+  auto     rowsperstrip = uint32{ 0 };
+  uint16_t predictor;
+
+  TIFFSetDirectory(tif, page);
+  TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, m_InternalWriter->m_Width);
+  TIFFSetField(tif, TIFFTAG_IMAGELENGTH, m_InternalWriter->m_Height);
+  TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+  TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, scomponents);
+  TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bps); // Fix for stype
+  TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+  if (this->GetComponentType() == IOComponentEnum::SHORT || this->GetComponentType() == IOComponentEnum::CHAR)
+  {
+    TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_INT);
+  }
+  else if (this->GetComponentType() == IOComponentEnum::FLOAT)
+  {
+    TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
+  }
+  TIFFSetField(tif, TIFFTAG_SOFTWARE, "InsightToolkit");
+
+  if (scomponents > 3)
+  {
+    // if number of scalar components is greater than 3, that means we assume
+    // there is alpha.
+    uint16 extra_samples = scomponents - 3;
+    auto * sample_info = new uint16[scomponents - 3];
+    sample_info[0] = EXTRASAMPLE_ASSOCALPHA;
+    for (uint16 cc = 1; cc < scomponents - 3; cc++)
     {
-      if (this->GetWritePalette())
-      {
-        itkWarningMacro(<< "Could not write this image as palette because pixel is not scalar");
-      }
-      TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+      sample_info[cc] = EXTRASAMPLE_UNSPECIFIED;
     }
-    if (compression == COMPRESSION_JPEG)
+    TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, extra_samples, sample_info);
+    delete[] sample_info;
+  }
+
+  TIFFSetField(tif, TIFFTAG_COMPRESSION, compression); // Fix for compression
+
+  if (scomponents == 1)
+  {
+    if (this->GetWritePalette())
     {
-      TIFFSetField(tif, TIFFTAG_JPEGQUALITY, this->GetJPEGQuality());
-      TIFFSetField(tif, TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB);
+      TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_PALETTE);
+      this->AllocateTiffPalette(bps);
+      // the colormap is copied in the directory
+      TIFFSetField(tif, TIFFTAG_COLORMAP, m_ColorRed, m_ColorGreen, m_ColorBlue);
+      _TIFFfree(m_ColorRed);
+      _TIFFfree(m_ColorGreen);
+      _TIFFfree(m_ColorBlue);
     }
-    else if (compression == COMPRESSION_DEFLATE)
+    else
     {
-      predictor = PREDICTOR_NONE;
-      TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor);
+      TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
     }
+  }
+  else
+  {
+    if (this->GetWritePalette())
+    {
+      itkWarningMacro(<< "Could not write this image as palette because pixel is not scalar");
+    }
+    TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+  }
+  if (compression == COMPRESSION_JPEG)
+  {
+    TIFFSetField(tif, TIFFTAG_JPEGQUALITY, this->GetJPEGQuality());
+    TIFFSetField(tif, TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB);
+  }
+  else if (compression == COMPRESSION_DEFLATE)
+  {
+    predictor = PREDICTOR_NONE;
+    TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor);
+  }
 
-
+  if (m_InternalWriter->m_TileWidth != 0)
+  {
+    TIFFSetField(tif, TIFFTAG_TILEWIDTH, m_InternalWriter->m_TileWidth);
+    TIFFSetField(tif, TIFFTAG_TILELENGTH, m_InternalWriter->m_TileHeight);
+  }
+  else
+  {
     // Previously, rowsperstrip was set to a default value so that it would be calculated using
     // the STRIP_SIZE_DEFAULT defined to be 8 kB in tiffiop.h.
     // However, this a very conservative small number, and it leads to very small strips resulting
@@ -770,70 +926,165 @@ TIFFImageIO::InternalWrite(const void * buffer)
     }
 
     TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    TIFFGetField(tif, TIFFTAG_ROWSPERSTRIP, &rowsperstrip);
+    m_InternalWriter->m_RowsPerStrip = std::min(rowsperstrip, m_InternalWriter->m_Height);
+  }
 
-    if (resolution_x > 0 && resolution_y > 0)
-    {
-      TIFFSetField(tif, TIFFTAG_XRESOLUTION, resolution_x);
-      TIFFSetField(tif, TIFFTAG_YRESOLUTION, resolution_y);
-      TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, RESUNIT_INCH);
-    }
+  if (resolution_x > 0 && resolution_y > 0)
+  {
+    TIFFSetField(tif, TIFFTAG_XRESOLUTION, resolution_x);
+    TIFFSetField(tif, TIFFTAG_YRESOLUTION, resolution_y);
+    TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, RESUNIT_INCH);
+  }
 
-    if (m_NumberOfDimensions == 3)
-    {
-      // We are writing single page of the multipage file
-      TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
-      // Set the page number
-      TIFFSetField(tif, TIFFTAG_PAGENUMBER, page, pages);
-    }
-    SizeValueType rowLength; // in bytes
+  if (m_NumberOfDimensions == 3)
+  {
+    // We are writing single page of the multipage file
+    TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
+    // Set the page number
+    TIFFSetField(tif, TIFFTAG_PAGENUMBER, page, m_InternalWriter->m_NumberOfPages);
+  }
+}
 
-    switch (this->GetComponentType())
+void
+TIFFImageIO::WritePageRows(const char * rows, uint32_t firstRow, uint32_t numberOfRows)
+{
+  const uint32_t      height = m_InternalWriter->m_Height;
+  const uint32_t      bandHeight = m_InternalWriter->m_TileWidth != 0 ? m_InternalWriter->m_TileHeight
+                                                                      : m_InternalWriter->m_RowsPerStrip;
+  const size_t        rowLength = m_InternalWriter->m_BytesPerPixel * m_InternalWriter->m_Width;
+  std::vector<char> & pendingRows = m_InternalWriter->m_PendingRows;
+
+  // complete the strip or row of tiles started by the previous piece
+  if (!pendingRows.empty())
+  {
+    const auto     numberOfPendingRows = static_cast<uint32_t>(pendingRows.size() / rowLength);
+    const uint32_t bandFirstRow = firstRow - numberOfPendingRows;
+    const uint32_t bandRows = std::min(bandHeight, height - bandFirstRow);
+    const uint32_t rowsToAdd = std::min(numberOfRows, bandRows - numberOfPendingRows);
+    pendingRows.insert(pendingRows.end(), rows, rows + rowsToAdd * rowLength);
+    rows += rowsToAdd * rowLength;
+    firstRow += rowsToAdd;
+    numberOfRows -= rowsToAdd;
+    if (numberOfPendingRows + rowsToAdd < bandRows)
     {
-      case IOComponentEnum::UCHAR:
-        rowLength = sizeof(unsigned char);
-        break;
-      case IOComponentEnum::USHORT:
-        rowLength = sizeof(unsigned short);
-        break;
-      case IOComponentEnum::CHAR:
-        rowLength = sizeof(char);
-        break;
-      case IOComponentEnum::SHORT:
-        rowLength = sizeof(short);
-        break;
-      case IOComponentEnum::FLOAT:
-        rowLength = sizeof(float);
-        break;
-      default:
-        itkExceptionMacro(<< "TIFF supports unsigned/signed char, unsigned/signed short, and float");
+      return;
     }
+    this->WriteStripsOrTiles(pendingRows.data(), bandFirstRow, bandRows);
+    pendingRows.clear();
+  }
+
+  // the complete strips or rows of tiles are written from the buffer
+  uint32_t completeRows = numberOfRows / bandHeight * bandHeight;
+  if (firstRow + numberOfRows == height)
+  {
+    completeRows = numberOfRows;
+  }
+  if (completeRows > 0)
+  {
+    this->WriteStripsOrTiles(rows, firstRow, completeRows);
+  }
+  pendingRows.assign(rows + completeRows * rowLength, rows + numberOfRows * rowLength);
+}
+
+void
+TIFFImageIO::WriteStripsOrTiles(const char * rows, uint32_t firstRow, uint32_t numberOfRows)
+{
+  TIFF *         tif = m_InternalWriter->m_Image;
+  const bool     tiled = m_InternalWriter->m_TileWidth != 0;
+  const uint32_t width = m_InternalWriter->m_Width;
+  const uint32_t bandWidth = tiled ? m_InternalWriter->m_TileWidth : width;
+  const uint32_t bandHeight = tiled ? m_InternalWriter->m_TileHeight : m_InternalWriter->m_RowsPerStrip;
+  const size_t   bytesPerPixel = m_InternalWriter->m_BytesPerPixel;
+  const size_t   rowLength = bytesPerPixel * width;
+  const size_t   chunkRowLength = bytesPerPixel * bandWidth;
+
+  const uint32_t numberOfChunksAcross = (width + bandWidth - 1) / bandWidth;
+  const uint32_t numberOfBands = (numberOfRows + bandHeight - 1) / bandHeight;
+  const uint32_t numberOfChunks = numberOfChunksAcross * numberOfBands;
+  const uint32_t firstChunk = firstRow / bandHeight * numberOfChunksAcross;
+
+  // The strips and tiles are compressed in parallel by batches, to bound the
+  // memory used, and written in order. libtiff compresses the JPEG ones.
+  const bool     compressedByLibTIFF = m_InternalWriter->m_Compression == COMPRESSION_JPEG;
+  const auto     multiThreader = MultiThreaderBase::New();
+  const uint32_t batchSize = 4 * std::max(multiThreader->GetNumberOfWorkUnits(), 1u);
+
+  std::vector<std::vector<char>> chunks;
+  for (uint32_t batchStart = 0; batchStart < numberOfChunks; batchStart += batchSize)
+  {
+    const uint32_t batchEnd = std::min(batchStart + batchSize, numberOfChunks);
+
+    if (tiled || !compressedByLibTIFF)
+    {
+      chunks.resize(batchEnd - batchStart);
+      multiThreader->ParallelizeArray(
+        batchStart,
+        batchEnd,
+        [&](SizeValueType chunk) {
+          const uint32_t band = static_cast<uint32_t>(chunk) / numberOfChunksAcross;
+          const uint32_t bandRows = std::min(bandHeight, numberOfRows - band * bandHeight);
+          const char *   bandStart = rows + band * bandHeight * rowLength;
+
+          if (!tiled)
+          {
+            m_InternalWriter->Compress(bandStart, rowLength, bandRows, chunks[chunk - batchStart]);
+            return;
+          }
 
-    rowLength *= this->GetNumberOfComponents();
-    rowLength *= width;
+          // the tiles on the right and bottom edges are padded with zeros
+          const uint32_t    column = static_cast<uint32_t>(chunk) % numberOfChunksAcross;
+          const size_t      columnLength = bytesPerPixel * std::min(bandWidth, width - column * bandWidth);
+          std::vector<char> tile(chunkRowLength * bandHeight, 0);
+          for (uint32_t row = 0; row < bandRows; ++row)
+          {
+            std::copy_n(bandStart + row * rowLength + column * chunkRowLength,
+                        columnLength,
+                        tile.data() + row * chunkRowLength);
+          }
+          if (compressedByLibTIFF)
+          {
+            chunks[chunk - batchStart].swap(tile);
+          }
+          else
+          {
+            m_InternalWriter->Compress(tile.data(), chunkRowLength, bandHeight, chunks[chunk - batchStart]);
+          }
+        },
+        nullptr);
+    }
 
-    uint32 row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; idx2++)
+    for (uint32_t chunk = batchStart; chunk < batchEnd; ++chunk)
     {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+      tmsize_t result;
+      if (!tiled && compressedByLibTIFF)
+      {
+        const uint32_t bandRows = std::min(bandHeight, numberOfRows - chunk * bandHeight);
+        result = TIFFWriteEncodedStrip(tif,
+                                       firstChunk + chunk,
+                                       const_cast<char *>(rows + chunk * bandHeight * rowLength),
+                                       static_cast<tmsize_t>(bandRows * rowLength));
+      }
+      else
+      {
+        std::vector<char> & data = chunks[chunk - batchStart];
+        const auto          size = static_cast<tmsize_t>(data.size());
+        if (tiled)
+        {
+          result = compressedByLibTIFF ? TIFFWriteEncodedTile(tif, firstChunk + chunk, data.data(), size)
+                                       : TIFFWriteRawTile(tif, firstChunk + chunk, data.data(), size);
+        }
+        else
+        {
+          result = TIFFWriteRawStrip(tif, firstChunk + chunk, data.data(), size);
+        }
+      }
+      if (result < 0)
       {
         itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
       }
-      outPtr += rowLength;
-      ++row;
-    }
-
-    if (m_NumberOfDimensions == 3)
-    {
-      TIFFWriteDirectory(tif);
-    }
-    if (paletteAllocated)
-    {
-      _TIFFfree(m_ColorRed);
-      _TIFFfree(m_ColorGreen);
-      _TIFFfree(m_ColorBlue);
     }
   }
-  TIFFClose(tif);
 }
 
 
@@ -1271,7 +1522,7 @@ TIFFImageIO::ReadTIFFTags()
 
 
 void
-TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
+TIFFImageIO::ReadCurrentPage(void * buffer, const ImageIORegion & region)
 {
   const uint32 width = m_InternalImage->m_Width;
   const uint32 height = m_InternalImage->m_Height;
@@ -1283,91 +1534,58 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
 
     if (this->GetNumberOfComponents() == 4 && m_ComponentType == IOComponentEnum::UCHAR)
     {
-      tempImage = static_cast<uint32 *>(buffer) + (pixelOffset / 4);
+      tempImage = static_cast<uint32 *>(buffer);
     }
     else
     {
       itkExceptionMacro("Logic Error: Unexpected buffer type!")
     }
 
+    if (region.GetIndex(0) != 0 || region.GetSize(0) != width || region.GetIndex(1) != 0 ||
+        region.GetSize(1) != height)
+    {
+      itkExceptionMacro(<< "Cannot read a part of a TIFF image read as a TIFF RGBA image");
+    }
+
     if (!TIFFReadRGBAImageOriented(m_InternalImage->m_Image, width, height, tempImage, ORIENTATION_TOPLEFT, 1))
     {
       itkExceptionMacro(<< "Cannot read TIFF image as a TIFF RGBA image");
     }
 
-    unsigned char * out = static_cast<unsigned char *>(buffer) + pixelOffset;
-    RGBAImageToBuffer<unsigned char>(out, tempImage);
+    RGBAImageToBuffer<unsigned char>(buffer, tempImage);
   }
   else
   {
 
     this->InitializeColors();
 
-
-    if (m_ComponentType == IOComponentEnum::USHORT)
-    {
-      auto * volume = static_cast<unsigned short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else if (m_ComponentType == IOComponentEnum::SHORT)
-    {
-      auto * volume = static_cast<short *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else if (m_ComponentType == IOComponentEnum::CHAR)
-    {
-      auto * volume = static_cast<char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else if (m_ComponentType == IOComponentEnum::FLOAT)
-    {
-      auto * volume = static_cast<float *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
-    else
-    {
-      auto * volume = static_cast<unsigned char *>(buffer);
-      volume += pixelOffset;
-      this->ReadGenericImage(volume, width, height);
-    }
+    this->ReadCurrentPageRegion(buffer, region);
   }
 }
 
 template <typename TComponent>
 void
-TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int height)
+TIFFImageIO::ReadCurrentPageRegion(void * buffer, const ImageIORegion & region)
 {
-  using ComponentType = TComponent;
-
-#ifdef TIFF_INT64_T // detect if libtiff4
-  uint64_t isize = TIFFScanlineSize64(m_InternalImage->m_Image);
-#else
-  tsize_t isize = TIFFScanlineSize(m_InternalImage->m_Image);
-#endif
-
-  size_t  inc;
-  tdata_t buf = _TIFFmalloc(static_cast<tmsize_t>(isize));
-  isize /= sizeof(ComponentType);
-
-  auto *          out = static_cast<ComponentType *>(_out);
-  ComponentType * image;
+  TIFF * const   image = m_InternalImage->m_Image;
+  const uint32   width = m_InternalImage->m_Width;
+  const uint32   height = m_InternalImage->m_Height;
+  const uint16_t orientation = m_InternalImage->m_Orientation;
 
   if (m_InternalImage->m_PlanarConfig != PLANARCONFIG_CONTIG && m_InternalImage->m_SamplesPerPixel != 1)
   {
     itkExceptionMacro(<< "This reader can only do PLANARCONFIG_CONTIG or single-component PLANARCONFIG_SEPARATE");
   }
 
-  if (m_InternalImage->m_Orientation != ORIENTATION_TOPLEFT && m_InternalImage->m_Orientation != ORIENTATION_BOTLEFT)
+  if (orientation != ORIENTATION_TOPLEFT && orientation != ORIENTATION_BOTLEFT)
   {
     itkExceptionMacro(<< "This reader can only do ORIENTATION_TOPLEFT and  ORIENTATION_BOTLEFT.");
   }
 
+  const unsigned int format = this->GetFormat();
 
-  switch (this->GetFormat())
+  size_t inc;
+  switch (format)
   {
     case TIFFImageIO::GRAYSCALE:
     case TIFFImageIO::PALETTE_GRAYSCALE:
@@ -1393,87 +1611,181 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       break;
   }
 
-  for (uint32 row = 0; row < height; ++row)
+  // A strip is decoded like a tile as wide as the page
+  const bool isTiled = TIFFIsTiled(image) != 0;
+  uint32     tileWidth = width;
+  uint32     tileHeight = height;
+  if (isTiled)
   {
-    if (TIFFReadScanline(m_InternalImage->m_Image, buf, row, 0) <= 0)
-    {
-      itkExceptionMacro(<< "Problem reading the row: " << row);
-    }
+    TIFFGetField(image, TIFFTAG_TILEWIDTH, &tileWidth);
+    TIFFGetField(image, TIFFTAG_TILELENGTH, &tileHeight);
+  }
+  else
+  {
+    TIFFGetFieldDefaulted(image, TIFFTAG_ROWSPERSTRIP, &tileHeight);
+    tileHeight = std::min(tileHeight, height);
+  }
+  if (tileWidth == 0 || tileHeight == 0)
+  {
+    itkExceptionMacro(<< "Invalid tile or strip size in " << m_FileName);
+  }
+  const tmsize_t tileSize = isTiled ? TIFFTileSize(image) : TIFFStripSize(image);
+  const size_t   bytesPerPixel = m_InternalImage->m_SamplesPerPixel * (m_InternalImage->m_BitsPerSample / 8);
 
-    if (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT)
-    {
-      image = out + inc * row * width;
-    }
-    else // bottom left
-    {
-      image = out + inc * width * (height - (row + 1));
+  // The rows of the page that hold the region, and the tiles that hold them
+  const uint32 regionX = static_cast<uint32>(region.GetIndex(0));
+  const uint32 regionY = static_cast<uint32>(region.GetIndex(1));
+  const uint32 regionWidth = static_cast<uint32>(region.GetSize(0));
+  const uint32 regionHeight = static_cast<uint32>(region.GetSize(1));
+  if (regionWidth == 0 || regionHeight == 0)
+  {
+    return;
+  }
+  const uint32 firstRow = (orientation == ORIENTATION_TOPLEFT) ? regionY : height - (regionY + regionHeight);
+  const uint32 endRow = firstRow + regionHeight;
+
+  const uint32        firstTileRow = firstRow / tileHeight;
+  const uint32        firstTileColumn = regionX / tileWidth;
+  const uint32        numberOfTileColumns = (regionX + regionWidth - 1) / tileWidth - firstTileColumn + 1;
+  const SizeValueType numberOfTiles =
+    static_cast<SizeValueType>(numberOfTileColumns) * ((endRow - 1) / tileHeight - firstTileRow + 1);
+
+  auto * out = static_cast<TComponent *>(buffer);
+
+  // Decode the tiles [first, last) of the region with the handle tiff
+  const auto readTiles = [&](TIFF * tiff, SizeValueType first, SizeValueType last) {
+    std::vector<unsigned char> tile(tileSize);
+    for (SizeValueType t = first; t < last; ++t)
+    {
+      const uint32 tileRow = (firstTileRow + static_cast<uint32>(t / numberOfTileColumns)) * tileHeight;
+      const uint32 tileColumn = (firstTileColumn + static_cast<uint32>(t % numberOfTileColumns)) * tileWidth;
+      const uint32 rowBegin = std::max(tileRow, firstRow);
+      const uint32 rowEnd = std::min(tileRow + tileHeight, endRow);
+      const uint32 columnBegin = std::max(tileColumn, regionX);
+      const uint32 columnEnd = std::min(tileColumn + tileWidth, regionX + regionWidth);
+
+      const tmsize_t decodedSize =
+        isTiled ? TIFFReadEncodedTile(tiff, TIFFComputeTile(tiff, tileColumn, tileRow, 0, 0), tile.data(), tileSize)
+                : TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, tileRow, 0), tile.data(), tileSize);
+      if (decodedSize < 0 ||
+          static_cast<size_t>(decodedSize) < bytesPerPixel * tileWidth * static_cast<size_t>(rowEnd - tileRow))
+      {
+        itkExceptionMacro(<< "Problem reading the " << (isTiled ? "tile" : "strip") << " at row " << tileRow
+                          << " and column " << tileColumn);
+      }
+
+      for (uint32 row = rowBegin; row < rowEnd; ++row)
+      {
+        const uint32 y = (orientation == ORIENTATION_TOPLEFT) ? row : height - (row + 1);
+        TComponent * to =
+          out + inc * (static_cast<size_t>(y - regionY) * regionWidth + static_cast<size_t>(columnBegin - regionX));
+        unsigned char * from =
+          tile.data() + bytesPerPixel * (static_cast<size_t>(row - tileRow) * tileWidth + (columnBegin - tileColumn));
+        this->PutRow<TComponent>(to, from, columnEnd - columnBegin, format);
+      }
     }
+  };
 
-    switch (this->GetFormat())
-    {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+  if (m_InternalImage->m_MultiThreader.IsNull())
+  {
+    m_InternalImage->m_MultiThreader = MultiThreaderBase::New();
+  }
+  MultiThreaderBase * const multiThreader = m_InternalImage->m_MultiThreader;
+  const auto                numberOfWorkUnits =
+    static_cast<SizeValueType>(std::min<SizeValueType>(multiThreader->GetNumberOfWorkUnits(), numberOfTiles));
+  if (numberOfWorkUnits < 2)
+  {
+    readTiles(image, 0, numberOfTiles);
+    return;
+  }
+
+  // A libtiff handle can not be shared between threads: the first work unit
+  // decodes with the handle of the page, the others each with their own
+  m_InternalImage->CreateWorkUnitImages(static_cast<unsigned int>(numberOfWorkUnits));
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](SizeValueType workUnit) {
+      const SizeValueType first = numberOfTiles * workUnit / numberOfWorkUnits;
+      const SizeValueType last = numberOfTiles * (workUnit + 1) / numberOfWorkUnits;
+      TIFF * const        tiff =
+        workUnit == 0 ? image
+                      : m_InternalImage->GetWorkUnitImage(static_cast<unsigned int>(workUnit), m_FileName.c_str());
+      if (tiff == nullptr)
+      {
+        itkExceptionMacro(<< "Cannot open file " << m_FileName << "!");
+      }
+      readTiles(tiff, first, last);
+    },
+    nullptr);
+}
+
+template <typename TComponent>
+void
+TIFFImageIO::PutRow(TComponent * to, void * from, unsigned int width, unsigned int format)
+{
+  using ComponentType = TComponent;
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
+  switch (format)
+  {
+    case TIFFImageIO::GRAYSCALE:
+      // check inverted
+      PutGrayscale<ComponentType>(to, static_cast<ComponentType *>(from), width, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<ComponentType>(to, static_cast<ComponentType *>(from), width, 1, 0, 0);
+      break;
+
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      switch (m_InternalImage->m_BitsPerSample)
+      {
+        case 8:
+          PutPaletteGrayscale<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), width, 1, 0, 0);
+          break;
+        case 16:
+          PutPaletteGrayscale<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), width, 1, 0, 0);
+          break;
+        default:
+          itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                            << "-bit samples with palette.");
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), width, 1, 0, 0);
             break;
           case 16:
-            PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), width, 1, 0, 0);
             break;
           default:
             itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
                               << "-bit samples with palette.");
         }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
-        }
-        else
+      }
+      else
+      {
+        switch (m_InternalImage->m_BitsPerSample)
         {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
+          case 8:
+            PutPaletteScalar<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), width, 1, 0, 0);
+            break;
+          case 16:
+            PutPaletteScalar<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), width, 1, 0, 0);
+            break;
+          default:
+            itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                              << "-bit samples with palette.");
         }
-        break;
+      }
+      break;
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
@@ -58,6 +58,48 @@ TIFFReaderInternal::Open(const char * filename)
   return 1;
 }
 
+int
+TIFFReaderInternal::SetDirectory(TIFF * image, tdir_t directory)
+{
+  tdir_t current = TIFFCurrentDirectory(image);
+  if (current > directory)
+  {
+    return TIFFSetDirectory(image, directory);
+  }
+  for (; current < directory; ++current)
+  {
+    if (!TIFFReadDirectory(image))
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+void
+TIFFReaderInternal::CreateWorkUnitImages(unsigned int numberOfWorkUnits)
+{
+  if (this->m_WorkUnitImages.size() + 1 < numberOfWorkUnits)
+  {
+    this->m_WorkUnitImages.resize(numberOfWorkUnits - 1, nullptr);
+  }
+}
+
+TIFF *
+TIFFReaderInternal::GetWorkUnitImage(unsigned int workUnit, const char * filename)
+{
+  TIFF *& image = this->m_WorkUnitImages[workUnit - 1];
+  if (image == nullptr)
+  {
+    image = TIFFOpen(filename, "r");
+  }
+  if (image == nullptr || !SetDirectory(image, TIFFCurrentDirectory(this->m_Image)))
+  {
+    return nullptr;
+  }
+  return image;
+}
+
 void
 TIFFReaderInternal::Clean()
 {
@@ -66,6 +108,14 @@ TIFFReaderInternal::Clean()
     TIFFClose(this->m_Image);
   }
   this->m_Image = nullptr;
+  for (TIFF * image : this->m_WorkUnitImages)
+  {
+    if (image)
+    {
+      TIFFClose(image);
+    }
+  }
+  this->m_WorkUnitImages.clear();
   this->m_Width = 0;
   this->m_Height = 0;
   this->m_SamplesPerPixel = 0;
@@ -195,9 +245,7 @@ TIFFReaderInternal::CanRead()
 {
   const bool compressionSupported = (TIFFIsCODECConfigured(this->m_Compression) == 1);
   return (this->m_Image && (this->m_Width > 0) && (this->m_Height > 0) && (this->m_SamplesPerPixel > 0) &&
-          compressionSupported && (m_NumberOfTiles == 0) // just use TIFFReadRGBAImage, an
-                                                         // native optimized version would be nice
-          && (this->m_HasValidPhotometricInterpretation) &&
+          compressionSupported && (this->m_HasValidPhotometricInterpretation) &&
           (this->m_Photometrics == PHOTOMETRIC_RGB || this->m_Photometrics == PHOTOMETRIC_MINISWHITE ||
            this->m_Photometrics == PHOTOMETRIC_MINISBLACK ||
            (this->m_Photometrics == PHOTOMETRIC_PALETTE && this->m_BitsPerSample != 32)) &&
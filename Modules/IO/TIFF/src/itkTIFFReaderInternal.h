@@ -20,8 +20,11 @@
 
 #include "ITKIOTIFFExport.h"
 #include "itkIntTypes.h"
+#include "itkMultiThreaderBase.h"
 #include "itk_tiff.h"
 
+#include <vector>
+
 
 namespace itk
 {
@@ -42,6 +45,20 @@ public:
   int
   Open(const char * filename);
 
+  // Make directory the current directory of image, reading the directories
+  // that follow the current one in order rather than from the first one
+  static int
+  SetDirectory(TIFF * image, tdir_t directory);
+
+  // The handle on filename of the work unit workUnit > 0, opened on first
+  // use, at the current directory of m_Image. Handles are created by the
+  // calling thread with CreateWorkUnitImages(), and closed by Clean().
+  TIFF *
+  GetWorkUnitImage(unsigned int workUnit, const char * filename);
+
+  void
+  CreateWorkUnitImages(unsigned int numberOfWorkUnits);
+
   TIFF *   m_Image;
   bool     m_IsOpen;
   uint32_t m_Width;
@@ -66,6 +83,11 @@ public:
   float    m_XResolution;
   float    m_YResolution;
   uint16_t m_SampleFormat;
+
+  // Decodes strips or tiles in parallel; the first work unit uses m_Image,
+  // the others their own handles, kept open for all the pages of a volume
+  MultiThreaderBase::Pointer m_MultiThreader;
+  std::vector<TIFF *>        m_WorkUnitImages;
 };
 
 } // namespace itk
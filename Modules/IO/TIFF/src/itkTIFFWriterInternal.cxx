@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkTIFFWriterInternal.h"
+#include "itkMacro.h"
+#include "itk_zlib.h"
+
+namespace itk
+{
+
+namespace
+{
+// Append the PackBits encoding of a row, whose runs do not cross rows as
+// in libtiff
+void
+PackBitsRow(const unsigned char * row, size_t rowSize, std::vector<char> & compressed)
+{
+  size_t i = 0;
+  while (i < rowSize)
+  {
+    size_t run = 1;
+    while (i + run < rowSize && run < 128 && row[i + run] == row[i])
+    {
+      ++run;
+    }
+    if (run >= 2)
+    {
+      compressed.push_back(static_cast<char>(1 - static_cast<int>(run)));
+      compressed.push_back(static_cast<char>(row[i]));
+      i += run;
+    }
+    else
+    {
+      const size_t literal = i;
+      while (i < rowSize && i - literal < 128 && !(i + 1 < rowSize && row[i] == row[i + 1]))
+      {
+        ++i;
+      }
+      compressed.push_back(static_cast<char>(i - literal - 1));
+      compressed.insert(compressed.end(), row + literal, row + i);
+    }
+  }
+}
+} // namespace
+
+TIFFWriterInternal::TIFFWriterInternal()
+{
+  this->m_Image = nullptr;
+  this->Clean();
+}
+
+TIFFWriterInternal::~TIFFWriterInternal()
+{
+  this->Clean();
+}
+
+void
+TIFFWriterInternal::Clean()
+{
+  if (this->m_Image)
+  {
+    TIFFClose(this->m_Image);
+  }
+  this->m_Image = nullptr;
+  this->m_Width = 0;
+  this->m_Height = 0;
+  this->m_NumberOfPages = 0;
+  this->m_Compression = COMPRESSION_NONE;
+  this->m_BytesPerPixel = 0;
+  this->m_TileWidth = 0;
+  this->m_TileHeight = 0;
+  this->m_RowsPerStrip = 0;
+  this->m_NumberOfWrittenRows = 0;
+  this->m_PendingRows.clear();
+}
+
+void
+TIFFWriterInternal::Compress(const char *        rows,
+                             size_t              rowSize,
+                             size_t              numberOfRows,
+                             std::vector<char> & compressed) const
+{
+  const size_t size = rowSize * numberOfRows;
+
+  switch (this->m_Compression)
+  {
+    case COMPRESSION_NONE:
+      compressed.assign(rows, rows + size);
+      break;
+    case COMPRESSION_PACKBITS:
+      compressed.clear();
+      compressed.reserve(size + (size + 127) / 128);
+      for (size_t row = 0; row < numberOfRows; ++row)
+      {
+        PackBitsRow(reinterpret_cast<const unsigned char *>(rows) + row * rowSize, rowSize, compressed);
+      }
+      break;
+    case COMPRESSION_DEFLATE:
+    case COMPRESSION_ADOBE_DEFLATE:
+    {
+      // A zlib stream, at the default level of libtiff
+      auto compressedSize = static_cast<uLongf>(compressBound(static_cast<uLong>(size)));
+      compressed.resize(compressedSize);
+      if (compress2(reinterpret_cast<Bytef *>(compressed.data()),
+                    &compressedSize,
+                    reinterpret_cast<const Bytef *>(rows),
+                    static_cast<uLong>(size),
+                    Z_DEFAULT_COMPRESSION) != Z_OK)
+      {
+        itkGenericExceptionMacro(<< "Deflate compression of a TIFF strip or tile failed");
+      }
+      compressed.resize(compressedSize);
+      break;
+    }
+    default:
+      itkGenericExceptionMacro(<< "TIFF compression " << this->m_Compression << " is only done by libtiff");
+  }
+}
+
+} // namespace itk
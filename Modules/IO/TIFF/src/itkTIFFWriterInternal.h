@@ -0,0 +1,67 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTIFFWriterInternal_h
+#define itkTIFFWriterInternal_h
+
+#include "ITKIOTIFFExport.h"
+#include "itkIntTypes.h"
+#include "itk_tiff.h"
+#include <vector>
+
+
+namespace itk
+{
+
+/** State of a TIFF file being written, possibly over several calls to
+ * TIFFImageIO::Write() when the image is streamed, and the codecs that
+ * compress its strips or tiles outside of libtiff, so that they can be
+ * compressed concurrently. */
+class ITKIOTIFF_HIDDEN TIFFWriterInternal
+{
+public:
+  TIFFWriterInternal();
+  ~TIFFWriterInternal();
+
+  void
+  Clean();
+
+  // Compress rows of rowSize bytes with the compression of the file, which
+  // must not be JPEG, into compressed
+  void
+  Compress(const char * rows, size_t rowSize, size_t numberOfRows, std::vector<char> & compressed) const;
+
+  TIFF *   m_Image;
+  uint32_t m_Width;
+  uint32_t m_Height;
+  uint16_t m_NumberOfPages;
+  uint16_t m_Compression;
+  size_t   m_BytesPerPixel;
+  uint32_t m_TileWidth; // 0 for an image written in strips
+  uint32_t m_TileHeight;
+  uint32_t m_RowsPerStrip;
+
+  // Rows of the image (over all pages) already received
+  SizeValueType m_NumberOfWrittenRows;
+
+  // Rows received for a strip or a row of tiles that is not complete yet
+  std::vector<char> m_PendingRows;
+};
+
+} // namespace itk
+
+#endif // itkTIFFWriterInternal_h
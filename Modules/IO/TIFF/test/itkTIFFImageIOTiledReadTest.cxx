@@ -0,0 +1,287 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkTIFFImageIO.h"
+#include "itkVectorImage.h"
+#include "itk_tiff.h"
+
+namespace
+{
+
+struct TIFFFileDescription
+{
+  const char * m_Name;
+  uint32       m_Width;
+  uint32       m_Height;
+  uint16       m_NumberOfPages;
+  uint16       m_SamplesPerPixel;
+  uint16       m_BitsPerSample;
+  uint16       m_SampleFormat;
+  uint16       m_Orientation;
+  uint16       m_Compression;
+  uint32       m_TileWidth; // 0 for an image stored in strips
+  uint32       m_TileHeight;
+  uint32       m_RowsPerStrip;
+};
+
+double
+PixelValue(unsigned int x, unsigned int y, unsigned int page, unsigned int sample)
+{
+  return (7 * x + 13 * y + 31 * page + 5 * sample) % 251;
+}
+
+template <typename TSample>
+void
+FillSamples(const TIFFFileDescription & description,
+            std::vector<TSample> &      samples,
+            uint32                      firstColumn,
+            uint32                      firstRow,
+            uint32                      width,
+            uint32                      height,
+            uint16                      page)
+{
+  samples.assign(static_cast<size_t>(width) * height * description.m_SamplesPerPixel, TSample{});
+  for (uint32 row = firstRow; row < std::min(firstRow + height, description.m_Height); ++row)
+  {
+    // Rows are stored from the bottom up in a bottom left oriented file
+    const uint32 y = description.m_Orientation == ORIENTATION_TOPLEFT ? row : description.m_Height - 1 - row;
+    for (uint32 x = firstColumn; x < std::min(firstColumn + width, description.m_Width); ++x)
+    {
+      for (uint16 s = 0; s < description.m_SamplesPerPixel; ++s)
+      {
+        samples[((row - firstRow) * width + x - firstColumn) * description.m_SamplesPerPixel + s] =
+          static_cast<TSample>(PixelValue(x, y, page, s));
+      }
+    }
+  }
+}
+
+// Write a TIFF file with libtiff, in strips or in tiles
+template <typename TSample>
+bool
+WriteTIFFFile(const TIFFFileDescription & description, const std::string & fileName)
+{
+  TIFF * tiff = TIFFOpen(fileName.c_str(), "w");
+  if (tiff == nullptr)
+  {
+    return false;
+  }
+
+  std::vector<TSample> samples;
+  for (uint16 page = 0; page < description.m_NumberOfPages; ++page)
+  {
+    TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, description.m_Width);
+    TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, description.m_Height);
+    TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, description.m_SamplesPerPixel);
+    TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, description.m_BitsPerSample);
+    TIFFSetField(tiff, TIFFTAG_SAMPLEFORMAT, description.m_SampleFormat);
+    TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+    TIFFSetField(
+      tiff, TIFFTAG_PHOTOMETRIC, description.m_SamplesPerPixel == 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK);
+    TIFFSetField(tiff, TIFFTAG_ORIENTATION, description.m_Orientation);
+    TIFFSetField(tiff, TIFFTAG_COMPRESSION, description.m_Compression);
+
+    if (description.m_TileWidth > 0)
+    {
+      TIFFSetField(tiff, TIFFTAG_TILEWIDTH, description.m_TileWidth);
+      TIFFSetField(tiff, TIFFTAG_TILELENGTH, description.m_TileHeight);
+      for (uint32 row = 0; row < description.m_Height; row += description.m_TileHeight)
+      {
+        for (uint32 column = 0; column < description.m_Width; column += description.m_TileWidth)
+        {
+          FillSamples(description, samples, column, row, description.m_TileWidth, description.m_TileHeight, page);
+          if (TIFFWriteEncodedTile(tiff,
+                                   TIFFComputeTile(tiff, column, row, 0, 0),
+                                   samples.data(),
+                                   samples.size() * sizeof(TSample)) < 0)
+          {
+            TIFFClose(tiff);
+            return false;
+          }
+        }
+      }
+    }
+    else
+    {
+      TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, description.m_RowsPerStrip);
+      for (uint32 row = 0; row < description.m_Height; row += description.m_RowsPerStrip)
+      {
+        const uint32 height = std::min(description.m_RowsPerStrip, description.m_Height - row);
+        FillSamples(description, samples, 0, row, description.m_Width, height, page);
+        if (TIFFWriteEncodedStrip(
+              tiff, TIFFComputeStrip(tiff, row, 0), samples.data(), samples.size() * sizeof(TSample)) < 0)
+        {
+          TIFFClose(tiff);
+          return false;
+        }
+      }
+    }
+    TIFFWriteDirectory(tiff);
+  }
+  TIFFClose(tiff);
+  return true;
+}
+
+template <typename TImage>
+bool
+CheckPixels(const TIFFFileDescription & description, const TImage * image)
+{
+  for (itk::ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    const unsigned int               page = TImage::ImageDimension > 2 ? index[TImage::ImageDimension - 1] : 0;
+    for (unsigned int s = 0; s < description.m_SamplesPerPixel; ++s)
+    {
+      if (it.Get()[s] != PixelValue(index[0], index[1], page, s))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Wrong sample " << s << " at " << index << " in " << description.m_Name << ": expected "
+                  << PixelValue(index[0], index[1], page, s) << ", but got " << it.Get()[s] << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Read the file whole, and by streaming it in pieces
+template <unsigned int VDimension>
+bool
+ReadTIFFFile(const TIFFFileDescription & description, const std::string & fileName)
+{
+  using ImageType = itk::VectorImage<float, VDimension>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::TIFFImageIO::New());
+  reader->Update();
+  if (!CheckPixels(description, reader->GetOutput()))
+  {
+    return false;
+  }
+
+  if (!reader->GetImageIO()->CanStreamRead() ||
+      reader->GetImageIO()->GetNumberOfComponents() != description.m_SamplesPerPixel)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << description.m_Name << " is not read natively" << std::endl;
+    return false;
+  }
+
+  constexpr unsigned int numberOfStreamDivisions = 5;
+
+  auto streamingReader = ReaderType::New();
+  streamingReader->SetFileName(fileName);
+  streamingReader->SetUseStreaming(true);
+
+  using MonitorFilterType = itk::PipelineMonitorImageFilter<ImageType>;
+  auto monitor = MonitorFilterType::New();
+  monitor->SetInput(streamingReader->GetOutput());
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(monitor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  streamer->Update();
+
+  // A volume is split along its pages, into fewer pieces when they are few
+  if (!monitor->VerifyAllInputCanStream(-3))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << description.m_Name << " was not streamed" << std::endl;
+    return false;
+  }
+  return CheckPixels(description, streamer->GetOutput());
+}
+
+} // namespace
+
+int
+itkTIFFImageIOTiledReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const TIFFFileDescription descriptions[] = {
+    { "TiledUChar", 100, 75, 1, 1, 8, SAMPLEFORMAT_UINT, ORIENTATION_TOPLEFT, COMPRESSION_LZW, 16, 16, 0 },
+    { "TiledRGBUShort", 70, 50, 1, 3, 16, SAMPLEFORMAT_UINT, ORIENTATION_TOPLEFT, COMPRESSION_NONE, 32, 16, 0 },
+    { "TiledBottomLeftShort", 45, 40, 1, 1, 16, SAMPLEFORMAT_INT, ORIENTATION_BOTLEFT, COMPRESSION_PACKBITS, 16, 32, 0 },
+    { "StripsFloat", 61, 43, 1, 1, 32, SAMPLEFORMAT_IEEEFP, ORIENTATION_TOPLEFT, COMPRESSION_NONE, 0, 0, 7 },
+    { "StripsBottomLeftRGB", 33, 29, 1, 3, 8, SAMPLEFORMAT_UINT, ORIENTATION_BOTLEFT, COMPRESSION_LZW, 0, 0, 4 },
+    { "TiledPagesUShort", 45, 33, 4, 1, 16, SAMPLEFORMAT_UINT, ORIENTATION_TOPLEFT, COMPRESSION_LZW, 16, 16, 0 },
+    { "StripsPagesUChar", 20, 30, 6, 1, 8, SAMPLEFORMAT_UINT, ORIENTATION_TOPLEFT, COMPRESSION_PACKBITS, 0, 0, 3 }
+  };
+
+  bool success = true;
+
+  for (const auto & description : descriptions)
+  {
+    const std::string fileName = std::string(argv[1]) + "/itkTIFFImageIOTiledReadTest" + description.m_Name + ".tif";
+    bool              written = false;
+    switch (description.m_BitsPerSample)
+    {
+      case 8:
+        written = WriteTIFFFile<uint8>(description, fileName);
+        break;
+      case 16:
+        written = description.m_SampleFormat == SAMPLEFORMAT_INT ? WriteTIFFFile<int16>(description, fileName)
+                                                                 : WriteTIFFFile<uint16>(description, fileName);
+        break;
+      default:
+        written = WriteTIFFFile<float>(description, fileName);
+    }
+    if (!written)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Could not write " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Strips and tiles are decoded serially, and in parallel
+    for (int numberOfThreads : { 1, 4 })
+    {
+      itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+      std::cout << "Reading " << description.m_Name << " with " << numberOfThreads << " threads" << std::endl;
+      if (description.m_NumberOfPages > 1)
+      {
+        success &= ReadTIFFFile<3>(description, fileName);
+      }
+      else
+      {
+        success &= ReadTIFFFile<2>(description, fileName);
+      }
+    }
+  }
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,309 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkTIFFImageIO.h"
+#include "itkVectorImage.h"
+#include "itk_tiff.h"
+#include <fstream>
+
+namespace
+{
+
+struct TIFFWriteDescription
+{
+  const char * m_Name;
+  unsigned int m_Width;
+  unsigned int m_Height;
+  unsigned int m_NumberOfPages; // 1 for a 2D image
+  unsigned int m_NumberOfComponents;
+  const char * m_Compressor;
+  unsigned int m_TileWidth; // 0 for an image written in strips
+  unsigned int m_TileHeight;
+  bool         m_UseBigTIFF;
+};
+
+double
+PixelValue(unsigned int x, unsigned int y, unsigned int page, unsigned int component)
+{
+  // smooth, for JPEG
+  return (x / 2 + y + 9 * page + 40 * component) % 200;
+}
+
+bool
+IsJPEG(const TIFFWriteDescription & description)
+{
+  return std::string(description.m_Compressor) == "JPEG";
+}
+
+template <typename TImage>
+bool
+CheckPixels(const TIFFWriteDescription & description, const TImage * image, const std::string & fileName)
+{
+  const typename TImage::RegionType region = image->GetLargestPossibleRegion();
+  if (region.GetSize(0) != description.m_Width || region.GetSize(1) != description.m_Height ||
+      (TImage::ImageDimension > 2 && region.GetSize(TImage::ImageDimension - 1) != description.m_NumberOfPages) ||
+      image->GetNumberOfComponentsPerPixel() != description.m_NumberOfComponents)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Wrong size of " << fileName << ": " << region << std::endl;
+    return false;
+  }
+
+  // JPEG is lossy, the error is checked on average
+  double totalError = 0.0;
+  for (itk::ImageRegionConstIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    const unsigned int               page = TImage::ImageDimension > 2 ? index[TImage::ImageDimension - 1] : 0;
+    for (unsigned int c = 0; c < description.m_NumberOfComponents; ++c)
+    {
+      const double error = std::abs(it.Get()[c] - PixelValue(index[0], index[1], page, c));
+      totalError += error;
+      if (!IsJPEG(description) && error != 0.0)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Wrong component " << c << " at " << index << " in " << fileName << ": expected "
+                  << PixelValue(index[0], index[1], page, c) << ", but got " << it.Get()[c] << std::endl;
+        return false;
+      }
+    }
+  }
+  const double meanError = totalError / (region.GetNumberOfPixels() * description.m_NumberOfComponents);
+  if (meanError > 4.0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Mean error " << meanError << " in " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Check the layout of the written file with libtiff
+bool
+CheckFile(const TIFFWriteDescription & description, const std::string & fileName)
+{
+  // the version is 43 in a BigTIFF header, 42 in a TIFF one
+  char          header[4] = {};
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  file.read(header, 4);
+  if (!file || (header[2] == 43 || header[3] == 43) != description.m_UseBigTIFF)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << fileName << " is not in the expected TIFF format" << std::endl;
+    return false;
+  }
+
+  TIFF * tiff = TIFFOpen(fileName.c_str(), "r");
+  if (tiff == nullptr)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Could not open " << fileName << std::endl;
+    return false;
+  }
+  bool success = true;
+  do
+  {
+    uint32 tileWidth = 0;
+    uint32 tileHeight = 0;
+    if (TIFFIsTiled(tiff))
+    {
+      TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tileWidth);
+      TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tileHeight);
+    }
+    if (tileWidth != description.m_TileWidth || tileHeight != description.m_TileHeight)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong tiles " << tileWidth << " x " << tileHeight << " in " << fileName << std::endl;
+      success = false;
+    }
+  } while (TIFFReadDirectory(tiff));
+  TIFFClose(tiff);
+  return success;
+}
+
+// Write the image whole, then stream it into a second file, and read both
+template <typename TComponent, unsigned int VDimension>
+bool
+WriteTIFFFile(const TIFFWriteDescription & description, const std::string & outputDirectory)
+{
+  using ImageType = itk::VectorImage<TComponent, VDimension>;
+  using WriterType = itk::ImageFileWriter<ImageType>;
+
+  typename ImageType::SizeType size;
+  size.Fill(description.m_NumberOfPages);
+  size[0] = description.m_Width;
+  size[1] = description.m_Height;
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(description.m_NumberOfComponents);
+  image->Allocate();
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const typename ImageType::IndexType index = it.GetIndex();
+    typename ImageType::PixelType       pixel(description.m_NumberOfComponents);
+    for (unsigned int c = 0; c < description.m_NumberOfComponents; ++c)
+    {
+      pixel[c] = static_cast<TComponent>(PixelValue(index[0], index[1], VDimension > 2 ? index[2] : 0, c));
+    }
+    it.Set(pixel);
+  }
+
+  const std::string fileName =
+    outputDirectory + "/itkTIFFImageIOTiledWriteTest" + description.m_Name + ".tif";
+  const std::string streamedFileName =
+    outputDirectory + "/itkTIFFImageIOTiledWriteTest" + description.m_Name + "Streamed.tif";
+
+  auto imageIO = itk::TIFFImageIO::New();
+  imageIO->SetTileWidth(description.m_TileWidth);
+  imageIO->SetTileHeight(description.m_TileHeight);
+  imageIO->SetUseBigTIFF(description.m_UseBigTIFF);
+
+  auto writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(imageIO);
+  writer->SetUseCompression(std::string(description.m_Compressor) != "NoCompression");
+  writer->GetImageIO()->SetCompressor(description.m_Compressor);
+  writer->Update();
+
+  // The whole file is read by pieces, which are written as they come
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto streamingReader = ReaderType::New();
+  streamingReader->SetFileName(fileName);
+  streamingReader->SetUseStreaming(true);
+
+  using MonitorFilterType = itk::PipelineMonitorImageFilter<ImageType>;
+  auto monitor = MonitorFilterType::New();
+  monitor->SetInput(streamingReader->GetOutput());
+
+  auto streamedImageIO = itk::TIFFImageIO::New();
+  streamedImageIO->SetTileWidth(description.m_TileWidth);
+  streamedImageIO->SetTileHeight(description.m_TileHeight);
+  streamedImageIO->SetUseBigTIFF(description.m_UseBigTIFF);
+
+  auto streamingWriter = WriterType::New();
+  streamingWriter->SetInput(monitor->GetOutput());
+  streamingWriter->SetFileName(streamedFileName);
+  streamingWriter->SetImageIO(streamedImageIO);
+  streamingWriter->SetUseCompression(std::string(description.m_Compressor) != "NoCompression");
+  streamingWriter->GetImageIO()->SetCompressor(description.m_Compressor);
+  streamingWriter->SetNumberOfStreamDivisions(5);
+  streamingWriter->Update();
+
+  // A volume is split along its pages, into fewer pieces when they are few
+  if (!monitor->VerifyAllInputCanStream(-3))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << description.m_Name << " was not streamed" << std::endl;
+    return false;
+  }
+
+  bool success = true;
+  for (const std::string & name : { fileName, streamedFileName })
+  {
+    using ReadImageType = itk::VectorImage<float, VDimension>;
+    auto reader = itk::ImageFileReader<ReadImageType>::New();
+    reader->SetFileName(name);
+    reader->Update();
+    success &= CheckFile(description, name) && CheckPixels(description, reader->GetOutput(), name);
+  }
+  return success;
+}
+
+} // namespace
+
+int
+itkTIFFImageIOTiledWriteTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto imageIO = itk::TIFFImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(imageIO, TIFFImageIO, ImageIOBase);
+
+  ITK_TEST_EXPECT_TRUE(imageIO->CanStreamWrite());
+  ITK_TEST_SET_GET_VALUE(0, imageIO->GetTileWidth());
+  ITK_TEST_SET_GET_VALUE(0, imageIO->GetTileHeight());
+  ITK_TEST_SET_GET_BOOLEAN(imageIO, UseBigTIFF, true);
+  imageIO->UseBigTIFFOff();
+
+  // The tiles must be multiples of 16 in both directions
+  using ImageType = itk::Image<unsigned char, 2>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 32 } });
+  image->Allocate(true);
+  imageIO->SetTileWidth(24);
+  imageIO->SetTileHeight(16);
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(std::string(argv[1]) + "/itkTIFFImageIOTiledWriteTestInvalidTiles.tif");
+  writer->SetImageIO(imageIO);
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+
+  const TIFFWriteDescription descriptions[] = {
+    { "TiledUCharDeflate", 100, 75, 1, 1, "Deflate", 32, 16, false },
+    { "TiledRGBPackBits", 70, 50, 1, 3, "PackBits", 16, 32, false },
+    { "TiledUCharJPEG", 64, 48, 1, 1, "JPEG", 16, 16, false },
+    { "StripsFloatDeflate", 4100, 150, 1, 1, "Deflate", 0, 0, false },
+    { "StripsRGBJPEG", 40, 36, 1, 3, "JPEG", 0, 0, false },
+    { "TiledPagesUShortBigTIFF", 45, 33, 4, 1, "NoCompression", 16, 16, true },
+    { "StripsPagesShortPackBits", 20, 30, 6, 1, "PackBits", 0, 0, false }
+  };
+
+  bool success = true;
+
+  for (const auto & description : descriptions)
+  {
+    // Strips and tiles are compressed serially, and in parallel
+    for (int numberOfThreads : { 1, 4 })
+    {
+      itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+      std::cout << "Writing " << description.m_Name << " with " << numberOfThreads << " threads" << std::endl;
+      if (description.m_NumberOfPages > 1)
+      {
+        success &= WriteTIFFFile<short, 3>(description, argv[1]);
+      }
+      else if (std::string(description.m_Name).find("Float") != std::string::npos)
+      {
+        success &= WriteTIFFFile<float, 2>(description, argv[1]);
+      }
+      else
+      {
+        success &= WriteTIFFFile<unsigned char, 2>(description, argv[1]);
+      }
+    }
+  }
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryTransformIO_h
+#define itkBinaryTransformIO_h
+
+#include "ITKIOTransformBinaryExport.h"
+
+#include "itkTransformIOBase.h"
+
+namespace itk
+{
+/** \class BinaryTransformIOTemplate
+ *  \brief Read and write transforms in a binary format, for transforms with
+ *  many parameters.
+ *
+ * The parameters of BSplineTransform and DisplacementFieldTransform objects
+ * can number in the millions, which makes text files slow to write and to
+ * parse, and large. The files of this IO, with the ".itkt" extension,
+ * store the parameter arrays raw instead, in little endian order and in the
+ * precision of the IO that wrote them:
+ *
+ * - a header with the signature, the version of the format and the number
+ *   of transforms;
+ * - for each transform, its type name and the description of its parameter
+ *   and fixed parameter arrays: element size, number of elements, position
+ *   and size of the stored data and, when compressed, the positions of the
+ *   compressed blocks;
+ * - the data of the arrays, each starting at a multiple of 64 bytes.
+ *
+ * Reading maps the file into memory and fills the parameters from the
+ * mapping, without any parsing or intermediate buffer. When UseCompression
+ * is on, the parameters are compressed by DeflateBlockCompressor, and
+ * their blocks are compressed and decompressed in parallel. Fixed
+ * parameters are never compressed.
+ *
+ * As for the other transform IO classes, the transforms of a
+ * CompositeTransform are written after it, and added back into it by
+ * TransformFileReader.
+ *
+ * \ingroup ITKIOTransformBinary
+ */
+template <typename TParametersValueType>
+class ITK_TEMPLATE_EXPORT BinaryTransformIOTemplate : public TransformIOBaseTemplate<TParametersValueType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BinaryTransformIOTemplate);
+
+  using Self = BinaryTransformIOTemplate;
+  using Superclass = TransformIOBaseTemplate<TParametersValueType>;
+  using Pointer = SmartPointer<Self>;
+  using typename Superclass::TransformType;
+  using typename Superclass::TransformPointer;
+  using typename Superclass::TransformListType;
+  using typename Superclass::ConstTransformListType;
+  using ParametersType = typename TransformType::ParametersType;
+  using ParametersValueType = typename TransformType::ParametersValueType;
+  using FixedParametersType = typename TransformType::FixedParametersType;
+  using FixedParametersValueType = typename TransformType::FixedParametersValueType;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BinaryTransformIOTemplate, Superclass);
+  itkNewMacro(Self);
+
+  /** Determine the file type. Returns true if this TransformIO can read the
+   * file specified, which is checked from its signature. */
+  bool
+  CanReadFile(const char *) override;
+
+  /** Determine the file type. Returns true if this TransformIO can write the
+   * file specified, which has the ".itkt" extension. */
+  bool
+  CanWriteFile(const char *) override;
+
+  /** Reads the transforms from the file. */
+  void
+  Read() override;
+
+  /** Writes the transforms to the file. */
+  void
+  Write() override;
+
+protected:
+  BinaryTransformIOTemplate();
+  ~BinaryTransformIOTemplate() override;
+};
+
+/** This helps to meet backward compatibility */
+using BinaryTransformIO = BinaryTransformIOTemplate<double>;
+
+} // namespace itk
+
+// Note: Explicit instantiation is done in itkBinaryTransformIO.cxx
+
+#endif // itkBinaryTransformIO_h
+
+/** Explicit instantiations */
+#ifndef ITK_TEMPLATE_EXPLICIT_BinaryTransformIO
+// Explicit instantiation is required to ensure correct dynamic_cast
+// behavior across shared libraries.
+//
+// IMPORTANT: Since within the same compilation unit,
+//            ITK_TEMPLATE_EXPLICIT_<classname> defined and undefined states
+//            need to be considered. This code *MUST* be *OUTSIDE* the header
+//            guards.
+//
+#if defined(ITKIOTransformBinary_EXPORTS)
+//   We are building this library
+#  define ITKIOTransformBinary_EXPORT_EXPLICIT ITK_FORWARD_EXPORT
+#else
+//   We are using this library
+#  define ITKIOTransformBinary_EXPORT_EXPLICIT ITKIOTransformBinary_EXPORT
+#endif
+namespace itk
+{
+ITK_GCC_PRAGMA_DIAG_PUSH()
+ITK_GCC_PRAGMA_DIAG(ignored "-Wattributes")
+extern template class ITKIOTransformBinary_EXPORT_EXPLICIT BinaryTransformIOTemplate<double>;
+extern template class ITKIOTransformBinary_EXPORT_EXPLICIT BinaryTransformIOTemplate<float>;
+ITK_GCC_PRAGMA_DIAG_POP()
+} // end namespace itk
+#undef ITKIOTransformBinary_EXPORT_EXPLICIT
+#endif
@@ -0,0 +1,18 @@
+set(DOCUMENTATION "This module contains the classes for the input and output
+of itkTransform objects in a binary format, whose parameter arrays are stored
+raw or compressed by blocks, and read from a memory mapping of the file.")
+
+itk_module(ITKIOTransformBinary
+  ENABLE_SHARED
+  DEPENDS
+    ITKIOTransformBase
+  PRIVATE_DEPENDS
+    ITKIOImageBase
+  TEST_DEPENDS
+    ITKTestKernel
+    ITKDisplacementField
+  FACTORY_NAMES
+    TransformIO::Binary
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
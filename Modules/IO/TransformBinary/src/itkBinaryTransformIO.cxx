@@ -0,0 +1,497 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#define ITK_TEMPLATE_EXPLICIT_BinaryTransformIO
+#include "itkBinaryTransformIO.h"
+#include "itkByteSwapper.h"
+#include "itkCompositeTransformIOHelper.h"
+#include "itkDeflateBlockCompressor.h"
+#include "itkMemoryMappedFile.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/SystemTools.hxx"
+#include <cstring>
+#include <type_traits>
+
+namespace itk
+{
+namespace
+{
+constexpr char     Signature[8] = { '\211', 'I', 'T', 'K', 'T', '\r', '\n', '\032' };
+constexpr uint32_t FormatVersion = 1;
+
+// Every array starts at a multiple of DataAlignment bytes in the file
+constexpr uint64_t DataAlignment = 64;
+
+// Arrays are converted by chunks of ElementsPerChunk elements, in parallel
+constexpr SizeValueType ElementsPerChunk = 65536;
+
+constexpr uint32_t NoCompression = 0;
+constexpr uint32_t DeflateCompression = 1;
+
+/** Description of an array stored in the file. m_Offset is the position of
+ * its data in the file, m_BlockOffsets the positions of its compressed
+ * blocks in this data. */
+struct ArrayHeader
+{
+  uint32_t              m_ElementSize{ 0 };
+  uint32_t              m_Compression{ NoCompression };
+  uint64_t              m_NumberOfElements{ 0 };
+  uint64_t              m_Offset{ 0 };
+  uint64_t              m_StoredSize{ 0 };
+  uint64_t              m_BlockSize{ 0 };
+  std::vector<uint64_t> m_BlockOffsets;
+};
+
+template <typename T>
+void
+AppendValue(std::vector<char> & buffer, T value)
+{
+  ByteSwapper<T>::SwapFromSystemToLittleEndian(&value);
+  const char * bytes = reinterpret_cast<const char *>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void
+AppendArrayHeader(std::vector<char> & buffer, const ArrayHeader & header)
+{
+  AppendValue(buffer, header.m_ElementSize);
+  AppendValue(buffer, header.m_Compression);
+  AppendValue(buffer, header.m_NumberOfElements);
+  AppendValue(buffer, header.m_Offset);
+  AppendValue(buffer, header.m_StoredSize);
+  AppendValue(buffer, header.m_BlockSize);
+  AppendValue(buffer, static_cast<uint64_t>(header.m_BlockOffsets.size()));
+  for (const uint64_t blockOffset : header.m_BlockOffsets)
+  {
+    AppendValue(buffer, blockOffset);
+  }
+}
+
+/** Sequential reading of the header from the mapped file, which throws when
+ * the header goes past the end of the file. */
+class HeaderParser
+{
+public:
+  HeaderParser(const char * begin, uint64_t size, const std::string & fileName)
+    : m_Begin(begin)
+    , m_Size(size)
+    , m_FileName(fileName)
+  {}
+
+  template <typename T>
+  T
+  ReadValue()
+  {
+    T value;
+    std::memcpy(&value, this->Advance(sizeof(T)), sizeof(T));
+    ByteSwapper<T>::SwapFromSystemToLittleEndian(&value);
+    return value;
+  }
+
+  std::string
+  ReadString(uint64_t length)
+  {
+    const char * characters = this->Advance(length);
+    return std::string(characters, static_cast<size_t>(length));
+  }
+
+  ArrayHeader
+  ReadArrayHeader()
+  {
+    ArrayHeader header;
+    header.m_ElementSize = this->ReadValue<uint32_t>();
+    header.m_Compression = this->ReadValue<uint32_t>();
+    header.m_NumberOfElements = this->ReadValue<uint64_t>();
+    header.m_Offset = this->ReadValue<uint64_t>();
+    header.m_StoredSize = this->ReadValue<uint64_t>();
+    header.m_BlockSize = this->ReadValue<uint64_t>();
+    const auto numberOfBlocks = this->ReadValue<uint64_t>();
+    if (numberOfBlocks > (m_Size - m_Position) / sizeof(uint64_t))
+    {
+      itkGenericExceptionMacro(<< "Invalid number of blocks " << numberOfBlocks << " in " << m_FileName);
+    }
+    header.m_BlockOffsets.resize(static_cast<size_t>(numberOfBlocks));
+    for (uint64_t & blockOffset : header.m_BlockOffsets)
+    {
+      blockOffset = this->ReadValue<uint64_t>();
+    }
+
+    // The number of elements is bounded by the maximal deflate ratio, so
+    // that a corrupt file cannot cause huge allocations
+    const bool validCompression = header.m_Compression == NoCompression ||
+                                  (header.m_Compression == DeflateCompression && header.m_BlockSize > 0 &&
+                                   header.m_BlockSize <= (uint64_t{ 1 } << 30) && numberOfBlocks > 0);
+    if ((header.m_ElementSize != sizeof(float) && header.m_ElementSize != sizeof(double)) || !validCompression ||
+        header.m_NumberOfElements > m_Size / header.m_ElementSize * 1024 || header.m_Offset > m_Size ||
+        header.m_StoredSize > m_Size - header.m_Offset || header.m_Offset % header.m_ElementSize != 0 ||
+        (header.m_Compression == NoCompression &&
+         header.m_StoredSize != header.m_NumberOfElements * header.m_ElementSize))
+    {
+      itkGenericExceptionMacro(<< "Invalid array description in " << m_FileName);
+    }
+    return header;
+  }
+
+private:
+  const char *
+  Advance(uint64_t numberOfBytes)
+  {
+    if (numberOfBytes > m_Size - m_Position)
+    {
+      itkGenericExceptionMacro(<< "Unexpected end of file " << m_FileName);
+    }
+    const char * position = m_Begin + m_Position;
+    m_Position += numberOfBytes;
+    return position;
+  }
+
+  const char *        m_Begin;
+  const uint64_t      m_Size;
+  uint64_t            m_Position{ 0 };
+  const std::string & m_FileName;
+};
+
+/** Call function(first, count) for consecutive chunks of the
+ * numberOfElements elements, concurrently when there are several chunks. */
+template <typename TFunction>
+void
+ForEachChunk(SizeValueType numberOfElements, const TFunction & function)
+{
+  const SizeValueType numberOfChunks = (numberOfElements + ElementsPerChunk - 1) / ElementsPerChunk;
+  if (numberOfChunks < 2)
+  {
+    function(0, numberOfElements);
+    return;
+  }
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [numberOfElements, &function](SizeValueType chunk) {
+      const SizeValueType first = chunk * ElementsPerChunk;
+      function(first, std::min(ElementsPerChunk, numberOfElements - first));
+    },
+    nullptr);
+}
+
+/** Convert count elements stored as TStored, in little endian order. */
+template <typename TStored, typename TValue>
+void
+ConvertElements(const char * stored, SizeValueType count, TValue * values)
+{
+  if (std::is_same<TStored, TValue>::value)
+  {
+    std::memcpy(values, stored, count * sizeof(TValue));
+    ByteSwapper<TValue>::SwapRangeFromSystemToLittleEndian(values, count);
+    return;
+  }
+  for (SizeValueType i = 0; i < count; ++i)
+  {
+    TStored value;
+    std::memcpy(&value, stored + i * sizeof(TStored), sizeof(TStored));
+    ByteSwapper<TStored>::SwapFromSystemToLittleEndian(&value);
+    values[i] = static_cast<TValue>(value);
+  }
+}
+
+/** Fill array with the elements described by header, whose data starts at
+ * data in the mapped file. */
+template <typename TArray>
+void
+ReadArray(const char * data, const ArrayHeader & header, TArray & array)
+{
+  using ValueType = typename TArray::ValueType;
+  const auto numberOfElements = static_cast<SizeValueType>(header.m_NumberOfElements);
+  array.SetSize(numberOfElements);
+  if (numberOfElements == 0)
+  {
+    return;
+  }
+  ValueType * const values = array.data_block();
+
+  std::unique_ptr<char[]> decompressed;
+  if (header.m_Compression == DeflateCompression)
+  {
+    std::vector<BlockCompressor::SizeType> blockOffsets(header.m_BlockOffsets.begin(), header.m_BlockOffsets.end());
+    auto                                   compressor = DeflateBlockCompressor::New();
+    compressor->SetBlockSize(static_cast<BlockCompressor::SizeType>(header.m_BlockSize));
+    const auto numberOfBytes = static_cast<BlockCompressor::SizeType>(numberOfElements * header.m_ElementSize);
+    if (header.m_ElementSize == sizeof(ValueType) && !ByteSwapper<ValueType>::SystemIsBigEndian())
+    {
+      // Decompressed straight into the array
+      compressor->Decompress(data,
+                             static_cast<BlockCompressor::SizeType>(header.m_StoredSize),
+                             blockOffsets,
+                             values,
+                             numberOfBytes);
+      return;
+    }
+    decompressed.reset(new char[static_cast<size_t>(numberOfBytes)]);
+    compressor->Decompress(data,
+                           static_cast<BlockCompressor::SizeType>(header.m_StoredSize),
+                           blockOffsets,
+                           decompressed.get(),
+                           numberOfBytes);
+    data = decompressed.get();
+  }
+
+  const uint32_t elementSize = header.m_ElementSize;
+  ForEachChunk(numberOfElements, [data, elementSize, values](SizeValueType first, SizeValueType count) {
+    if (elementSize == sizeof(float))
+    {
+      ConvertElements<float>(data + first * sizeof(float), count, values + first);
+    }
+    else
+    {
+      ConvertElements<double>(data + first * sizeof(double), count, values + first);
+    }
+  });
+}
+
+/** An array to write, with its data in little endian order, compressed
+ * when requested. */
+template <typename TValue>
+struct ArrayToWrite
+{
+  ArrayHeader         m_Header;
+  const char *        m_Data{ nullptr };
+  std::vector<TValue> m_Swapped;
+  std::vector<char>   m_Compressed;
+
+  void
+  Initialize(const TValue * values, SizeValueType numberOfElements, bool useCompression)
+  {
+    m_Header.m_ElementSize = sizeof(TValue);
+    m_Header.m_NumberOfElements = numberOfElements;
+    m_Header.m_StoredSize = numberOfElements * sizeof(TValue);
+    m_Data = reinterpret_cast<const char *>(values);
+    if (ByteSwapper<TValue>::SystemIsBigEndian())
+    {
+      m_Swapped.assign(values, values + numberOfElements);
+      ByteSwapper<TValue>::SwapRangeFromSystemToLittleEndian(m_Swapped.data(), numberOfElements);
+      m_Data = reinterpret_cast<const char *>(m_Swapped.data());
+    }
+
+    if (useCompression && numberOfElements > 0)
+    {
+      auto                                   compressor = DeflateBlockCompressor::New();
+      std::vector<BlockCompressor::SizeType> blockOffsets;
+      compressor->Compress(
+        m_Data, static_cast<BlockCompressor::SizeType>(m_Header.m_StoredSize), m_Compressed, &blockOffsets);
+      m_Header.m_Compression = DeflateCompression;
+      m_Header.m_StoredSize = m_Compressed.size();
+      m_Header.m_BlockSize = static_cast<uint64_t>(compressor->GetBlockSize());
+      m_Header.m_BlockOffsets.assign(blockOffsets.begin(), blockOffsets.end());
+      m_Data = m_Compressed.data();
+      m_Swapped.clear();
+    }
+  }
+};
+
+uint64_t
+AlignOffset(uint64_t offset)
+{
+  return (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+}
+} // namespace
+
+template <typename TParametersValueType>
+BinaryTransformIOTemplate<TParametersValueType>::BinaryTransformIOTemplate() = default;
+
+template <typename TParametersValueType>
+BinaryTransformIOTemplate<TParametersValueType>::~BinaryTransformIOTemplate() = default;
+
+template <typename TParametersValueType>
+bool
+BinaryTransformIOTemplate<TParametersValueType>::CanReadFile(const char * fileName)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  char          signature[sizeof(Signature)];
+  return file.read(signature, sizeof(Signature)) && std::memcmp(signature, Signature, sizeof(Signature)) == 0;
+}
+
+template <typename TParametersValueType>
+bool
+BinaryTransformIOTemplate<TParametersValueType>::CanWriteFile(const char * fileName)
+{
+  return itksys::SystemTools::GetFilenameLastExtension(fileName) == ".itkt";
+}
+
+template <typename TParametersValueType>
+void
+BinaryTransformIOTemplate<TParametersValueType>::Read()
+{
+  const std::string fileName = this->GetFileName();
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    itkExceptionMacro("The file could not be opened for read access " << std::endl
+                                                                      << "Filename: \"" << fileName << "\"");
+  }
+  const auto fileSize = static_cast<uint64_t>(itksys::SystemTools::FileLength(fileName));
+  if (fileSize < sizeof(Signature) + 2 * sizeof(uint32_t))
+  {
+    itkExceptionMacro(<< "File too short to be a binary transform file: " << fileName);
+  }
+
+  auto mappedFile = MemoryMappedFile::New();
+  mappedFile->Map(fileName, 0, static_cast<SizeValueType>(fileSize));
+  const char * const file = static_cast<const char *>(mappedFile->GetData());
+
+  HeaderParser parser(file, fileSize, fileName);
+  if (parser.ReadString(sizeof(Signature)) != std::string(Signature, sizeof(Signature)))
+  {
+    itkExceptionMacro(<< "Not a binary transform file: " << fileName);
+  }
+  const auto version = parser.ReadValue<uint32_t>();
+  if (version != FormatVersion)
+  {
+    itkExceptionMacro(<< "Unsupported version " << version << " of binary transform file " << fileName);
+  }
+
+  const auto numberOfTransforms = parser.ReadValue<uint32_t>();
+  for (uint32_t i = 0; i < numberOfTransforms; ++i)
+  {
+    std::string transformType = parser.ReadString(parser.ReadValue<uint32_t>());
+    const ArrayHeader parametersHeader = parser.ReadArrayHeader();
+    const ArrayHeader fixedParametersHeader = parser.ReadArrayHeader();
+
+    // Transform name should be modified to have the output precision type.
+    Superclass::CorrectTransformPrecisionType(transformType);
+
+    TransformPointer transform;
+    this->CreateTransform(transform, transformType);
+    this->GetReadTransformList().push_back(transform);
+
+    // Composite transform doesn't store its own parameters
+    if (transformType.find("CompositeTransform") == std::string::npos)
+    {
+      FixedParametersType fixedParameters;
+      ReadArray(file + fixedParametersHeader.m_Offset, fixedParametersHeader, fixedParameters);
+      transform->SetFixedParameters(fixedParameters);
+
+      ParametersType parameters;
+      ReadArray(file + parametersHeader.m_Offset, parametersHeader, parameters);
+      transform->SetParametersByValue(parameters);
+    }
+  }
+}
+
+template <typename TParametersValueType>
+void
+BinaryTransformIOTemplate<TParametersValueType>::Write()
+{
+  ConstTransformListType transformList = this->GetWriteTransformList();
+  if (transformList.empty())
+  {
+    itkExceptionMacro(<< "No transform to write in " << this->GetFileName());
+  }
+
+  // if the first transform in the list is a
+  // composite transform, use its internal list
+  // instead of the IO
+  CompositeTransformIOHelperTemplate<TParametersValueType> helper;
+  if (transformList.front()->GetTransformTypeAsString().find("CompositeTransform") != std::string::npos)
+  {
+    transformList = helper.GetTransformList(transformList.front().GetPointer());
+  }
+
+  struct TransformToWrite
+  {
+    std::string                            m_TransformType;
+    ArrayToWrite<ParametersValueType>      m_Parameters;
+    ArrayToWrite<FixedParametersValueType> m_FixedParameters;
+  };
+  std::vector<TransformToWrite> transforms(transformList.size());
+
+  // The parameters are compressed in parallel blocks, transform by transform
+  auto transformToWrite = transforms.begin();
+  for (auto it = transformList.begin(); it != transformList.end(); ++it, ++transformToWrite)
+  {
+    const TransformType * transform = it->GetPointer();
+    transformToWrite->m_TransformType = transform->GetTransformTypeAsString();
+    if (transformToWrite->m_TransformType.find("CompositeTransform") != std::string::npos)
+    {
+      if (it != transformList.begin())
+      {
+        itkExceptionMacro(<< "Composite Transform can only be 1st transform in a file");
+      }
+      transformToWrite->m_Parameters.Initialize(nullptr, 0, false);
+      transformToWrite->m_FixedParameters.Initialize(nullptr, 0, false);
+      continue;
+    }
+    const ParametersType &      parameters = transform->GetParameters();
+    const FixedParametersType & fixedParameters = transform->GetFixedParameters();
+    transformToWrite->m_Parameters.Initialize(parameters.data_block(), parameters.Size(), this->GetUseCompression());
+    transformToWrite->m_FixedParameters.Initialize(fixedParameters.data_block(), fixedParameters.Size(), false);
+  }
+
+  auto makeHeader = [&transforms]() {
+    std::vector<char> header(Signature, Signature + sizeof(Signature));
+    AppendValue(header, FormatVersion);
+    AppendValue(header, static_cast<uint32_t>(transforms.size()));
+    for (const TransformToWrite & transform : transforms)
+    {
+      AppendValue(header, static_cast<uint32_t>(transform.m_TransformType.size()));
+      header.insert(header.end(), transform.m_TransformType.begin(), transform.m_TransformType.end());
+      AppendArrayHeader(header, transform.m_Parameters.m_Header);
+      AppendArrayHeader(header, transform.m_FixedParameters.m_Header);
+    }
+    return header;
+  };
+
+  // The size of the header does not depend on the offsets of the arrays
+  uint64_t offset = AlignOffset(makeHeader().size());
+  for (TransformToWrite & transform : transforms)
+  {
+    transform.m_Parameters.m_Header.m_Offset = offset;
+    offset = AlignOffset(offset + transform.m_Parameters.m_Header.m_StoredSize);
+    transform.m_FixedParameters.m_Header.m_Offset = offset;
+    offset = AlignOffset(offset + transform.m_FixedParameters.m_Header.m_StoredSize);
+  }
+
+  const std::vector<char> header = makeHeader();
+
+  std::ofstream out;
+  this->OpenStream(out, true);
+  out.write(header.data(), static_cast<std::streamsize>(header.size()));
+  const char padding[DataAlignment] = {};
+  uint64_t   position = header.size();
+  auto       writeArray = [&out, &padding, &position](const ArrayHeader & arrayHeader, const char * data) {
+    out.write(padding, static_cast<std::streamsize>(arrayHeader.m_Offset - position));
+    out.write(data, static_cast<std::streamsize>(arrayHeader.m_StoredSize));
+    position = arrayHeader.m_Offset + arrayHeader.m_StoredSize;
+  };
+  for (const TransformToWrite & transform : transforms)
+  {
+    writeArray(transform.m_Parameters.m_Header, transform.m_Parameters.m_Data);
+    writeArray(transform.m_FixedParameters.m_Header, transform.m_FixedParameters.m_Data);
+  }
+  if (out.fail())
+  {
+    itkExceptionMacro(<< "Failed writing " << this->GetFileName());
+  }
+  out.close();
+}
+
+ITK_GCC_PRAGMA_DIAG_PUSH()
+ITK_GCC_PRAGMA_DIAG(ignored "-Wattributes")
+
+template class ITKIOTransformBinary_EXPORT BinaryTransformIOTemplate<double>;
+template class ITKIOTransformBinary_EXPORT BinaryTransformIOTemplate<float>;
+
+ITK_GCC_PRAGMA_DIAG_POP()
+
+} // end namespace itk
@@ -0,0 +1,71 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBinaryTransformIOFactory.h"
+#include "itkCreateObjectFunction.h"
+#include "itkBinaryTransformIO.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+void
+BinaryTransformIOFactory::PrintSelf(std::ostream &, Indent) const
+{}
+
+BinaryTransformIOFactory::BinaryTransformIOFactory()
+{
+  this->RegisterOverride("itkTransformIOBaseTemplate",
+                         "itkBinaryTransformIO",
+                         "Binary Transform float IO",
+                         true,
+                         CreateObjectFunction<BinaryTransformIOTemplate<float>>::New());
+  this->RegisterOverride("itkTransformIOBaseTemplate",
+                         "itkBinaryTransformIO",
+                         "Binary Transform double IO",
+                         true,
+                         CreateObjectFunction<BinaryTransformIOTemplate<double>>::New());
+}
+
+BinaryTransformIOFactory::~BinaryTransformIOFactory() = default;
+
+const char *
+BinaryTransformIOFactory::GetITKSourceVersion() const
+{
+  return ITK_SOURCE_VERSION;
+}
+
+const char *
+BinaryTransformIOFactory::GetDescription() const
+{
+  return "Binary TransformIO Factory, allows the "
+         "loading of binary transforms into insight";
+}
+
+// Undocumented API used to register during static initialization.
+// DO NOT CALL DIRECTLY.
+static bool BinaryTransformIOFactoryHasBeenRegistered;
+
+void ITKIOTransformBinary_EXPORT
+     BinaryTransformIOFactoryRegister__Private()
+{
+  if (!BinaryTransformIOFactoryHasBeenRegistered)
+  {
+    BinaryTransformIOFactoryHasBeenRegistered = true;
+    BinaryTransformIOFactory::RegisterOneFactory();
+  }
+}
+} // end namespace itk
@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryTransformIO.h"
+#include "itkBinaryTransformIOFactory.h"
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkTestingMacros.h"
+#include "itkTransformFileReader.h"
+#include "itkTransformFileWriter.h"
+#include "itksys/SystemTools.hxx"
+#include <fstream>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using CompositeTransformType = itk::CompositeTransform<double, Dimension>;
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+using DisplacementFieldTransformType = itk::DisplacementFieldTransform<double, Dimension>;
+
+// A composite of an affine transform and two transforms with many
+// parameters, which do not have exact float values
+CompositeTransformType::Pointer
+MakeCompositeTransform()
+{
+  auto affine = AffineTransformType::New();
+  auto affineParameters = affine->GetParameters();
+  for (unsigned int i = 0; i < affineParameters.Size(); ++i)
+  {
+    affineParameters[i] = 0.1 * i + 1e-9;
+  }
+  affine->SetParameters(affineParameters);
+
+  auto                                         bspline = BSplineTransformType::New();
+  BSplineTransformType::MeshSizeType           meshSize;
+  BSplineTransformType::PhysicalDimensionsType dimensions;
+  meshSize.Fill(37);
+  dimensions.Fill(100.0);
+  bspline->SetTransformDomainMeshSize(meshSize);
+  bspline->SetTransformDomainPhysicalDimensions(dimensions);
+  BSplineTransformType::ParametersType bsplineParameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < bsplineParameters.Size(); ++i)
+  {
+    bsplineParameters[i] = std::sin(0.001 * i) / 3.0;
+  }
+  bspline->SetParametersByValue(bsplineParameters);
+
+  using FieldType = DisplacementFieldTransformType::DisplacementFieldType;
+  auto                field = FieldType::New();
+  FieldType::SizeType size;
+  size.Fill(32);
+  field->SetRegions(size);
+  FieldType::SpacingType spacing;
+  spacing.Fill(1.0 / 3.0);
+  field->SetSpacing(spacing);
+  field->Allocate();
+  DisplacementFieldTransformType::OutputVectorType displacement;
+  displacement.Fill(1.0 / 7.0);
+  field->FillBuffer(displacement);
+  auto displacementField = DisplacementFieldTransformType::New();
+  displacementField->SetDisplacementField(field);
+
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(affine);
+  composite->AddTransform(bspline);
+  composite->AddTransform(displacementField);
+  return composite;
+}
+
+template <typename TParametersValueType>
+bool
+CheckTransforms(const CompositeTransformType * expected, const std::string & fileName)
+{
+  using ReaderType = itk::TransformFileReaderTemplate<TParametersValueType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->Update();
+
+  const auto & transforms = *reader->GetTransformList();
+  if (transforms.size() != 1)
+  {
+    std::cerr << "Expected one transform in " << fileName << ", but got " << transforms.size() << std::endl;
+    return false;
+  }
+  const auto * composite =
+    dynamic_cast<const itk::CompositeTransform<TParametersValueType, Dimension> *>(transforms.front().GetPointer());
+  if (composite == nullptr || composite->GetNumberOfTransforms() != expected->GetNumberOfTransforms())
+  {
+    std::cerr << "Wrong composite transform read from " << fileName << std::endl;
+    return false;
+  }
+
+  // Exact values in the precision read
+  for (unsigned int i = 0; i < expected->GetNumberOfTransforms(); ++i)
+  {
+    const auto * expectedTransform = expected->GetNthTransformConstPointer(i);
+    const auto * transform = composite->GetNthTransformConstPointer(i);
+    const auto & expectedParameters = expectedTransform->GetParameters();
+    const auto & parameters = transform->GetParameters();
+    const auto & expectedFixedParameters = expectedTransform->GetFixedParameters();
+    const auto & fixedParameters = transform->GetFixedParameters();
+    bool         same = parameters.Size() == expectedParameters.Size() &&
+                fixedParameters.Size() == expectedFixedParameters.Size();
+    for (unsigned int j = 0; same && j < parameters.Size(); ++j)
+    {
+      same = parameters[j] == static_cast<TParametersValueType>(expectedParameters[j]);
+    }
+    for (unsigned int j = 0; same && j < fixedParameters.Size(); ++j)
+    {
+      same = fixedParameters[j] == expectedFixedParameters[j];
+    }
+    if (!same)
+    {
+      std::cerr << "Wrong parameters of " << transform->GetNameOfClass() << " read from " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkIOTransformBinaryTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkIOTransformBinaryTest.itkt";
+  const std::string compressedFileName = std::string(argv[1]) + "/itkIOTransformBinaryTestCompressed.itkt";
+  const std::string truncatedFileName = std::string(argv[1]) + "/itkIOTransformBinaryTestTruncated.itkt";
+
+  auto transformIO = itk::BinaryTransformIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(transformIO, BinaryTransformIOTemplate, TransformIOBaseTemplate);
+  ITK_TEST_EXPECT_TRUE(transformIO->CanWriteFile(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!transformIO->CanWriteFile("transform.txt"));
+
+  itk::ObjectFactoryBase::RegisterFactory(itk::BinaryTransformIOFactory::New());
+
+  const CompositeTransformType::Pointer composite = MakeCompositeTransform();
+
+  // Written through the factory, raw and compressed
+  auto writer = itk::TransformFileWriter::New();
+  writer->SetInput(composite);
+  writer->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<const itk::BinaryTransformIO *>(writer->GetTransformIO()) != nullptr);
+  ITK_TEST_EXPECT_TRUE(transformIO->CanReadFile(fileName.c_str()));
+
+  writer->SetFileName(compressedFileName);
+  writer->SetUseCompression(true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileLength(compressedFileName) <
+                       itksys::SystemTools::FileLength(fileName));
+
+  ITK_TEST_EXPECT_TRUE(CheckTransforms<double>(composite, fileName));
+  ITK_TEST_EXPECT_TRUE(CheckTransforms<double>(composite, compressedFileName));
+  ITK_TEST_EXPECT_TRUE(CheckTransforms<float>(composite, fileName));
+  ITK_TEST_EXPECT_TRUE(CheckTransforms<float>(composite, compressedFileName));
+
+  // A file cut in the parameters is an error, not a crash
+  {
+    std::ifstream     in(fileName, std::ios::binary);
+    std::vector<char> contents(static_cast<size_t>(itksys::SystemTools::FileLength(fileName)) / 2);
+    in.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    std::ofstream out(truncatedFileName, std::ios::binary);
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  }
+  auto reader = itk::TransformFileReader::New();
+  reader->SetFileName(truncatedFileName);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -92,6 +92,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Binary data can be memory mapped when it needs no byte swapping,
+   * that is on big endian machines or for single byte components.
+   * Symmetric tensors, which are stored as full matrices, cannot. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -607,6 +607,20 @@ VTKImageIO::Read(void * buffer)
   }
 }
 
+bool
+VTKImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  // VTK legacy files store binary data big endian
+  if (this->GetFileType() != IOFileEnum::Binary || this->GetPixelType() == IOPixelEnum::SYMMETRICSECONDRANKTENSOR ||
+      (this->GetComponentSize() > 1 && !ByteSwapper<uint16_t>::SystemIsBigEndian()) || this->GetHeaderSize() == 0)
+  {
+    return false;
+  }
+  fileName = m_FileName;
+  offset = this->GetDataPosition();
+  return true;
+}
+
 void
 VTKImageIO::ReadImageInformation()
 {